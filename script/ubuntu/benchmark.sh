@@ -0,0 +1,33 @@
+#! /bin/bash
+
+set -euo pipefail
+
+BASE_PATH="$(realpath "$(dirname "$0")/../..")"
+
+INPUT="$(realpath "$1")"
+RUNS="${2:-10}"
+WORK="$(mktemp --directory)"
+trap 'rm --force --recursive "$WORK"' EXIT
+cd "$WORK"
+
+# Both backends write their output on the working directory.
+TARGET_LANGUAGE=JAVA "$BASE_PATH/build/Compiler" < "$INPUT" >/dev/null 2>&1
+TARGET_LANGUAGE=C "$BASE_PATH/build/Compiler" < "$INPUT" >/dev/null 2>&1
+javac -d "$WORK" output.java
+cc -std=c99 -O2 -o program output.c -lm
+
+# Prints the mean wall time, in milliseconds, of running the command.
+measure() {
+	local TOTAL=0
+	for (( k = 0; k < RUNS; k++ )); do
+		local START="$(date +%s%N)"
+		"$@" >/dev/null
+		local END="$(date +%s%N)"
+		TOTAL=$(( TOTAL + END - START ))
+	done
+	echo "$(( TOTAL / RUNS / 1000000 ))"
+}
+
+echo "Java: $(measure java -cp "$WORK" Main) ms"
+echo "C:    $(measure ./program) ms"
+echo "Mean of $RUNS runs each."
@@ -10,6 +10,12 @@ RED='\033[0;31m'
 OFF='\033[0m'
 STATUS=0
 
+# The backends write their output on the working directory.
+ROOT="$(pwd)"
+COMPILER="$ROOT/build/Compiler"
+WORK="$(mktemp --directory)"
+trap 'rm --force --recursive "$WORK"' EXIT
+
 echo "Compiler should accept..."
 echo ""
 
@@ -40,5 +46,217 @@ for test in $(ls src/test/c/reject/); do
 done
 echo ""
 
+echo "C backend should run what it translates, and leave nothing otherwise..."
+echo ""
+
+for test in $(ls src/test/c/accept/ | sed "s|^|accept/|") $(ls src/test/c/reject/ | sed "s|^|reject/|"); do
+	rm --force "$WORK/output.c" "$WORK/program"
+	(cd "$WORK" && TARGET_LANGUAGE=C "$COMPILER" < "$ROOT/src/test/c/$test" >/dev/null 2>&1)
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && cc -std=c99 -o "$WORK/program" "$WORK/output.c" -lm >/dev/null 2>&1 && timeout 10 "$WORK/program" >/dev/null 2>&1; then
+		echo -e "    $test, ${GREEN}and it runs${OFF} (status $RESULT)"
+	elif [ "$RESULT" != "0" ] && [ ! -e "$WORK/output.c" ]; then
+		echo -e "    $test, ${GREEN}and it rejects it${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it fails${OFF} (status $RESULT)"
+	fi
+done
+echo ""
+
+echo "Class file backend should write a class file that runs..."
+echo ""
+
+# The programs the class file backend does not translate yet, and turns into
+# Java source instead. Any other program falling back is a regression.
+FALLBACKS="02-func-plus-main-code.py 10-for-loop.py 11-dead-code.py 13-collection-loops.py 15-arithmetic-lowering.py 16-string-accumulators.py 17-membership.py 20-tail-calls.py 21-cached-functions.py 22-tuple-unpacking.py 23-parallel-reductions.py 25-module-constants.py 26-integer-ranges.py 27-character-concatenation.py 28-nested-unpacking.py"
+
+if ! command -v java >/dev/null 2>&1 || ! command -v javac >/dev/null 2>&1 || ! command -v javap >/dev/null 2>&1; then
+	STATUS=1
+	echo -e "    ${RED}Failed, since there is no JDK installed${OFF}"
+else
+	for test in $(ls src/test/c/accept/); do
+		rm --force "$WORK/Main.class" "$WORK/output.java"
+		(cd "$WORK" && TARGET_LANGUAGE=CLASS "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+		RESULT="$?"
+		if [[ " $FALLBACKS " == *" $test "* ]]; then
+			if [ "$RESULT" == "0" ] && [ -e "$WORK/output.java" ] && javac -d "$WORK" "$WORK/output.java" >/dev/null 2>&1 && java -cp "$WORK" Main >/dev/null 2>&1; then
+				echo -e "    $test, ${GREEN}and it falls back to Java${OFF} (status $RESULT)"
+			else
+				STATUS=1
+				echo -e "    $test, ${RED}but its fallback fails${OFF} (status $RESULT)"
+			fi
+		elif [ "$RESULT" == "0" ] && [ ! -e "$WORK/output.java" ] && javap -c -p -cp "$WORK" Main >/dev/null 2>&1 && java -cp "$WORK" Main >/dev/null 2>&1; then
+			echo -e "    $test, ${GREEN}and it runs${OFF} (status $RESULT)"
+		else
+			STATUS=1
+			echo -e "    $test, ${RED}but it fails${OFF} (status $RESULT)"
+		fi
+	done
+fi
+echo ""
+
+echo "Virtual machine should end every program as the Java backend does..."
+echo ""
+
+# The Java programs print nothing, so both runs are compared by how they end,
+# allowing some seconds to each before taking it as one that never ends.
+# The programs whose integers leave the longs, which Java promotes to big
+# integers, make the machine raise an OverflowError instead.
+OVERFLOWS="23-parallel-reductions.py 26-integer-ranges.py"
+
+outcome() {
+	case "$1" in
+		0) echo "runs" ;;
+		124) echo "never ends" ;;
+		*) echo "fails" ;;
+	esac
+}
+
+if ! command -v java >/dev/null 2>&1 || ! command -v javac >/dev/null 2>&1; then
+	STATUS=1
+	echo -e "    ${RED}Failed, since there is no JDK installed${OFF}"
+else
+	for test in $(ls src/test/c/accept/); do
+		(cd "$WORK" && TARGET_LANGUAGE=VM timeout 10 "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+		RESULT="$?"
+		rm --force "$WORK/output.java" "$WORK"/*.class
+		(cd "$WORK" && TARGET_LANGUAGE=JAVA "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+		javac -d "$WORK" "$WORK/output.java" >/dev/null 2>&1 && timeout 10 java -cp "$WORK" Main >/dev/null 2>&1
+		EXPECTED="$?"
+		if [[ " $OVERFLOWS " == *" $test "* ]]; then
+			if [ "$(outcome "$RESULT")" == "fails" ] && [ "$(outcome "$EXPECTED")" == "runs" ]; then
+				echo -e "    $test, ${GREEN}and it overflows where Java runs${OFF} (status $RESULT)"
+			else
+				STATUS=1
+				echo -e "    $test, ${RED}but it $(outcome "$RESULT") while Java $(outcome "$EXPECTED")${OFF} (status $RESULT)"
+			fi
+		elif [ "$(outcome "$RESULT")" == "$(outcome "$EXPECTED")" ]; then
+			echo -e "    $test, ${GREEN}and it $(outcome "$RESULT")${OFF} (status $RESULT)"
+		else
+			STATUS=1
+			echo -e "    $test, ${RED}but it $(outcome "$RESULT") while Java $(outcome "$EXPECTED")${OFF} (status $RESULT)"
+		fi
+	done
+fi
+echo ""
+
+echo "Compiler should accept the synthetic programs of the benchmark..."
+echo ""
+
+# Every generated function is called, so dead code elimination must keep all
+# of them, and the Java program has a method for each one.
+for seed in 1 2 3 4 5; do
+	build/CompilerBench --generate --lines 200 --seed "$seed" > "$WORK/corpus.py" 2>/dev/null
+	GENERATED="$?"
+	rm --force "$WORK/output.java"
+	(cd "$WORK" && "$COMPILER" < "$WORK/corpus.py" >/dev/null 2>&1)
+	RESULT="$?"
+	DEFINED="$(grep --count "^def f[0-9]*(" "$WORK/corpus.py")"
+	KEPT="$(grep --count --extended-regexp "^\s*public static \S+ f[0-9]+\(" "$WORK/output.java" 2>/dev/null)"
+	if [ "$GENERATED" != "0" ] || [ "$RESULT" != "0" ]; then
+		STATUS=1
+		echo -e "    seed $seed, ${RED}but it rejects${OFF} (status $RESULT)"
+	elif [ "$DEFINED" == "0" ] || [ "$KEPT" != "$DEFINED" ]; then
+		STATUS=1
+		echo -e "    seed $seed, ${RED}but it keeps $KEPT of its $DEFINED functions${OFF} (status $RESULT)"
+	else
+		echo -e "    seed $seed, ${GREEN}and it does, keeping its $DEFINED functions${OFF} (status $RESULT)"
+	fi
+done
+echo ""
+
+echo "Statistics should report every phase, with or without performance counters..."
+echo ""
+
+PHASES="parse computeProgram eliminateDeadCode computeFunctionEffects inferTypes hoistLoopInvariants generate releaseProgram"
+
+# Checks that the report of STATISTICS_FILE has one entry per phase, in order,
+# and counters that are either counts or null, which all must be when asked.
+cat > "$WORK/statistics.py" <<-'EOF'
+	import json, sys
+	report = json.load(open(sys.argv[1]))
+	assert [phase["name"] for phase in report["phases"]] == sys.argv[2].split()
+	for counters in [phase["counters"] for phase in report["phases"]] + [report["counters"]]:
+	    for value in counters.values():
+	        assert value is None or (isinstance(value, int) and 0 <= value)
+	        assert value is None or sys.argv[3:] != ["null"]
+EOF
+
+# Runs a command where perf_event_open fails with EACCES, as inside most
+# containers, through a seccomp filter on its system call.
+cat > "$WORK/without-counters.py" <<-'EOF'
+	import ctypes, os, platform, struct, sys
+	number = {"x86_64": 298, "aarch64": 241}[platform.machine()]
+	# Loads the system call number, and fails it with EACCES if it matches.
+	program = struct.pack("HBBI", 0x20, 0, 0, 0) + struct.pack("HBBI", 0x15, 0, 1, number) \
+	    + struct.pack("HBBI", 0x06, 0, 0, 0x00050000 | 13) + struct.pack("HBBI", 0x06, 0, 0, 0x7fff0000)
+	buffer = ctypes.create_string_buffer(program)
+	class Program(ctypes.Structure):
+	    _fields_ = [("length", ctypes.c_ushort), ("filter", ctypes.c_void_p)]
+	libc = ctypes.CDLL(None, use_errno=True)
+	assert libc.prctl(38, 1, 0, 0, 0) == 0
+	assert libc.prctl(22, 2, ctypes.byref(Program(4, ctypes.addressof(buffer))), 0, 0) == 0
+	os.execv(sys.argv[1], sys.argv[1:])
+EOF
+
+for test in $(ls src/test/c/accept/ | head -n 3); do
+	rm --force "$WORK/statistics.json"
+	(cd "$WORK" && STATISTICS_FILE="$WORK/statistics.json" "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && python3 "$WORK/statistics.py" "$WORK/statistics.json" "$PHASES" >/dev/null 2>&1; then
+		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it does not${OFF} (status $RESULT)"
+	fi
+	rm --force "$WORK/statistics.json"
+	(cd "$WORK" && STATISTICS_FILE="$WORK/statistics.json" python3 "$WORK/without-counters.py" "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && python3 "$WORK/statistics.py" "$WORK/statistics.json" "$PHASES" "null" >/dev/null 2>&1; then
+		echo -e "    $test without counters, ${GREEN}and it does${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test without counters, ${RED}but it does not${OFF} (status $RESULT)"
+	fi
+done
+echo ""
+
+echo "Trace should balance the spans of every phase..."
+echo ""
+
+# Checks that the events of TRACE_FILE form a JSON array where every span that
+# begins on a thread ends on it, and the spans of the phases come in order.
+cat > "$WORK/trace.py" <<-'EOF'
+	import json, sys
+	events = json.load(open(sys.argv[1]))
+	assert isinstance(events, list)
+	open_spans = {}
+	phases = []
+	for event in events:
+	    spans = open_spans.setdefault(event["tid"], [])
+	    if event["ph"] == "B":
+	        spans.append(event)
+	        if event["cat"] == "phase":
+	            phases.append(event["name"])
+	    elif event["ph"] == "E":
+	        assert spans.pop()["ts"] <= event["ts"]
+	assert all(len(spans) == 0 for spans in open_spans.values())
+	assert phases == sys.argv[2].split()
+EOF
+
+for test in $(ls src/test/c/accept/ | head -n 3); do
+	rm --force "$WORK/trace.json"
+	(cd "$WORK" && TRACE_FILE="$WORK/trace.json" "$COMPILER" < "$ROOT/src/test/c/accept/$test" >/dev/null 2>&1)
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && python3 "$WORK/trace.py" "$WORK/trace.json" "$PHASES" >/dev/null 2>&1; then
+		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it does not${OFF} (status $RESULT)"
+	fi
+done
+echo ""
+
 echo "All done."
 exit $STATUS
@@ -0,0 +1,218 @@
+#include "CorpusGenerator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (_WIN32)
+#include <windows.h>
+#define NULL_DEVICE "NUL"
+#else
+#include <sys/wait.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+/**
+ * Generates synthetic programs of growing sizes, compiles each one with the
+ * compiler and collects the statistics it reports for every phase into a
+ * single JSON report, so that runs on different commits can be compared.
+ */
+
+/** The sizes, in lines, measured unless others are given. */
+static const char * const DEFAULT_SIZES = "1000,10000,100000,1000000,10000000";
+
+static double _now() {
+#if defined (_WIN32)
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return 1000.0 * counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return 1000.0 * now.tv_sec + now.tv_nsec / 1000000.0;
+#endif
+}
+
+static void _usage(const char * program) {
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  --lines N[,N...]    the sizes of the programs to compile (default %s)\n"
+		"  --functions N       the functions of every program (default one per 40 lines)\n"
+		"  --statements N      the sentences of every function body (default 8)\n"
+		"  --depth N           the deepest nesting of an expression (default 3)\n"
+		"  --identifiers N     the distinct names of every kind of variable (default 32)\n"
+		"  --string-size N     the characters of every string literal (default 16)\n"
+		"  --nesting N         the deepest nesting of loops and conditionals (default 2)\n"
+		"  --seed N            the seed of the generator (default 1)\n"
+		"  --compiler PATH     the compiler to measure (default the one next to this program)\n"
+		"  --report PATH       where to write the JSON report (default benchmark.json)\n"
+		"  --generate          only write the program of the first size on the standard output\n",
+		program, DEFAULT_SIZES);
+}
+
+/** The compiler built next to this program. */
+static char * _siblingCompiler(const char * program) {
+	const char * separator = strrchr(program, '/');
+#if defined (_WIN32)
+	const char * backslash = strrchr(program, '\\');
+	if (separator == NULL || (backslash != NULL && separator < backslash)) {
+		separator = backslash;
+	}
+#endif
+	const size_t prefix = (separator == NULL) ? 0 : (size_t) (separator - program + 1);
+	char * compiler = calloc(prefix + sizeof("Compiler"), sizeof(char));
+	memcpy(compiler, program, prefix);
+	strcpy(compiler + prefix, "Compiler");
+	return compiler;
+}
+
+/** Copies a whole file on the report, or "null" if it cannot be read. */
+static void _copyFile(FILE * report, const char * path) {
+	FILE * file = fopen(path, "r");
+	if (file == NULL) {
+		fputs("null", report);
+		return;
+	}
+	char buffer[4096];
+	size_t size;
+	while (0 < (size = fread(buffer, 1, sizeof(buffer), file))) {
+		fwrite(buffer, 1, size, report);
+	}
+	fclose(file);
+}
+
+static int _setEnvironment(const char * name, const char * value) {
+#if defined (_WIN32)
+	return _putenv_s(name, value);
+#else
+	return setenv(name, value, 1);
+#endif
+}
+
+/**
+ * Generates a program of the given size, compiles it and appends the
+ * results to the report. Returns the exit status of the compiler.
+ */
+static int _measure(FILE * report, const char * compiler, CorpusOptions * options) {
+	char corpus[64];
+	char statistics[64];
+	snprintf(corpus, sizeof(corpus), "corpus-%ld.py", options->lines);
+	snprintf(statistics, sizeof(statistics), "statistics-%ld.json", options->lines);
+	FILE * file = fopen(corpus, "w");
+	if (file == NULL) {
+		fprintf(stderr, "Cannot write the program on \"%s\".\n", corpus);
+		return -1;
+	}
+	const long lines = generateCorpus(file, options);
+	const long bytes = ftell(file);
+	fclose(file);
+
+	const size_t length = strlen(compiler) + strlen(corpus) + sizeof(NULL_DEVICE) + 32;
+	char * command = calloc(length, sizeof(char));
+	snprintf(command, length, "\"%s\" < \"%s\" > %s 2>&1", compiler, corpus, NULL_DEVICE);
+	_setEnvironment("STATISTICS_FILE", statistics);
+	remove(statistics);
+	const double start = _now();
+	int status = system(command);
+	const double wallMilliseconds = _now() - start;
+#if !defined (_WIN32)
+	status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+	free(command);
+
+	fprintf(report, "\t\t{\n\t\t\t\"lines\": %ld,\n\t\t\t\"bytes\": %ld,\n\t\t\t\"status\": %d,\n\t\t\t\"wallMilliseconds\": %.3f,\n\t\t\t\"statistics\": ",
+		lines, bytes, status, wallMilliseconds);
+	_copyFile(report, statistics);
+	fprintf(report, "\t\t}");
+	remove(statistics);
+	remove(corpus);
+	printf("%10ld lines, %12ld bytes: status %d in %.1f ms\n", lines, bytes, status, wallMilliseconds);
+	fflush(stdout);
+	return status;
+}
+
+int main(const int count, const char ** arguments) {
+	CorpusOptions options = defaultCorpusOptions();
+	const char * sizes = DEFAULT_SIZES;
+	const char * reportPath = "benchmark.json";
+	char * compiler = NULL;
+	int isGenerating = 0;
+	for (int k = 1; k < count; ++k) {
+		const char * option = arguments[k];
+		const char * value = (k + 1 < count) ? arguments[k + 1] : NULL;
+		if (strcmp(option, "--generate") == 0) {
+			isGenerating = 1;
+			continue;
+		}
+		if (value == NULL) {
+			_usage(arguments[0]);
+			return 1;
+		}
+		++k;
+		if (strcmp(option, "--lines") == 0) {
+			sizes = value;
+		} else if (strcmp(option, "--functions") == 0) {
+			options.functions = atol(value);
+		} else if (strcmp(option, "--statements") == 0) {
+			options.statements = atoi(value);
+		} else if (strcmp(option, "--depth") == 0) {
+			options.depth = atoi(value);
+		} else if (strcmp(option, "--identifiers") == 0) {
+			options.identifiers = atoi(value);
+		} else if (strcmp(option, "--string-size") == 0) {
+			options.stringSize = atoi(value);
+		} else if (strcmp(option, "--nesting") == 0) {
+			options.nesting = atoi(value);
+		} else if (strcmp(option, "--seed") == 0) {
+			options.seed = strtoull(value, NULL, 10);
+		} else if (strcmp(option, "--compiler") == 0) {
+			free(compiler);
+			compiler = strdup(value);
+		} else if (strcmp(option, "--report") == 0) {
+			reportPath = value;
+		} else {
+			_usage(arguments[0]);
+			return 1;
+		}
+	}
+	if (options.statements < 1 || options.depth < 0 || options.identifiers < 1 || options.stringSize < 0 || options.nesting < 0) {
+		_usage(arguments[0]);
+		return 1;
+	}
+	if (isGenerating) {
+		options.lines = atol(sizes);
+		generateCorpus(stdout, &options);
+		return 0;
+	}
+	if (compiler == NULL) {
+		compiler = _siblingCompiler(arguments[0]);
+	}
+	FILE * report = fopen(reportPath, "w");
+	if (report == NULL) {
+		fprintf(stderr, "Cannot write the report on \"%s\".\n", reportPath);
+		return 1;
+	}
+	fprintf(report, "{\n\t\"options\": { \"functions\": %ld, \"statements\": %d, \"depth\": %d, \"identifiers\": %d, \"stringSize\": %d, \"nesting\": %d, \"seed\": %llu },\n\t\"runs\": [\n",
+		options.functions, options.statements, options.depth, options.identifiers, options.stringSize, options.nesting, (unsigned long long) options.seed);
+	int status = 0;
+	int isFirst = 1;
+	for (const char * size = sizes; *size != '\0'; ) {
+		char * end = NULL;
+		options.lines = strtol(size, &end, 10);
+		if (end == size || options.lines <= 0) {
+			_usage(arguments[0]);
+			status = 1;
+			break;
+		}
+		if (!isFirst) {
+			fprintf(report, ",\n");
+		}
+		isFirst = 0;
+		status |= _measure(report, compiler, &options) != 0;
+		size = (*end == ',') ? end + 1 : end;
+	}
+	fprintf(report, "\n\t]\n}\n");
+	fclose(report);
+	free(compiler);
+	return status;
+}
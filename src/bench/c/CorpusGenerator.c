@@ -0,0 +1,277 @@
+#include "CorpusGenerator.h"
+#include <stdarg.h>
+
+/** The lines per function when their count is not given. */
+#define LINES_PER_FUNCTION 40
+
+/** The most sentences in the body of a loop or a conditional. */
+#define MAXIMUM_BLOCK_STATEMENTS 3
+
+/* MODULE INTERNAL STATE */
+
+static const CorpusOptions * _options = NULL;
+static FILE * _file = NULL;
+static long _lines = 0;
+static uint64_t _state = 0;
+
+/** The functions defined so far, which are the only ones that may be called. */
+static long _functionCount = 0;
+
+/** Whether the sentences go into the body of a function. */
+static int _isInFunction = 0;
+
+/** The variables of every kind assigned so far, named with a prefix and their index. */
+static int _integers = 0;
+static int _locals = 0;
+static int _strings = 0;
+static int _floats = 0;
+
+/** The loops around the current sentence, whose variables are "c0", "c1" and so on. */
+static int _loops = 0;
+
+/* PRIVATE FUNCTIONS */
+
+/**
+ * The next number of a xorshift64* generator, which only depends on the
+ * seed so that every platform generates the same program.
+ */
+static uint64_t _random() {
+	_state ^= _state >> 12;
+	_state ^= _state << 25;
+	_state ^= _state >> 27;
+	return _state * 0x2545F4914F6CDD1DULL;
+}
+
+static long _below(const long bound) {
+	return (long) (_random() % (uint64_t) bound);
+}
+
+static void _write(const char * format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	vfprintf(_file, format, arguments);
+	va_end(arguments);
+}
+
+static void _indent(const int level) {
+	for (int k = 0; k < level; ++k) {
+		fputs("    ", _file);
+	}
+}
+
+static void _endLine() {
+	fputc('\n', _file);
+	++_lines;
+}
+
+static void _integerLeaf() {
+	const long choice = _below(4);
+	if (choice == 0 && _loops > 0) {
+		_write("c%ld", _below(_loops));
+	} else if (choice == 1 && _isInFunction) {
+		_write("%c", (_below(2) == 0) ? 'a' : 'b');
+	} else if (choice == 2 && _isInFunction) {
+		_write("l%ld", _below(_locals));
+	} else if (choice == 2 && !_isInFunction && _integers > 0) {
+		_write("v%ld", _below(_integers));
+	} else {
+		_write("%ld", _below(100));
+	}
+}
+
+static void _integerExpression(const int depth) {
+	const long choice = _below(10);
+	if (depth <= 0 || choice < 3) {
+		_integerLeaf();
+	} else if (choice == 3 && _functionCount > 0) {
+		_write("f%ld(", _below(_functionCount));
+		_integerExpression(depth - 1);
+		_write(", ");
+		_integerExpression(depth - 1);
+		_write(")");
+	} else if (choice < 6) {
+		// Divides by literals only, so that no generated program divides by zero.
+		_write("(");
+		_integerExpression(depth - 1);
+		_write((choice == 4) ? " // %ld)" : " %% %ld)", 2 + _below(8));
+	} else {
+		static const char * const operators[] = { "+", "-", "*" };
+		_write("(");
+		_integerExpression(depth - 1);
+		_write(" %s ", operators[_below(3)]);
+		_integerExpression(depth - 1);
+		_write(")");
+	}
+}
+
+static void _stringLiteral() {
+	static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ";
+	fputc('"', _file);
+	for (int k = 0; k < _options->stringSize; ++k) {
+		fputc(alphabet[_below(sizeof(alphabet) - 1)], _file);
+	}
+	fputc('"', _file);
+}
+
+/**
+ * Assigns a variable of the given kind, of which at least one exists. Only
+ * sentences out of every block declare new variables, so that any variable
+ * read was surely assigned.
+ */
+static void _assignment(const int level, const int isNested, const char prefix, int * count) {
+	const int isDeclaration = !isNested && *count < _options->identifiers && _below(3) == 0;
+	const long target = isDeclaration ? *count : _below(*count);
+	_indent(level);
+	_write("%c%ld = ", prefix, target);
+	if (prefix == 's') {
+		_write("s%ld + ", _below(*count));
+		_stringLiteral();
+	} else if (prefix == 'x') {
+		_write("x%ld * 1.5 + ", _below(*count));
+		_integerExpression(1);
+	} else {
+		_integerExpression(_options->depth);
+	}
+	_endLine();
+	// The new variable is only readable once assigned.
+	if (isDeclaration) {
+		++*count;
+	}
+}
+
+static void _statements(const int level, const int nesting, const long count);
+
+static void _block(const int level, const int nesting) {
+	_statements(level + 1, nesting + 1, 1 + _below(MAXIMUM_BLOCK_STATEMENTS));
+	_indent(level);
+	_write("@}");
+	_endLine();
+}
+
+static void _statement(const int level, const int nesting) {
+	const long choice = _below(12);
+	if (choice < 6 || nesting >= _options->nesting) {
+		if (_isInFunction) {
+			_assignment(level, nesting > 0, 'l', &_locals);
+		} else {
+			_assignment(level, nesting > 0, 'v', &_integers);
+		}
+	} else if (choice == 6 && !_isInFunction) {
+		_assignment(level, nesting > 0, 's', &_strings);
+	} else if (choice == 7 && !_isInFunction) {
+		_assignment(level, nesting > 0, 'x', &_floats);
+	} else if (choice < 9) {
+		_indent(level);
+		_write("for c%d in range(", _loops);
+		_integerExpression(1);
+		_write("): @{");
+		_endLine();
+		++_loops;
+		_block(level, nesting);
+		--_loops;
+	} else if (choice < 11) {
+		_indent(level);
+		_write("if ");
+		_integerExpression(1);
+		_write(" < ");
+		_integerExpression(1);
+		_write(": @{");
+		_endLine();
+		_block(level, nesting);
+		if (_below(2) == 0) {
+			_indent(level);
+			_write("else: @{");
+			_endLine();
+			_block(level, nesting);
+		}
+	} else {
+		_indent(level);
+		_write("n%d = 0", nesting);
+		_endLine();
+		_indent(level);
+		_write("while n%d < %ld: @{", nesting, 1 + _below(8));
+		_endLine();
+		_indent(level + 1);
+		_write("n%d = n%d + 1", nesting, nesting);
+		_endLine();
+		_block(level, nesting);
+	}
+}
+
+static void _statements(const int level, const int nesting, const long count) {
+	for (long k = 0; k < count; ++k) {
+		_statement(level, nesting);
+	}
+}
+
+static void _function() {
+	_write("def f%ld(a, b): @{", _functionCount);
+	_endLine();
+	_isInFunction = 1;
+	_locals = 1;
+	_write("    l0 = a + b");
+	_endLine();
+	_statements(1, 0, _options->statements - 1);
+	_write("    return ");
+	_integerExpression(_options->depth);
+	_endLine();
+	_write("@}");
+	_endLine();
+	_endLine();
+	_isInFunction = 0;
+	// Calls it right away, as later sentences may not, so that dead code elimination keeps it.
+	_write("v%ld = f%ld(", _below(_integers), _functionCount);
+	_integerExpression(1);
+	_write(", ");
+	_integerExpression(1);
+	_write(")");
+	_endLine();
+	++_functionCount;
+}
+
+/* PUBLIC FUNCTIONS */
+
+CorpusOptions defaultCorpusOptions() {
+	CorpusOptions options = {
+		.lines = 1000,
+		.functions = 0,
+		.statements = 8,
+		.depth = 3,
+		.identifiers = 32,
+		.stringSize = 16,
+		.nesting = 2,
+		.seed = 1
+	};
+	return options;
+}
+
+long generateCorpus(FILE * file, const CorpusOptions * options) {
+	_options = options;
+	_file = file;
+	_lines = 0;
+	// A xorshift generator never leaves zero.
+	_state = (options->seed == 0) ? 0x9E3779B97F4A7C15ULL : options->seed;
+	_functionCount = 0;
+	_integers = 1;
+	_strings = 1;
+	_floats = 1;
+	_loops = 0;
+	const long long functions = (0 < options->functions) ? options->functions : 1 + options->lines / LINES_PER_FUNCTION;
+	_write("# Generated by CompilerBench: %ld lines, seed %llu", options->lines, (unsigned long long) options->seed);
+	_endLine();
+	_write("v0 = 1");
+	_endLine();
+	_write("s0 = ");
+	_stringLiteral();
+	_endLine();
+	_write("x0 = 2.5");
+	_endLine();
+	while (_lines < options->lines) {
+		if (_functionCount < functions && (long long) _functionCount * options->lines <= (long long) _lines * functions) {
+			_function();
+		} else {
+			_statement(0, 0);
+		}
+	}
+	return _lines;
+}
@@ -0,0 +1,39 @@
+#ifndef CORPUS_GENERATOR_HEADER
+#define CORPUS_GENERATOR_HEADER
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * The shape of a synthetic program. The same options and seed always
+ * generate the same program.
+ */
+typedef struct {
+	/** The fewest lines to generate; the program ends on the first complete sentence past them. */
+	long lines;
+	/** The functions to define, spread evenly over the program. Zero means one per 40 lines. */
+	long functions;
+	/** The sentences in the body of every function. */
+	int statements;
+	/** The deepest nesting of operators and calls in an expression. */
+	int depth;
+	/** The distinct names of every kind of variable, both locals and top-level ones. */
+	int identifiers;
+	/** The characters of every string literal. */
+	int stringSize;
+	/** The deepest nesting of loops and conditionals. */
+	int nesting;
+	uint64_t seed;
+} CorpusOptions;
+
+/** The options used unless others are given. */
+CorpusOptions defaultCorpusOptions();
+
+/**
+ * Writes a program the compiler accepts, which is also valid Python once
+ * its braces are removed. Every name keeps a single type, and every
+ * variable is assigned before it is read. Returns the lines written.
+ */
+long generateCorpus(FILE * file, const CorpusOptions * options);
+
+#endif
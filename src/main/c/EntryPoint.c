@@ -1,6 +1,13 @@
+#include "backend/code-generation/CGenerator.h"
+#include "backend/code-generation/ClassFileGenerator.h"
+#include "backend/code-generation/DeadCodeEliminator.h"
 #include "backend/code-generation/Generator.h"
+#include "backend/code-generation/LoopInvariantHoister.h"
 // #include "backend/domain-specific/Calculator.h"
+#include "backend/domain-specific/BytecodeCompiler.h"
+#include "backend/domain-specific/VirtualMachine.h"
 #include "backend/semantic-analysis/SemanticAnalyzer.h"
+#include "backend/semantic-analysis/TypeInference.h"
 #include "frontend/lexical-analysis/FlexActions.h"
 #include "frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "frontend/syntactic-analysis/BisonActions.h"
@@ -8,7 +15,9 @@
 #include "shared/CompilerState.h"
 #include "shared/Environment.h"
 #include "shared/Logger.h"
+#include "shared/Statistics.h"
 #include "shared/String.h"
+#include "shared/Trace.h"
 #include "frontend/lexical-analysis/LexicalAnalyzerContext.h"
 /**
  * The main entry-point of the entire application.
@@ -18,12 +27,21 @@ extern LexicalAnalyzerContext * oldLexicalAnalyzerContext;
 
 const int main(const int count, const char ** arguments) {
 	Logger * logger = createLogger("EntryPoint");
+	initializeTraceModule();
+	initializeStatisticsModule();
 	initializeFlexActionsModule();
 	initializeBisonActionsModule();
 	initializeSyntacticAnalyzerModule();
 	initializeAbstractSyntaxTreeModule();
 	initializeSemanticAnalyzerModule();
+	initializeDeadCodeEliminatorModule();
+	initializeTypeInferenceModule();
+	initializeLoopInvariantHoisterModule();
 	initializeGeneratorModule();
+	initializeCGeneratorModule();
+	initializeClassFileGeneratorModule();
+	initializeBytecodeCompilerModule();
+	initializeVirtualMachineModule();
 
 	// Logs the arguments of the application.
 	for (int k = 0; k < count; ++k) {
@@ -36,21 +54,62 @@ const int main(const int count, const char ** arguments) {
 		.succeed = false,
 		.value = 0
 	};
+	beginPhase("parse");
 	const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
+	endPhase();
 	CompilationStatus compilationStatus = SUCCEED;
 	if (syntacticAnalysisStatus == ACCEPT) {
 		Program * program = compilerState.abstractSyntaxtTree;
 		logDebugging(logger, "Computing program value...");
+		beginPhase("computeProgram");
 		SaComputationResult computationResult = computeProgram(program);
+		endPhase();
 		if (computationResult.success) {
 		 	logInformation(logger, "The computation phase accepts the input program.");
-		 	generateProgram(program);
+		 	beginPhase("eliminateDeadCode");
+		 	eliminateDeadCode(program);
+		 	endPhase();
+		 	beginPhase("computeFunctionEffects");
+		 	computeFunctionEffects(program);
+		 	endPhase();
+		 	beginPhase("inferTypes");
+		 	inferTypes(program);
+		 	endPhase();
+		 	beginPhase("hoistLoopInvariants");
+		 	hoistLoopInvariants(program);
+		 	endPhase();
+		 	beginPhase("generate");
+		 	if (isVirtualMachineSelected()) {
+		 		BytecodeProgram * bytecode = compileBytecode(program);
+		 		if (bytecode == NULL) {
+		 			logError(logger, "The bytecode compiler rejects the input program.");
+		 			compilationStatus = FAILED;
+		 		} else {
+		 			if (!runBytecode(bytecode)) {
+		 				compilationStatus = FAILED;
+		 			}
+		 			releaseBytecode(bytecode);
+		 		}
+		 	} else if (isCTargetSelected()) {
+		 		if (!generateCProgram(program)) {
+		 			logError(logger, "The C backend rejects the input program.");
+		 			compilationStatus = FAILED;
+		 		}
+		 	} else if (!isClassTargetSelected()) {
+		 		generateProgram(program);
+		 	} else if (!generateClassFile(program)) {
+		 		logWarning(logger, "The class file backend rejects the input program, generating Java source instead.");
+		 		generateProgram(program);
+		 	}
+		 	endPhase();
 		 } else {
 		 	logError(logger, "The computation phase rejects the input program.");
 		 	compilationStatus = FAILED;
 		 }
 		logDebugging(logger, "Releasing AST resources...");
+		beginPhase("releaseProgram");
 		releaseProgram(program);
+		endPhase();
 	} else {
 		logError(logger, "The syntactic-analysis phase rejects the input program.");
 		compilationStatus = FAILED;
@@ -76,7 +135,14 @@ const int main(const int count, const char ** arguments) {
 	// }
 
 	logDebugging(logger, "Releasing modules resources...");
+	shutdownVirtualMachineModule();
+	shutdownBytecodeCompilerModule();
+	shutdownClassFileGeneratorModule();
+	shutdownCGeneratorModule();
 	shutdownGeneratorModule();
+	shutdownLoopInvariantHoisterModule();
+	shutdownTypeInferenceModule();
+	shutdownDeadCodeEliminatorModule();
 	shutdownSemanticAnalyzerModule();
 	shutdownAbstractSyntaxTreeModule();
 	shutdownSyntacticAnalyzerModule();
@@ -85,5 +151,7 @@ const int main(const int count, const char ** arguments) {
 	logDebugging(logger, "Compilation is done.");
 	destroyLogger(logger);
 	destroyLexicalAnalyzerContext(oldLexicalAnalyzerContext);
+	shutdownStatisticsModule();
+	shutdownTraceModule();
 	return compilationStatus;
 }
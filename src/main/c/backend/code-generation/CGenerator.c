@@ -0,0 +1,1252 @@
+#include "CGenerator.h"
+#include "../semantic-analysis/HashMap.h"
+
+/** The most functions a program translated to C may define. */
+#define MAXIMUM_C_FUNCTIONS 256
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+static FILE * _file = NULL;
+
+static int _indentLevel = 0;
+
+static int _loopCount = 0;
+
+/** Whether the target language, read from the environment, is C. */
+static boolean _isCTarget = false;
+
+/** Whether some construct of the program has no C translation. */
+static boolean _isUnsupported = false;
+
+typedef struct {
+    const char * name;
+} tSymbolKey;
+
+/** The symbols already declared on the C function being generated, or on the file for the top-level ones. */
+static hashMapADT _declared = NULL;
+
+/** The function definitions of the program, in the order they appear. */
+static Block * _functions[MAXIMUM_C_FUNCTIONS];
+static int _functionCount = 0;
+
+/** The hidden variable of the unpacking whose elements are being assigned from temporaries. */
+static const Variable * _unpackedVariable = NULL;
+static int _unpackedCount = 0;
+
+/** The type returned by the function being generated. */
+static SaDataType _returnType = SA_VOID;
+
+/**
+ * The runtime every generated program carries. Strings and lists are views
+ * over memory taken from an arena, which is never freed one object at a
+ * time, so values may be shared freely.
+ */
+static const char * const _runtime[] = {
+    "#include <math.h>",
+    "#include <stdbool.h>",
+    "#include <stdint.h>",
+    "#include <stdio.h>",
+    "#include <stdlib.h>",
+    "#include <string.h>",
+    "",
+    "typedef struct tp_chunk {",
+    "\tstruct tp_chunk * next;",
+    "\tsize_t used;",
+    "\tsize_t size;",
+    "\tdouble data[];",
+    "} tp_chunk;",
+    "",
+    "static tp_chunk * tp_arena = NULL;",
+    "",
+    "static inline void tp_fail(const char * message) {",
+    "\tfprintf(stderr, \"Exception: %s\\n\", message);",
+    "\texit(1);",
+    "}",
+    "",
+    "static inline void * tp_allocate(size_t size) {",
+    "\tsize = (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);",
+    "\tif (tp_arena == NULL || tp_arena->size - tp_arena->used < size) {",
+    "\t\tconst size_t chunkSize = (size < 65536)? 65536 : size;",
+    "\t\ttp_chunk * chunk = malloc(sizeof(tp_chunk) + chunkSize);",
+    "\t\tif (chunk == NULL) {",
+    "\t\t\ttp_fail(\"out of memory\");",
+    "\t\t}",
+    "\t\tchunk->next = tp_arena;",
+    "\t\tchunk->used = 0;",
+    "\t\tchunk->size = chunkSize;",
+    "\t\ttp_arena = chunk;",
+    "\t}",
+    "\tvoid * memory = (char *) tp_arena->data + tp_arena->used;",
+    "\ttp_arena->used += size;",
+    "\treturn memory;",
+    "}",
+    "",
+    "static inline void tp_release(void) {",
+    "\twhile (tp_arena != NULL) {",
+    "\t\ttp_chunk * next = tp_arena->next;",
+    "\t\tfree(tp_arena);",
+    "\t\ttp_arena = next;",
+    "\t}",
+    "}",
+    "",
+    "static inline void * tp_copy(const void * items, size_t size) {",
+    "\tvoid * copy = tp_allocate(size);",
+    "\tmemcpy(copy, items, size);",
+    "\treturn copy;",
+    "}",
+    "",
+    "typedef struct {",
+    "\tint32_t length;",
+    "\tconst char * chars;",
+    "} tp_string;",
+    "",
+    "#define TP_LITERAL(text) ((tp_string) { (int32_t) (sizeof(text) - 1), text })",
+    "",
+    "static const char tp_characters[512] = {",
+    "#define TP_CHARACTER(c) (char) (c), 0, (char) (c + 1), 0, (char) (c + 2), 0, (char) (c + 3), 0",
+    "#define TP_CHARACTERS(c) TP_CHARACTER(c), TP_CHARACTER(c + 4), TP_CHARACTER(c + 8), TP_CHARACTER(c + 12)",
+    "\tTP_CHARACTERS(0), TP_CHARACTERS(16), TP_CHARACTERS(32), TP_CHARACTERS(48),",
+    "\tTP_CHARACTERS(64), TP_CHARACTERS(80), TP_CHARACTERS(96), TP_CHARACTERS(112),",
+    "\tTP_CHARACTERS(128), TP_CHARACTERS(144), TP_CHARACTERS(160), TP_CHARACTERS(176),",
+    "\tTP_CHARACTERS(192), TP_CHARACTERS(208), TP_CHARACTERS(224), TP_CHARACTERS(240)",
+    "};",
+    "",
+    "static inline tp_string tp_char_string(char c) {",
+    "\treturn (tp_string) { 1, &tp_characters[2 * (unsigned char) c] };",
+    "}",
+    "",
+    "static inline tp_string tp_concat(tp_string left, tp_string right) {",
+    "\tchar * chars = tp_allocate((size_t) left.length + right.length + 1);",
+    "\tmemcpy(chars, left.chars, left.length);",
+    "\tmemcpy(chars + left.length, right.chars, right.length);",
+    "\tchars[left.length + right.length] = 0;",
+    "\treturn (tp_string) { left.length + right.length, chars };",
+    "}",
+    "",
+    "static inline int tp_compare(tp_string left, tp_string right) {",
+    "\tconst int32_t length = (left.length < right.length)? left.length : right.length;",
+    "\tconst int order = (length == 0)? 0 : memcmp(left.chars, right.chars, length);",
+    "\treturn (order != 0)? order : (left.length > right.length) - (left.length < right.length);",
+    "}",
+    "",
+    "static inline bool tp_equals(tp_string left, tp_string right) {",
+    "\treturn left.length == right.length && (left.length == 0 || memcmp(left.chars, right.chars, left.length) == 0);",
+    "}",
+    "",
+    "static inline bool tp_contains_string(tp_string text, tp_string part) {",
+    "\tfor (int32_t k = 0; k + part.length <= text.length; k++) {",
+    "\t\tif (memcmp(text.chars + k, part.chars, part.length) == 0) {",
+    "\t\t\treturn true;",
+    "\t\t}",
+    "\t}",
+    "\treturn false;",
+    "}",
+    "",
+    "#define TP_LIST(name, type) \\",
+    "\ttypedef struct { int32_t length; type * items; } name; \\",
+    "\tstatic inline bool tp_contains_##name(name list, type value) { \\",
+    "\t\tfor (int32_t k = 0; k < list.length; k++) { \\",
+    "\t\t\tif (list.items[k] == value) { \\",
+    "\t\t\t\treturn true; \\",
+    "\t\t\t} \\",
+    "\t\t} \\",
+    "\t\treturn false; \\",
+    "\t}",
+    "",
+    "TP_LIST(tp_bools, bool)",
+    "TP_LIST(tp_ints, int32_t)",
+    "TP_LIST(tp_longs, int64_t)",
+    "TP_LIST(tp_doubles, double)",
+    "",
+    "typedef struct {",
+    "\tint32_t length;",
+    "\ttp_string * items;",
+    "} tp_strings;",
+    "",
+    "static inline bool tp_contains_tp_strings(tp_strings list, tp_string value) {",
+    "\tfor (int32_t k = 0; k < list.length; k++) {",
+    "\t\tif (tp_equals(list.items[k], value)) {",
+    "\t\t\treturn true;",
+    "\t\t}",
+    "\t}",
+    "\treturn false;",
+    "}",
+    "",
+    "static inline int64_t tp_add_exact(int64_t left, int64_t right) {",
+    "\tif ((right > 0 && left > INT64_MAX - right) || (right < 0 && left < INT64_MIN - right)) {",
+    "\t\ttp_fail(\"integer overflow\");",
+    "\t}",
+    "\treturn left + right;",
+    "}",
+    "",
+    "static inline int64_t tp_subtract_exact(int64_t left, int64_t right) {",
+    "\tif ((right < 0 && left > INT64_MAX + right) || (right > 0 && left < INT64_MIN + right)) {",
+    "\t\ttp_fail(\"integer overflow\");",
+    "\t}",
+    "\treturn left - right;",
+    "}",
+    "",
+    "static inline int64_t tp_multiply_exact(int64_t left, int64_t right) {",
+    "\tconst bool overflows = (left > 0)",
+    "\t\t? ((right > 0)? left > INT64_MAX / right : right < INT64_MIN / left)",
+    "\t\t: ((right > 0)? left < INT64_MIN / right : left != 0 && right < INT64_MAX / left);",
+    "\tif (overflows) {",
+    "\t\ttp_fail(\"integer overflow\");",
+    "\t}",
+    "\treturn left * right;",
+    "}",
+    "",
+    "static inline int64_t tp_floor_divide(int64_t left, int64_t right) {",
+    "\tif (right == 0) {",
+    "\t\ttp_fail(\"integer division or modulo by zero\");",
+    "\t}",
+    "\tif (right == -1) {",
+    "\t\treturn (int64_t) (0 - (uint64_t) left);",
+    "\t}",
+    "\tconst int64_t quotient = left / right;",
+    "\treturn (left % right != 0 && (left < 0) != (right < 0))? quotient - 1 : quotient;",
+    "}",
+    "",
+    "static inline int64_t tp_floor_divide_exact(int64_t left, int64_t right) {",
+    "\tif (left == INT64_MIN && right == -1) {",
+    "\t\ttp_fail(\"integer overflow\");",
+    "\t}",
+    "\treturn tp_floor_divide(left, right);",
+    "}",
+    "",
+    "static inline int64_t tp_floor_modulo(int64_t left, int64_t right) {",
+    "\tif (right == 0) {",
+    "\t\ttp_fail(\"integer division or modulo by zero\");",
+    "\t}",
+    "\tif (right == -1) {",
+    "\t\treturn 0;",
+    "\t}",
+    "\tconst int64_t remainder = left % right;",
+    "\treturn (remainder != 0 && (remainder < 0) != (right < 0))? remainder + right : remainder;",
+    "}",
+    "",
+    "static inline double tp_floor_fmod(double left, double right) {",
+    "\tconst double remainder = fmod(left, right);",
+    "\treturn (remainder != 0 && (remainder < 0) != (right < 0))? remainder + right : remainder;",
+    "}",
+    "",
+    "static inline int64_t tp_power(int64_t base, int64_t exponent) {",
+    "\tif (exponent < 0) {",
+    "\t\ttp_fail(\"negative integer exponent\");",
+    "\t}",
+    "\tuint64_t result = 1;",
+    "\tuint64_t factor = (uint64_t) base;",
+    "\tfor (; exponent > 0; exponent >>= 1) {",
+    "\t\tif (exponent & 1) {",
+    "\t\t\tresult *= factor;",
+    "\t\t}",
+    "\t\tfactor *= factor;",
+    "\t}",
+    "\treturn (int64_t) result;",
+    "}",
+    "",
+    "static inline int64_t tp_power_exact(int64_t base, int64_t exponent) {",
+    "\tif (exponent < 0) {",
+    "\t\ttp_fail(\"negative integer exponent\");",
+    "\t}",
+    "\tint64_t result = 1;",
+    "\tfor (; exponent > 0; exponent >>= 1) {",
+    "\t\tif (exponent & 1) {",
+    "\t\t\tresult = tp_multiply_exact(result, base);",
+    "\t\t}",
+    "\t\tif (exponent > 1) {",
+    "\t\t\tbase = tp_multiply_exact(base, base);",
+    "\t\t}",
+    "\t}",
+    "\treturn result;",
+    "}",
+    NULL
+};
+
+void initializeCGeneratorModule() {
+    _logger = createLogger("CGenerator");
+    _isCTarget = strcmp(getStringOrDefault("TARGET_LANGUAGE", "JAVA"), "C") == 0;
+}
+
+void shutdownCGeneratorModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+boolean isCTargetSelected() {
+    return _isCTarget;
+}
+
+/** PRIVATE FUNCTIONS */
+
+static void _output(const char * const format, ...) {
+    va_list arguments;
+    va_start(arguments, format);
+    vfprintf(_file, format, arguments);
+    va_end(arguments);
+}
+
+static void _outputIndent() {
+    for (int i = 0; i < _indentLevel; i++) {
+        _output("\t");
+    }
+}
+
+static void _outputBraceWithIndent() {
+    _outputIndent();
+    _output("}\n");
+}
+
+/**
+ * Records a construct without C translation. Generation goes on, so every
+ * one of them gets reported.
+ */
+static void _unsupported(const char * construct) {
+    logError(_logger, "The C backend does not support %s.", construct);
+    _isUnsupported = true;
+}
+
+/**
+ * Outputs the C name of a symbol. Python names get a prefix, so they never
+ * collide with keywords or the C library, and hidden names swap their "$"
+ * for the prefix of the runtime.
+ */
+static void _outputName(const char * name) {
+    if (name[0] == '$') {
+        _output("tp_%s", name + 1);
+    } else {
+        _output("py_%s", name);
+    }
+}
+
+/**
+ * The C type of a list or tuple whose elements have the given type, or NULL
+ * if the runtime has none.
+ */
+static const char * _cListType(const SaDataType elementType) {
+    switch (elementType) {
+        case SA_BOOLEAN:
+            return "tp_bools";
+        case SA_INTEGER:
+            return "tp_ints";
+        case SA_LONG:
+            return "tp_longs";
+        case SA_FLOAT:
+            return "tp_doubles";
+        case SA_STRING:
+            return "tp_strings";
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * The C type of a symbol of the given type, or NULL if its values are only
+ * known at runtime.
+ */
+static const char * _cType(const SaDataType type, const SaDataType elementType) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return "bool";
+        case SA_CHARACTER:
+            return "char";
+        case SA_FLOAT:
+            return "double";
+        case SA_INTEGER:
+            return "int32_t";
+        case SA_LONG:
+            return "int64_t";
+        case SA_STRING:
+            return "tp_string";
+        case SA_VOID:
+            return "void";
+        case SA_LIST:
+        case SA_TUPLE:
+            return _cListType(elementType);
+        default:
+            return NULL;
+    }
+}
+
+static const char * _cDeclarationType(const SaDataType type, const SaDataType elementType, const char * name) {
+    if (type == SA_BIG_INTEGER) {
+        _unsupported("integers that may not fit in a long");
+        return "int64_t";
+    }
+    const char * cType = _cType(type, elementType);
+    if (cType == NULL || strcmp(cType, "void") == 0) {
+        logError(_logger, "The type of \"%s\" is only known at runtime.", name);
+        _unsupported("dynamically typed symbols");
+        return "int32_t";
+    }
+    return cType;
+}
+
+static boolean _isIntegral(const SaDataType type) {
+    return type == SA_INTEGER || type == SA_LONG;
+}
+
+/**
+ * Outputs a floating point literal that reads back as the same double.
+ */
+static void _outputDecimal(const double value) {
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%.15g", value);
+    if (strtod(buffer, NULL) != value) {
+        snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    if (strpbrk(buffer, ".e") == NULL) {
+        strcat(buffer, ".0");
+    }
+    _output("%s", buffer);
+}
+
+/* DECLARATIONS */
+
+static boolean _isUnpacking(const Sentence * sentence) {
+    const Sentence * element = sentence->nextSentence;
+    return sentence->type == VARIABLE_SENTENCE && element != NULL && element->type == VARIABLE_SENTENCE
+        && element->variable->expression->type == UNPACKED_ELEMENT
+        && element->variable->expression->unpackedVariable == sentence->variable;
+}
+
+static Parameters * _elementsOf(const Expression * collection) {
+    return (collection->constant->list->type == LT_PARAMETRIZED_LIST)? collection->constant->list->elements : NULL;
+}
+
+/**
+ * Whether the unpacked value is a constant with exactly one expression per
+ * target, which are evaluated into temporaries instead of a list, so that
+ * their types may differ.
+ */
+static boolean _isUnpackedInPlace(const Sentence * sentence) {
+    if (!_isUnpacking(sentence)) {
+        return false;
+    }
+    const Expression * unpacked = sentence->variable->expression;
+    if (unpacked->type != CONSTANT_EXPRESSION || (unpacked->constant->type != CT_LIST && unpacked->constant->type != CT_TUPLE)) {
+        return false;
+    }
+    int count = 0;
+    for (const Parameters * element = _elementsOf(unpacked); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        count++;
+    }
+    return count == sentence->nextSentence->variable->expression->elementCount;
+}
+
+static void _declare(const char * name, const SaDataType type, const SaDataType elementType, const char * prefix) {
+    tSymbolKey key = { .name = name };
+    if (hashMapFind(_declared, &key, NULL)) {
+        return;
+    }
+    hashMapInsertOrUpdate(_declared, &key, &key);
+    _outputIndent();
+    _output("%s%s ", prefix, _cDeclarationType(type, elementType, name));
+    _outputName(name);
+    // The views of the runtime are empty when all their fields are zero.
+    _output((type == SA_STRING || type == SA_LIST || type == SA_TUPLE)? " = {0};\n" : " = 0;\n");
+}
+
+/**
+ * Declares every variable assigned by the sentences, as C needs them
+ * declared before use and Python variables outlive the blocks that assign
+ * them. Function definitions declare their own.
+ */
+static void _declareAssigned(const Sentence * sentence, const char * prefix) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE && !_isUnpackedInPlace(sentence)) {
+            _declare(sentence->variable->identifier, sentence->variable->dataType, sentence->variable->elementType, prefix);
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            if (sentence->block->type == BT_FOR) {
+                const Expression * variable = sentence->block->forBlock->left;
+                _declare(variable->variableCall->variableName, variable->dataType, variable->elementType, prefix);
+            }
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _declareAssigned(block->nextSentence, prefix);
+            }
+        }
+    }
+}
+
+static void _beginDeclarations() {
+    if (_declared != NULL) {
+        hashMapDestroy(_declared);
+    }
+    _declared = hashMapInit(sizeof(tSymbolKey), sizeof(tSymbolKey), hashMapStringHash, hashMapStringKeyEquals);
+}
+
+/**
+ * Collects the function definitions of the program. Only top-level ones have
+ * a translation, as C functions cannot read the locals of another.
+ */
+static void _collectFunctions(Sentence * sentence, const boolean isNested) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        Block * block = sentence->block;
+        switch (block->type) {
+            case BT_FUNCTION_DEFINITION:
+                if (isNested) {
+                    _unsupported("nested function definitions");
+                } else if (_functionCount == MAXIMUM_C_FUNCTIONS) {
+                    _unsupported("that many function definitions");
+                } else {
+                    _functions[_functionCount++] = block;
+                }
+                _collectFunctions(block->nextSentence, true);
+                break;
+            case BT_CLASS_DEFINITION:
+                _unsupported("class definitions");
+                break;
+            default:
+                for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                    _collectFunctions(block->nextSentence, isNested);
+                }
+                break;
+        }
+    }
+}
+
+/* EXPRESSIONS */
+
+static void _generateCExpression(Expression * expression);
+
+static boolean _isCompound(const Expression * expression) {
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+        case VARIABLE_CALL_EXPRESSION:
+        case FUNCTION_CALL_EXPRESSION:
+        case UNPACKED_ELEMENT:
+            return false;
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+            // Checked and string operations are calls.
+            return !expression->mayOverflow && expression->dataType != SA_STRING;
+        default:
+            return true;
+    }
+}
+
+static void _generateOperand(Expression * expression) {
+    if (_isCompound(expression)) {
+        _output("(");
+        _generateCExpression(expression);
+        _output(")");
+    } else {
+        _generateCExpression(expression);
+    }
+}
+
+/**
+ * Outputs an expression where a value of the given type is expected. C
+ * converts numbers implicitly, but characters must become strings.
+ */
+static void _generateConverted(Expression * expression, const SaDataType type) {
+    if (type == SA_STRING && expression->dataType == SA_CHARACTER) {
+        _output("tp_char_string(");
+        _generateCExpression(expression);
+        _output(")");
+    } else {
+        _generateCExpression(expression);
+    }
+}
+
+static void _generateCollection(Expression * expression) {
+    const char * listType = _cListType(expression->elementType);
+    const char * itemType = _cType(expression->elementType, SA_UNKNOWN);
+    if (listType == NULL) {
+        _unsupported("collections whose elements have different types");
+        return;
+    }
+    int count = 0;
+    for (Parameters * element = _elementsOf(expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        count++;
+    }
+    if (count == 0) {
+        _output("((%s) { 0, NULL })", listType);
+        return;
+    }
+    _output("((%s) { %d, tp_copy((%s[]) { ", listType, count, itemType);
+    for (Parameters * element = _elementsOf(expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        _generateConverted(element->leftExpression, expression->elementType);
+        if (element->rightParameters != NULL && element->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+    }
+    _output(" }, %d * sizeof(%s)) })", count, itemType);
+}
+
+static void _generateConstant(Expression * expression) {
+    Constant * constant = expression->constant;
+    switch (constant->type) {
+        case CT_BOOLEAN:
+            _output(constant->boolean? "true" : "false");
+            return;
+        case CT_INTEGER:
+            if (constant->integer < INT32_MIN || INT32_MAX < constant->integer) {
+                _output("INT64_C(%lld)", constant->integer);
+            } else {
+                _output("%lld", constant->integer);
+            }
+            return;
+        case CT_FLOAT:
+            _outputDecimal(constant->decimal);
+            return;
+        case CT_STRING:
+            _output("TP_LITERAL(%s)", constant->string);
+            return;
+        case CT_LIST:
+        case CT_TUPLE:
+            _generateCollection(expression);
+            return;
+        default:
+            return;
+    }
+}
+
+/**
+ * Outputs an addition, subtraction or multiplication of numbers, where a
+ * long result of narrower operands widens the first one before operating,
+ * and a result that may not fit in a long fails instead of wrapping around.
+ */
+static void _generateArithmetic(Expression * expression, const char * operator, const char * exactFunction) {
+    if (expression->dataType == SA_STRING) {
+        _output("tp_concat(");
+        _generateConverted(expression->leftExpression, SA_STRING);
+        _output(", ");
+        _generateConverted(expression->rightExpression, SA_STRING);
+        _output(")");
+        return;
+    }
+    if (expression->mayOverflow) {
+        _output("%s(", exactFunction);
+        _generateCExpression(expression->leftExpression);
+        _output(", ");
+        _generateCExpression(expression->rightExpression);
+        _output(")");
+        return;
+    }
+    if (expression->dataType == SA_LONG && expression->leftExpression->dataType != SA_LONG && expression->rightExpression->dataType != SA_LONG) {
+        _output("(int64_t) ");
+    }
+    _generateOperand(expression->leftExpression);
+    _output(" %s ", operator);
+    _generateOperand(expression->rightExpression);
+}
+
+static boolean _areIntegral(const Expression * expression) {
+    const SaDataType left = expression->leftExpression->dataType;
+    const SaDataType right = expression->rightExpression->dataType;
+    return (_isIntegral(left) || left == SA_BOOLEAN) && (_isIntegral(right) || right == SA_BOOLEAN);
+}
+
+static void _generateCall(const char * function, Expression * left, Expression * right) {
+    _output("%s(", function);
+    _generateCExpression(left);
+    _output(", ");
+    _generateCExpression(right);
+    _output(")");
+}
+
+static void _generateDivision(Expression * expression) {
+    if (_areIntegral(expression)) {
+        // Python divisions are always true divisions.
+        _output("(double) ");
+    }
+    _generateOperand(expression->leftExpression);
+    _output(" / ");
+    _generateOperand(expression->rightExpression);
+}
+
+static void _generateFloorDivision(Expression * expression) {
+    if (_areIntegral(expression)) {
+        _generateCall(expression->mayOverflow? "tp_floor_divide_exact" : "tp_floor_divide", expression->leftExpression, expression->rightExpression);
+        return;
+    }
+    _output("floor(");
+    _generateOperand(expression->leftExpression);
+    _output(" / ");
+    _generateOperand(expression->rightExpression);
+    _output(")");
+}
+
+static void _generateModulo(Expression * expression) {
+    _generateCall(_areIntegral(expression)? "tp_floor_modulo" : "tp_floor_fmod", expression->leftExpression, expression->rightExpression);
+}
+
+static void _generatePower(Expression * expression) {
+    if (_isIntegral(expression->dataType)) {
+        _generateCall(expression->mayOverflow? "tp_power_exact" : "tp_power", expression->leftExpression, expression->rightExpression);
+        return;
+    }
+    _output("pow(");
+    _generateCExpression(expression->leftExpression);
+    _output(", ");
+    _generateCExpression(expression->rightExpression);
+    _output(")");
+}
+
+static boolean _isTextual(const SaDataType type) {
+    return type == SA_STRING || type == SA_CHARACTER;
+}
+
+/**
+ * Outputs a comparison. Characters compared with one-character literals stay
+ * primitive, and strings are compared by content.
+ */
+static void _generateComparison(Expression * expression, const char * operator) {
+    Expression * left = expression->leftExpression;
+    Expression * right = expression->rightExpression;
+    const boolean isCharacterLiteral = right->type == CONSTANT_EXPRESSION && right->constant->type == CT_STRING
+        && strlen(right->constant->string) == 3 && right->constant->string[1] != '\\' && right->constant->string[1] != '\'';
+    if (left->dataType == SA_CHARACTER && isCharacterLiteral) {
+        _generateOperand(left);
+        _output(" %s '%c'", operator, right->constant->string[1]);
+        return;
+    }
+    if (!(left->dataType == SA_CHARACTER && right->dataType == SA_CHARACTER) && _isTextual(left->dataType) && _isTextual(right->dataType)) {
+        if (strcmp(operator, "==") == 0 || strcmp(operator, "!=") == 0) {
+            _output(operator[0] == '!'? "!tp_equals(" : "tp_equals(");
+            _generateConverted(left, SA_STRING);
+            _output(", ");
+            _generateConverted(right, SA_STRING);
+            _output(")");
+        } else {
+            _output("tp_compare(");
+            _generateConverted(left, SA_STRING);
+            _output(", ");
+            _generateConverted(right, SA_STRING);
+            _output(") %s 0", operator);
+        }
+        return;
+    }
+    if (_isTextual(left->dataType) || _isTextual(right->dataType) || _cType(left->dataType, left->elementType) == NULL
+            || _cType(right->dataType, right->elementType) == NULL || left->dataType == SA_LIST || left->dataType == SA_TUPLE) {
+        _unsupported("comparisons of values with different or composite types");
+        return;
+    }
+    _generateOperand(left);
+    _output(" %s ", operator);
+    _generateOperand(right);
+}
+
+static void _generateMembership(Expression * expression) {
+    Expression * value = expression->leftCompExpression;
+    Expression * collection = expression->rightCompExpression;
+    if (collection->dataType == SA_STRING && _isTextual(value->dataType)) {
+        _output("tp_contains_string(");
+        _generateCExpression(collection);
+        _output(", ");
+        _generateConverted(value, SA_STRING);
+        _output(")");
+        return;
+    }
+    const char * listType = (collection->dataType == SA_LIST || collection->dataType == SA_TUPLE)? _cListType(collection->elementType) : NULL;
+    if (listType == NULL || (collection->elementType == SA_STRING) != _isTextual(value->dataType)) {
+        _unsupported("membership tests on values with different types");
+        return;
+    }
+    _output("tp_contains_%s(", listType);
+    _generateCExpression(collection);
+    _output(", ");
+    _generateConverted(value, collection->elementType);
+    _output(")");
+}
+
+static void _generateBuiltinCall(FunctionCall * functionCall) {
+    Expression * argument = functionCall->functionArguments->leftExpression;
+    switch (functionCall->object->builtinDefinition) {
+        case BTF_LEN:
+            if (argument->dataType == SA_STRING || argument->dataType == SA_LIST || argument->dataType == SA_TUPLE) {
+                _generateOperand(argument);
+                _output(".length");
+                return;
+            }
+            break;
+        case BTF_ABS:
+            if (_isIntegral(argument->dataType) || argument->dataType == SA_FLOAT) {
+                _output(argument->dataType == SA_FLOAT? "fabs(" : "llabs(");
+                _generateCExpression(argument);
+                _output(")");
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    _unsupported("this builtin call");
+}
+
+static int _countExpressions(const Parameters * parameters) {
+    int count = 0;
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        count++;
+    }
+    return count;
+}
+
+static const Block * _findFunction(const char * name) {
+    for (int k = 0; k < _functionCount; k++) {
+        if (strcmp(_functions[k]->functionDefinition->functionName, name) == 0) {
+            return _functions[k];
+        }
+    }
+    return NULL;
+}
+
+static void _generateFunctionCall(FunctionCall * functionCall) {
+    if (functionCall->type == FC_OBJECT) {
+        _generateBuiltinCall(functionCall);
+        return;
+    }
+    const Block * function = _findFunction(functionCall->functionName);
+    Parameters * parameter = (function != NULL)? function->functionDefinition->parameters : NULL;
+    if (_countExpressions(parameter) != _countExpressions(functionCall->functionArguments)) {
+        _unsupported("calls whose arguments do not match the parameters");
+    }
+    _outputName(functionCall->functionName);
+    _output("(");
+    for (Parameters * argument = functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        const boolean hasParameter = parameter != NULL && parameter->leftExpression != NULL;
+        _generateConverted(argument->leftExpression, hasParameter? parameter->leftExpression->dataType : SA_UNKNOWN);
+        if (argument->rightParameters != NULL && argument->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+        parameter = hasParameter? parameter->rightParameters : NULL;
+    }
+    _output(")");
+}
+
+static void _generateUnpackedElement(const Expression * element) {
+    const Variable * variable = element->unpackedVariable;
+    if (variable == _unpackedVariable) {
+        _output("tp_unpacked%d_%d", _unpackedCount - 1, element->elementIndex);
+        return;
+    }
+    if ((variable->dataType != SA_LIST && variable->dataType != SA_TUPLE) || _cListType(variable->elementType) == NULL) {
+        _unsupported("unpacking values whose elements have different types");
+        return;
+    }
+    _outputName(variable->identifier);
+    _output(".items[%d]", element->elementIndex);
+}
+
+static void _generateCExpression(Expression * expression) {
+    if (expression == NULL) {
+        return;
+    }
+    if (expression->dataType == SA_BIG_INTEGER) {
+        _unsupported("integers that may not fit in a long");
+        return;
+    }
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            _generateConstant(expression);
+            return;
+        case ADDITION:
+            _generateArithmetic(expression, "+", "tp_add_exact");
+            return;
+        case SUBTRACTION:
+            _generateArithmetic(expression, "-", "tp_subtract_exact");
+            return;
+        case MULTIPLICATION:
+            _generateArithmetic(expression, "*", "tp_multiply_exact");
+            return;
+        case DIVISION:
+            _generateDivision(expression);
+            return;
+        case TRUNCATED_DIVISION:
+            _generateFloorDivision(expression);
+            return;
+        case MODULO:
+            _generateModulo(expression);
+            return;
+        case EXPONENTIATION:
+            _generatePower(expression);
+            return;
+        case LOGIC_AND:
+            _generateOperand(expression->leftExpression);
+            _output(" && ");
+            _generateOperand(expression->rightExpression);
+            return;
+        case LOGIC_OR:
+            _generateOperand(expression->leftExpression);
+            _output(" || ");
+            _generateOperand(expression->rightExpression);
+            return;
+        case LOGIC_NOT:
+            _output("!");
+            _generateOperand(expression->notExpression);
+            return;
+        case COMPARISON_EXPRESSION:
+            switch (expression->compType) {
+                case BCT_EQU:
+                    _generateComparison(expression, "==");
+                    return;
+                case BCT_NEQ:
+                    _generateComparison(expression, "!=");
+                    return;
+                case BCT_GT:
+                    _generateComparison(expression, ">");
+                    return;
+                case BCT_GTE:
+                    _generateComparison(expression, ">=");
+                    return;
+                case BCT_LT:
+                    _generateComparison(expression, "<");
+                    return;
+                case BCT_LTE:
+                    _generateComparison(expression, "<=");
+                    return;
+                case BCT_MEMBER:
+                    _generateMembership(expression);
+                    return;
+                case BCT_NMEMBER:
+                    _output("!");
+                    _generateMembership(expression);
+                    return;
+                default:
+                    _unsupported("identity comparisons");
+                    return;
+            }
+        case VARIABLE_CALL_EXPRESSION:
+            _outputName(expression->variableCall->variableName);
+            return;
+        case FUNCTION_CALL_EXPRESSION:
+            _generateFunctionCall(expression->functionCall);
+            return;
+        case UNPACKED_ELEMENT:
+            _generateUnpackedElement(expression);
+            return;
+        case METHOD_CALL_EXPRESSION:
+            _unsupported("method calls");
+            return;
+        case FIELD_GETTER_EXPRESSION:
+            _unsupported("field accesses");
+            return;
+        default:
+            _unsupported("this kind of expression");
+            return;
+    }
+}
+
+/* SENTENCES */
+
+static void _generateSentences(Sentence * sentence);
+
+/**
+ * Evaluates every element of an unpacked constant before any target is
+ * assigned, as a swap needs.
+ */
+static void _generateUnpacking(const Sentence * sentence) {
+    const Variable * variable = sentence->variable;
+    int index = 0;
+    for (Parameters * element = _elementsOf(variable->expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters, index++) {
+        Expression * value = element->leftExpression;
+        if (index > 0) {
+            _outputIndent();
+        }
+        _output("const %s tp_unpacked%d_%d = ", _cDeclarationType(value->dataType, value->elementType, variable->identifier), _unpackedCount, index);
+        _generateCExpression(value);
+        _output(";\n");
+    }
+    _unpackedVariable = variable;
+    _unpackedCount++;
+}
+
+static void _generateConditionalBlock(Block * block) {
+    for (boolean isFirst = true; block != NULL && block->conditional != NULL; block = block->nextCond, isFirst = false) {
+        switch (block->conditional->type) {
+            case CB_IF:
+            case CB_ELIF:
+                _output(isFirst? "if (" : " else if (");
+                _generateCExpression(block->conditional->expression);
+                _output(") {\n");
+                break;
+            default:
+                _output(" else {\n");
+                break;
+        }
+        _indentLevel++;
+        _generateSentences(block->nextSentence);
+        _indentLevel--;
+        _outputIndent();
+        _output("}");
+    }
+    _output("\n");
+}
+
+/**
+ * Iterates over a range with a counted loop on a hidden long index, so that
+ * the bounds are evaluated once, the body may assign the loop variable, and
+ * the variable keeps the last produced value afterwards.
+ */
+static void _generateRangeForBlock(Block * block, const int loop) {
+    ForBlock * forBlock = block->forBlock;
+    Expression * arguments[3] = { NULL, NULL, NULL };
+    int count = 0;
+    for (Parameters * argument = forBlock->right->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL && count < 3; argument = argument->rightParameters) {
+        arguments[count++] = argument->leftExpression;
+    }
+    Expression * start = (count > 1)? arguments[0] : NULL;
+    Expression * stop = (count > 1)? arguments[1] : arguments[0];
+    Expression * step = (count > 2)? arguments[2] : NULL;
+    // The analyzer rejects a zero step, so zero stands for a step only known at runtime.
+    const long long stepValue = (step == NULL)? 1
+        : ((step->type == CONSTANT_EXPRESSION && step->constant->type == CT_INTEGER)? step->constant->integer : 0);
+    _output("for (int64_t tp_index%d = ", loop);
+    if (start == NULL) {
+        _output("0");
+    } else {
+        _generateCExpression(start);
+    }
+    _output(", tp_stop%d = ", loop);
+    _generateCExpression(stop);
+    if (stepValue == 0) {
+        _output(", tp_step%d = ", loop);
+        _generateCExpression(step);
+        _output("; (tp_step%d > 0)? tp_index%d < tp_stop%d : tp_index%d > tp_stop%d; tp_index%d += tp_step%d) {\n", loop, loop, loop, loop, loop, loop, loop);
+    } else {
+        _output((stepValue > 0)? "; tp_index%d < tp_stop%d; " : "; tp_index%d > tp_stop%d; ", loop, loop);
+        _output("tp_index%d += %lld) {\n", loop, stepValue);
+    }
+    _indentLevel++;
+    _outputIndent();
+    _outputName(forBlock->left->variableCall->variableName);
+    _output(" = tp_index%d;\n", loop);
+    _generateSentences(block->nextSentence);
+    _indentLevel--;
+    _outputBraceWithIndent();
+    if (stepValue == 0) {
+        // A zero step makes Python fail before the first iteration, but here it just never iterates.
+        logWarning(_logger, "A range with a step only known at runtime does not fail when the step is zero.");
+    }
+}
+
+/**
+ * Iterates with an index over the string or list, which is evaluated once,
+ * as in Python.
+ */
+static void _generateForBlock(Block * block) {
+    ForBlock * forBlock = block->forBlock;
+    Expression * iterable = forBlock->right;
+    const int loop = _loopCount++;
+    if (iterable->dataType == SA_RANGE) {
+        _generateRangeForBlock(block, loop);
+        return;
+    }
+    const boolean isIndexable = iterable->dataType == SA_STRING
+        || ((iterable->dataType == SA_LIST || iterable->dataType == SA_TUPLE) && _cListType(iterable->elementType) != NULL);
+    if (!isIndexable) {
+        _unsupported("iterating over values whose elements are only known at runtime");
+        _output("{\n");
+        _indentLevel++;
+        _generateSentences(block->nextSentence);
+        _indentLevel--;
+        _outputBraceWithIndent();
+        return;
+    }
+    _output("{\n");
+    _indentLevel++;
+    _outputIndent();
+    _output("const %s tp_iterable%d = ", _cType(iterable->dataType, iterable->elementType), loop);
+    _generateCExpression(iterable);
+    _output(";\n");
+    _outputIndent();
+    _output("for (int32_t tp_index%d = 0; tp_index%d < tp_iterable%d.length; tp_index%d++) {\n", loop, loop, loop, loop);
+    _indentLevel++;
+    _outputIndent();
+    _outputName(forBlock->left->variableCall->variableName);
+    _output(" = tp_iterable%d.%s[tp_index%d];\n", loop, (iterable->dataType == SA_STRING)? "chars" : "items", loop);
+    _generateSentences(block->nextSentence);
+    _indentLevel--;
+    _outputBraceWithIndent();
+    _indentLevel--;
+    _outputBraceWithIndent();
+}
+
+static void _generateBlock(Block * block) {
+    switch (block->type) {
+        case BT_CONDITIONAL:
+            _generateConditionalBlock(block);
+            return;
+        case BT_FOR:
+            _generateForBlock(block);
+            return;
+        case BT_WHILE:
+            _output("while (");
+            _generateCExpression(block->whileBlock->expression);
+            _output(") {\n");
+            _indentLevel++;
+            _generateSentences(block->nextSentence);
+            _indentLevel--;
+            _outputBraceWithIndent();
+            return;
+        default:
+            return;
+    }
+}
+
+static void _generateSentences(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type == BT_FUNCTION_DEFINITION) {
+            continue;
+        }
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type == BT_CONDITIONAL && sentence->block->conditional == NULL) {
+            continue;
+        }
+        _outputIndent();
+        switch (sentence->type) {
+            case EXPRESSION_SENTENCE:
+                if (sentence->expression->type == FUNCTION_CALL_EXPRESSION) {
+                    _generateCExpression(sentence->expression);
+                } else {
+                    _output("(void) (");
+                    _generateCExpression(sentence->expression);
+                    _output(")");
+                }
+                _output(";\n");
+                break;
+            case VARIABLE_SENTENCE:
+                if (_isUnpackedInPlace(sentence)) {
+                    _generateUnpacking(sentence);
+                    break;
+                }
+                _outputName(sentence->variable->identifier);
+                _output(" = ");
+                _generateConverted(sentence->variable->expression, sentence->variable->dataType);
+                _output(";\n");
+                break;
+            case BLOCK_SENTENCE:
+                _generateBlock(sentence->block);
+                break;
+            case RETURN_SENTENCE:
+                if (sentence->expression == NULL) {
+                    _output("return;\n");
+                    break;
+                }
+                _output("return ");
+                _generateConverted(sentence->expression, _returnType);
+                _output(";\n");
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/* FUNCTIONS */
+
+static void _generateSignature(FunctionDefinition * function) {
+    const char * returnType = _cType(function->dataType, function->elementType);
+    if (function->dataType == SA_BIG_INTEGER) {
+        _unsupported("integers that may not fit in a long");
+        returnType = "int64_t";
+    } else if (returnType == NULL) {
+        logError(_logger, "The function \"%s\" returns values whose type is only known at runtime, or None.", function->functionName);
+        _unsupported("dynamically typed returns");
+        returnType = "void";
+    }
+    _output("static %s ", returnType);
+    _outputName(function->functionName);
+    _output("(");
+    const Parameters * parameter = function->parameters;
+    if (parameter == NULL || parameter->leftExpression == NULL) {
+        _output("void");
+    }
+    for (; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        const Expression * variable = parameter->leftExpression;
+        _output("%s ", _cDeclarationType(variable->dataType, variable->elementType, variable->variableCall->variableName));
+        _outputName(variable->variableCall->variableName);
+        if (parameter->rightParameters != NULL && parameter->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+    }
+    _output(")");
+}
+
+static void _generateFunction(const Block * block) {
+    FunctionDefinition * function = block->functionDefinition;
+    _generateSignature(function);
+    _output(" {\n");
+    _indentLevel = 1;
+    _returnType = function->dataType;
+    _beginDeclarations();
+    for (const Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        tSymbolKey key = { .name = parameter->leftExpression->variableCall->variableName };
+        hashMapInsertOrUpdate(_declared, &key, &key);
+    }
+    _declareAssigned(block->nextSentence, "");
+    _generateSentences(block->nextSentence);
+    _indentLevel = 0;
+    _output("}\n\n");
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean generateCProgram(Program * program) {
+    beginSpan("io", "open", "output.c");
+    _file = fopen("output.c", "w");
+    endSpan();
+    if (_file == NULL) {
+        logError(_logger, "Cannot open \"output.c\" for writing.");
+        return false;
+    }
+    logDebugging(_logger, "Generating C output...");
+    _isUnsupported = false;
+    _loopCount = 0;
+    _functionCount = 0;
+    _unpackedVariable = NULL;
+    _unpackedCount = 0;
+    _indentLevel = 0;
+    for (int k = 0; _runtime[k] != NULL; k++) {
+        _output("%s\n", _runtime[k]);
+    }
+    _output("\n");
+    _collectFunctions(program->sentence, false);
+    // Top-level variables are globals, so functions may read them.
+    _beginDeclarations();
+    _declareAssigned(program->sentence, "static ");
+    _output("\n");
+    for (int k = 0; k < _functionCount; k++) {
+        _generateSignature(_functions[k]->functionDefinition);
+        _output(";\n");
+    }
+    _output("\n");
+    for (int k = 0; k < _functionCount; k++) {
+        // Without its memo table, a "@cache" function may take exponential time.
+        if (_functions[k]->functionDefinition->isCached) {
+            _unsupported("@cache functions");
+        }
+        beginSpan("generation", "function", _functions[k]->functionDefinition->functionName);
+        _generateFunction(_functions[k]);
+        endSpan();
+    }
+    beginSpan("generation", "function", "main");
+    _output("int main(void) {\n");
+    _indentLevel = 1;
+    _generateSentences(program->sentence);
+    _output("\ttp_release();\n");
+    _output("\treturn 0;\n");
+    _output("}\n");
+    endSpan();
+    countEmittedBytes(ftell(_file));
+    beginSpan("io", "close", "output.c");
+    fclose(_file);
+    endSpan();
+    _file = NULL;
+    hashMapDestroy(_declared);
+    _declared = NULL;
+    if (_isUnsupported) {
+        // A program only partly translated must not be mistaken for the output.
+        remove("output.c");
+        return false;
+    }
+    logDebugging(_logger, "C generation is done.");
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef C_GENERATOR_HEADER
+#define C_GENERATOR_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
+#include "../../shared/Type.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeCGeneratorModule();
+
+/** Shutdown module's internal state. */
+void shutdownCGeneratorModule();
+
+/**
+ * Whether the programs must be translated to C instead of Java, as selected
+ * by the "TARGET_LANGUAGE" environment variable.
+ */
+boolean isCTargetSelected();
+
+/**
+ * Writes the program as a single C99 translation unit on "output.c", which
+ * carries its own runtime and builds with any C compiler and the math
+ * library. Strings and lists live in an arena released when the program
+ * ends. Must run after the types were inferred, since every symbol gets a
+ * primitive C type. Returns false if the program uses a construct the C
+ * backend cannot express, such as classes, methods or values whose type is
+ * only known at runtime; no file is then left behind.
+ */
+boolean generateCProgram(Program * program);
+
+#endif
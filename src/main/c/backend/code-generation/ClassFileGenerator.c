@@ -0,0 +1,1844 @@
+#include "ClassFileGenerator.h"
+#include "../semantic-analysis/HashMap.h"
+
+/** The class file version, which is the first one that requires stack map frames. */
+#define CLASS_MAJOR_VERSION 52
+
+/** The most entries of the constant pool, and the longest method, in bytes. */
+#define MAXIMUM_POOL_SIZE 65535
+#define MAXIMUM_CODE_LENGTH 65535
+
+/** The farthest a branch may jump, as its offset takes two bytes. */
+#define MAXIMUM_BRANCH_OFFSET 32767
+
+/** The most values the operand stack of a method may hold at once. */
+#define MAXIMUM_STACK_ITEMS 256
+
+/** The most locals, counted by slot, and functions a compiled program may have. */
+#define MAXIMUM_LOCAL_SLOTS 4096
+#define MAXIMUM_CLASS_FUNCTIONS 256
+
+/** The largest constant exponent of an integral power, which is written as repeated multiplications. */
+#define MAXIMUM_MULTIPLIED_EXPONENT 4
+
+/* JVM OPCODES */
+
+#define OP_NOP 0x00
+#define OP_ACONST_NULL 0x01
+#define OP_ICONST_0 0x03
+#define OP_LCONST_0 0x09
+#define OP_LCONST_1 0x0a
+#define OP_DCONST_0 0x0e
+#define OP_DCONST_1 0x0f
+#define OP_BIPUSH 0x10
+#define OP_SIPUSH 0x11
+#define OP_LDC 0x12
+#define OP_LDC_W 0x13
+#define OP_LDC2_W 0x14
+#define OP_ILOAD 0x15
+#define OP_LLOAD 0x16
+#define OP_DLOAD 0x18
+#define OP_ALOAD 0x19
+#define OP_ISTORE 0x36
+#define OP_LSTORE 0x37
+#define OP_DSTORE 0x39
+#define OP_ASTORE 0x3a
+#define OP_POP 0x57
+#define OP_POP2 0x58
+#define OP_DUP 0x59
+#define OP_IADD 0x60
+#define OP_LADD 0x61
+#define OP_DADD 0x63
+#define OP_ISUB 0x64
+#define OP_LSUB 0x65
+#define OP_DSUB 0x67
+#define OP_IMUL 0x68
+#define OP_LMUL 0x69
+#define OP_DMUL 0x6b
+#define OP_DDIV 0x6f
+#define OP_I2L 0x85
+#define OP_I2D 0x87
+#define OP_L2I 0x88
+#define OP_L2D 0x8a
+#define OP_D2I 0x8e
+#define OP_D2L 0x8f
+#define OP_LCMP 0x94
+#define OP_DCMPL 0x97
+#define OP_DCMPG 0x98
+#define OP_IFEQ 0x99
+#define OP_IFNE 0x9a
+#define OP_IFLT 0x9b
+#define OP_IFGE 0x9c
+#define OP_IFGT 0x9d
+#define OP_IFLE 0x9e
+#define OP_IF_ICMPEQ 0x9f
+#define OP_GOTO 0xa7
+#define OP_IRETURN 0xac
+#define OP_LRETURN 0xad
+#define OP_DRETURN 0xaf
+#define OP_ARETURN 0xb0
+#define OP_RETURN 0xb1
+#define OP_GETSTATIC 0xb2
+#define OP_PUTSTATIC 0xb3
+#define OP_INVOKEVIRTUAL 0xb6
+#define OP_INVOKESPECIAL 0xb7
+#define OP_INVOKESTATIC 0xb8
+#define OP_NEW 0xbb
+#define OP_ATHROW 0xbf
+#define OP_WIDE 0xc4
+
+/** The offset from an "if<cond>" opcode to the "if_icmp<cond>" one with the same condition. */
+#define IF_ICMP_OFFSET (OP_IF_ICMPEQ - OP_IFEQ)
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+/** Whether the target language, read from the environment, is the class file. */
+static boolean _isClassTarget = false;
+
+/** Whether some construct of the program has no bytecode translation. */
+static boolean _isUnsupported = false;
+
+typedef struct {
+    uint8_t * bytes;
+    int length;
+    int capacity;
+} tBuffer;
+
+/** The constant pool, with its entries mapped from a textual key to their index. */
+static tBuffer _pool;
+static int _poolCount = 1;
+static hashMapADT _poolIndexes = NULL;
+
+typedef struct {
+    const char * key;
+    int index;
+} tPoolEntry;
+
+/** The verification types of the JVM, which also tell the kind of each value on the operand stack. */
+typedef enum {
+    VT_TOP = 0,
+    VT_INTEGER = 1,
+    VT_DOUBLE = 3,
+    VT_LONG = 4,
+    VT_OBJECT = 7
+} tVerificationType;
+
+typedef struct {
+    tVerificationType type;
+    /** The internal name of the class, for objects. */
+    const char * className;
+} tValueType;
+
+typedef struct {
+    /** The name of the variable, or NULL for hidden temporaries. */
+    const char * name;
+    SaDataType dataType;
+    int slot;
+} tLocal;
+
+typedef struct {
+    /** The position of the label on the code, or -1 until it is placed. */
+    int position;
+    /** Whether some branch jumps to the label, which then needs a stack map frame. */
+    boolean isTarget;
+    /** The operand stack when the label is reached, once known. */
+    boolean hasStack;
+    int stackSize;
+    tValueType * stack;
+} tLabel;
+
+typedef struct {
+    int label;
+    int instruction;
+} tFixup;
+
+/** The method being assembled. */
+static tBuffer _code;
+static tValueType _stack[MAXIMUM_STACK_ITEMS];
+static int _stackSize = 0;
+static int _stackDepth = 0;
+static int _maximumDepth = 0;
+static tLocal _locals[MAXIMUM_LOCAL_SLOTS];
+static int _localCount = 0;
+static int _slotCount = 0;
+static int _parameterCount = 0;
+static tLabel * _labels = NULL;
+static int _labelCount = 0;
+static tFixup * _fixups = NULL;
+static int _fixupCount = 0;
+/** Whether the next instruction may run. Unreachable ones are never written, since the verifier would need a frame for them. */
+static boolean _isReachable = true;
+static SaDataType _returnType = SA_VOID;
+
+/** The top-level variables, which are static fields so that functions may read them. */
+static hashMapADT _globals = NULL;
+
+typedef struct {
+    const char * name;
+    SaDataType dataType;
+} tGlobal;
+
+static Block * _functions[MAXIMUM_CLASS_FUNCTIONS];
+static int _functionCount = 0;
+
+/** The hidden variable of the unpacking whose elements are being assigned from temporaries, and their first slot. */
+static const Variable * _unpackedVariable = NULL;
+static int _unpackedLocal = 0;
+
+/** The function whose calls to itself in tail position jump back to the label at the start of its body. */
+static const FunctionDefinition * _tailFunction = NULL;
+static int _recurseLabel = 0;
+
+void initializeClassFileGeneratorModule() {
+    _logger = createLogger("ClassFileGenerator");
+    _isClassTarget = strcmp(getStringOrDefault("TARGET_LANGUAGE", "JAVA"), "CLASS") == 0;
+}
+
+void shutdownClassFileGeneratorModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+boolean isClassTargetSelected() {
+    return _isClassTarget;
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * Records a construct without bytecode translation. Generation goes on, so
+ * every one of them gets reported.
+ */
+static void _unsupported(const char * construct) {
+    if (!_isUnsupported) {
+        logWarning(_logger, "The class file backend does not support %s.", construct);
+    }
+    _isUnsupported = true;
+}
+
+/* BUFFERS */
+
+static void _putByte(tBuffer * buffer, const int value) {
+    if (buffer->length == buffer->capacity) {
+        buffer->capacity = (buffer->capacity == 0)? 256 : 2 * buffer->capacity;
+        buffer->bytes = realloc(buffer->bytes, buffer->capacity);
+    }
+    buffer->bytes[buffer->length++] = (uint8_t) value;
+}
+
+static void _putShort(tBuffer * buffer, const int value) {
+    _putByte(buffer, value >> 8);
+    _putByte(buffer, value);
+}
+
+static void _putInteger(tBuffer * buffer, const uint32_t value) {
+    _putShort(buffer, (int) (value >> 16));
+    _putShort(buffer, (int) (value & 0xffff));
+}
+
+static void _putBuffer(tBuffer * buffer, const tBuffer * other) {
+    for (int k = 0; k < other->length; k++) {
+        _putByte(buffer, other->bytes[k]);
+    }
+}
+
+static void _releaseBuffer(tBuffer * buffer) {
+    free(buffer->bytes);
+    *buffer = (tBuffer) { .bytes = NULL, .length = 0, .capacity = 0 };
+}
+
+/* CONSTANT POOL */
+
+/**
+ * Gets the index of the constant with the key, adding it with the given
+ * tag and body when it is not on the pool yet.
+ */
+static int _constant(const char * key, const int tag, const tBuffer * body, const int slots) {
+    tPoolEntry entry = { .key = key };
+    if (hashMapFind(_poolIndexes, &entry, &entry)) {
+        return entry.index;
+    }
+    if (MAXIMUM_POOL_SIZE <= _poolCount + slots) {
+        _unsupported("that many constants");
+        return 1;
+    }
+    entry = (tPoolEntry) { .key = strdup(key), .index = _poolCount };
+    hashMapInsertOrUpdate(_poolIndexes, &entry, &entry);
+    _putByte(&_pool, tag);
+    _putBuffer(&_pool, body);
+    // Longs and doubles take two entries.
+    _poolCount += slots;
+    return entry.index;
+}
+
+static int _keyedConstant(const char * prefix, const char * text, const int tag, tBuffer * body, const int slots) {
+    char * key = malloc(strlen(prefix) + strlen(text) + 1);
+    strcpy(key, prefix);
+    strcat(key, text);
+    const int index = _constant(key, tag, body, slots);
+    free(key);
+    _releaseBuffer(body);
+    return index;
+}
+
+/**
+ * The index of a Utf8 constant, whose text must already be in the modified
+ * UTF-8 of class files.
+ */
+static int _utf8(const char * text) {
+    tBuffer body = { 0 };
+    const int length = strlen(text);
+    _putShort(&body, length);
+    for (int k = 0; k < length; k++) {
+        _putByte(&body, (uint8_t) text[k]);
+    }
+    return _keyedConstant("U", text, 1, &body, 1);
+}
+
+static int _reference(const char * prefix, const int tag, const char * text, const int first, const int second) {
+    tBuffer body = { 0 };
+    _putShort(&body, first);
+    if (second != 0) {
+        _putShort(&body, second);
+    }
+    return _keyedConstant(prefix, text, tag, &body, 1);
+}
+
+static int _class(const char * name) {
+    return _reference("C", 7, name, _utf8(name), 0);
+}
+
+static int _string(const char * text) {
+    return _reference("S", 8, text, _utf8(text), 0);
+}
+
+static int _member(const int tag, const char * owner, const char * name, const char * descriptor) {
+    char * key = malloc(strlen(owner) + strlen(name) + strlen(descriptor) + 3);
+    sprintf(key, "%s.%s:%s", owner, name, descriptor);
+    const int nameAndType = _reference("N", 12, key + strlen(owner) + 1, _utf8(name), _utf8(descriptor));
+    const int index = _reference((tag == 9)? "F" : "M", tag, key, _class(owner), nameAndType);
+    free(key);
+    return index;
+}
+
+static int _numeric(const char * prefix, const int tag, const uint64_t bits, const int slots) {
+    char text[24];
+    snprintf(text, sizeof(text), "%llx", (unsigned long long) bits);
+    tBuffer body = { 0 };
+    if (slots == 2) {
+        _putInteger(&body, (uint32_t) (bits >> 32));
+    }
+    _putInteger(&body, (uint32_t) bits);
+    return _keyedConstant(prefix, text, tag, &body, slots);
+}
+
+/* TYPES */
+
+static tValueType _valueType(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+        case SA_INTEGER:
+            return (tValueType) { .type = VT_INTEGER };
+        case SA_LONG:
+            return (tValueType) { .type = VT_LONG };
+        case SA_FLOAT:
+            return (tValueType) { .type = VT_DOUBLE };
+        case SA_STRING:
+            return (tValueType) { .type = VT_OBJECT, .className = "java/lang/String" };
+        default:
+            return (tValueType) { .type = VT_TOP };
+    }
+}
+
+/**
+ * The JVM descriptor of a type, or NULL if its values are only known at
+ * runtime or are collections.
+ */
+static const char * _descriptor(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return "Z";
+        case SA_INTEGER:
+            return "I";
+        case SA_LONG:
+            return "J";
+        case SA_FLOAT:
+            return "D";
+        case SA_STRING:
+            return "Ljava/lang/String;";
+        case SA_VOID:
+            return "V";
+        default:
+            return NULL;
+    }
+}
+
+static boolean _isValueType(const SaDataType type) {
+    return _valueType(type).type != VT_TOP;
+}
+
+static int _slotsOf(const tVerificationType type) {
+    return (type == VT_LONG || type == VT_DOUBLE)? 2 : 1;
+}
+
+/**
+ * The descriptor of a function, written on the buffer, which must hold at
+ * least 512 characters.
+ */
+static boolean _methodDescriptor(const FunctionDefinition * function, char * descriptor) {
+    strcpy(descriptor, "(");
+    int length = 1;
+    for (const Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        const char * type = _descriptor(parameter->leftExpression->dataType);
+        if (type == NULL || strcmp(type, "V") == 0 || 500 < length) {
+            return false;
+        }
+        strcat(descriptor, type);
+        length += strlen(type);
+    }
+    const char * returned = _descriptor(function->dataType);
+    if (returned == NULL) {
+        return false;
+    }
+    strcat(descriptor, ")");
+    strcat(descriptor, returned);
+    return true;
+}
+
+/* INSTRUCTIONS */
+
+static void _push(const tValueType type) {
+    if (_stackSize == MAXIMUM_STACK_ITEMS) {
+        _unsupported("expressions nested that deep");
+        return;
+    }
+    _stack[_stackSize++] = type;
+    _stackDepth += _slotsOf(type.type);
+    if (_maximumDepth < _stackDepth) {
+        _maximumDepth = _stackDepth;
+    }
+}
+
+static void _pop(int count) {
+    for (; 0 < count && 0 < _stackSize; count--) {
+        _stackDepth -= _slotsOf(_stack[--_stackSize].type);
+    }
+}
+
+/**
+ * Writes an instruction that pops some values and pushes at most one, whose
+ * operand bytes follow. Nothing is written while the code is unreachable.
+ */
+static boolean _instruction(const int opcode, const int pops, const tVerificationType pushed) {
+    if (!_isReachable) {
+        return false;
+    }
+    _putByte(&_code, opcode);
+    _pop(pops);
+    if (pushed != VT_TOP) {
+        _push((tValueType) { .type = pushed, .className = (pushed == VT_OBJECT)? "java/lang/String" : NULL });
+    }
+    return true;
+}
+
+static void _emit(const int opcode, const int pops, const tVerificationType pushed) {
+    _instruction(opcode, pops, pushed);
+}
+
+static void _emitWithIndex(const int opcode, const int index, const int pops, const tVerificationType pushed) {
+    if (_instruction(opcode, pops, pushed)) {
+        _putShort(&_code, index);
+    }
+}
+
+static void _emitLocal(const int opcode, const int slot, const int pops, const tVerificationType pushed) {
+    if (!_isReachable) {
+        return;
+    }
+    if (slot < 256) {
+        _instruction(opcode, pops, pushed);
+        _putByte(&_code, slot);
+    } else {
+        _putByte(&_code, OP_WIDE);
+        _instruction(opcode, pops, pushed);
+        _putShort(&_code, slot);
+    }
+}
+
+static void _emitInteger(const long long value) {
+    if (-1 <= value && value <= 5) {
+        _emit(OP_ICONST_0 + (int) value, 0, VT_INTEGER);
+    } else if (INT8_MIN <= value && value <= INT8_MAX) {
+        if (_instruction(OP_BIPUSH, 0, VT_INTEGER)) {
+            _putByte(&_code, (int) value);
+        }
+    } else if (INT16_MIN <= value && value <= INT16_MAX) {
+        _emitWithIndex(OP_SIPUSH, (int) (value & 0xffff), 0, VT_INTEGER);
+    } else {
+        const int index = _numeric("I", 3, (uint32_t) value, 1);
+        if (index < 256) {
+            if (_instruction(OP_LDC, 0, VT_INTEGER)) {
+                _putByte(&_code, index);
+            }
+        } else {
+            _emitWithIndex(OP_LDC_W, index, 0, VT_INTEGER);
+        }
+    }
+}
+
+static void _emitLong(const long long value) {
+    if (value == 0 || value == 1) {
+        _emit(OP_LCONST_0 + (int) value, 0, VT_LONG);
+    } else {
+        _emitWithIndex(OP_LDC2_W, _numeric("J", 5, (uint64_t) value, 2), 0, VT_LONG);
+    }
+}
+
+static void _emitDouble(const double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits == 0) {
+        _emit(OP_DCONST_0, 0, VT_DOUBLE);
+    } else if (value == 1.0) {
+        _emit(OP_DCONST_1, 0, VT_DOUBLE);
+    } else {
+        _emitWithIndex(OP_LDC2_W, _numeric("D", 6, bits, 2), 0, VT_DOUBLE);
+    }
+}
+
+static void _emitString(const char * text) {
+    const int index = _string(text);
+    if (index < 256) {
+        if (_instruction(OP_LDC, 0, VT_OBJECT)) {
+            _putByte(&_code, index);
+        }
+    } else {
+        _emitWithIndex(OP_LDC_W, index, 0, VT_OBJECT);
+    }
+}
+
+/**
+ * Calls a static or virtual method, whose arguments and receiver are on
+ * the operand stack.
+ */
+static void _emitInvoke(const int opcode, const char * owner, const char * name, const char * descriptor, int arguments) {
+    const char * returned = strchr(descriptor, ')') + 1;
+    const tVerificationType pushed = (returned[0] == 'V')? VT_TOP
+        : (returned[0] == 'J')? VT_LONG : (returned[0] == 'D')? VT_DOUBLE : (returned[0] == 'L')? VT_OBJECT : VT_INTEGER;
+    _emitWithIndex(opcode, _member(10, owner, name, descriptor), arguments + (opcode != OP_INVOKESTATIC), pushed);
+}
+
+static void _emitMath(const char * name, const char * descriptor, const int arguments) {
+    _emitInvoke(OP_INVOKESTATIC, "java/lang/Math", name, descriptor, arguments);
+}
+
+/* LABELS */
+
+static int _newLabel() {
+    _labels = realloc(_labels, (_labelCount + 1) * sizeof(tLabel));
+    _labels[_labelCount] = (tLabel) { .position = -1, .isTarget = false, .hasStack = false, .stackSize = 0, .stack = NULL };
+    return _labelCount++;
+}
+
+static void _recordStack(tLabel * label) {
+    label->hasStack = true;
+    label->stackSize = _stackSize;
+    label->stack = malloc((_stackSize + 1) * sizeof(tValueType));
+    memcpy(label->stack, _stack, _stackSize * sizeof(tValueType));
+}
+
+/**
+ * Writes a branch to the label, after popping the operands the branch
+ * compares. Forward offsets are patched once the label is placed.
+ */
+static void _emitJump(const int opcode, const int label, const int pops) {
+    if (!_isReachable) {
+        return;
+    }
+    const int instruction = _code.length;
+    _instruction(opcode, pops, VT_TOP);
+    _putShort(&_code, 0);
+    tLabel * target = &_labels[label];
+    target->isTarget = true;
+    if (!target->hasStack) {
+        _recordStack(target);
+    }
+    _fixups = realloc(_fixups, (_fixupCount + 1) * sizeof(tFixup));
+    _fixups[_fixupCount++] = (tFixup) { .label = label, .instruction = instruction };
+    if (opcode == OP_GOTO) {
+        _isReachable = false;
+    }
+}
+
+/**
+ * Places the label on the next instruction. Code that only follows a label
+ * no branch jumps to remains unreachable.
+ */
+static void _placeLabel(const int label) {
+    tLabel * target = &_labels[label];
+    target->position = _code.length;
+    if (_isReachable) {
+        if (!target->hasStack) {
+            _recordStack(target);
+        }
+    } else if (target->hasStack) {
+        memcpy(_stack, target->stack, target->stackSize * sizeof(tValueType));
+        _stackSize = target->stackSize;
+        _stackDepth = 0;
+        for (int k = 0; k < _stackSize; k++) {
+            _stackDepth += _slotsOf(_stack[k].type);
+        }
+        _isReachable = true;
+    }
+}
+
+static void _emitReturn(const int opcode, const int pops) {
+    _emit(opcode, pops, VT_TOP);
+    _isReachable = false;
+}
+
+/* LOCALS AND FIELDS */
+
+static const tLocal * _findLocal(const char * name) {
+    for (int k = 0; k < _localCount; k++) {
+        if (_locals[k].name != NULL && strcmp(_locals[k].name, name) == 0) {
+            return &_locals[k];
+        }
+    }
+    return NULL;
+}
+
+static int _addLocal(const char * name, const SaDataType type) {
+    const tValueType value = _valueType(type);
+    if (value.type == VT_TOP) {
+        _unsupported("variables whose type is only known at runtime, or collections");
+        return 0;
+    }
+    if (_localCount == MAXIMUM_LOCAL_SLOTS || MAXIMUM_LOCAL_SLOTS < _slotCount + 2) {
+        _unsupported("that many locals");
+        return 0;
+    }
+    _locals[_localCount++] = (tLocal) { .name = name, .dataType = type, .slot = _slotCount };
+    _slotCount += _slotsOf(value.type);
+    return _slotCount - _slotsOf(value.type);
+}
+
+static int _loadOpcode(const tVerificationType type) {
+    return (type == VT_LONG)? OP_LLOAD : (type == VT_DOUBLE)? OP_DLOAD : (type == VT_OBJECT)? OP_ALOAD : OP_ILOAD;
+}
+
+static int _storeOpcode(const tVerificationType type) {
+    return (type == VT_LONG)? OP_LSTORE : (type == VT_DOUBLE)? OP_DSTORE : (type == VT_OBJECT)? OP_ASTORE : OP_ISTORE;
+}
+
+static void _emitLoad(const SaDataType type, const int slot) {
+    const tVerificationType value = _valueType(type).type;
+    _emitLocal(_loadOpcode(value), slot, 0, value);
+}
+
+static void _emitStore(const SaDataType type, const int slot) {
+    _emitLocal(_storeOpcode(_valueType(type).type), slot, 1, VT_TOP);
+}
+
+static boolean _findGlobal(const char * name, tGlobal * global) {
+    tGlobal key = { .name = name };
+    return hashMapFind(_globals, &key, global);
+}
+
+static void _emitField(const int opcode, const tGlobal * global) {
+    const tVerificationType value = _valueType(global->dataType).type;
+    const int index = _member(9, "Main", global->name, _descriptor(global->dataType));
+    _emitWithIndex(opcode, index, (opcode == OP_PUTSTATIC)? 1 : 0, (opcode == OP_GETSTATIC)? value : VT_TOP);
+}
+
+static void _addGlobal(const char * name, const SaDataType type) {
+    tGlobal global = { .name = name, .dataType = type };
+    if (_findGlobal(name, NULL)) {
+        return;
+    }
+    if (!_isValueType(type)) {
+        _unsupported("variables whose type is only known at runtime, or collections");
+        return;
+    }
+    hashMapInsertOrUpdate(_globals, &global, &global);
+}
+
+/* DECLARATIONS */
+
+static boolean _isUnpacking(const Sentence * sentence) {
+    const Sentence * element = sentence->nextSentence;
+    return sentence->type == VARIABLE_SENTENCE && element != NULL && element->type == VARIABLE_SENTENCE
+        && element->variable->expression->type == UNPACKED_ELEMENT
+        && element->variable->expression->unpackedVariable == sentence->variable;
+}
+
+static Parameters * _elementsOf(const Expression * collection) {
+    return (collection->constant->list->type == LT_PARAMETRIZED_LIST)? collection->constant->list->elements : NULL;
+}
+
+static int _countExpressions(const Parameters * parameters) {
+    int count = 0;
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Whether the unpacked value is a constant with exactly one expression per
+ * target, which are evaluated into temporaries, as no other unpacking has a
+ * bytecode translation.
+ */
+static boolean _isUnpackedInPlace(const Sentence * sentence) {
+    if (!_isUnpacking(sentence)) {
+        return false;
+    }
+    const Expression * unpacked = sentence->variable->expression;
+    return unpacked->type == CONSTANT_EXPRESSION && (unpacked->constant->type == CT_LIST || unpacked->constant->type == CT_TUPLE)
+        && _countExpressions(_elementsOf(unpacked)) == sentence->nextSentence->variable->expression->elementCount;
+}
+
+/**
+ * Visits every variable assigned by the sentences, including the loop
+ * variables, but not the ones of function definitions.
+ */
+static void _declareAssigned(const Sentence * sentence, void (* declare)(const char *, const SaDataType)) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE && !_isUnpackedInPlace(sentence)) {
+            declare(sentence->variable->identifier, sentence->variable->dataType);
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            if (sentence->block->type == BT_FOR) {
+                const Expression * variable = sentence->block->forBlock->left;
+                declare(variable->variableCall->variableName, variable->dataType);
+            }
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _declareAssigned(block->nextSentence, declare);
+            }
+        }
+    }
+}
+
+static void _declareLocal(const char * name, const SaDataType type) {
+    if (_findLocal(name) == NULL) {
+        _addLocal(name, type);
+    }
+}
+
+static void _collectFunctions(Sentence * sentence, const boolean isNested) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        Block * block = sentence->block;
+        switch (block->type) {
+            case BT_FUNCTION_DEFINITION:
+                if (isNested) {
+                    _unsupported("nested function definitions");
+                } else if (block->functionDefinition->isCached) {
+                    // Only the Java source memoizes them.
+                    _unsupported("@cache functions");
+                } else if (_functionCount == MAXIMUM_CLASS_FUNCTIONS) {
+                    _unsupported("that many function definitions");
+                } else {
+                    _functions[_functionCount++] = block;
+                }
+                _collectFunctions(block->nextSentence, true);
+                break;
+            case BT_CLASS_DEFINITION:
+                _unsupported("class definitions");
+                break;
+            default:
+                for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                    _collectFunctions(block->nextSentence, isNested);
+                }
+                break;
+        }
+    }
+}
+
+static const Block * _findFunction(const char * name) {
+    for (int k = 0; k < _functionCount; k++) {
+        if (strcmp(_functions[k]->functionDefinition->functionName, name) == 0) {
+            return _functions[k];
+        }
+    }
+    return NULL;
+}
+
+/* EXPRESSIONS */
+
+static void _emitExpression(Expression * expression);
+static void _emitCondition(Expression * expression, const int label, const boolean jumpsIfTrue);
+
+/**
+ * Converts the value on top of the stack between numeric types.
+ */
+static void _emitConversion(const SaDataType from, const SaDataType to) {
+    const tVerificationType source = _valueType(from).type;
+    const tVerificationType target = _valueType(to).type;
+    if (source == target || (from == SA_VOID && to == SA_VOID)) {
+        return;
+    }
+    if (source == VT_OBJECT || target == VT_OBJECT || source == VT_TOP || target == VT_TOP) {
+        _unsupported("conversions between strings, collections and numbers");
+        return;
+    }
+    static const int conversions[5][5] = {
+        [VT_INTEGER] = { [VT_LONG] = OP_I2L, [VT_DOUBLE] = OP_I2D },
+        [VT_LONG] = { [VT_INTEGER] = OP_L2I, [VT_DOUBLE] = OP_L2D },
+        [VT_DOUBLE] = { [VT_INTEGER] = OP_D2I, [VT_LONG] = OP_D2L },
+    };
+    _emit(conversions[source][target], 1, target);
+}
+
+static void _emitConverted(Expression * expression, const SaDataType type) {
+    _emitExpression(expression);
+    _emitConversion(expression->dataType, type);
+}
+
+/**
+ * Decodes a string literal into the modified UTF-8 of class files, where
+ * the null character takes two bytes. Returns NULL for escapes it does not
+ * know.
+ */
+static char * _decodeLiteral(const char * literal) {
+    const int length = strlen(literal);
+    char * text = calloc(2 * length + 1, sizeof(char));
+    int size = 0;
+    if (length < 2 || literal[0] != '"') {
+        free(text);
+        return NULL;
+    }
+    for (int k = 1; k < length - 1; k++) {
+        char value = literal[k];
+        if (value == '\\') {
+            switch (literal[++k]) {
+                case 'n': value = '\n'; break;
+                case 't': value = '\t'; break;
+                case 'r': value = '\r'; break;
+                case 'b': value = '\b'; break;
+                case 'f': value = '\f'; break;
+                case '0': value = '\0'; break;
+                case '\\': value = '\\'; break;
+                case '"': value = '"'; break;
+                case '\'': value = '\''; break;
+                default:
+                    free(text);
+                    return NULL;
+            }
+        } else if ((uint8_t) value >= 0xf0) {
+            // Characters outside the basic plane would need surrogate pairs.
+            free(text);
+            return NULL;
+        }
+        if (value == '\0') {
+            text[size++] = (char) 0xc0;
+            text[size++] = (char) 0x80;
+        } else {
+            text[size++] = value;
+        }
+    }
+    return text;
+}
+
+static void _emitConstant(Expression * expression) {
+    const Constant * constant = expression->constant;
+    switch (constant->type) {
+        case CT_BOOLEAN:
+            _emitInteger(constant->boolean? 1 : 0);
+            return;
+        case CT_INTEGER:
+            // Literals that do not fit an int were typed as longs.
+            if (_valueType(expression->dataType).type == VT_LONG) {
+                _emitLong(constant->integer);
+            } else {
+                _emitInteger(constant->integer);
+            }
+            return;
+        case CT_FLOAT:
+            _emitDouble(constant->decimal);
+            return;
+        case CT_STRING: {
+            char * text = _decodeLiteral(constant->string);
+            if (text == NULL) {
+                _unsupported("this string literal");
+                return;
+            }
+            _emitString(text);
+            free(text);
+            return;
+        }
+        default:
+            _unsupported("collections");
+            return;
+    }
+}
+
+/**
+ * Outputs an addition, subtraction or multiplication. A result that may not
+ * fit in a long fails on overflow instead of wrapping around.
+ */
+static void _emitArithmetic(Expression * expression, const int integerOpcode, const char * exactMethod) {
+    const SaDataType type = expression->dataType;
+    if (type == SA_STRING && integerOpcode == OP_IADD) {
+        _emitConverted(expression->leftExpression, SA_STRING);
+        _emitConverted(expression->rightExpression, SA_STRING);
+        _emitInvoke(OP_INVOKEVIRTUAL, "java/lang/String", "concat", "(Ljava/lang/String;)Ljava/lang/String;", 1);
+        return;
+    }
+    const tVerificationType value = _valueType(type).type;
+    if (value != VT_INTEGER && value != VT_LONG && value != VT_DOUBLE) {
+        _unsupported("arithmetic on values whose type is only known at runtime");
+        return;
+    }
+    _emitConverted(expression->leftExpression, type);
+    _emitConverted(expression->rightExpression, type);
+    if (expression->mayOverflow && value == VT_LONG) {
+        _emitMath(exactMethod, "(JJ)J", 2);
+    } else {
+        // The long and double variants follow the int one.
+        _emit(integerOpcode + ((value == VT_LONG)? 1 : (value == VT_DOUBLE)? 3 : 0), 2, value);
+    }
+}
+
+/**
+ * Throws a new exception of the given class, with the given message, from a
+ * point where the operand stack is empty.
+ */
+static void _emitThrow(const char * exception, const char * message) {
+    _emitWithIndex(OP_NEW, _class(exception), 0, VT_OBJECT);
+    _emit(OP_DUP, 0, VT_OBJECT);
+    _emitString(message);
+    _emitInvoke(OP_INVOKESPECIAL, exception, "<init>", "(Ljava/lang/String;)V", 1);
+    _emit(OP_ATHROW, 1, VT_TOP);
+    _isReachable = false;
+}
+
+/**
+ * Outputs a floor division of longs that fails as the Java source does when
+ * the smallest long is divided by -1, instead of wrapping around.
+ */
+static void _emitExactFloorDivision(Expression * expression) {
+    const int dividend = _addLocal(NULL, SA_LONG);
+    const int divisor = _addLocal(NULL, SA_LONG);
+    const int isValid = _newLabel();
+    _emitConverted(expression->leftExpression, SA_LONG);
+    _emitStore(SA_LONG, dividend);
+    _emitConverted(expression->rightExpression, SA_LONG);
+    _emitStore(SA_LONG, divisor);
+    _emitLoad(SA_LONG, divisor);
+    _emitLong(-1);
+    _emit(OP_LCMP, 2, VT_INTEGER);
+    _emitJump(OP_IFNE, isValid, 1);
+    _emitLoad(SA_LONG, dividend);
+    _emitLong(LLONG_MIN);
+    _emit(OP_LCMP, 2, VT_INTEGER);
+    _emitJump(OP_IFNE, isValid, 1);
+    _emitThrow("java/lang/ArithmeticException", "long overflow");
+    _placeLabel(isValid);
+    _emitLoad(SA_LONG, dividend);
+    _emitLoad(SA_LONG, divisor);
+    _emitMath("floorDiv", "(JJ)J", 2);
+}
+
+static void _emitFloorOperation(Expression * expression, const char * method) {
+    const SaDataType type = expression->dataType;
+    const tVerificationType value = _valueType(type).type;
+    if (value == VT_DOUBLE && strcmp(method, "floorDiv") == 0) {
+        _emitConverted(expression->leftExpression, SA_FLOAT);
+        _emitConverted(expression->rightExpression, SA_FLOAT);
+        _emit(OP_DDIV, 2, VT_DOUBLE);
+        _emitMath("floor", "(D)D", 1);
+        return;
+    }
+    if (value != VT_INTEGER && value != VT_LONG) {
+        _unsupported("floating point modulo");
+        return;
+    }
+    if (expression->mayOverflow && value == VT_LONG && strcmp(method, "floorDiv") == 0) {
+        _emitExactFloorDivision(expression);
+        return;
+    }
+    _emitConverted(expression->leftExpression, type);
+    _emitConverted(expression->rightExpression, type);
+    _emitMath(method, (value == VT_LONG)? "(JJ)J" : "(II)I", 2);
+}
+
+/**
+ * Outputs a power. Integral ones need a constant exponent, and are written
+ * as repeated multiplications of the base, evaluated once into a temporary.
+ */
+static void _emitPower(Expression * expression) {
+    const SaDataType type = expression->dataType;
+    const tVerificationType value = _valueType(type).type;
+    Expression * exponent = expression->rightExpression;
+    if (value == VT_DOUBLE) {
+        _emitConverted(expression->leftExpression, SA_FLOAT);
+        _emitConverted(exponent, SA_FLOAT);
+        _emitMath("pow", "(DD)D", 2);
+        return;
+    }
+    const boolean isConstant = exponent->type == CONSTANT_EXPRESSION && exponent->constant->type == CT_INTEGER
+        && 0 <= exponent->constant->integer && exponent->constant->integer <= MAXIMUM_MULTIPLIED_EXPONENT;
+    if ((value != VT_INTEGER && value != VT_LONG) || !isConstant) {
+        _unsupported("integral powers without a small constant exponent");
+        return;
+    }
+    if (exponent->constant->integer == 0) {
+        if (value == VT_LONG) {
+            _emitLong(1);
+        } else {
+            _emitInteger(1);
+        }
+        return;
+    }
+    const int base = _addLocal(NULL, type);
+    _emitConverted(expression->leftExpression, type);
+    _emitStore(type, base);
+    _emitLoad(type, base);
+    for (int k = 1; k < exponent->constant->integer; k++) {
+        _emitLoad(type, base);
+        if (expression->mayOverflow && value == VT_LONG) {
+            _emitMath("multiplyExact", "(JJ)J", 2);
+        } else {
+            _emit((value == VT_LONG)? OP_LMUL : OP_IMUL, 2, value);
+        }
+    }
+}
+
+/**
+ * Outputs a boolean expression as the value 1 or 0.
+ */
+static void _emitBoolean(Expression * expression) {
+    const int isFalse = _newLabel();
+    const int end = _newLabel();
+    _emitCondition(expression, isFalse, false);
+    _emitInteger(1);
+    _emitJump(OP_GOTO, end, 0);
+    _placeLabel(isFalse);
+    _emitInteger(0);
+    _placeLabel(end);
+}
+
+static void _emitVariable(const char * name) {
+    const tLocal * local = _findLocal(name);
+    tGlobal global;
+    if (local != NULL) {
+        _emitLoad(local->dataType, local->slot);
+    } else if (_findGlobal(name, &global)) {
+        _emitField(OP_GETSTATIC, &global);
+    } else {
+        _unsupported("variables that are neither locals nor top-level ones");
+    }
+}
+
+static void _assignVariable(const char * name) {
+    const tLocal * local = _findLocal(name);
+    tGlobal global;
+    if (local != NULL) {
+        _emitStore(local->dataType, local->slot);
+    } else if (_findGlobal(name, &global)) {
+        _emitField(OP_PUTSTATIC, &global);
+    } else {
+        _unsupported("variables that are neither locals nor top-level ones");
+    }
+}
+
+static SaDataType _variableType(const char * name) {
+    const tLocal * local = _findLocal(name);
+    tGlobal global = { .dataType = SA_UNKNOWN };
+    if (local != NULL) {
+        return local->dataType;
+    }
+    _findGlobal(name, &global);
+    return global.dataType;
+}
+
+static void _emitBuiltinCall(FunctionCall * functionCall) {
+    Expression * argument = functionCall->functionArguments->leftExpression;
+    const tVerificationType value = _valueType(argument->dataType).type;
+    switch (functionCall->object->builtinDefinition) {
+        case BTF_LEN:
+            if (argument->dataType == SA_STRING) {
+                _emitExpression(argument);
+                _emitInvoke(OP_INVOKEVIRTUAL, "java/lang/String", "length", "()I", 0);
+                return;
+            }
+            break;
+        case BTF_ABS:
+            if (value == VT_INTEGER || value == VT_LONG || value == VT_DOUBLE) {
+                _emitExpression(argument);
+                _emitMath("abs", (value == VT_LONG)? "(J)J" : (value == VT_DOUBLE)? "(D)D" : "(I)I", 1);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    _unsupported("this builtin call");
+}
+
+static void _emitFunctionCall(FunctionCall * functionCall) {
+    if (functionCall->type == FC_OBJECT) {
+        _emitBuiltinCall(functionCall);
+        return;
+    }
+    const Block * function = _findFunction(functionCall->functionName);
+    char descriptor[512];
+    if (function == NULL || !_methodDescriptor(function->functionDefinition, descriptor)
+            || _countExpressions(function->functionDefinition->parameters) != _countExpressions(functionCall->functionArguments)) {
+        _unsupported("calls to functions without a static method");
+        return;
+    }
+    Parameters * parameter = function->functionDefinition->parameters;
+    for (Parameters * argument = functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        _emitConverted(argument->leftExpression, parameter->leftExpression->dataType);
+        parameter = parameter->rightParameters;
+    }
+    _emitInvoke(OP_INVOKESTATIC, "Main", functionCall->functionName, descriptor, _countExpressions(functionCall->functionArguments));
+}
+
+static void _emitExpression(Expression * expression) {
+    if (expression == NULL) {
+        return;
+    }
+    if (expression->dataType != SA_VOID && !_isValueType(expression->dataType)) {
+        _unsupported("values whose type is only known at runtime, or collections");
+        return;
+    }
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            _emitConstant(expression);
+            return;
+        case ADDITION:
+            _emitArithmetic(expression, OP_IADD, "addExact");
+            return;
+        case SUBTRACTION:
+            _emitArithmetic(expression, OP_ISUB, "subtractExact");
+            return;
+        case MULTIPLICATION:
+            _emitArithmetic(expression, OP_IMUL, "multiplyExact");
+            return;
+        case DIVISION:
+            // Python divisions are always true divisions.
+            _emitConverted(expression->leftExpression, SA_FLOAT);
+            _emitConverted(expression->rightExpression, SA_FLOAT);
+            _emit(OP_DDIV, 2, VT_DOUBLE);
+            return;
+        case TRUNCATED_DIVISION:
+            _emitFloorOperation(expression, "floorDiv");
+            return;
+        case MODULO:
+            _emitFloorOperation(expression, "floorMod");
+            return;
+        case EXPONENTIATION:
+            _emitPower(expression);
+            return;
+        case LOGIC_AND:
+        case LOGIC_OR:
+        case LOGIC_NOT:
+        case COMPARISON_EXPRESSION:
+            _emitBoolean(expression);
+            return;
+        case VARIABLE_CALL_EXPRESSION:
+            _emitVariable(expression->variableCall->variableName);
+            return;
+        case FUNCTION_CALL_EXPRESSION:
+            _emitFunctionCall(expression->functionCall);
+            return;
+        case UNPACKED_ELEMENT:
+            if (expression->unpackedVariable != _unpackedVariable) {
+                _unsupported("unpacking values other than constants");
+                return;
+            }
+            _emitLoad(expression->dataType, _locals[_unpackedLocal + expression->elementIndex].slot);
+            return;
+        default:
+            _unsupported("methods, fields and the rest of dynamic expressions");
+            return;
+    }
+}
+
+/* CONDITIONS */
+
+/** The branch taken when the comparison holds, as an "if<cond>" opcode on the result of comparing. */
+static int _comparisonOpcode(const BinaryComparatorType comparator) {
+    switch (comparator) {
+        case BCT_EQU:
+            return OP_IFEQ;
+        case BCT_NEQ:
+            return OP_IFNE;
+        case BCT_GT:
+            return OP_IFGT;
+        case BCT_GTE:
+            return OP_IFGE;
+        case BCT_LT:
+            return OP_IFLT;
+        default:
+            return OP_IFLE;
+    }
+}
+
+/** The opposite branch, since "if<cond>" opcodes come in pairs. */
+static int _negatedOpcode(const int opcode) {
+    return ((opcode - OP_IFEQ) % 2 == 0)? opcode + 1 : opcode - 1;
+}
+
+/**
+ * The type both operands of a comparison are converted to, or SA_UNKNOWN if
+ * they cannot be compared.
+ */
+static SaDataType _comparisonType(const SaDataType left, const SaDataType right) {
+    const tVerificationType leftValue = _valueType(left).type;
+    const tVerificationType rightValue = _valueType(right).type;
+    if (leftValue == VT_OBJECT || rightValue == VT_OBJECT) {
+        return (leftValue == rightValue)? SA_STRING : SA_UNKNOWN;
+    }
+    if (leftValue == VT_TOP || rightValue == VT_TOP) {
+        return SA_UNKNOWN;
+    }
+    if (leftValue == VT_DOUBLE || rightValue == VT_DOUBLE) {
+        return SA_FLOAT;
+    }
+    return (leftValue == VT_LONG || rightValue == VT_LONG)? SA_LONG : SA_INTEGER;
+}
+
+static void _emitComparison(Expression * expression, const int label, const boolean jumpsIfTrue) {
+    const BinaryComparatorType comparator = expression->compType;
+    if (comparator != BCT_EQU && comparator != BCT_NEQ && comparator != BCT_GT && comparator != BCT_GTE
+            && comparator != BCT_LT && comparator != BCT_LTE) {
+        _unsupported("membership and identity tests");
+        return;
+    }
+    const SaDataType type = _comparisonType(expression->leftCompExpression->dataType, expression->rightCompExpression->dataType);
+    if (type == SA_UNKNOWN) {
+        _unsupported("comparisons between values of different kinds");
+        return;
+    }
+    int opcode = _comparisonOpcode(comparator);
+    _emitConverted(expression->leftCompExpression, type);
+    _emitConverted(expression->rightCompExpression, type);
+    if (type == SA_STRING && (comparator == BCT_EQU || comparator == BCT_NEQ)) {
+        // Equal strings give 1, so the branch compares with 0 the other way around.
+        _emitInvoke(OP_INVOKEVIRTUAL, "java/lang/String", "equals", "(Ljava/lang/Object;)Z", 1);
+        opcode = _negatedOpcode(opcode);
+    } else if (type == SA_STRING) {
+        _emitInvoke(OP_INVOKEVIRTUAL, "java/lang/String", "compareTo", "(Ljava/lang/String;)I", 1);
+    } else if (type == SA_LONG) {
+        _emit(OP_LCMP, 2, VT_INTEGER);
+    } else if (type == SA_FLOAT) {
+        // Comparisons with NaN are false, so it must compare as greater for "<" and as less for ">".
+        _emit((comparator == BCT_LT || comparator == BCT_LTE)? OP_DCMPG : OP_DCMPL, 2, VT_INTEGER);
+    } else {
+        _emitJump((jumpsIfTrue? opcode : _negatedOpcode(opcode)) + IF_ICMP_OFFSET, label, 2);
+        return;
+    }
+    _emitJump(jumpsIfTrue? opcode : _negatedOpcode(opcode), label, 1);
+}
+
+/**
+ * Jumps to the label when the condition has the given truth value, and
+ * falls through otherwise, so conditions never materialize a boolean.
+ */
+static void _emitCondition(Expression * expression, const int label, const boolean jumpsIfTrue) {
+    const int skip = _newLabel();
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_BOOLEAN) {
+                if (expression->constant->boolean == jumpsIfTrue) {
+                    _emitJump(OP_GOTO, label, 0);
+                }
+                return;
+            }
+            break;
+        case LOGIC_NOT:
+            _emitCondition(expression->notExpression, label, !jumpsIfTrue);
+            return;
+        case LOGIC_AND:
+        case LOGIC_OR:
+            if ((expression->type == LOGIC_AND) != jumpsIfTrue) {
+                // Either operand decides on its own.
+                _emitCondition(expression->leftExpression, label, jumpsIfTrue);
+                _emitCondition(expression->rightExpression, label, jumpsIfTrue);
+            } else {
+                _emitCondition(expression->leftExpression, skip, !jumpsIfTrue);
+                _emitCondition(expression->rightExpression, label, jumpsIfTrue);
+                _placeLabel(skip);
+            }
+            return;
+        case COMPARISON_EXPRESSION:
+            _emitComparison(expression, label, jumpsIfTrue);
+            return;
+        default:
+            break;
+    }
+    const tVerificationType value = _valueType(expression->dataType).type;
+    if (value != VT_INTEGER) {
+        _unsupported("conditions on values other than booleans and integers");
+        return;
+    }
+    _emitExpression(expression);
+    _emitJump(jumpsIfTrue? OP_IFNE : OP_IFEQ, label, 1);
+}
+
+/* SENTENCES */
+
+static void _emitSentences(Sentence * sentence);
+
+/**
+ * Evaluates every element of an unpacked constant into a temporary before
+ * any target is assigned, as a swap needs.
+ */
+static void _emitUnpacking(const Sentence * sentence) {
+    const Variable * variable = sentence->variable;
+    const int first = _localCount;
+    for (Parameters * element = _elementsOf(variable->expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        Expression * value = element->leftExpression;
+        const int slot = _addLocal(NULL, value->dataType);
+        _emitExpression(value);
+        _emitStore(value->dataType, slot);
+    }
+    _unpackedVariable = variable;
+    _unpackedLocal = first;
+}
+
+static void _emitConditionalBlock(Block * block) {
+    const int end = _newLabel();
+    for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+        const int next = _newLabel();
+        if (block->conditional->type != CB_ELSE) {
+            _emitCondition(block->conditional->expression, next, false);
+        }
+        _emitSentences(block->nextSentence);
+        if (block->nextCond != NULL && block->nextCond->conditional != NULL) {
+            _emitJump(OP_GOTO, end, 0);
+        }
+        _placeLabel(next);
+    }
+    _placeLabel(end);
+}
+
+static void _emitWhileBlock(Block * block) {
+    const int condition = _newLabel();
+    const int end = _newLabel();
+    _placeLabel(condition);
+    _emitCondition(block->whileBlock->expression, end, false);
+    _emitSentences(block->nextSentence);
+    _emitJump(OP_GOTO, condition, 0);
+    _placeLabel(end);
+}
+
+/**
+ * Throws the exception of the Java source, when a range is given a zero
+ * step only known at runtime.
+ */
+static void _emitZeroStepCheck(const int step) {
+    const int isValid = _newLabel();
+    _emitLoad(SA_LONG, step);
+    _emitLong(0);
+    _emit(OP_LCMP, 2, VT_INTEGER);
+    _emitJump(OP_IFNE, isValid, 1);
+    _emitThrow("java/lang/IllegalArgumentException", "range() arg 3 must not be zero");
+    _placeLabel(isValid);
+}
+
+/**
+ * Iterates over a range with a counted loop on a hidden long index, so that
+ * the bounds are evaluated once, the body may assign the loop variable, and
+ * the variable keeps the last produced value afterwards.
+ */
+static void _emitRangeForBlock(Block * block) {
+    ForBlock * forBlock = block->forBlock;
+    Expression * arguments[3] = { NULL, NULL, NULL };
+    int count = 0;
+    for (Parameters * argument = forBlock->right->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL && count < 3; argument = argument->rightParameters) {
+        arguments[count++] = argument->leftExpression;
+    }
+    Expression * start = (count > 1)? arguments[0] : NULL;
+    Expression * stop = (count > 1)? arguments[1] : arguments[0];
+    Expression * step = (count > 2)? arguments[2] : NULL;
+    // The analyzer rejects a zero step, so zero stands for a step only known at runtime.
+    const long long stepValue = (step == NULL)? 1
+        : ((step->type == CONSTANT_EXPRESSION && step->constant->type == CT_INTEGER)? step->constant->integer : 0);
+    const int index = _addLocal(NULL, SA_LONG);
+    const int limit = _addLocal(NULL, SA_LONG);
+    const int stride = (stepValue == 0)? _addLocal(NULL, SA_LONG) : 0;
+    if (start == NULL) {
+        _emitLong(0);
+    } else {
+        _emitConverted(start, SA_LONG);
+    }
+    _emitStore(SA_LONG, index);
+    _emitConverted(stop, SA_LONG);
+    _emitStore(SA_LONG, limit);
+    if (stepValue == 0) {
+        _emitConverted(step, SA_LONG);
+        _emitStore(SA_LONG, stride);
+        _emitZeroStepCheck(stride);
+    }
+    const int condition = _newLabel();
+    const int body = _newLabel();
+    const int descending = _newLabel();
+    const int end = _newLabel();
+    _placeLabel(condition);
+    if (stepValue == 0) {
+        _emitLoad(SA_LONG, stride);
+        _emitLong(0);
+        _emit(OP_LCMP, 2, VT_INTEGER);
+        _emitJump(OP_IFLT, descending, 1);
+    }
+    _emitLoad(SA_LONG, index);
+    _emitLoad(SA_LONG, limit);
+    _emit(OP_LCMP, 2, VT_INTEGER);
+    _emitJump((stepValue < 0)? OP_IFLE : OP_IFGE, end, 1);
+    if (stepValue == 0) {
+        _emitJump(OP_GOTO, body, 0);
+        _placeLabel(descending);
+        _emitLoad(SA_LONG, index);
+        _emitLoad(SA_LONG, limit);
+        _emit(OP_LCMP, 2, VT_INTEGER);
+        _emitJump(OP_IFLE, end, 1);
+    }
+    _placeLabel(body);
+    const char * variable = forBlock->left->variableCall->variableName;
+    _emitLoad(SA_LONG, index);
+    _emitConversion(SA_LONG, _variableType(variable));
+    _assignVariable(variable);
+    _emitSentences(block->nextSentence);
+    _emitLoad(SA_LONG, index);
+    if (stepValue == 0) {
+        _emitLoad(SA_LONG, stride);
+    } else {
+        _emitLong(stepValue);
+    }
+    _emit(OP_LADD, 2, VT_LONG);
+    _emitStore(SA_LONG, index);
+    _emitJump(OP_GOTO, condition, 0);
+    _placeLabel(end);
+}
+
+static void _emitBlock(Block * block) {
+    switch (block->type) {
+        case BT_CONDITIONAL:
+            _emitConditionalBlock(block);
+            return;
+        case BT_WHILE:
+            _emitWhileBlock(block);
+            return;
+        case BT_FOR:
+            if (block->forBlock->right->dataType != SA_RANGE) {
+                _unsupported("iterating over strings and collections");
+                return;
+            }
+            _emitRangeForBlock(block);
+            return;
+        default:
+            return;
+    }
+}
+
+static boolean _isTailCall(const Expression * expression) {
+    return _tailFunction != NULL && expression != NULL && expression->type == FUNCTION_CALL_EXPRESSION
+        && expression->functionCall->type == FC_DEF
+        && strcmp(expression->functionCall->functionName, _tailFunction->functionName) == 0
+        && _countExpressions(expression->functionCall->functionArguments) == _countExpressions(_tailFunction->parameters);
+}
+
+static boolean _hasTailCall(const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == RETURN_SENTENCE && _isTailCall(sentence->expression)) {
+            return true;
+        }
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                if (_hasTailCall(block->nextSentence)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Outputs a call of the function to itself in tail position, as the Java
+ * source does: every argument is evaluated on the operand stack before the
+ * parameters are reassigned, and the body starts over.
+ */
+static void _emitTailCall(FunctionCall * functionCall) {
+    const int count = _countExpressions(functionCall->functionArguments);
+    Parameters * parameter = _tailFunction->parameters;
+    for (Parameters * argument = functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        _emitConverted(argument->leftExpression, parameter->leftExpression->dataType);
+        parameter = parameter->rightParameters;
+    }
+    // The parameters are the first locals, and the last argument is on top.
+    for (int k = count - 1; 0 <= k; k--) {
+        _emitStore(_locals[k].dataType, _locals[k].slot);
+    }
+    _emitJump(OP_GOTO, _recurseLabel, 0);
+}
+
+static void _emitSentences(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case EXPRESSION_SENTENCE:
+                _emitExpression(sentence->expression);
+                if (sentence->expression->dataType != SA_VOID) {
+                    // The value is discarded.
+                    _emit((_slotsOf(_valueType(sentence->expression->dataType).type) == 2)? OP_POP2 : OP_POP, 1, VT_TOP);
+                }
+                break;
+            case VARIABLE_SENTENCE:
+                if (_isUnpackedInPlace(sentence)) {
+                    _emitUnpacking(sentence);
+                    break;
+                }
+                _emitConverted(sentence->variable->expression, _variableType(sentence->variable->identifier));
+                _assignVariable(sentence->variable->identifier);
+                break;
+            case BLOCK_SENTENCE:
+                _emitBlock(sentence->block);
+                break;
+            case RETURN_SENTENCE:
+                if (_isTailCall(sentence->expression)) {
+                    _emitTailCall(sentence->expression->functionCall);
+                    break;
+                }
+                if (sentence->expression == NULL || _returnType == SA_VOID) {
+                    if (sentence->expression != NULL && sentence->expression->dataType != SA_VOID) {
+                        _unsupported("returning values from functions without a result");
+                    }
+                    _emitExpression(sentence->expression);
+                    _emitReturn(OP_RETURN, 0);
+                    break;
+                }
+                _emitConverted(sentence->expression, _returnType);
+                switch (_valueType(_returnType).type) {
+                    case VT_LONG:
+                        _emitReturn(OP_LRETURN, 1);
+                        break;
+                    case VT_DOUBLE:
+                        _emitReturn(OP_DRETURN, 1);
+                        break;
+                    case VT_OBJECT:
+                        _emitReturn(OP_ARETURN, 1);
+                        break;
+                    default:
+                        _emitReturn(OP_IRETURN, 1);
+                        break;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/* METHODS */
+
+static void _beginMethod(const SaDataType returnType) {
+    _releaseBuffer(&_code);
+    _stackSize = 0;
+    _stackDepth = 0;
+    _maximumDepth = 0;
+    _localCount = 0;
+    _slotCount = 0;
+    _labelCount = 0;
+    _fixupCount = 0;
+    _isReachable = true;
+    _returnType = returnType;
+    _unpackedVariable = NULL;
+}
+
+static void _putVerificationType(tBuffer * buffer, const tValueType type) {
+    _putByte(buffer, type.type);
+    if (type.type == VT_OBJECT) {
+        _putShort(buffer, _class(type.className));
+    }
+}
+
+static int _compareLabels(const void * left, const void * right) {
+    return ((const tLabel *) left)->position - ((const tLabel *) right)->position;
+}
+
+/**
+ * Writes the Code attribute of the method. Every local but the parameters
+ * gets its default value first, so that all of them keep a single type on
+ * every frame.
+ */
+static void _putCode(tBuffer * method, const char * argumentsClass) {
+    for (int k = 0; k < _fixupCount; k++) {
+        const int offset = _labels[_fixups[k].label].position - _fixups[k].instruction;
+        if (offset < -MAXIMUM_BRANCH_OFFSET || MAXIMUM_BRANCH_OFFSET < offset) {
+            _unsupported("methods that long");
+        }
+        _code.bytes[_fixups[k].instruction + 1] = (uint8_t) (offset >> 8);
+        _code.bytes[_fixups[k].instruction + 2] = (uint8_t) offset;
+    }
+    tBuffer prologue = { 0 };
+    tBuffer saved = _code;
+    _code = prologue;
+    _isReachable = true;
+    for (int k = _parameterCount; k < _localCount; k++) {
+        switch (_valueType(_locals[k].dataType).type) {
+            case VT_LONG:
+                _emitLong(0);
+                break;
+            case VT_DOUBLE:
+                _emitDouble(0);
+                break;
+            case VT_OBJECT:
+                _emit(OP_ACONST_NULL, 0, VT_OBJECT);
+                break;
+            default:
+                _emitInteger(0);
+                break;
+        }
+        _emitStore(_locals[k].dataType, _locals[k].slot);
+    }
+    if (_code.length == 0) {
+        // The first frame may then never fall on the first instruction.
+        _emit(OP_NOP, 0, VT_TOP);
+    }
+    prologue = _code;
+    _code = saved;
+    const int codeLength = prologue.length + _code.length;
+    if (MAXIMUM_CODE_LENGTH <= codeLength) {
+        _unsupported("methods that long");
+    }
+
+    tBuffer frames = { 0 };
+    int frameCount = 0;
+    int previous = -1;
+    if (_labelCount > 0) {
+        qsort(_labels, _labelCount, sizeof(tLabel), _compareLabels);
+    }
+    for (int k = 0; k < _labelCount; k++) {
+        const tLabel * label = &_labels[k];
+        const int position = prologue.length + label->position;
+        if (!label->isTarget || label->position < 0 || position == previous) {
+            continue;
+        }
+        // Full frames, as every local is live everywhere.
+        _putByte(&frames, 255);
+        _putShort(&frames, (previous < 0)? position : position - previous - 1);
+        const int locals = _localCount + (argumentsClass != NULL);
+        _putShort(&frames, locals);
+        if (argumentsClass != NULL) {
+            _putVerificationType(&frames, (tValueType) { .type = VT_OBJECT, .className = argumentsClass });
+        }
+        for (int j = 0; j < _localCount; j++) {
+            _putVerificationType(&frames, _valueType(_locals[j].dataType));
+        }
+        _putShort(&frames, label->stackSize);
+        for (int j = 0; j < label->stackSize; j++) {
+            _putVerificationType(&frames, label->stack[j]);
+        }
+        previous = position;
+        frameCount++;
+    }
+
+    tBuffer attribute = { 0 };
+    _putShort(&attribute, (_maximumDepth < 4)? 4 : _maximumDepth);
+    _putShort(&attribute, _slotCount + (argumentsClass != NULL));
+    _putInteger(&attribute, codeLength);
+    _putBuffer(&attribute, &prologue);
+    _putBuffer(&attribute, &_code);
+    _putShort(&attribute, 0);
+    _putShort(&attribute, (frameCount > 0)? 1 : 0);
+    if (frameCount > 0) {
+        _putShort(&attribute, _utf8("StackMapTable"));
+        _putInteger(&attribute, frames.length + 2);
+        _putShort(&attribute, frameCount);
+        _putBuffer(&attribute, &frames);
+    }
+    _putShort(method, _utf8("Code"));
+    _putInteger(method, attribute.length);
+    _putBuffer(method, &attribute);
+    _releaseBuffer(&attribute);
+    _releaseBuffer(&frames);
+    _releaseBuffer(&prologue);
+    for (int k = 0; k < _labelCount; k++) {
+        free(_labels[k].stack);
+    }
+}
+
+/**
+ * Ends the body of a method, which returns when it completes normally.
+ * Functions that return values only complete normally when the analysis of
+ * reachability here is weaker than the one of the semantic analysis.
+ */
+static void _endMethod() {
+    switch (_valueType(_returnType).type) {
+        case VT_TOP:
+            _emitReturn(OP_RETURN, 0);
+            break;
+        case VT_LONG:
+            _emitLong(0);
+            _emitReturn(OP_LRETURN, 1);
+            break;
+        case VT_DOUBLE:
+            _emitDouble(0);
+            _emitReturn(OP_DRETURN, 1);
+            break;
+        case VT_OBJECT:
+            _emit(OP_ACONST_NULL, 0, VT_OBJECT);
+            _emitReturn(OP_ARETURN, 1);
+            break;
+        default:
+            _emitInteger(0);
+            _emitReturn(OP_IRETURN, 1);
+            break;
+    }
+}
+
+static void _putMethod(tBuffer * methods, const Block * function) {
+    FunctionDefinition * definition = function->functionDefinition;
+    char descriptor[512];
+    if (!_methodDescriptor(definition, descriptor)) {
+        logWarning(_logger, "The function \"%s\" takes or returns values whose type is only known at runtime.", definition->functionName);
+        _unsupported("functions without primitive or string types");
+        return;
+    }
+    _beginMethod(definition->dataType);
+    for (const Parameters * parameter = definition->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        _addLocal(parameter->leftExpression->variableCall->variableName, parameter->leftExpression->dataType);
+    }
+    _parameterCount = _localCount;
+    _declareAssigned(function->nextSentence, _declareLocal);
+    _tailFunction = definition;
+    if (_hasTailCall(function->nextSentence)) {
+        _recurseLabel = _newLabel();
+        _placeLabel(_recurseLabel);
+    } else {
+        _tailFunction = NULL;
+    }
+    _emitSentences(function->nextSentence);
+    _endMethod();
+    _tailFunction = NULL;
+    // Public and static.
+    _putShort(methods, 0x0009);
+    _putShort(methods, _utf8(definition->functionName));
+    _putShort(methods, _utf8(descriptor));
+    _putShort(methods, 1);
+    _putCode(methods, NULL);
+}
+
+static void _putMain(tBuffer * methods, Program * program) {
+    _beginMethod(SA_VOID);
+    // The arguments take the first slot.
+    _slotCount = 1;
+    _parameterCount = 0;
+    _emitSentences(program->sentence);
+    _endMethod();
+    _putShort(methods, 0x0009);
+    _putShort(methods, _utf8("main"));
+    _putShort(methods, _utf8("([Ljava/lang/String;)V"));
+    _putShort(methods, 1);
+    _putCode(methods, "[Ljava/lang/String;");
+}
+
+static void _putFields(tBuffer * fields, int * count) {
+    int size = 0;
+    tGlobal ** globals = (tGlobal **) hashMapValues(_globals, &size);
+    for (int k = 0; k < size; k++) {
+        // Private and static.
+        _putShort(fields, 0x000a);
+        _putShort(fields, _utf8(globals[k]->name));
+        _putShort(fields, _utf8(_descriptor(globals[k]->dataType)));
+        _putShort(fields, 0);
+    }
+    free(globals);
+    *count = size;
+}
+
+static void _releaseState() {
+    int size = 0;
+    tPoolEntry ** entries = (tPoolEntry **) hashMapValues(_poolIndexes, &size);
+    for (int k = 0; k < size; k++) {
+        free((char *) entries[k]->key);
+    }
+    free(entries);
+    hashMapDestroy(_poolIndexes);
+    _poolIndexes = NULL;
+    hashMapDestroy(_globals);
+    _globals = NULL;
+    _releaseBuffer(&_pool);
+    _releaseBuffer(&_code);
+    free(_labels);
+    _labels = NULL;
+    free(_fixups);
+    _fixups = NULL;
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean generateClassFile(Program * program) {
+    logDebugging(_logger, "Generating class file...");
+    _isUnsupported = false;
+    _poolCount = 1;
+    _functionCount = 0;
+    _poolIndexes = hashMapInit(sizeof(tPoolEntry), sizeof(tPoolEntry), hashMapStringHash, hashMapStringKeyEquals);
+    _globals = hashMapInit(sizeof(tGlobal), sizeof(tGlobal), hashMapStringHash, hashMapStringKeyEquals);
+    _collectFunctions(program->sentence, false);
+    _declareAssigned(program->sentence, _addGlobal);
+
+    tBuffer methods = { 0 };
+    tBuffer fields = { 0 };
+    int fieldCount = 0;
+    beginSpan("generation", "function", "main");
+    _putMain(&methods, program);
+    endSpan();
+    for (int k = 0; k < _functionCount && !_isUnsupported; k++) {
+        beginSpan("generation", "function", _functions[k]->functionDefinition->functionName);
+        _putMethod(&methods, _functions[k]);
+        endSpan();
+    }
+    _putFields(&fields, &fieldCount);
+    const int thisClass = _class("Main");
+    const int superClass = _class("java/lang/Object");
+
+    boolean isWritten = false;
+    FILE * file = _isUnsupported? NULL : fopen("Main.class", "wb");
+    if (file != NULL) {
+        tBuffer header = { 0 };
+        _putInteger(&header, 0xcafebabe);
+        _putShort(&header, 0);
+        _putShort(&header, CLASS_MAJOR_VERSION);
+        _putShort(&header, _poolCount);
+        tBuffer body = { 0 };
+        // Public, and with the modern semantics of "invokespecial".
+        _putShort(&body, 0x0021);
+        _putShort(&body, thisClass);
+        _putShort(&body, superClass);
+        _putShort(&body, 0);
+        _putShort(&body, fieldCount);
+        _putBuffer(&body, &fields);
+        _putShort(&body, 1 + _functionCount);
+        _putBuffer(&body, &methods);
+        _putShort(&body, 0);
+        beginSpan("io", "write", "Main.class");
+        isWritten = fwrite(header.bytes, 1, header.length, file) == (size_t) header.length
+            && fwrite(_pool.bytes, 1, _pool.length, file) == (size_t) _pool.length
+            && fwrite(body.bytes, 1, body.length, file) == (size_t) body.length;
+        fclose(file);
+        endSpan();
+        if (isWritten) {
+            countEmittedBytes(header.length + _pool.length + body.length);
+        }
+        _releaseBuffer(&header);
+        _releaseBuffer(&body);
+        if (!isWritten) {
+            logError(_logger, "Cannot write \"Main.class\".");
+        }
+    }
+    _releaseBuffer(&methods);
+    _releaseBuffer(&fields);
+    _releaseState();
+    logDebugging(_logger, "Class file generation is done.");
+    return isWritten;
+}
@@ -0,0 +1,34 @@
+#ifndef CLASS_FILE_GENERATOR_HEADER
+#define CLASS_FILE_GENERATOR_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
+#include "../../shared/Type.h"
+#include <stdint.h>
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeClassFileGeneratorModule();
+
+/** Shutdown module's internal state. */
+void shutdownClassFileGeneratorModule();
+
+/**
+ * Whether the programs must be compiled straight to "Main.class", as
+ * selected by the "TARGET_LANGUAGE" environment variable.
+ */
+boolean isClassTargetSelected();
+
+/**
+ * Writes the program as "Main.class", a Java 8 class file with its
+ * bytecode and stack map frames, so that it runs without going through
+ * javac. Must run after the types were inferred, since every symbol gets a
+ * primitive JVM type. Returns false, writing nothing, if the program uses a
+ * construct this backend cannot express, in which case the Java source must
+ * be generated instead.
+ */
+boolean generateClassFile(Program * program);
+
+#endif
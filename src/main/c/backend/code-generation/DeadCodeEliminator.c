@@ -0,0 +1,419 @@
+#include "DeadCodeEliminator.h"
+#include "../semantic-analysis/HashMap.h"
+
+/* MODULE INTERNAL STATE */
+
+typedef struct {
+	const char * functionName;
+} FunctionKey;
+
+typedef struct {
+	Block * block;
+	boolean isReachable;
+} FunctionValue;
+
+static Logger * _logger = NULL;
+static boolean _logEliminatedCode = false;
+static hashMapADT _functions = NULL;
+static Block ** _pending = NULL;
+static int _pendingCount = 0;
+static int _pendingCapacity = 0;
+static int _removedSentences = 0;
+static int _removedFunctions = 0;
+
+void initializeDeadCodeEliminatorModule() {
+	_logger = createLogger("DeadCodeEliminator");
+	_logEliminatedCode = getBooleanOrDefault("LOG_ELIMINATED_CODE", _logEliminatedCode);
+}
+
+void shutdownDeadCodeEliminatorModule() {
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static void _collectCallsInExpression(Expression * expression);
+static void _collectCallsInSentence(Sentence * sentence);
+static void _pruneSentences(Sentence ** head);
+
+/**
+ * Logs a removal, at INFORMATION level only if the report was requested.
+ */
+static void _report(const char * what, const char * name, const char * reason) {
+	if (_logEliminatedCode) {
+		logInformation(_logger, "Removed %s%s%s (%s).", what, *name ? " " : "", name, reason);
+	} else {
+		logDebugging(_logger, "Removed %s%s%s (%s).", what, *name ? " " : "", name, reason);
+	}
+}
+
+static const char * _describeSentence(const Sentence * sentence, const char ** name) {
+	*name = "";
+	switch (sentence->type) {
+		case EXPRESSION_SENTENCE:
+			return "expression";
+		case VARIABLE_SENTENCE:
+			*name = sentence->variable->identifier;
+			return "assignment to";
+		case RETURN_SENTENCE:
+			return "return";
+		case BLOCK_SENTENCE:
+			switch (sentence->block->type) {
+				case BT_FUNCTION_DEFINITION:
+					*name = sentence->block->functionDefinition->functionName;
+					return "function";
+				case BT_CONDITIONAL:
+					return "conditional";
+				case BT_FOR:
+					return "for loop";
+				case BT_WHILE:
+					return "while loop";
+				default:
+					return "block";
+			}
+		default:
+			return "sentence";
+	}
+}
+
+static void _reportSentences(const Sentence * sentence, const char * reason) {
+	for (; sentence != NULL; sentence = sentence->nextSentence) {
+		const char * name;
+		const char * what = _describeSentence(sentence, &name);
+		_report(what, name, reason);
+		++_removedSentences;
+	}
+}
+
+static void _reportBranches(const Block * block, const char * reason) {
+	for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+		_report(block->conditional->type == CB_ELSE ? "else branch" : "elif branch", "", reason);
+		_reportSentences(block->nextSentence, reason);
+	}
+}
+
+static boolean _isBooleanConstant(const Expression * expression, const boolean value) {
+	return expression != NULL
+		&& expression->type == CONSTANT_EXPRESSION
+		&& expression->constant->type == CT_BOOLEAN
+		&& expression->constant->boolean == value;
+}
+
+static boolean _chainTerminates(const Sentence * sentence);
+
+/**
+ * A sentence terminates if the sentences that follow it in the same chain
+ * can never be executed: a return, a conditional where every branch
+ * terminates and one of them is always taken, or an endless loop (the
+ * language has no "break").
+ */
+static boolean _terminates(const Sentence * sentence) {
+	if (sentence->type == RETURN_SENTENCE) {
+		return true;
+	}
+	if (sentence->type != BLOCK_SENTENCE) {
+		return false;
+	}
+	const Block * block = sentence->block;
+	switch (block->type) {
+		case BT_WHILE:
+			return _isBooleanConstant(block->whileBlock->expression, true);
+		case BT_CONDITIONAL:
+			for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+				if (!_chainTerminates(block->nextSentence)) {
+					return false;
+				}
+				if (block->conditional->type == CB_ELSE || _isBooleanConstant(block->conditional->expression, true)) {
+					return true;
+				}
+			}
+			return false;
+		default:
+			return false;
+	}
+}
+
+static boolean _chainTerminates(const Sentence * sentence) {
+	for (; sentence != NULL; sentence = sentence->nextSentence) {
+		if (_terminates(sentence)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Removes the branches of a conditional chain that can never be taken: the
+ * elifs guarded by a constant false condition, and everything after a branch
+ * guarded by a constant true condition.
+ */
+static void _pruneConditional(Block * block) {
+	Block * current = block;
+	while (current != NULL && current->conditional != NULL) {
+		_pruneSentences(&current->nextSentence);
+		if (current->conditional->type != CB_ELSE && _isBooleanConstant(current->conditional->expression, true)) {
+			_reportBranches(current->nextCond, "follows an always taken branch");
+			releaseBlock(current->nextCond);
+			current->nextCond = NULL;
+			return;
+		}
+		Block * next = current->nextCond;
+		if (next != NULL && next->conditional != NULL && next->conditional->type == CB_ELIF
+				&& _isBooleanConstant(next->conditional->expression, false)) {
+			Block * rest = next->nextCond;
+			next->nextCond = NULL;
+			_reportBranches(next, "constant false condition");
+			current->nextCond = rest;
+			releaseBlock(next);
+			continue;
+		}
+		current = next;
+	}
+}
+
+/**
+ * Returns true if the whole block never executes, so its sentence can be
+ * dropped: a while loop or a lone if guarded by a constant false condition.
+ */
+static boolean _isDeadBlock(const Block * block) {
+	switch (block->type) {
+		case BT_WHILE:
+			return _isBooleanConstant(block->whileBlock->expression, false);
+		case BT_CONDITIONAL:
+			return _isBooleanConstant(block->conditional->expression, false)
+				&& (block->nextCond == NULL || block->nextCond->conditional == NULL);
+		default:
+			return false;
+	}
+}
+
+static void _pruneSentences(Sentence ** head) {
+	Sentence ** link = head;
+	while (*link != NULL) {
+		Sentence * sentence = *link;
+		if (sentence->type == BLOCK_SENTENCE && _isDeadBlock(sentence->block)) {
+			*link = sentence->nextSentence;
+			sentence->nextSentence = NULL;
+			_reportSentences(sentence, "constant false condition");
+			releaseSentence(sentence);
+			continue;
+		}
+		if (sentence->type == BLOCK_SENTENCE) {
+			if (sentence->block->type == BT_CONDITIONAL) {
+				_pruneConditional(sentence->block);
+			} else {
+				_pruneSentences(&sentence->block->nextSentence);
+			}
+		}
+		if (sentence->nextSentence != NULL && _terminates(sentence)) {
+			_reportSentences(sentence->nextSentence, "follows a terminating sentence");
+			releaseSentence(sentence->nextSentence);
+			sentence->nextSentence = NULL;
+		}
+		link = &sentence->nextSentence;
+	}
+}
+
+/**
+ * Marks a function as reachable, and queues its body for scanning the first
+ * time it is seen. Names that are not user-defined functions are ignored.
+ */
+static void _markReachable(const char * name) {
+	FunctionKey key = { .functionName = name };
+	FunctionValue value;
+	if (name == NULL || !hashMapFind(_functions, &key, &value) || value.isReachable) {
+		return;
+	}
+	value.isReachable = true;
+	hashMapInsertOrUpdate(_functions, &key, &value);
+	if (_pendingCount == _pendingCapacity) {
+		_pendingCapacity = _pendingCapacity == 0 ? 16 : 2 * _pendingCapacity;
+		_pending = realloc(_pending, _pendingCapacity * sizeof(Block *));
+	}
+	_pending[_pendingCount++] = value.block;
+}
+
+static void _collectCallsInParameters(Parameters * parameters) {
+	for (; parameters != NULL; parameters = parameters->rightParameters) {
+		_collectCallsInExpression(parameters->leftExpression);
+	}
+}
+
+static void _collectCallsInExpression(Expression * expression) {
+	if (expression == NULL) {
+		return;
+	}
+	switch (expression->type) {
+		case CONSTANT_EXPRESSION:
+			if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+				if (expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+					_collectCallsInParameters(expression->constant->list->elements);
+				}
+			}
+			return;
+		case VARIABLE_CALL_EXPRESSION:
+			// A function referenced by name may be called elsewhere.
+			_markReachable(expression->variableCall->variableName);
+			return;
+		case FUNCTION_CALL_EXPRESSION:
+			if (expression->functionCall->type == FC_DEF) {
+				_markReachable(expression->functionCall->functionName);
+			}
+			_collectCallsInParameters(expression->functionCall->functionArguments);
+			return;
+		case METHOD_CALL_EXPRESSION:
+			_collectCallsInParameters(expression->methodCall->functionCall->functionArguments);
+			return;
+		case FIELD_GETTER_EXPRESSION:
+		case UNPACKED_ELEMENT:
+			// The unpacked value is scanned where it is assigned.
+			return;
+		case LOGIC_NOT:
+			_collectCallsInExpression(expression->notExpression);
+			return;
+		default:
+			_collectCallsInExpression(expression->leftExpression);
+			_collectCallsInExpression(expression->rightExpression);
+			return;
+	}
+}
+
+/**
+ * Scans a sentence chain for calls. Function definitions are registered, but
+ * their bodies are only scanned once they become reachable.
+ */
+static void _collectCallsInSentence(Sentence * sentence) {
+	for (; sentence != NULL; sentence = sentence->nextSentence) {
+		switch (sentence->type) {
+			case EXPRESSION_SENTENCE:
+			case RETURN_SENTENCE:
+				_collectCallsInExpression(sentence->expression);
+				break;
+			case VARIABLE_SENTENCE:
+				_collectCallsInExpression(sentence->variable->expression);
+				break;
+			case BLOCK_SENTENCE:
+				switch (sentence->block->type) {
+					case BT_FUNCTION_DEFINITION:
+						break;
+					case BT_CONDITIONAL:
+						for (Block * block = sentence->block; block != NULL && block->conditional != NULL; block = block->nextCond) {
+							_collectCallsInExpression(block->conditional->expression);
+							_collectCallsInSentence(block->nextSentence);
+						}
+						break;
+					case BT_FOR:
+						_collectCallsInExpression(sentence->block->forBlock->right);
+						_collectCallsInSentence(sentence->block->nextSentence);
+						break;
+					case BT_WHILE:
+						_collectCallsInExpression(sentence->block->whileBlock->expression);
+						_collectCallsInSentence(sentence->block->nextSentence);
+						break;
+					default:
+						_collectCallsInSentence(sentence->block->nextSentence);
+						break;
+				}
+				break;
+		}
+	}
+}
+
+static void _registerFunctions(Sentence * sentence) {
+	for (; sentence != NULL; sentence = sentence->nextSentence) {
+		if (sentence->type != BLOCK_SENTENCE) {
+			continue;
+		}
+		Block * block = sentence->block;
+		if (block->type == BT_FUNCTION_DEFINITION) {
+			FunctionKey key = { .functionName = block->functionDefinition->functionName };
+			FunctionValue value = { .block = block, .isReachable = false };
+			hashMapInsertOrUpdate(_functions, &key, &value);
+		} else if (block->type == BT_CONDITIONAL) {
+			for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+				_registerFunctions(block->nextSentence);
+			}
+		} else {
+			_registerFunctions(block->nextSentence);
+		}
+	}
+}
+
+static void _removeUnreachableFunctions(Sentence ** head) {
+	Sentence ** link = head;
+	while (*link != NULL) {
+		Sentence * sentence = *link;
+		if (sentence->type == BLOCK_SENTENCE) {
+			Block * block = sentence->block;
+			if (block->type == BT_FUNCTION_DEFINITION) {
+				FunctionKey key = { .functionName = block->functionDefinition->functionName };
+				FunctionValue value;
+				hashMapFind(_functions, &key, &value);
+				// Only the last definition of a name is registered, and only that one may be reachable.
+				if (!value.isReachable || value.block != block) {
+					_report("function", key.functionName, "never called");
+					++_removedFunctions;
+					// The registered key borrows the name of the last definition, which is about to be released.
+					if (value.block == block) {
+						hashMapRemove(_functions, &key);
+					}
+					*link = sentence->nextSentence;
+					sentence->nextSentence = NULL;
+					releaseSentence(sentence);
+					continue;
+				}
+			} else if (block->type == BT_CONDITIONAL) {
+				for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+					_removeUnreachableFunctions(&block->nextSentence);
+				}
+			} else {
+				_removeUnreachableFunctions(&block->nextSentence);
+			}
+		}
+		link = &sentence->nextSentence;
+	}
+}
+
+/** PUBLIC FUNCTIONS */
+
+void eliminateDeadCode(Program * program) {
+	if (program == NULL) {
+		return;
+	}
+	logDebugging(_logger, "Eliminating dead code...");
+	_removedSentences = 0;
+	_removedFunctions = 0;
+	for (Program * current = program; current != NULL; current = current->nextProgram) {
+		_pruneSentences(&current->sentence);
+	}
+
+	_functions = hashMapInit(sizeof(FunctionKey), sizeof(FunctionValue), hashMapStringHash, hashMapStringKeyEquals);
+	_pendingCount = 0;
+	for (Program * current = program; current != NULL; current = current->nextProgram) {
+		_registerFunctions(current->sentence);
+	}
+	for (Program * current = program; current != NULL; current = current->nextProgram) {
+		_collectCallsInSentence(current->sentence);
+	}
+	while (_pendingCount > 0) {
+		Block * function = _pending[--_pendingCount];
+		_collectCallsInSentence(function->nextSentence);
+	}
+	for (Program * current = program; current != NULL; current = current->nextProgram) {
+		_removeUnreachableFunctions(&current->sentence);
+	}
+	hashMapDestroy(_functions);
+	_functions = NULL;
+	free(_pending);
+	_pending = NULL;
+	_pendingCapacity = 0;
+
+	if (_removedSentences > 0 || _removedFunctions > 0) {
+		if (_logEliminatedCode) {
+			logInformation(_logger, "Removed %d unreachable sentence(s) and %d unused function(s).", _removedSentences, _removedFunctions);
+		}
+	}
+	logDebugging(_logger, "Dead code elimination is done.");
+}
@@ -0,0 +1,25 @@
+#ifndef DEAD_CODE_ELIMINATOR_HEADER
+#define DEAD_CODE_ELIMINATOR_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+
+/** Initialize module's internal state. */
+void initializeDeadCodeEliminatorModule();
+
+/** Shutdown module's internal state. */
+void shutdownDeadCodeEliminatorModule();
+
+/**
+ * Removes from the program every sentence that can never execute (the ones
+ * after a return, a branch that always returns or an endless loop, and
+ * blocks guarded by a constant false condition), and every function that is
+ * not reachable through the call graph rooted at the top-level sentences.
+ * Must run after the semantic analysis accepted the program, and before its
+ * generation.
+ */
+void eliminateDeadCode(Program * program);
+
+#endif
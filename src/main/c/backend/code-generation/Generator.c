@@ -1,7 +1,50 @@
 #include "Generator.h"
-#include "../semantic-analysis/SymbolTable.h"
 #include "../semantic-analysis/funcList.h"
-#include "../semantic-analysis/utils.h"
+#include "../semantic-analysis/HashMap.h"
+#include "../semantic-analysis/SemanticAnalyzer.h"
+#include "../semantic-analysis/TypeInference.h"
+
+/** Tuple constants up to this size are iterated by repeating the loop body. */
+#define MAXIMUM_UNROLLED_ELEMENTS 8
+
+/** Powers up to this constant exponent are written as repeated multiplications. */
+#define MAXIMUM_UNROLLED_EXPONENT 4
+
+/** Membership tests against integer literals up to this value use a bitmask. */
+#define MAXIMUM_BITMASK_ELEMENT 63
+
+/** The most string accumulators a single loop rewrites into builders. */
+#define MAXIMUM_ACCUMULATORS 8
+
+/** The largest initial capacity given to a builder, however long its loop. */
+#define MAXIMUM_PRESIZED_CAPACITY (1 << 20)
+
+/** The expected length of an appended value that is not a literal. */
+#define APPENDED_LENGTH_ESTIMATE 16
+
+/** The most parameters a function may take to be inlined. */
+#define MAXIMUM_INLINED_PARAMETERS 8
+
+/** The most calls being inlined into one another at a single call site. */
+#define MAXIMUM_INLINING_DEPTH 4
+
+/** The default size of the largest inlined body, counted in expression nodes. */
+#define DEFAULT_INLINE_SIZE_BUDGET 16
+
+/** The most functions given a variant that returns its tuple in static fields. */
+#define MAXIMUM_FLATTENED_FUNCTIONS 32
+
+/** The most variables a loop lowered to a parallel stream may read besides its element. */
+#define MAXIMUM_CAPTURED_VARIABLES 8
+
+/** The most operands added to an accumulator that a reduction regroups into one sum. */
+#define MAXIMUM_REGROUPED_OPERANDS 8
+
+/** The default number of iterations from which a reduction loop runs in parallel. */
+#define DEFAULT_PARALLEL_THRESHOLD 10000
+
+/** The default size, in estimated bytes of bytecode, from which the main method is split. */
+#define DEFAULT_MAXIMUM_METHOD_SIZE 6000
 
 /* MODULE INTERNAL STATE */
 void generateVariableCall(VariableCall * variableCall);
@@ -12,8 +55,44 @@ const char _indentationSize = 4;
 
 static Logger * _logger = NULL;
 
+typedef struct {
+    const char * name;
+} tDeclarationKey;
+
+/** The locals already declared on the Java method being generated. */
+static hashMapADT _declared = NULL;
+
+/** The top-level variables emitted as constants of the class, while the main method is generated. */
+static hashMapADT _constants = NULL;
+
+/** The string locals being appended to a StringBuilder, mapped to its number. */
+static hashMapADT _accumulators = NULL;
+
+/** The functions of the program, mapped to their definition blocks. */
+static hashMapADT _functions = NULL;
+
+/** A call whose function body is being generated in place of the call. */
+typedef struct tInlining {
+    const Block * function;
+    Parameters * arguments;
+    const struct tInlining * caller;
+} tInlining;
+
+/** The innermost call being inlined, or NULL outside of inlined bodies. */
+static const tInlining * _inlining = NULL;
+static int _inlineSizeBudget = DEFAULT_INLINE_SIZE_BUDGET;
+static int _parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+static int _maximumMethodSize = DEFAULT_MAXIMUM_METHOD_SIZE;
+
+/** Whether the generated program reports the hits and misses of its memo tables. */
+static boolean _logCacheStatistics = false;
+
 void initializeGeneratorModule() {
 	_logger = createLogger("Generator");
+	_inlineSizeBudget = getIntegerOrDefault("INLINE_SIZE_BUDGET", _inlineSizeBudget);
+	_logCacheStatistics = getBooleanOrDefault("LOG_CACHE_STATISTICS", _logCacheStatistics);
+	_parallelThreshold = getIntegerOrDefault("PARALLEL_THRESHOLD", _parallelThreshold);
+	_maximumMethodSize = getIntegerOrDefault("MAXIMUM_METHOD_SIZE", _maximumMethodSize);
 }
 
 void shutdownGeneratorModule() {
@@ -23,6 +102,114 @@ void shutdownGeneratorModule() {
 }
 
 static int indentLevel = 0;
+/** The helper methods the generated class needs, emitted after every other method. */
+static boolean _usesIntegerPower = false;
+static boolean _usesLongPower = false;
+static boolean _usesExactPower = false;
+static boolean _usesFloorModulo = false;
+static boolean _usesExactFloorDivision = false;
+static boolean _usesBigDivision = false;
+static boolean _usesIntegerContains = false;
+static boolean _usesLongContains = false;
+static boolean _usesDecimalContains = false;
+static boolean _usesObjectContains = false;
+static boolean _usesMemo = false;
+static boolean _usesWideMemo = false;
+static boolean _usesObjectMemo = false;
+
+typedef enum {
+    MK_SWITCH,
+    MK_SET
+} tMembershipKind;
+
+/** A membership test against a literal, emitted as a helper method or constant set. */
+typedef struct {
+    Expression * membership;
+    tMembershipKind kind;
+} tMembership;
+
+static tMembership * _memberships = NULL;
+static int _membershipCount = 0;
+static void _generateMemberships();
+static boolean _isSimpleOperand(const Expression * expression);
+/** Numbers the hidden locals of each for loop, which use "$" so they never clash with Python names. */
+static int _loopCount = 0;
+/** Numbers the hidden locals holding the arguments of tail calls. */
+static int _tailCallCount = 0;
+/** The function being generated as a loop, as it calls itself in tail position. */
+static const FunctionDefinition * _tailFunction = NULL;
+/** The type returned by the function being generated. */
+static SaDataType _returnType = SA_VOID;
+
+typedef enum {
+    /** The elements of a constant tuple are evaluated into locals, without building it. */
+    UM_TEMPORARIES,
+    /** A variant of the called function leaves the elements in static fields. */
+    UM_FIELDS,
+    /** The value is stored in an array, whose elements are then read. */
+    UM_ARRAY
+} tUnpackingMode;
+
+/** A function returning tuples, and the number of elements of each one. */
+typedef struct {
+    const Block * function;
+    int count;
+    /** Whether every call unpacks the result in place, so only the variant is generated. */
+    boolean isOnlyUnpacked;
+} tFlattened;
+
+/** The unpacking assignment whose elements are being generated. */
+typedef struct {
+    const Variable * variable;
+    tUnpackingMode mode;
+    const Block * function;
+    int temporaries;
+} tUnpacking;
+
+static tUnpacking _unpacking = { .variable = NULL };
+/** Numbers the hidden locals holding the elements of unpacked constants. */
+static int _unpackedCount = 0;
+/** The functions whose flattened variant is generated after the others. */
+static tFlattened _flattened[MAXIMUM_FLATTENED_FUNCTIONS];
+static int _flattenedCount = 0;
+/** The function whose flattened variant is being generated, if any. */
+static const tFlattened * _flattenedFunction = NULL;
+/** Numbers the hidden locals holding the returned elements of flattened functions. */
+static int _resultCount = 0;
+/**
+ * Whether some call leaves its elements in the static fields of a flattened
+ * variant, which threads would share.
+ */
+static boolean _usesResultFields = false;
+static void _generateUnpackedElement(const Expression * element);
+static boolean _isUnpackedInPlace(const Sentence * sentence);
+
+/** A loop that only folds a pure expression of its element into an accumulator. */
+typedef struct {
+    const Variable * accumulator;
+    Expression * mapped;
+    Expression * filter;
+    char operator;
+    const char * variable;
+    boolean isArray;
+    int loop;
+    const Expression * captures[MAXIMUM_CAPTURED_VARIABLES];
+    int captureCount;
+    /** The sums built when the accumulator is the first of several added operands. */
+    Expression regrouped[MAXIMUM_REGROUPED_OPERANDS];
+} tReduction;
+
+/** The reduction whose lambdas are being generated, if any. */
+static const tReduction * _reduction = NULL;
+static boolean _usesIntRange = false;
+static boolean _usesLongRange = false;
+/** The body of the method being generated. */
+static const Sentence * _methodBody = NULL;
+/** The first top-level sentence after the chunk of the main method being generated, if it is split. */
+static const Sentence * _chunkEnd = NULL;
+/** Whether hoisted declarations become static fields, shared by every chunk of a split main method. */
+static boolean _hoistsFields = false;
+static int _builderCount = 0;
 static void _output(const char * const format, ...);
 
 /** PRIVATE FUNCTIONS */
@@ -36,6 +223,228 @@ void _outputBraceWithIndent(){
     _outputIndent();
     _output("}\n");
 }
+
+/**
+ * The Java type used to declare a symbol of the given type.
+ */
+static const char * _javaType(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return "boolean";
+        case SA_FLOAT:
+            return "double";
+        case SA_CHARACTER:
+            return "char";
+        case SA_INTEGER:
+            return "int";
+        case SA_LONG:
+            return "long";
+        case SA_BIG_INTEGER:
+            return "java.math.BigInteger";
+        case SA_STRING:
+            return "String";
+        case SA_VOID:
+            return "void";
+        default:
+            return "Object";
+    }
+}
+
+/**
+ * The Java type used to declare a symbol of the given type, where lists and
+ * tuples are backed by arrays of their element type.
+ */
+static const char * _javaDeclarationType(const SaDataType type, const SaDataType elementType) {
+    if (type != SA_LIST && type != SA_TUPLE) {
+        return _javaType(type);
+    }
+    switch (elementType) {
+        case SA_BOOLEAN:
+            return "boolean[]";
+        case SA_FLOAT:
+            return "double[]";
+        case SA_CHARACTER:
+            return "char[]";
+        case SA_INTEGER:
+            return "int[]";
+        case SA_LONG:
+            return "long[]";
+        case SA_BIG_INTEGER:
+            return "java.math.BigInteger[]";
+        case SA_STRING:
+            return "String[]";
+        default:
+            return "Object[]";
+    }
+}
+/**
+ * The Java literal a local of the given type is initialized with when its
+ * declaration is hoisted.
+ */
+static const char * _javaDefaultValue(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return "false";
+        case SA_FLOAT:
+            return "0.0";
+        case SA_INTEGER:
+            return "0";
+        case SA_LONG:
+            return "0L";
+        case SA_BIG_INTEGER:
+            return "java.math.BigInteger.ZERO";
+        case SA_CHARACTER:
+            return "'\\0'";
+        default:
+            return "null";
+    }
+}
+
+static boolean _isDeclared(const char * name) {
+    tDeclarationKey key = { .name = name };
+    return hashMapFind(_declared, &key, NULL);
+}
+
+static void _markDeclared(const char * name) {
+    tDeclarationKey key = { .name = name };
+    hashMapInsertOrUpdate(_declared, &key, &key);
+}
+
+static void _declareHoisted(const char * name, const SaDataType type, const SaDataType elementType) {
+    _outputIndent();
+    _output("%s%s %s = %s;\n", _hoistsFields? "private static " : "", _javaDeclarationType(type, elementType), name, _javaDefaultValue(type));
+    _markDeclared(name);
+}
+
+/**
+ * Declares, on top of the method, every local whose first assignment is
+ * nested in a block, so that it remains visible after that block ends.
+ * Locals first assigned on the method body itself are declared in place.
+ */
+static void _hoistDeclarations(hashMapADT assigned, Sentence * sentence, const boolean isNested) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE && _isUnpackedInPlace(sentence)) {
+            // The unpacked value never gets a local of its own.
+            continue;
+        }
+        if (sentence->type == VARIABLE_SENTENCE) {
+            tDeclarationKey key = { .name = sentence->variable->identifier };
+            if (!hashMapFind(assigned, &key, NULL)) {
+                hashMapInsertOrUpdate(assigned, &key, &key);
+                if (isNested && !_isDeclared(key.name)) {
+                    _declareHoisted(key.name, sentence->variable->dataType, sentence->variable->elementType);
+                }
+            }
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            if (sentence->block->type == BT_FOR) {
+                // The loop assigns its variable on every iteration, so it is always declared ahead.
+                Expression * variable = sentence->block->forBlock->left;
+                tDeclarationKey key = { .name = variable->variableCall->variableName };
+                if (!hashMapFind(assigned, &key, NULL)) {
+                    hashMapInsertOrUpdate(assigned, &key, &key);
+                    if (!_isDeclared(key.name)) {
+                        _declareHoisted(key.name, variable->dataType, variable->elementType);
+                    }
+                }
+            }
+            for (Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _hoistDeclarations(assigned, block->nextSentence, true);
+            }
+        }
+    }
+}
+
+/**
+ * Resets the declared locals for a new Java method, with its parameters
+ * already declared.
+ */
+static void _beginMethod(Parameters * parameters, Sentence * body) {
+    if (_declared != NULL) {
+        hashMapDestroy(_declared);
+    }
+    _declared = hashMapInit(sizeof(tDeclarationKey), sizeof(tDeclarationKey), hashMapStringHash, hashMapStringKeyEquals);
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        _markDeclared(parameters->leftExpression->variableCall->variableName);
+    }
+    if (_constants != NULL) {
+        int count = 0;
+        tDeclarationKey ** constants = (tDeclarationKey **) hashMapValues(_constants, &count);
+        for (int k = 0; k < count; ++k) {
+            _markDeclared(constants[k]->name);
+        }
+        free(constants);
+    }
+    _methodBody = body;
+    hashMapADT assigned = hashMapInit(sizeof(tDeclarationKey), sizeof(tDeclarationKey), hashMapStringHash, hashMapStringKeyEquals);
+    // Fields outlive the chunk that assigns them first, so every one of them is declared ahead.
+    _hoistDeclarations(assigned, body, _hoistsFields);
+    hashMapDestroy(assigned);
+}
+
+static boolean _isEndlessLoop(const Block * block) {
+    return block->type == BT_WHILE
+        && block->whileBlock->expression->type == CONSTANT_EXPRESSION
+        && block->whileBlock->expression->constant->type == CT_BOOLEAN
+        && block->whileBlock->expression->constant->boolean == true;
+}
+
+/**
+ * Whether, under Java's reachability rules, the execution can fall off the
+ * end of the sentences: only a return, an endless loop or a conditional with
+ * an else where no branch falls off prevent it.
+ */
+static boolean _completesNormally(const Sentence * sentence) {
+    if (sentence == NULL) {
+        return true;
+    }
+    while (sentence->nextSentence != NULL) {
+        sentence = sentence->nextSentence;
+    }
+    if (sentence->type == RETURN_SENTENCE) {
+        return false;
+    }
+    if (sentence->type != BLOCK_SENTENCE) {
+        return true;
+    }
+    const Block * block = sentence->block;
+    switch (block->type) {
+        case BT_WHILE:
+            return !_isEndlessLoop(block);
+        case BT_CONDITIONAL:
+            for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                if (_completesNormally(block->nextSentence)) {
+                    return true;
+                }
+                if (block->conditional->type == CB_ELSE) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Outputs a floating point literal that reads back as the same double, and
+ * that Java does not mistake for an integer.
+ */
+static void _outputDecimal(const double value) {
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%.15g", value);
+    if (strtod(buffer, NULL) != value) {
+        snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    if (strpbrk(buffer, ".e") == NULL) {
+        strcat(buffer, ".0");
+    }
+    _output("%s", buffer);
+}
+
+static boolean _isIntegral(const SaDataType type) {
+    return type == SA_INTEGER || type == SA_LONG;
+}
+
 FILE * file = NULL;
 FILE * write = NULL;
 
@@ -48,10 +457,13 @@ void generateConstant(Constant * constant){
             _output( (constant->boolean == true )? "true" : "false" );
             return;
         case CT_INTEGER:
-            _output("%d", constant->integer);
+            _output("%lld", constant->integer);
+            if (constant->integer < INT32_MIN || INT32_MAX < constant->integer) {
+                _output("L");
+            }
             return;
         case CT_FLOAT:
-            _output("%g", constant->decimal);
+            _outputDecimal(constant->decimal);
             return;
         case CT_STRING:
             _output("%s", constant->string);
@@ -61,359 +473,3269 @@ void generateConstant(Constant * constant){
     }
 }
 
-void generateExpression(Expression * expression) {
-    if (expression == NULL) {
-        return;
-    }
-     switch (expression->type) {
+/* ARITHMETIC LOWERING */
+
+static boolean _isIntegerConstant(const Expression * expression) {
+    return expression->type == CONSTANT_EXPRESSION && expression->constant->type == CT_INTEGER;
+}
+
+/**
+ * Whether an operand must be parenthesized to keep the grouping of the AST,
+ * as Java precedences differ from Python ones.
+ */
+static boolean _isCompound(const Expression * expression) {
+    switch (expression->type) {
         case CONSTANT_EXPRESSION:
-            generateConstant(expression->constant);
-                break;
+        case VARIABLE_CALL_EXPRESSION:
+        case FUNCTION_CALL_EXPRESSION:
+        case METHOD_CALL_EXPRESSION:
+        case FIELD_GETTER_EXPRESSION:
+            return false;
         case ADDITION:
-            generateExpression(expression->leftExpression);
-            _output(" + ");
-            generateExpression(expression->rightExpression);
-                break;
-        case MULTIPLICATION:
-            generateExpression(expression->leftExpression);
-            _output(" * ");
-            generateExpression(expression->rightExpression);
-                break;
         case SUBTRACTION:
-            generateExpression(expression->leftExpression);
-            _output(" - ");
-            generateExpression(expression->rightExpression);
-                break;
-        case DIVISION:
-            generateExpression(expression->leftExpression);
-            _output(" / ");
-            generateExpression(expression->rightExpression);
-                break;
+        case MULTIPLICATION:
+            // Checked operations are already calls.
+            return !expression->mayOverflow && expression->dataType != SA_BIG_INTEGER;
         case TRUNCATED_DIVISION:
-            generateExpression(expression->leftExpression);
-            _output(" // ");
-            generateExpression(expression->rightExpression);
-                break;
         case MODULO:
-            generateExpression(expression->leftExpression);
-            _output(" \% ");
-            generateExpression(expression->rightExpression);
-                break;
         case EXPONENTIATION:
-            generateExpression(expression->leftExpression);
-            _output(" ** ");
-            generateExpression(expression->rightExpression);
-                break;
-        case LOGIC_AND:
-            generateExpression(expression->leftExpression);
-            _output(" && ");
-            generateExpression(expression->rightExpression);
-            break;
-        case LOGIC_OR:
-            generateExpression(expression->leftExpression);
-            _output(" || ");
-            generateExpression(expression->rightExpression);
-            break;
-        case LOGIC_NOT:
-            _output("! ");
-            generateExpression(expression);
-                break;
-        case COMPARISON_EXPRESSION:
-            switch (expression->compType) {
-                case BCT_EQU:
-                generateExpression(expression->leftExpression);
-                _output(" == ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_NEQ:
-                generateExpression(expression->leftExpression);
-                _output(" != ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_GT:
-                generateExpression(expression->leftExpression);
-                _output(" > ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_GTE:
-                generateExpression(expression->leftExpression);
-                _output(" >= ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_LT:
-                generateExpression(expression->leftExpression);
-                _output(" < ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_LTE:
-                generateExpression(expression->leftExpression);
-                _output(" <= ");
-                generateExpression(expression->rightExpression);
-                break;
-                case BCT_MEMBER:
-                generateExpression(expression->rightExpression);
-                _output(".contains(");
-                generateExpression(expression->rightExpression);
-                _output(")");
-                break;
-                case BCT_NMEMBER:
-                    _output("!");
-                    generateExpression(expression->rightExpression);
-                    _output(".contains(");
-                    generateExpression(expression->rightExpression);
-                    _output(")");
-                    break;
-                case BCT_IDENTITY:
-                case BCT_NIDENTITY:
-                break;
-
-            }
-        case MEMBERSHIP:
-        case NOT_MEMBERSHIP:
-        case BIT_ARITHMETIC_AND:
-        case BIT_ARITHMETIC_OR:
-        case BIT_ARITHMETIC_XOR:
-        case BIT_ARITHMETIC_NOT:
-        case BIT_ARITHMETIC_LEFT_SHIFT:
-        case BIT_ARITHMETIC_RIGHT_SHIFT:
-            return;
-        case ASSIGNMENT:
-        case ADDITION_ASSIGNMENT:
-        case DIVISION_ASSIGNMENT:
-        case MULTIPLICATION_ASSIGNMENT:
-        case SUBTRACTION_ASSIGNMENT:
-        case EXPONENTIATION_ASSIGNMENT:
-        case TRUNCATED_DIVISION_ASSIGNMENT:
-        case MODULO_ASSIGNMENT:
-        case BITWISE_AND_ASSIGNMENT:
-        case BITWISE_OR_ASSIGNMENT:
-        case BITWISE_XOR_ASSIGNMENT:
-        case BITWISE_LEFT_SHIFT_ASSIGNMENT:
-        case BITWISE_RIGHT_SHIFT_ASSIGNMENT:
-        case RETURNED_ASSIGNMENT:
-        case IDENTITY:
-        case VARIABLE_CALL_EXPRESSION:
-            generateVariableCall(expression->variableCall);
-            break;
-        case FUNCTION_CALL_EXPRESSION:
-            generateFunctionCall(expression->functionCall);
-            break;
-        case METHOD_CALL_EXPRESSION:
-        case FIELD_GETTER_EXPRESSION:
+            // And so are the ones on big integers.
+            return expression->dataType != SA_BIG_INTEGER;
         default:
-            return;
+            return true;
     }
 }
 
-void generateVariableCall(VariableCall * variableCall) {
-    if (variableCall == NULL) {
-        return;
+static void _generateOperand(Expression * expression) {
+    if (_isCompound(expression)) {
+        _output("(");
+        generateExpression(expression);
+        _output(")");
+    } else {
+        generateExpression(expression);
     }
-    _output(variableCall->variableName);
 }
 
-void generateFunctionCall(FunctionCall * functionCall){
-    if (functionCall == NULL) {
-        return;
-    }
-    _output(functionCall->functionName);
-    _output("(");
-    if (functionCall->functionArguments == NULL){
+/**
+ * Outputs an operand of a numeric operation, where Python booleans count as
+ * integers but Java ones do not, and big integers convert from and to the
+ * primitives explicitly.
+ */
+static void _generateNumericOperand(Expression * expression, const SaDataType resultType) {
+    boolean isNumericResult = resultType == SA_INTEGER || resultType == SA_LONG || resultType == SA_FLOAT;
+    if (resultType == SA_BIG_INTEGER && _isIntegerConstant(expression) && (expression->constant->integer == 0 || expression->constant->integer == 1)) {
+        _output((expression->constant->integer == 0)? "java.math.BigInteger.ZERO" : "java.math.BigInteger.ONE");
+    } else if (resultType == SA_BIG_INTEGER && expression->dataType != SA_BIG_INTEGER) {
+        _output("java.math.BigInteger.valueOf(");
+        if (expression->dataType == SA_BOOLEAN) {
+            _generateNumericOperand(expression, SA_LONG);
+        } else {
+            generateExpression(expression);
+        }
         _output(")");
-        return;
+    } else if (isNumericResult && expression->dataType == SA_BIG_INTEGER) {
+        _generateOperand(expression);
+        _output((resultType == SA_FLOAT)? ".doubleValue()" : (resultType == SA_LONG)? ".longValueExact()" : ".intValueExact()");
+    } else if (isNumericResult && expression->dataType == SA_BOOLEAN) {
+        _output("(");
+        _generateOperand(expression);
+        _output("? 1 : 0)");
+    } else {
+        _generateOperand(expression);
     }
-    while (functionCall->functionArguments->leftExpression != NULL){
-        generateExpression(functionCall->functionArguments->leftExpression);
+}
 
-        if(functionCall->functionArguments->rightParameters != NULL){
-            _output(", ");
-        }
-        else{
-            break;
-        }
-        functionCall->functionArguments = functionCall->functionArguments->rightParameters;
+/**
+ * Outputs a character as a string, since Java adds two chars as numbers
+ * where Python joins them.
+ */
+static void _generateCharacterAsString(Expression * expression) {
+    _output("String.valueOf(");
+    generateExpression(expression);
+    _output(")");
+}
+
+/**
+ * Outputs a value for a symbol of the given type, converting integers from
+ * and to big integers, which Java does not do on its own.
+ */
+static void _generateStored(Expression * expression, const SaDataType type) {
+    if (expression->dataType != type && (type == SA_BIG_INTEGER || expression->dataType == SA_BIG_INTEGER)) {
+        _generateNumericOperand(expression, type);
+    } else {
+        generateExpression(expression);
+    }
+}
+
+/**
+ * Outputs an operation on big integers as a call to the method of the left
+ * operand, or to a helper if there is none with Python semantics.
+ */
+static void _generateBigArithmetic(Expression * expression, const char * method) {
+    if (method[0] == '$') {
+        _output("%s(", method);
+        _generateNumericOperand(expression->leftExpression, SA_BIG_INTEGER);
+        _output(", ");
+    } else {
+        _generateNumericOperand(expression->leftExpression, SA_BIG_INTEGER);
+        _output(".%s(", method);
     }
+    _generateNumericOperand(expression->rightExpression, SA_BIG_INTEGER);
     _output(")");
 }
 
-void generateVariable(Variable * variable) {
-    if (variable == NULL) {
+/**
+ * Outputs an addition, subtraction or multiplication. A long result of
+ * narrower operands widens the first one before operating, and a result that
+ * may not even fit in a long fails on overflow instead of wrapping around.
+ * A concatenation that starts with a character makes it a string first.
+ */
+static void _generateArithmetic(Expression * expression, const char * operator, const char * exactMethod) {
+    const SaDataType type = expression->dataType;
+    if (type == SA_BIG_INTEGER) {
+        _generateBigArithmetic(expression, (operator[0] == '+')? "add" : (operator[0] == '-')? "subtract" : "multiply");
         return;
     }
-    struct value value;
-    struct key key;
-    bool declared = isDeclared(variable->identifier);
-    bool inferType = false;
-    if (variable->expression->type == FUNCTION_CALL_EXPRESSION){
-        inferType = true;
-        key.varname = variable->expression->functionCall->functionName;
-    } else
-        key.varname = variable->identifier;
-    if (!declared) {
-        symbolTableFind(&key, &value);
-        switch (value.type) {
-            case SA_BOOLEAN:
-                _output("boolean  ");
-                break;
-            case SA_FLOAT:
-                _output("double  ");
+    const boolean isWidened = type == SA_LONG
+        && expression->leftExpression->dataType != SA_LONG && expression->rightExpression->dataType != SA_LONG;
+    if (expression->mayOverflow) {
+        _output("%s(", exactMethod);
+    }
+    if (isWidened) {
+        _output("(long) ");
+    }
+    if (type == SA_STRING && expression->leftExpression->dataType == SA_CHARACTER) {
+        _generateCharacterAsString(expression->leftExpression);
+    } else {
+        _generateNumericOperand(expression->leftExpression, type);
+    }
+    _output(expression->mayOverflow? ", " : " %s ", operator);
+    _generateNumericOperand(expression->rightExpression, type);
+    if (expression->mayOverflow) {
+        _output(")");
+    }
+}
+
+/**
+ * Returns k if the expression is the integer constant 2^k, for a positive k,
+ * or zero otherwise.
+ */
+static int _powerOfTwoExponent(const Expression * expression) {
+    if (!_isIntegerConstant(expression) || expression->constant->integer <= 1) {
+        return 0;
+    }
+    long long value = expression->constant->integer;
+    if ((value & (value - 1)) != 0) {
+        return 0;
+    }
+    int exponent = 0;
+    for (; value > 1; value >>= 1) {
+        ++exponent;
+    }
+    return exponent;
+}
+
+/**
+ * Whether a shift or mask of k bits is exact on the dividend, which needs a
+ * long once k exceeds the bits of an int.
+ */
+static boolean _isShiftable(const Expression * dividend, const int bits) {
+    return bits > 0 && (bits < 31 || dividend->dataType == SA_LONG);
+}
+
+/**
+ * Python floors integer divisions where Java truncates them. Flooring by a
+ * power of two is exactly an arithmetic shift, for dividends of any sign.
+ * The smallest int divided by -1 needs a long result, and the smallest long
+ * divided by -1 fails, as no long can hold it.
+ */
+static void _generateFloorDivision(Expression * expression) {
+    Expression * left = expression->leftExpression;
+    Expression * right = expression->rightExpression;
+    if (expression->dataType == SA_BIG_INTEGER) {
+        _usesBigDivision = true;
+        _generateBigArithmetic(expression, "$floorDiv");
+        return;
+    }
+    if (_isIntegral(expression->dataType)) {
+        const int bits = _powerOfTwoExponent(right);
+        if (_isShiftable(left, bits)) {
+            _generateNumericOperand(left, expression->dataType);
+            _output(" >> %d", bits);
+            return;
+        }
+        if (expression->mayOverflow) {
+            _usesExactFloorDivision = true;
+        }
+        _output(expression->mayOverflow? "$floorDivExact(" : "Math.floorDiv(");
+        if (expression->dataType == SA_LONG && left->dataType != SA_LONG && right->dataType != SA_LONG) {
+            _output("(long) ");
+        }
+        _generateNumericOperand(left, expression->dataType);
+        _output(", ");
+        _generateNumericOperand(right, expression->dataType);
+        _output(")");
+        return;
+    }
+    _output("Math.floor(");
+    _generateNumericOperand(left, SA_FLOAT);
+    _output(" / ");
+    _generateNumericOperand(right, SA_FLOAT);
+    _output(")");
+}
+
+/**
+ * Python modulos take the sign of the divisor where Java ones take the sign
+ * of the dividend. Modulo by a power of two is exactly a mask, for dividends
+ * of any sign.
+ */
+static void _generateModulo(Expression * expression) {
+    Expression * left = expression->leftExpression;
+    Expression * right = expression->rightExpression;
+    if (expression->dataType == SA_BIG_INTEGER) {
+        _usesBigDivision = true;
+        _generateBigArithmetic(expression, "$floorMod");
+        return;
+    }
+    if (_isIntegral(expression->dataType)) {
+        const int bits = _powerOfTwoExponent(right);
+        if (_isShiftable(left, bits)) {
+            const long long mask = right->constant->integer - 1;
+            _generateNumericOperand(left, expression->dataType);
+            _output((mask > INT32_MAX)? " & %lldL" : " & %lld", mask);
+            return;
+        }
+        _output("Math.floorMod(");
+        _generateNumericOperand(left, expression->dataType);
+        _output(", ");
+        _generateNumericOperand(right, expression->dataType);
+        _output(")");
+        return;
+    }
+    if (expression->dataType == SA_FLOAT) {
+        _usesFloorModulo = true;
+        _output("$floorMod(");
+        _generateNumericOperand(left, SA_FLOAT);
+        _output(", ");
+        _generateNumericOperand(right, SA_FLOAT);
+        _output(")");
+        return;
+    }
+    _generateOperand(left);
+    _output(" %% ");
+    _generateOperand(right);
+}
+
+/**
+ * Small constant powers of simple bases become multiplications, square roots
+ * use Math.sqrt, and integer powers, whose exponent is always a non-negative
+ * literal, are computed by squaring to stay exact.
+ */
+static void _generatePower(Expression * expression) {
+    Expression * base = expression->leftExpression;
+    Expression * exponent = expression->rightExpression;
+    if (expression->dataType == SA_BIG_INTEGER) {
+        _generateNumericOperand(base, SA_BIG_INTEGER);
+        _output(".pow(%lld)", exponent->constant->integer);
+        return;
+    }
+    if (exponent->type == CONSTANT_EXPRESSION && exponent->constant->type == CT_FLOAT && exponent->constant->decimal == 0.5) {
+        _output("Math.sqrt(");
+        _generateNumericOperand(base, SA_FLOAT);
+        _output(")");
+        return;
+    }
+    if (_isIntegerConstant(exponent) && _isSimpleOperand(base) && !expression->mayOverflow
+            && 0 <= exponent->constant->integer && exponent->constant->integer <= MAXIMUM_UNROLLED_EXPONENT) {
+        const long long times = exponent->constant->integer;
+        if (times == 0) {
+            _output((expression->dataType == SA_FLOAT)? "1.0" : (expression->dataType == SA_LONG)? "1L" : "1");
+            return;
+        }
+        _output("(");
+        for (long long i = 0; i < times; ++i) {
+            _output((i == 0)? "" : " * ");
+            if (i == 0 && expression->dataType == SA_LONG && base->dataType != SA_LONG) {
+                _output("(long) ");
+            }
+            _generateNumericOperand(base, expression->dataType);
+        }
+        _output(")");
+        return;
+    }
+    if (_isIntegral(expression->dataType)) {
+        const boolean isLong = expression->dataType == SA_LONG;
+        if (expression->mayOverflow) {
+            _usesExactPower = true;
+            _output("$exactPower(");
+            _generateNumericOperand(base, expression->dataType);
+            _output(", ");
+            _generateNumericOperand(exponent, expression->dataType);
+            _output(")");
+            return;
+        }
+        _usesLongPower = _usesLongPower || isLong;
+        _usesIntegerPower = _usesIntegerPower || !isLong;
+        _output(isLong? "$power((long) " : "$power(");
+        _generateNumericOperand(base, expression->dataType);
+        _output(isLong? ", (long) " : ", ");
+        _generateNumericOperand(exponent, expression->dataType);
+        _output(")");
+        return;
+    }
+    _output("Math.pow(");
+    _generateNumericOperand(base, SA_FLOAT);
+    _output(", ");
+    _generateNumericOperand(exponent, SA_FLOAT);
+    _output(")");
+}
+
+/**
+ * Outputs an open-addressing table from packed primitive arguments to the
+ * bits of a primitive result, whose keys take one long or, if wide, two.
+ */
+static void _generateMemoClass(const boolean isWide) {
+    const char * parameters = isWide? "long key, long highKey" : "long key";
+    const char * arguments = isWide? "key, highKey" : "key";
+    _output("\tprivate static final class %s {\n", isWide? "$WideMemo" : "$Memo");
+    _output("\t\tlong[] keys = new long[16];\n");
+    if (isWide) {
+        _output("\t\tlong[] highKeys = new long[16];\n");
+    }
+    _output("\t\tlong[] values = new long[16];\n\t\tboolean[] used = new boolean[16];\n");
+    _output("\t\tint size = 0;\n\t\tlong hits = 0;\n\t\tlong misses = 0;\n");
+    _output("\t\tint slot(%s) {\n", parameters);
+    _output("\t\t\tint mask = keys.length - 1;\n");
+    if (isWide) {
+        _output("\t\t\tint slot = (int) (((key + highKey * 0xC2B2AE3D27D4EB4FL) * 0x9E3779B97F4A7C15L) >>> 32) & mask;\n");
+        _output("\t\t\twhile (used[slot] && (keys[slot] != key || highKeys[slot] != highKey)) {\n");
+    } else {
+        _output("\t\t\tint slot = (int) ((key * 0x9E3779B97F4A7C15L) >>> 32) & mask;\n");
+        _output("\t\t\twhile (used[slot] && keys[slot] != key) {\n");
+    }
+    _output("\t\t\t\tslot = (slot + 1) & mask;\n\t\t\t}\n");
+    _output("\t\t\treturn slot;\n\t\t}\n");
+    _output("\t\tint find(%s) {\n", parameters);
+    _output("\t\t\tint slot = slot(%s);\n", arguments);
+    _output("\t\t\tif (used[slot]) {\n\t\t\t\thits++;\n\t\t\t\treturn slot;\n\t\t\t}\n");
+    _output("\t\t\tmisses++;\n\t\t\treturn -1;\n\t\t}\n");
+    _output("\t\tvoid put(%s, long value) {\n", parameters);
+    _output("\t\t\tif (2 * (size + 1) > keys.length) {\n");
+    _output("\t\t\t\tlong[] oldKeys = keys;\n");
+    if (isWide) {
+        _output("\t\t\t\tlong[] oldHighKeys = highKeys;\n");
+    }
+    _output("\t\t\t\tlong[] oldValues = values;\n\t\t\t\tboolean[] oldUsed = used;\n");
+    _output("\t\t\t\tkeys = new long[2 * oldKeys.length];\n");
+    if (isWide) {
+        _output("\t\t\t\thighKeys = new long[2 * oldKeys.length];\n");
+    }
+    _output("\t\t\t\tvalues = new long[2 * oldKeys.length];\n\t\t\t\tused = new boolean[2 * oldKeys.length];\n");
+    _output("\t\t\t\tfor (int i = 0; i < oldKeys.length; i++) {\n");
+    _output("\t\t\t\t\tif (oldUsed[i]) {\n");
+    _output("\t\t\t\t\t\tint slot = slot(%s);\n", isWide? "oldKeys[i], oldHighKeys[i]" : "oldKeys[i]");
+    _output("\t\t\t\t\t\tused[slot] = true;\n\t\t\t\t\t\tkeys[slot] = oldKeys[i];\n");
+    if (isWide) {
+        _output("\t\t\t\t\t\thighKeys[slot] = oldHighKeys[i];\n");
+    }
+    _output("\t\t\t\t\t\tvalues[slot] = oldValues[i];\n");
+    _output("\t\t\t\t\t}\n\t\t\t\t}\n\t\t\t}\n");
+    _output("\t\t\tint slot = slot(%s);\n", arguments);
+    _output("\t\t\tif (!used[slot]) {\n\t\t\t\tused[slot] = true;\n\t\t\t\tkeys[slot] = key;\n");
+    if (isWide) {
+        _output("\t\t\t\thighKeys[slot] = highKey;\n");
+    }
+    _output("\t\t\t\tsize++;\n\t\t\t}\n");
+    _output("\t\t\tvalues[slot] = value;\n\t\t}\n\t}\n");
+}
+
+/**
+ * Outputs the helper methods used by the lowered operations.
+ */
+static void _generateHelpers() {
+    _generateMemberships();
+    if (_usesIntegerPower) {
+        _output("\tprivate static int $power(int base, int exponent) {\n");
+        _output("\t\tint result = 1;\n");
+        _output("\t\tfor (; exponent > 0; exponent >>= 1, base *= base) {\n");
+        _output("\t\t\tif ((exponent & 1) != 0) {\n\t\t\t\tresult *= base;\n\t\t\t}\n");
+        _output("\t\t}\n\t\treturn result;\n\t}\n");
+    }
+    if (_usesLongPower) {
+        _output("\tprivate static long $power(long base, long exponent) {\n");
+        _output("\t\tlong result = 1;\n");
+        _output("\t\tfor (; exponent > 0; exponent >>= 1, base *= base) {\n");
+        _output("\t\t\tif ((exponent & 1) != 0) {\n\t\t\t\tresult *= base;\n\t\t\t}\n");
+        _output("\t\t}\n\t\treturn result;\n\t}\n");
+    }
+    if (_usesExactPower) {
+        _output("\tprivate static long $exactPower(long base, long exponent) {\n");
+        _output("\t\tlong result = 1;\n");
+        _output("\t\tfor (; exponent > 0; exponent >>= 1) {\n");
+        _output("\t\t\tif ((exponent & 1) != 0) {\n\t\t\t\tresult = Math.multiplyExact(result, base);\n\t\t\t}\n");
+        _output("\t\t\tif (exponent > 1) {\n\t\t\t\tbase = Math.multiplyExact(base, base);\n\t\t\t}\n");
+        _output("\t\t}\n\t\treturn result;\n\t}\n");
+    }
+    if (_usesFloorModulo) {
+        _output("\tprivate static double $floorMod(double dividend, double divisor) {\n");
+        _output("\t\tdouble remainder = dividend %% divisor;\n");
+        _output("\t\treturn (remainder != 0 && (remainder < 0) != (divisor < 0))? remainder + divisor : remainder;\n");
+        _output("\t}\n");
+    }
+    if (_usesBigDivision) {
+        _output("\tprivate static java.math.BigInteger $floorDiv(java.math.BigInteger dividend, java.math.BigInteger divisor) {\n");
+        _output("\t\tjava.math.BigInteger[] division = dividend.divideAndRemainder(divisor);\n");
+        _output("\t\tboolean isFloored = division[1].signum() != 0 && division[1].signum() != divisor.signum();\n");
+        _output("\t\treturn isFloored? division[0].subtract(java.math.BigInteger.ONE) : division[0];\n");
+        _output("\t}\n");
+        _output("\tprivate static java.math.BigInteger $floorMod(java.math.BigInteger dividend, java.math.BigInteger divisor) {\n");
+        _output("\t\tjava.math.BigInteger remainder = dividend.remainder(divisor);\n");
+        _output("\t\treturn (remainder.signum() != 0 && remainder.signum() != divisor.signum())? remainder.add(divisor) : remainder;\n");
+        _output("\t}\n");
+    }
+    if (_usesExactFloorDivision) {
+        _output("\tprivate static long $floorDivExact(long dividend, long divisor) {\n");
+        _output("\t\tif (dividend == Long.MIN_VALUE && divisor == -1) {\n\t\t\tthrow new ArithmeticException(\"long overflow\");\n\t\t}\n");
+        _output("\t\treturn Math.floorDiv(dividend, divisor);\n");
+        _output("\t}\n");
+    }
+    if (_usesIntRange) {
+        // Short ranges stay sequential, as splitting them costs more than it saves.
+        _output("\tprivate static java.util.stream.IntStream $intRange(int start, int stop) {\n");
+        _output("\t\tjava.util.stream.IntStream range = java.util.stream.IntStream.range(start, stop);\n");
+        _output("\t\treturn ((long) stop - start >= %d)? range.parallel() : range;\n", _parallelThreshold);
+        _output("\t}\n");
+    }
+    if (_usesLongRange) {
+        _output("\tprivate static java.util.stream.LongStream $longRange(long start, long stop) {\n");
+        _output("\t\tjava.util.stream.LongStream range = java.util.stream.LongStream.range(start, stop);\n");
+        _output("\t\treturn (stop > start && stop - start >= %d)? range.parallel() : range;\n", _parallelThreshold);
+        _output("\t}\n");
+    }
+    if (_usesMemo) {
+        _generateMemoClass(false);
+    }
+    if (_usesWideMemo) {
+        _generateMemoClass(true);
+    }
+    if (_usesObjectMemo) {
+        _output("\tprivate static final class $ObjectMemo {\n");
+        _output("\t\tstatic final Object MISSING = new Object();\n");
+        _output("\t\tfinal java.util.HashMap<Object, Object> values = new java.util.HashMap<>();\n");
+        _output("\t\tlong hits = 0;\n\t\tlong misses = 0;\n");
+        _output("\t\tObject find(Object key) {\n");
+        _output("\t\t\tObject value = values.getOrDefault(key, MISSING);\n");
+        _output("\t\t\tif (value == MISSING) {\n\t\t\t\tmisses++;\n\t\t\t} else {\n\t\t\t\thits++;\n\t\t\t}\n");
+        _output("\t\t\treturn value;\n\t\t}\n\t}\n");
+    }
+    const char * containers[4][2] = { { "int[]", "double" }, { "long[]", "long" }, { "double[]", "double" }, { "Object[]", "Object" } };
+    const boolean isContainerUsed[4] = { _usesIntegerContains, _usesLongContains, _usesDecimalContains, _usesObjectContains };
+    for (int i = 0; i < 4; ++i) {
+        if (isContainerUsed[i]) {
+            _output("\tprivate static boolean $contains(%s values, %s value) {\n", containers[i][0], containers[i][1]);
+            _output("\t\tfor (int i = 0; i < values.length; i++) {\n");
+            _output(i == 3? "\t\t\tif (java.util.Objects.equals(values[i], value)) {\n" : "\t\t\tif (values[i] == value) {\n");
+            _output("\t\t\t\treturn true;\n\t\t\t}\n\t\t}\n\t\treturn false;\n\t}\n");
+        }
+    }
+}
+
+/**
+ * Outputs a list or tuple constant as an array of its element type.
+ */
+static void _generateCollection(Expression * expression) {
+    const List * collection = (expression->constant->type == CT_LIST)? expression->constant->list : expression->constant->tuple;
+    _output("new %s[]{", _javaType(expression->elementType));
+    for (Parameters * element = collection->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        _generateStored(element->leftExpression, expression->elementType);
+        if (element->rightParameters != NULL && element->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+    }
+    _output("}");
+}
+
+static void _outputCharacter(const char value) {
+    _output((value == '\'' || value == '\\')? "'\\%c'" : "'%c'", value);
+}
+
+static boolean _isSingleCharacterString(const Expression * expression) {
+    return expression->type == CONSTANT_EXPRESSION
+        && expression->constant->type == CT_STRING
+        && strlen(expression->constant->string) == 3;
+}
+
+/**
+ * Compares a big integer with a number through compareTo, or as doubles if
+ * the other one is a float. Returns false if the comparison involves no big
+ * integer.
+ */
+static boolean _generateBigComparison(Expression * expression, const char * operator) {
+    Expression * left = expression->leftExpression;
+    Expression * right = expression->rightExpression;
+    if (left->dataType != SA_BIG_INTEGER && right->dataType != SA_BIG_INTEGER) {
+        return false;
+    }
+    if (left->dataType == SA_FLOAT || right->dataType == SA_FLOAT) {
+        _generateNumericOperand(left, SA_FLOAT);
+        _output(" %s ", operator);
+        _generateNumericOperand(right, SA_FLOAT);
+        return true;
+    }
+    _generateNumericOperand(left, SA_BIG_INTEGER);
+    _output(".compareTo(");
+    _generateNumericOperand(right, SA_BIG_INTEGER);
+    _output(") %s 0", operator);
+    return true;
+}
+
+/**
+ * Compares a character, as produced by iterating over a string, with a
+ * string. Single character literals become char literals, so the comparison
+ * stays primitive. Returns false if the comparison involves no character.
+ */
+static boolean _generateCharacterEquality(Expression * expression, const char * operator) {
+    Expression * left = expression->leftExpression;
+    Expression * right = expression->rightExpression;
+    if (left->dataType != SA_CHARACTER && right->dataType != SA_CHARACTER) {
+        return false;
+    }
+    Expression * character = (left->dataType == SA_CHARACTER)? left : right;
+    Expression * other = (character == left)? right : left;
+    if (other->dataType == SA_CHARACTER) {
+        return false;
+    }
+    if (_isSingleCharacterString(other)) {
+        generateExpression(character);
+        _output(" %s ", operator);
+        _outputCharacter(other->constant->string[1]);
+        return true;
+    }
+    _output(operator[0] == '!'? "!String.valueOf(" : "String.valueOf(");
+    generateExpression(character);
+    _output(").equals(");
+    generateExpression(other);
+    _output(")");
+    return true;
+}
+
+/* MEMBERSHIP LOWERING */
+
+/**
+ * Whether the expression is a list or tuple literal made only of scalar
+ * literals, so its elements are known at compile time.
+ */
+static boolean _isConstantCollection(const Expression * expression) {
+    if (expression->type != CONSTANT_EXPRESSION || (expression->constant->type != CT_LIST && expression->constant->type != CT_TUPLE)) {
+        return false;
+    }
+    if (expression->constant->list->type == LT_TYPED_LIST) {
+        return false;
+    }
+    for (Parameters * element = expression->constant->list->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        const Expression * value = element->leftExpression;
+        if (value->type != CONSTANT_EXPRESSION || value->constant->type == CT_LIST || value->constant->type == CT_TUPLE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Parameters * _elementsOf(const Expression * collection) {
+    return (collection->constant->list->type == LT_PARAMETRIZED_LIST)? collection->constant->list->elements : NULL;
+}
+
+/**
+ * Whether every element of a constant collection is a literal of the type.
+ */
+static boolean _areAllConstants(const Expression * collection, const ConstantType type) {
+    for (Parameters * element = _elementsOf(collection); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        if (element->leftExpression->constant->type != type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static boolean _isPlainString(const char * literal) {
+    return strchr(literal, '\\') == NULL;
+}
+
+/**
+ * Whether every element is a string literal without escapes, so that the
+ * single character ones can be compared as char literals.
+ */
+static boolean _areAllPlainStrings(const Expression * collection) {
+    for (Parameters * element = _elementsOf(collection); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        if (element->leftExpression->constant->type != CT_STRING || !_isPlainString(element->leftExpression->constant->string)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The bits set by integer literals in [0, 63], or 0 if any literal is
+ * outside of that interval.
+ */
+static uint64_t _bitmaskOf(const Expression * collection) {
+    uint64_t mask = 0;
+    for (Parameters * element = _elementsOf(collection); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        const long long value = element->leftExpression->constant->integer;
+        if (value < 0 || MAXIMUM_BITMASK_ELEMENT < value) {
+            return 0;
+        }
+        mask |= (uint64_t) 1 << value;
+    }
+    return mask;
+}
+
+static void _registerMembership(Expression * membership, const tMembershipKind kind) {
+    _memberships = realloc(_memberships, (_membershipCount + 1) * sizeof(tMembership));
+    _memberships[_membershipCount++] = (tMembership) { .membership = membership, .kind = kind };
+}
+
+/**
+ * Whether a membership test against a literal collection is lowered to a
+ * lookup in a constant hash set, rather than to a bitmask or a switch.
+ */
+static boolean _isSetMembership(const Expression * membership) {
+    const Expression * value = membership->leftExpression;
+    const Expression * collection = membership->rightExpression;
+    if (collection->dataType == SA_STRING || !_isConstantCollection(collection)) {
+        return false;
+    }
+    const boolean isIntegerSet = _elementsOf(collection) != NULL && _areAllConstants(collection, CT_INTEGER);
+    if (isIntegerSet && _bitmaskOf(collection) != 0 && _isIntegral(value->dataType) && _isSimpleOperand(value)) {
+        return false;
+    }
+    const boolean isSwitchable = (value->dataType == SA_INTEGER && isIntegerSet)
+        || ((value->dataType == SA_CHARACTER || value->dataType == SA_STRING) && _elementsOf(collection) != NULL && _areAllPlainStrings(collection));
+    return !isSwitchable;
+}
+
+/**
+ * The Java type of the values a constant set holds, which is wide enough
+ * for both its literals and the searched value, so that boxing never makes
+ * an Integer differ from an equal Long.
+ */
+static SaDataType _setElementType(const Expression * membership) {
+    const Expression * collection = membership->rightExpression;
+    const Expression * value = membership->leftExpression;
+    if (_elementsOf(collection) == NULL) {
+        return SA_OBJECT;
+    }
+    if (_areAllConstants(collection, CT_STRING)) {
+        return SA_STRING;
+    }
+    SaDataType type = value->dataType;
+    if (type != SA_INTEGER && type != SA_LONG && type != SA_FLOAT) {
+        return SA_OBJECT;
+    }
+    for (Parameters * element = _elementsOf(collection); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        const Expression * literal = element->leftExpression;
+        if (literal->constant->type != CT_INTEGER && literal->constant->type != CT_FLOAT) {
+            return SA_OBJECT;
+        }
+        type = joinDataTypes(type, literal->dataType);
+    }
+    return type;
+}
+
+static const char * _boxedType(const SaDataType type) {
+    switch (type) {
+        case SA_INTEGER:
+            return "Integer";
+        case SA_LONG:
+            return "Long";
+        case SA_FLOAT:
+            return "Double";
+        case SA_STRING:
+            return "String";
+        default:
+            return "Object";
+    }
+}
+
+/**
+ * Outputs a scalar literal as a value of the given type.
+ */
+static void _generateLiteralAs(Constant * constant, const SaDataType type) {
+    if (constant->type == CT_INTEGER && type == SA_LONG) {
+        _output("%lldL", constant->integer);
+    } else if (constant->type == CT_INTEGER && type == SA_FLOAT) {
+        _outputDecimal((double) constant->integer);
+    } else {
+        generateConstant(constant);
+    }
+}
+
+/**
+ * Searches an array with a linear scan, as its contents are only known at
+ * runtime.
+ */
+static void _generateArrayMembership(Expression * value, Expression * collection) {
+    switch (collection->elementType) {
+        case SA_INTEGER:
+            _usesIntegerContains = true;
+            break;
+        case SA_LONG:
+            _usesLongContains = true;
+            break;
+        case SA_FLOAT:
+            _usesDecimalContains = true;
+            break;
+        default:
+            _usesObjectContains = true;
+            break;
+    }
+    _output("$contains(");
+    generateExpression(collection);
+    _output(", ");
+    generateExpression(value);
+    _output(")");
+}
+
+/**
+ * Lowers "value in collection". Literal collections are never built: small
+ * integer sets become a bitmask test, integer, character and string sets a
+ * switch in a helper method, and any other literal a constant hash set.
+ * Strings are searched for a substring, as in Python.
+ */
+static void _generateMembership(Expression * membership) {
+    Expression * value = membership->leftExpression;
+    Expression * collection = membership->rightExpression;
+    if (collection->dataType == SA_STRING) {
+        if (value->dataType == SA_CHARACTER && collection->type == CONSTANT_EXPRESSION && _isPlainString(collection->constant->string)) {
+            _registerMembership(membership, MK_SWITCH);
+            _output("$member%d(", _membershipCount - 1);
+            generateExpression(value);
+            _output(")");
+        } else if (value->dataType == SA_CHARACTER) {
+            _output("(");
+            _generateOperand(collection);
+            _output(".indexOf(");
+            generateExpression(value);
+            _output(") >= 0)");
+        } else if (value->dataType == SA_STRING) {
+            _generateOperand(collection);
+            _output(".contains(");
+            generateExpression(value);
+            _output(")");
+        } else {
+            _generateOperand(collection);
+            _output(".contains(String.valueOf(");
+            generateExpression(value);
+            _output("))");
+        }
+        return;
+    }
+    if (!_isConstantCollection(collection)) {
+        if (collection->dataType == SA_LIST || collection->dataType == SA_TUPLE) {
+            _generateArrayMembership(value, collection);
+            return;
+        }
+        _generateOperand(collection);
+        _output(".contains(");
+        generateExpression(value);
+        _output(")");
+        return;
+    }
+    const boolean isIntegerSet = _elementsOf(collection) != NULL && _areAllConstants(collection, CT_INTEGER);
+    const uint64_t mask = isIntegerSet? _bitmaskOf(collection) : 0;
+    if (mask != 0 && _isIntegral(value->dataType) && _isSimpleOperand(value)) {
+        _output("(");
+        generateExpression(value);
+        _output(" >= 0 && ");
+        generateExpression(value);
+        _output(" <= %d && ((0x%llxL >>> ", MAXIMUM_BITMASK_ELEMENT, (unsigned long long) mask);
+        generateExpression(value);
+        _output(") & 1L) != 0)");
+        return;
+    }
+    if (!_isSetMembership(membership)) {
+        _registerMembership(membership, MK_SWITCH);
+        _output("$member%d(", _membershipCount - 1);
+        generateExpression(value);
+        _output(")");
+        return;
+    }
+    _registerMembership(membership, MK_SET);
+    _output("$members%d.contains(", _membershipCount - 1);
+    const SaDataType elementType = _setElementType(membership);
+    if (value->dataType == SA_CHARACTER) {
+        _output("String.valueOf(");
+        generateExpression(value);
+        _output(")");
+    } else if (value->dataType != elementType && (elementType == SA_LONG || elementType == SA_FLOAT)) {
+        _output("(%s) ", _javaType(elementType));
+        _generateOperand(value);
+    } else {
+        generateExpression(value);
+    }
+    _output(")");
+}
+
+/**
+ * Outputs the case labels of a switch helper, skipping duplicates, which
+ * Java rejects, and literals the searched value can never be equal to.
+ */
+static void _generateSwitchCases(const tMembership * membership) {
+    const Expression * value = membership->membership->leftExpression;
+    const Expression * collection = membership->membership->rightExpression;
+    if (collection->dataType == SA_STRING) {
+        const char * literal = collection->constant->string;
+        const size_t length = strlen(literal);
+        for (size_t i = 1; i + 1 < length; ++i) {
+            if (memchr(literal + 1, literal[i], i - 1) == NULL) {
+                _output("\t\t\tcase ");
+                _outputCharacter(literal[i]);
+                _output(":\n");
+            }
+        }
+        return;
+    }
+    Parameters * first = _elementsOf(collection);
+    for (Parameters * element = first; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        const Constant * constant = element->leftExpression->constant;
+        boolean isDuplicate = false;
+        for (Parameters * previous = first; previous != element && !isDuplicate; previous = previous->rightParameters) {
+            isDuplicate = (constant->type == CT_INTEGER)
+                ? previous->leftExpression->constant->integer == constant->integer
+                : strcmp(previous->leftExpression->constant->string, constant->string) == 0;
+        }
+        if (isDuplicate) {
+            continue;
+        }
+        if (constant->type == CT_INTEGER && INT32_MIN <= constant->integer && constant->integer <= INT32_MAX) {
+            _output("\t\t\tcase %lld:\n", constant->integer);
+        } else if (value->dataType == SA_CHARACTER && strlen(constant->string) == 3) {
+            _output("\t\t\tcase ");
+            _outputCharacter(constant->string[1]);
+            _output(":\n");
+        } else if (value->dataType == SA_STRING) {
+            _output("\t\t\tcase %s:\n", constant->string);
+        }
+    }
+}
+
+/**
+ * Outputs the helper methods and constant sets of the membership tests
+ * against literals.
+ */
+static void _generateMemberships() {
+    for (int i = 0; i < _membershipCount; ++i) {
+        const Expression * collection = _memberships[i].membership->rightExpression;
+        if (_memberships[i].kind == MK_SET) {
+            const SaDataType type = _setElementType(_memberships[i].membership);
+            _output("\tprivate static final java.util.Set<%s> $members%d = new java.util.HashSet<>(java.util.Arrays.<%s>asList(", _boxedType(type), i, _boxedType(type));
+            for (Parameters * element = _elementsOf(collection); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+                _generateLiteralAs(element->leftExpression->constant, type);
+                _output((element->rightParameters != NULL && element->rightParameters->leftExpression != NULL)? ", " : "");
+            }
+            _output("));\n");
+            continue;
+        }
+        _output("\tprivate static boolean $member%d(%s value) {\n", i, _javaType(_memberships[i].membership->leftExpression->dataType));
+        _output("\t\tswitch (value) {\n");
+        _generateSwitchCases(&_memberships[i]);
+        _output("\t\t\t\treturn true;\n");
+        _output("\t\t\tdefault:\n");
+        _output("\t\t\t\treturn false;\n");
+        _output("\t\t}\n\t}\n");
+    }
+    free(_memberships);
+    _memberships = NULL;
+    _membershipCount = 0;
+}
+
+void generateExpression(Expression * expression) {
+    if (expression == NULL) {
+        return;
+    }
+     switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                _generateCollection(expression);
+                break;
+            }
+            generateConstant(expression->constant);
+                break;
+        case ADDITION:
+            _generateArithmetic(expression, "+", "Math.addExact");
+                break;
+        case MULTIPLICATION:
+            _generateArithmetic(expression, "*", "Math.multiplyExact");
+                break;
+        case SUBTRACTION:
+            _generateArithmetic(expression, "-", "Math.subtractExact");
+                break;
+        case DIVISION:
+            if (_isIntegral(expression->leftExpression->dataType) && _isIntegral(expression->rightExpression->dataType)) {
+                // Python divisions are always true divisions.
+                _output("(double) ");
+                _generateOperand(expression->leftExpression);
+                _output(" / ");
+                _generateOperand(expression->rightExpression);
+                break;
+            }
+            _generateNumericOperand(expression->leftExpression, expression->dataType);
+            _output(" / ");
+            _generateNumericOperand(expression->rightExpression, expression->dataType);
+                break;
+        case TRUNCATED_DIVISION:
+            _generateFloorDivision(expression);
+                break;
+        case MODULO:
+            _generateModulo(expression);
+                break;
+        case EXPONENTIATION:
+            _generatePower(expression);
+                break;
+        case LOGIC_AND:
+            _generateOperand(expression->leftExpression);
+            _output(" && ");
+            _generateOperand(expression->rightExpression);
+            break;
+        case LOGIC_OR:
+            _generateOperand(expression->leftExpression);
+            _output(" || ");
+            _generateOperand(expression->rightExpression);
+            break;
+        case LOGIC_NOT:
+            _output("!");
+            _generateOperand(expression->notExpression);
+                break;
+        case COMPARISON_EXPRESSION:
+            switch (expression->compType) {
+                case BCT_EQU:
+                if (_generateBigComparison(expression, "==") || _generateCharacterEquality(expression, "==")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" == ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_NEQ:
+                if (_generateBigComparison(expression, "!=") || _generateCharacterEquality(expression, "!=")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" != ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_GT:
+                if (_generateBigComparison(expression, ">")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" > ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_GTE:
+                if (_generateBigComparison(expression, ">=")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" >= ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_LT:
+                if (_generateBigComparison(expression, "<")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" < ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_LTE:
+                if (_generateBigComparison(expression, "<=")) {
+                    break;
+                }
+                _generateOperand(expression->leftExpression);
+                _output(" <= ");
+                _generateOperand(expression->rightExpression);
+                break;
+                case BCT_MEMBER:
+                _generateMembership(expression);
+                break;
+                case BCT_NMEMBER:
+                _output("!");
+                _generateMembership(expression);
+                break;
+                case BCT_IDENTITY:
+                case BCT_NIDENTITY:
+                break;
+
+            }
+            break;
+        case MEMBERSHIP:
+        case NOT_MEMBERSHIP:
+        case BIT_ARITHMETIC_AND:
+        case BIT_ARITHMETIC_OR:
+        case BIT_ARITHMETIC_XOR:
+        case BIT_ARITHMETIC_NOT:
+        case BIT_ARITHMETIC_LEFT_SHIFT:
+        case BIT_ARITHMETIC_RIGHT_SHIFT:
+            return;
+        case ASSIGNMENT:
+        case ADDITION_ASSIGNMENT:
+        case DIVISION_ASSIGNMENT:
+        case MULTIPLICATION_ASSIGNMENT:
+        case SUBTRACTION_ASSIGNMENT:
+        case EXPONENTIATION_ASSIGNMENT:
+        case TRUNCATED_DIVISION_ASSIGNMENT:
+        case MODULO_ASSIGNMENT:
+        case BITWISE_AND_ASSIGNMENT:
+        case BITWISE_OR_ASSIGNMENT:
+        case BITWISE_XOR_ASSIGNMENT:
+        case BITWISE_LEFT_SHIFT_ASSIGNMENT:
+        case BITWISE_RIGHT_SHIFT_ASSIGNMENT:
+        case RETURNED_ASSIGNMENT:
+        case IDENTITY:
+        case VARIABLE_CALL_EXPRESSION:
+            generateVariableCall(expression->variableCall);
+            break;
+        case FUNCTION_CALL_EXPRESSION:
+            generateFunctionCall(expression->functionCall);
+            break;
+        case METHOD_CALL_EXPRESSION:
+        case UNPACKED_ELEMENT:
+            _generateUnpackedElement(expression);
+            break;
+        case FIELD_GETTER_EXPRESSION:
+        default:
+            return;
+    }
+}
+
+/* INLINING */
+
+typedef struct {
+    const char * name;
+    Block * function;
+} tFunction;
+
+/** How the parameters of a function are read by its returned expression. */
+typedef struct {
+    const char * functionName;
+    const Parameters * parameters;
+    int uses[MAXIMUM_INLINED_PARAMETERS];
+    int order[MAXIMUM_INLINED_PARAMETERS];
+    boolean isConditional[MAXIMUM_INLINED_PARAMETERS];
+    int reads;
+    int cost;
+    boolean isClosed;
+    boolean calls;
+} tInliningAnalysis;
+
+static Block * _findFunction(const char * name) {
+    tFunction function = { .name = name, .function = NULL };
+    if (_functions != NULL && hashMapFind(_functions, &function, &function)) {
+        return function.function;
+    }
+    return NULL;
+}
+
+/**
+ * The position of the parameter with the given name, or -1 if there is none.
+ */
+static int _parameterIndex(const Parameters * parameters, const char * name) {
+    for (int index = 0; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters, ++index) {
+        if (strcmp(parameters->leftExpression->variableCall->variableName, name) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+static int _countParameters(const Parameters * parameters) {
+    int count = 0;
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        ++count;
+    }
+    return count;
+}
+
+static Parameters * _parameterAt(Parameters * parameters, int index) {
+    for (; 0 < index; --index) {
+        parameters = parameters->rightParameters;
+    }
+    return parameters;
+}
+
+/**
+ * The argument an inlined call passes for the named parameter, or NULL if the
+ * name is not a parameter of that call.
+ */
+static Expression * _argumentOf(const tInlining * inlining, const char * name, SaDataType * parameterType) {
+    Parameters * parameters = inlining->function->functionDefinition->parameters;
+    const int index = _parameterIndex(parameters, name);
+    if (index < 0) {
+        return NULL;
+    }
+    *parameterType = _parameterAt(parameters, index)->leftExpression->dataType;
+    return _parameterAt(inlining->arguments, index)->leftExpression;
+}
+
+/**
+ * Whether the expression is a literal or a local, once the parameters of the
+ * inlined calls are replaced by their arguments, so repeating it costs
+ * nothing and has no effects.
+ */
+static boolean _isAtomic(const Expression * expression, const tInlining * inlining) {
+    SaDataType parameterType;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            return true;
+        case VARIABLE_CALL_EXPRESSION:
+            if (inlining != NULL) {
+                const Expression * argument = _argumentOf(inlining, expression->variableCall->variableName, &parameterType);
+                if (argument != NULL) {
+                    return _isAtomic(argument, inlining->caller);
+                }
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+static boolean _isSimpleOperand(const Expression * expression) {
+    return _isAtomic(expression, _inlining);
+}
+
+static boolean _isPureExpression(const Expression * expression, const tInlining * inlining);
+
+static boolean _arePureParameters(const Parameters * parameters, const tInlining * inlining) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        if (!_isPureExpression(parameters->leftExpression, inlining)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Whether evaluating the expression has no effects besides its value, which
+ * only holds if it calls no function but the builtins.
+ */
+static boolean _isPureExpression(const Expression * expression, const tInlining * inlining) {
+    SaDataType parameterType;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return expression->constant->list->type != LT_PARAMETRIZED_LIST || _arePureParameters(expression->constant->list->elements, inlining);
+            }
+            return true;
+        case VARIABLE_CALL_EXPRESSION:
+            if (inlining != NULL) {
+                const Expression * argument = _argumentOf(inlining, expression->variableCall->variableName, &parameterType);
+                if (argument != NULL) {
+                    return _isPureExpression(argument, inlining->caller);
+                }
+            }
+            return true;
+        case FUNCTION_CALL_EXPRESSION:
+            return expression->functionCall->type == FC_OBJECT && _arePureParameters(expression->functionCall->functionArguments, inlining);
+        case LOGIC_NOT:
+            return _isPureExpression(expression->notExpression, inlining);
+        case COMPARISON_EXPRESSION:
+            return _isPureExpression(expression->leftCompExpression, inlining) && _isPureExpression(expression->rightCompExpression, inlining);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _isPureExpression(expression->leftExpression, inlining) && _isPureExpression(expression->rightExpression, inlining);
+        default:
+            return false;
+    }
+}
+
+static void _analyzeInlined(const Expression * expression, tInliningAnalysis * analysis, const boolean isConditional);
+
+static void _analyzeInlinedParameters(const Parameters * parameters, tInliningAnalysis * analysis, const boolean isConditional) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        _analyzeInlined(parameters->leftExpression, analysis, isConditional);
+    }
+}
+
+/**
+ * Counts the nodes of a returned expression, and records how many times and
+ * in which order it reads each parameter. Reads on the right of "and" and
+ * "or" are conditional, as they may never happen.
+ */
+static void _analyzeInlined(const Expression * expression, tInliningAnalysis * analysis, const boolean isConditional) {
+    ++analysis->cost;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if ((expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE)
+                    && expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+                _analyzeInlinedParameters(expression->constant->list->elements, analysis, isConditional);
+            }
+            return;
+        case VARIABLE_CALL_EXPRESSION: {
+            const int index = _parameterIndex(analysis->parameters, expression->variableCall->variableName);
+            if (index < 0) {
+                analysis->isClosed = false;
+                return;
+            }
+            if (analysis->uses[index]++ == 0) {
+                analysis->order[index] = analysis->reads;
+            }
+            ++analysis->reads;
+            analysis->isConditional[index] |= isConditional;
+            return;
+        }
+        case FUNCTION_CALL_EXPRESSION:
+            if (expression->functionCall->type == FC_DEF) {
+                analysis->calls = true;
+                if (strcmp(expression->functionCall->functionName, analysis->functionName) == 0) {
+                    // Recursive functions are never inlined.
+                    analysis->isClosed = false;
+                }
+            }
+            _analyzeInlinedParameters(expression->functionCall->functionArguments, analysis, isConditional);
+            return;
+        case LOGIC_NOT:
+            _analyzeInlined(expression->notExpression, analysis, isConditional);
+            return;
+        case COMPARISON_EXPRESSION:
+            _analyzeInlined(expression->leftCompExpression, analysis, isConditional);
+            _analyzeInlined(expression->rightCompExpression, analysis, isConditional);
+            return;
+        case LOGIC_AND:
+        case LOGIC_OR:
+            _analyzeInlined(expression->leftExpression, analysis, isConditional);
+            _analyzeInlined(expression->rightExpression, analysis, true);
+            return;
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+            _analyzeInlined(expression->leftExpression, analysis, isConditional);
+            _analyzeInlined(expression->rightExpression, analysis, isConditional);
+            return;
+        default:
+            analysis->isClosed = false;
+            return;
+    }
+}
+
+/**
+ * Whether a value of the argument type can stand for the parameter, at most
+ * after a widening or a conversion that a Java call would have applied too.
+ */
+static boolean _isPassable(const SaDataType argumentType, const SaDataType parameterType) {
+    switch (parameterType) {
+        case SA_FLOAT:
+            return argumentType == SA_FLOAT || argumentType == SA_LONG || argumentType == SA_INTEGER || argumentType == SA_BOOLEAN;
+        case SA_BIG_INTEGER:
+            return argumentType == SA_BIG_INTEGER || argumentType == SA_LONG || argumentType == SA_INTEGER || argumentType == SA_BOOLEAN;
+        case SA_LONG:
+            return argumentType == SA_LONG || argumentType == SA_INTEGER || argumentType == SA_BOOLEAN;
+        case SA_INTEGER:
+            return argumentType == SA_INTEGER || argumentType == SA_BOOLEAN;
+        case SA_STRING:
+            return argumentType == SA_STRING || argumentType == SA_CHARACTER;
+        default:
+            return argumentType == parameterType;
+    }
+}
+
+/**
+ * Whether the call can be replaced by the body of its function: a single
+ * return of an expression within the size budget, which only reads the
+ * parameters and does not call the function itself. Arguments that are not
+ * literals nor locals must be read exactly once and unconditionally, and the
+ * ones with effects must also be read in the order they are passed, by a body
+ * that calls nothing else, so they are evaluated just as the call would.
+ */
+static boolean _isInlinable(const Block * function, Parameters * arguments) {
+    const FunctionDefinition * definition = function->functionDefinition;
+    const Sentence * body = function->nextSentence;
+    if (_inlineSizeBudget <= 0 || definition->isCached || body == NULL || body->type != RETURN_SENTENCE || body->nextSentence != NULL
+            || body->expression == NULL || body->expression->dataType != definition->dataType) {
+        return false;
+    }
+    int depth = 0;
+    for (const tInlining * inlining = _inlining; inlining != NULL; inlining = inlining->caller, ++depth) {
+        if (inlining->function == function || MAXIMUM_INLINING_DEPTH <= depth + 1) {
+            return false;
+        }
+    }
+    const int count = _countParameters(definition->parameters);
+    if (MAXIMUM_INLINED_PARAMETERS < count || _countParameters(arguments) != count) {
+        return false;
+    }
+    tInliningAnalysis analysis = {
+        .functionName = definition->functionName,
+        .parameters = definition->parameters,
+        .reads = 0,
+        .cost = 0,
+        .isClosed = true,
+        .calls = false
+    };
+    for (int i = 0; i < count; ++i) {
+        analysis.uses[i] = 0;
+        analysis.isConditional[i] = false;
+    }
+    _analyzeInlined(body->expression, &analysis, false);
+    if (!analysis.isClosed || _inlineSizeBudget < analysis.cost) {
+        return false;
+    }
+    const Parameters * parameter = definition->parameters;
+    const Parameters * argument = arguments;
+    int lastRead = -1;
+    for (int i = 0; i < count; ++i, parameter = parameter->rightParameters, argument = argument->rightParameters) {
+        const Expression * value = argument->leftExpression;
+        if (!_isPassable(value->dataType, parameter->leftExpression->dataType)) {
+            return false;
+        }
+        if (_isAtomic(value, _inlining)) {
+            continue;
+        }
+        if (analysis.uses[i] != 1 || analysis.isConditional[i]) {
+            return false;
+        }
+        if (!_isPureExpression(value, _inlining)) {
+            if (analysis.calls || analysis.order[i] < lastRead) {
+                return false;
+            }
+            lastRead = analysis.order[i];
+        }
+    }
+    return true;
+}
+
+/**
+ * Outputs an argument converted to the type of its parameter, as a Java call
+ * would have converted it.
+ */
+static void _generateConverted(Expression * argument, const SaDataType parameterType) {
+    if (argument->dataType == parameterType) {
+        generateExpression(argument);
+    } else if (parameterType == SA_STRING) {
+        _output("String.valueOf(");
+        generateExpression(argument);
+        _output(")");
+    } else if (parameterType == SA_INTEGER || parameterType == SA_BIG_INTEGER || argument->dataType == SA_BIG_INTEGER) {
+        _generateNumericOperand(argument, parameterType);
+    } else {
+        _output("((%s) ", _javaType(parameterType));
+        _generateNumericOperand(argument, parameterType);
+        _output(")");
+    }
+}
+
+/**
+ * Outputs the argument of an inlined call in place of its parameter, in the
+ * context of the caller.
+ */
+static void _generateArgument(Expression * argument, const SaDataType parameterType) {
+    const tInlining * inlining = _inlining;
+    _inlining = inlining->caller;
+    if (argument->dataType == parameterType) {
+        _generateOperand(argument);
+    } else {
+        _generateConverted(argument, parameterType);
+    }
+    _inlining = inlining;
+}
+
+/**
+ * Outputs the returned expression of the function in place of the call.
+ */
+static void _generateInlinedCall(const Block * function, Parameters * arguments) {
+    const tInlining inlining = { .function = function, .arguments = arguments, .caller = _inlining };
+    _inlining = &inlining;
+    _generateOperand(function->nextSentence->expression);
+    _inlining = inlining.caller;
+}
+
+/**
+ * Maps every top-level function of the program to its definition, so that
+ * calls generated before it can already find the body to inline.
+ */
+static void _collectFunctions(Sentence * sentence) {
+    _functions = hashMapInit(sizeof(tDeclarationKey), sizeof(tFunction), hashMapStringHash, hashMapStringKeyEquals);
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type == BT_FUNCTION_DEFINITION) {
+            tFunction function = { .name = sentence->block->functionDefinition->functionName, .function = sentence->block };
+            hashMapInsertOrUpdate(_functions, &function, &function);
+        }
+    }
+}
+
+void generateVariableCall(VariableCall * variableCall) {
+    if (variableCall == NULL) {
+        return;
+    }
+    if (_inlining != NULL) {
+        SaDataType parameterType;
+        Expression * argument = _argumentOf(_inlining, variableCall->variableName, &parameterType);
+        if (argument != NULL) {
+            _generateArgument(argument, parameterType);
+            return;
+        }
+    } else if (_reduction != NULL) {
+        // Inside a lambda, the element is read through the index and every other variable through its final copy.
+        if (strcmp(variableCall->variableName, _reduction->variable) == 0) {
+            _output(_reduction->isArray? "$iterable%d[$index%d]" : "$index%d", _reduction->loop, _reduction->loop);
+        } else {
+            _output("%s$captured%d", variableCall->variableName, _reduction->loop);
+        }
+        return;
+    }
+    _output(variableCall->variableName);
+}
+
+/**
+ * Outputs a call to len or abs, which the semantic analysis resolved to
+ * their builtins.
+ */
+static void _generateBuiltinCall(FunctionCall * functionCall) {
+    Expression * argument = functionCall->functionArguments->leftExpression;
+    switch (functionCall->object->builtinDefinition) {
+        case BTF_LEN:
+            if (argument->dataType == SA_STRING) {
+                _generateOperand(argument);
+                _output(".length()");
+            } else if (argument->dataType == SA_LIST || argument->dataType == SA_TUPLE) {
+                _generateOperand(argument);
+                _output(".length");
+            } else {
+                _output("String.valueOf(");
+                generateExpression(argument);
+                _output(").length()");
+            }
+            return;
+        case BTF_ABS:
+            if (argument->dataType == SA_BIG_INTEGER) {
+                _generateOperand(argument);
+                _output(".abs()");
+                return;
+            }
+            _output("Math.abs(");
+            _generateNumericOperand(argument, SA_INTEGER);
+            _output(")");
+            return;
+        default:
+            return;
+    }
+}
+
+/**
+ * Outputs the arguments of a call, converted to the parameters of the
+ * function if it is known.
+ */
+static void _generateArguments(Parameters * arguments, Parameters * parameters) {
+    _output("(");
+    for (Parameters * argument = arguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        if (parameters != NULL && parameters->leftExpression != NULL) {
+            _generateStored(argument->leftExpression, parameters->leftExpression->dataType);
+            parameters = parameters->rightParameters;
+        } else {
+            generateExpression(argument->leftExpression);
+        }
+        if (argument->rightParameters != NULL && argument->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+    }
+    _output(")");
+}
+
+void generateFunctionCall(FunctionCall * functionCall){
+    if (functionCall == NULL) {
+        return;
+    }
+    if (functionCall->type == FC_OBJECT) {
+        _generateBuiltinCall(functionCall);
+        return;
+    }
+    const Block * function = _findFunction(functionCall->functionName);
+    if (function != NULL && _isInlinable(function, functionCall->functionArguments)) {
+        _generateInlinedCall(function, functionCall->functionArguments);
+        return;
+    }
+    _output(functionCall->functionName);
+    _generateArguments(functionCall->functionArguments, (function != NULL)? function->functionDefinition->parameters : NULL);
+}
+
+/* STRING ACCUMULATORS */
+
+typedef struct {
+    const char * name;
+    int builder;
+} tAccumulator;
+
+/**
+ * Whether the assignment is s = s + a + ..., which only appends to s.
+ */
+static boolean _isAppend(const Variable * variable) {
+    if (variable->dataType != SA_STRING) {
+        return false;
+    }
+    const Expression * head = variable->expression;
+    for (; head->type == ADDITION && head->dataType == SA_STRING; head = head->leftExpression);
+    return head != variable->expression && head->type == VARIABLE_CALL_EXPRESSION
+        && strcmp(head->variableCall->variableName, variable->identifier) == 0;
+}
+
+static boolean _mentions(const Expression * expression, const char * name);
+
+static boolean _parametersMention(const Parameters * parameters, const char * name) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        if (_mentions(parameters->leftExpression, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Whether the expression may read the local. Expressions the generator does
+ * not look into are assumed to read it.
+ */
+static boolean _mentions(const Expression * expression, const char * name) {
+    if (expression == NULL) {
+        return false;
+    }
+    switch (expression->type) {
+        case VARIABLE_CALL_EXPRESSION:
+            return strcmp(expression->variableCall->variableName, name) == 0;
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return expression->constant->list->type == LT_PARAMETRIZED_LIST && _parametersMention(expression->constant->list->elements, name);
+            }
+            return false;
+        case FUNCTION_CALL_EXPRESSION:
+            return _parametersMention(expression->functionCall->functionArguments, name);
+        case LOGIC_NOT:
+            return _mentions(expression->notExpression, name);
+        case COMPARISON_EXPRESSION:
+            return _mentions(expression->leftCompExpression, name) || _mentions(expression->rightCompExpression, name);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _mentions(expression->leftExpression, name) || _mentions(expression->rightExpression, name);
+        default:
+            return true;
+    }
+}
+
+static boolean _isOnlyAppendedIn(const Sentence * sentence, const char * name);
+
+static boolean _isOnlyAppendedInBlock(const Block * block, const char * name) {
+    switch (block->type) {
+        case BT_FUNCTION_DEFINITION:
+            return true;
+        case BT_WHILE:
+            return !_mentions(block->whileBlock->expression, name) && _isOnlyAppendedIn(block->nextSentence, name);
+        case BT_FOR:
+            return strcmp(block->forBlock->left->variableCall->variableName, name) != 0
+                && !_mentions(block->forBlock->right, name) && _isOnlyAppendedIn(block->nextSentence, name);
+        case BT_CONDITIONAL:
+            for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                if (_mentions(block->conditional->expression, name) || !_isOnlyAppendedIn(block->nextSentence, name)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Whether every mention of the local in the sentences appends to it, so it
+ * is never read while it lives in a builder, and no sentence returns before
+ * the builder is read back.
+ */
+static boolean _isOnlyAppendedIn(const Sentence * sentence, const char * name) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case VARIABLE_SENTENCE:
+                if (strcmp(sentence->variable->identifier, name) != 0) {
+                    if (_mentions(sentence->variable->expression, name)) {
+                        return false;
+                    }
+                    break;
+                }
+                if (!_isAppend(sentence->variable)) {
+                    return false;
+                }
+                for (const Expression * append = sentence->variable->expression; append->type == ADDITION && append->dataType == SA_STRING; append = append->leftExpression) {
+                    if (_mentions(append->rightExpression, name)) {
+                        return false;
+                    }
+                }
+                break;
+            case EXPRESSION_SENTENCE:
+                if (_mentions(sentence->expression, name)) {
+                    return false;
+                }
+                break;
+            case BLOCK_SENTENCE:
+                if (!_isOnlyAppendedInBlock(sentence->block, name)) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+static boolean _isAccumulating(const char * name) {
+    tDeclarationKey key = { .name = name };
+    return hashMapFind(_accumulators, &key, NULL);
+}
+
+/**
+ * Collects the locals appended to somewhere in the sentences, skipping the
+ * ones an enclosing loop already accumulates.
+ */
+static int _collectAppended(const Sentence * sentence, tAccumulator * accumulators, int count) {
+    for (; sentence != NULL && count < MAXIMUM_ACCUMULATORS; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE && _isAppend(sentence->variable) && !_isAccumulating(sentence->variable->identifier)) {
+            boolean isCollected = false;
+            for (int i = 0; i < count && !isCollected; ++i) {
+                isCollected = strcmp(accumulators[i].name, sentence->variable->identifier) == 0;
+            }
+            if (!isCollected) {
+                accumulators[count++].name = sentence->variable->identifier;
+            }
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                count = _collectAppended(block->nextSentence, accumulators, count);
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * The characters the sentences append to the local on each iteration, counting
+ * literals by their length and any other value by an estimate.
+ */
+static long long _appendedLength(const Sentence * sentence, const char * name) {
+    long long length = 0;
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE && strcmp(sentence->variable->identifier, name) == 0) {
+            for (const Expression * append = sentence->variable->expression; append->type == ADDITION && append->dataType == SA_STRING; append = append->leftExpression) {
+                const Expression * value = append->rightExpression;
+                if (value->type == CONSTANT_EXPRESSION && value->constant->type == CT_STRING) {
+                    // The literal keeps its quotes.
+                    length += strlen(value->constant->string) - 2;
+                } else {
+                    length += (value->dataType == SA_CHARACTER)? 1 : APPENDED_LENGTH_ESTIMATE;
+                }
+            }
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                length += _appendedLength(block->nextSentence, name);
+            }
+        }
+    }
+    return length;
+}
+
+/**
+ * The iterations of a loop known before generating it, or -1 otherwise.
+ */
+static long long _iterationCount(const Block * loop) {
+    if (loop->type != BT_FOR) {
+        return -1;
+    }
+    const Expression * iterable = loop->forBlock->right;
+    if (iterable->type == CONSTANT_EXPRESSION && (iterable->constant->type == CT_LIST || iterable->constant->type == CT_TUPLE)) {
+        if (iterable->constant->list->type != LT_PARAMETRIZED_LIST) {
+            return 0;
+        }
+        long long count = 0;
+        for (Parameters * element = iterable->constant->list->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+            count++;
+        }
+        return count;
+    }
+    if (iterable->dataType != SA_RANGE) {
+        return -1;
+    }
+    long long bounds[3] = { 0, 0, 1 };
+    int count = 0;
+    for (Parameters * argument = iterable->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL && count < 3; argument = argument->rightParameters) {
+        if (!_isIntegerConstant(argument->leftExpression)) {
+            return -1;
+        }
+        bounds[count++] = argument->leftExpression->constant->integer;
+    }
+    const long long start = (count > 1)? bounds[0] : 0;
+    const long long stop = (count > 1)? bounds[1] : bounds[0];
+    const long long step = (count > 2)? bounds[2] : 1;
+    if ((step > 0 && start >= stop) || (step < 0 && start <= stop)) {
+        return 0;
+    }
+    // Both bounds are literals, so their distance cannot overflow in practice.
+    return (step > 0)? (stop - start + step - 1) / step : (start - stop - step - 1) / -step;
+}
+
+/**
+ * Moves every string local that the loop only appends to into a builder
+ * before the loop, so that appending is not quadratic. The builder is
+ * presized when the number of iterations is known.
+ */
+static int _beginAccumulators(const Block * loop, tAccumulator * accumulators) {
+    if (_isEndlessLoop(loop)) {
+        // Nothing after the loop is reachable to read the builders back.
+        return 0;
+    }
+    int count = _collectAppended(loop->nextSentence, accumulators, 0);
+    const long long iterations = _iterationCount(loop);
+    int accepted = 0;
+    for (int i = 0; i < count; ++i) {
+        const char * name = accumulators[i].name;
+        const boolean isHeaderFree = (loop->type == BT_WHILE)
+            ? !_mentions(loop->whileBlock->expression, name)
+            : strcmp(loop->forBlock->left->variableCall->variableName, name) != 0 && !_mentions(loop->forBlock->right, name);
+        if (!_isDeclared(name) || !isHeaderFree || !_isOnlyAppendedIn(loop->nextSentence, name)) {
+            continue;
+        }
+        tAccumulator accumulator = { .name = name, .builder = _builderCount++ };
+        if (iterations < 0) {
+            _output("StringBuilder $builder%d = new StringBuilder(%s);\n", accumulator.builder, name);
+        } else {
+            long long capacity = iterations * _appendedLength(loop->nextSentence, name);
+            capacity = (capacity < MAXIMUM_PRESIZED_CAPACITY)? capacity : MAXIMUM_PRESIZED_CAPACITY;
+            _output("StringBuilder $builder%d = new StringBuilder(%s.length() + %lld).append(%s);\n", accumulator.builder, name, capacity, name);
+        }
+        _outputIndent();
+        hashMapInsertOrUpdate(_accumulators, &accumulator, &accumulator);
+        accumulators[accepted++] = accumulator;
+    }
+    return accepted;
+}
+
+/**
+ * Reads the builders back into their locals once the loop exits.
+ */
+static void _endAccumulators(const tAccumulator * accumulators, const int count) {
+    for (int i = 0; i < count; ++i) {
+        _outputIndent();
+        _output("%s = $builder%d.toString();\n", accumulators[i].name, accumulators[i].builder);
+        tDeclarationKey key = { .name = accumulators[i].name };
+        hashMapRemove(_accumulators, &key);
+    }
+}
+
+static void _generateAppends(Expression * expression, const int builder) {
+    if (expression->type == ADDITION && expression->dataType == SA_STRING) {
+        _generateAppends(expression->leftExpression, builder);
+        _output(".append(");
+        generateExpression(expression->rightExpression);
+        _output(")");
+    } else {
+        _output("$builder%d", builder);
+    }
+}
+
+void generateVariable(Variable * variable) {
+    if (variable == NULL) {
+        return;
+    }
+    tAccumulator accumulator = { .name = variable->identifier };
+    if (_accumulators != NULL && hashMapFind(_accumulators, &accumulator, &accumulator)) {
+        _generateAppends(variable->expression, accumulator.builder);
+        return;
+    }
+    if (!_isDeclared(variable->identifier)) {
+        _output("%s ", _javaDeclarationType(variable->dataType, variable->elementType));
+        _markDeclared(variable->identifier);
+    }
+
+    _output(variable->identifier);
+    _output(" = ");
+    if (variable->dataType == SA_STRING && variable->expression->dataType == SA_CHARACTER) {
+        _generateCharacterAsString(variable->expression);
+    } else {
+        _generateStored(variable->expression, variable->dataType);
+    }
+}
+
+/* TAIL CALLS */
+
+static boolean _isTailCall(const Expression * expression, const FunctionDefinition * function) {
+    return function != NULL && expression != NULL && expression->type == FUNCTION_CALL_EXPRESSION
+        && expression->functionCall->type == FC_DEF
+        && strcmp(expression->functionCall->functionName, function->functionName) == 0
+        && _countParameters(expression->functionCall->functionArguments) == _countParameters(function->parameters);
+}
+
+/**
+ * Whether some return of the sentences gives back the result of calling the
+ * function itself, which then needs no new frame.
+ */
+static boolean _hasTailCall(const Sentence * sentence, const FunctionDefinition * function) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == RETURN_SENTENCE && _isTailCall(sentence->expression, function)) {
+            return true;
+        }
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                if (_hasTailCall(block->nextSentence, function)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static boolean _isParameterItself(const Expression * argument, const Expression * parameter) {
+    return argument->type == VARIABLE_CALL_EXPRESSION
+        && strcmp(argument->variableCall->variableName, parameter->variableCall->variableName) == 0;
+}
+
+/**
+ * Whether the parameters can be reassigned one after the other, because no
+ * argument reads a parameter reassigned before it.
+ */
+static boolean _isSequentiallyAssignable(Parameters * parameters, Parameters * arguments) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters, arguments = arguments->rightParameters) {
+        if (_isParameterItself(arguments->leftExpression, parameters->leftExpression)) {
+            continue;
+        }
+        const char * name = parameters->leftExpression->variableCall->variableName;
+        for (Parameters * next = arguments->rightParameters; next != NULL && next->leftExpression != NULL; next = next->rightParameters) {
+            if (_mentions(next->leftExpression, name)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Outputs a call of the function to itself in tail position, which reassigns
+ * the parameters and restarts the loop around the method body. Arguments are
+ * evaluated before any parameter changes, through temporaries if needed.
+ */
+static void _generateTailCall(FunctionCall * functionCall) {
+    Parameters * parameters = _tailFunction->parameters;
+    Parameters * arguments = functionCall->functionArguments;
+    const boolean isSequential = _isSequentiallyAssignable(parameters, arguments);
+    const int call = _tailCallCount++;
+    int index = 0;
+    for (Parameters * parameter = parameters, * argument = arguments; parameter != NULL && parameter->leftExpression != NULL;
+            parameter = parameter->rightParameters, argument = argument->rightParameters, ++index) {
+        if (_isParameterItself(argument->leftExpression, parameter->leftExpression)) {
+            continue;
+        }
+        if (isSequential) {
+            _output("%s = ", parameter->leftExpression->variableCall->variableName);
+        } else {
+            _output("%s $next%d_%d = ", _javaDeclarationType(parameter->leftExpression->dataType, parameter->leftExpression->elementType), call, index);
+        }
+        _generateConverted(argument->leftExpression, parameter->leftExpression->dataType);
+        _output(";\n");
+        _outputIndent();
+    }
+    index = 0;
+    for (Parameters * parameter = parameters, * argument = arguments; !isSequential && parameter != NULL && parameter->leftExpression != NULL;
+            parameter = parameter->rightParameters, argument = argument->rightParameters, ++index) {
+        if (!_isParameterItself(argument->leftExpression, parameter->leftExpression)) {
+            _output("%s = $next%d_%d;\n", parameter->leftExpression->variableCall->variableName, call, index);
+            _outputIndent();
+        }
+    }
+    _output("continue $recurse;\n");
+}
+
+/* MEMOIZATION */
+
+/** The bits a parameter takes in a packed memo key, or 0 if it cannot be packed. */
+static int _packedWidth(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return 1;
+        case SA_CHARACTER:
+            return 16;
+        case SA_INTEGER:
+            return 32;
+        case SA_LONG:
+        case SA_FLOAT:
+            return 64;
+        default:
+            return 0;
+    }
+}
+
+static boolean _isMemoized(const FunctionDefinition * function) {
+    return function->isCached && function->dataType != SA_VOID;
+}
+
+/**
+ * The longs the key of a primitive memo table takes, packing the arguments
+ * in order until one no longer fits, or 0 if the memo cannot be primitive:
+ * its result must be a primitive and its arguments fit in at most two longs.
+ */
+static int _packedWords(const FunctionDefinition * function) {
+    if (_packedWidth(function->dataType) == 0) {
+        return 0;
+    }
+    int words = 1;
+    int width = 0;
+    for (const Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        const int parameterWidth = _packedWidth(parameter->leftExpression->dataType);
+        if (parameterWidth == 0) {
+            return 0;
+        }
+        if (width + parameterWidth > 64) {
+            if (words == 2) {
+                return 0;
+            }
+            words = 2;
+            width = 0;
+        }
+        width += parameterWidth;
+    }
+    return words;
+}
+
+/**
+ * Outputs a parameter as the bits it takes in a packed key, which only the
+ * first parameter may sign-extend, as its extra bits are shifted out.
+ */
+static void _generatePackedParameter(const Expression * parameter, const boolean isFirst) {
+    const char * name = parameter->variableCall->variableName;
+    switch (parameter->dataType) {
+        case SA_BOOLEAN:
+            _output("(%s? 1L : 0L)", name);
+            return;
+        case SA_FLOAT:
+            _output("Double.doubleToLongBits(%s)", name);
+            return;
+        case SA_INTEGER:
+            _output(isFirst? "(long) %s" : "(%s & 0xFFFFFFFFL)", name);
+            return;
+        default:
+            _output("(long) %s", name);
+            return;
+    }
+}
+
+/**
+ * Outputs the memo table of a "@cache" function and the method with its name,
+ * which looks the arguments up before calling the actual body on a miss.
+ */
+static void _generateMemoizedFunction(FunctionDefinition * function) {
+    const char * name = function->functionName;
+    const char * type = _javaDeclarationType(function->dataType, function->elementType);
+    const int words = _packedWords(function);
+    const boolean isPacked = words > 0;
+    const char * memo = (words == 2)? "$WideMemo" : (isPacked? "$Memo" : "$ObjectMemo");
+    const char * keys = (words == 2)? "$key, $highKey" : "$key";
+    _usesMemo |= words == 1;
+    _usesWideMemo |= words == 2;
+    _usesObjectMemo |= !isPacked;
+    _output("private static final %s $%sMemo = new %s();\n", memo, name, memo);
+    _outputIndent();
+    _output("public static %s %s(", type, name);
+    const int count = _countParameters(function->parameters);
+    for (Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        _output("%s %s", _javaDeclarationType(parameter->leftExpression->dataType, parameter->leftExpression->elementType), parameter->leftExpression->variableCall->variableName);
+        _output((parameter->rightParameters != NULL && parameter->rightParameters->leftExpression != NULL)? ", " : "");
+    }
+    _output("){\n");
+    if (isPacked) {
+        _output("\t\tlong $key = ");
+        if (count == 0) {
+            _output("0L");
+        }
+        const char * word = "$key";
+        int width = 0;
+        for (Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+            const int parameterWidth = _packedWidth(parameter->leftExpression->dataType);
+            if (width + parameterWidth > 64) {
+                // The arguments that no longer fit go to the second long of the key.
+                word = "$highKey";
+                width = 0;
+                _output(";\n\t\tlong $highKey = ");
+            } else if (width > 0) {
+                _output(";\n\t\t%s = (%s << %d) | ", word, word, parameterWidth);
+            }
+            _generatePackedParameter(parameter->leftExpression, width == 0);
+            width += parameterWidth;
+        }
+        _output(";\n");
+        _output("\t\tint $slot = $%sMemo.find(%s);\n", name, keys);
+        _output("\t\tif ($slot >= 0) {\n\t\t\treturn ");
+        switch (function->dataType) {
+            case SA_BOOLEAN:
+                _output("$%sMemo.values[$slot] != 0", name);
+                break;
+            case SA_FLOAT:
+                _output("Double.longBitsToDouble($%sMemo.values[$slot])", name);
+                break;
+            case SA_LONG:
+                _output("$%sMemo.values[$slot]", name);
+                break;
+            default:
+                _output("(%s) $%sMemo.values[$slot]", type, name);
+                break;
+        }
+        _output(";\n\t\t}\n");
+    } else {
+        _output("\t\tObject $key = ");
+        if (count == 1) {
+            _output("%s", function->parameters->leftExpression->variableCall->variableName);
+        } else {
+            _output("java.util.Arrays.<Object>asList(");
+            for (Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+                _output("%s%s", parameter->leftExpression->variableCall->variableName,
+                    (parameter->rightParameters != NULL && parameter->rightParameters->leftExpression != NULL)? ", " : "");
+            }
+            _output(")");
+        }
+        _output(";\n");
+        _output("\t\tObject $cached = $%sMemo.find($key);\n", name);
+        _output("\t\tif ($cached != $ObjectMemo.MISSING) {\n");
+        switch (function->dataType) {
+            case SA_BOOLEAN:
+                _output("\t\t\treturn (Boolean) $cached;\n");
+                break;
+            case SA_CHARACTER:
+                _output("\t\t\treturn (Character) $cached;\n");
+                break;
+            case SA_INTEGER:
+            case SA_LONG:
+            case SA_FLOAT:
+                _output("\t\t\treturn (%s) $cached;\n", _boxedType(function->dataType));
+                break;
+            default:
+                _output("\t\t\treturn (%s) $cached;\n", type);
+                break;
+        }
+        _output("\t\t}\n");
+    }
+    _output("\t\t%s $value = %s$compute(", type, name);
+    for (Parameters * parameter = function->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        _output("%s%s", parameter->leftExpression->variableCall->variableName,
+            (parameter->rightParameters != NULL && parameter->rightParameters->leftExpression != NULL)? ", " : "");
+    }
+    _output(");\n");
+    if (!isPacked) {
+        _output("\t\t$%sMemo.values.put($key, $value);\n", name);
+    } else if (function->dataType == SA_BOOLEAN) {
+        _output("\t\t$%sMemo.put(%s, $value? 1L : 0L);\n", name, keys);
+    } else if (function->dataType == SA_FLOAT) {
+        _output("\t\t$%sMemo.put(%s, Double.doubleToRawLongBits($value));\n", name, keys);
+    } else {
+        _output("\t\t$%sMemo.put(%s, $value);\n", name, keys);
+    }
+    _output("\t\treturn $value;\n\t}\n");
+}
+
+/**
+ * Outputs, at the end of the main method, how many calls of each top-level
+ * "@cache" function were answered by its memo table.
+ */
+static void _generateMemoStatistics(const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == BLOCK_SENTENCE && sentence->block->type == BT_FUNCTION_DEFINITION && _isMemoized(sentence->block->functionDefinition)) {
+            const char * name = sentence->block->functionDefinition->functionName;
+            _outputIndent();
+            _output("System.err.println(\"%s: \" + $%sMemo.hits + \" hits, \" + $%sMemo.misses + \" misses\");\n", name, name, name);
+        }
+    }
+}
+
+static void _generateParameters(Parameters * parameters) {
+    _output("(");
+    for (Parameters * parameter = parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        _output("%s ", _javaDeclarationType(parameter->leftExpression->dataType, parameter->leftExpression->elementType));
+        _output(parameter->leftExpression->variableCall->variableName);
+        if (parameter->rightParameters != NULL && parameter->rightParameters->leftExpression != NULL) {
+            _output(", ");
+        }
+    }
+    _output(")");
+}
+
+/* UNPACKING */
+
+/**
+ * Whether the sentence assigns the hidden variable of an unpacking
+ * assignment, whose elements are assigned by the sentences that follow.
+ */
+static boolean _isUnpacking(const Sentence * sentence) {
+    const Sentence * element = sentence->nextSentence;
+    return sentence->type == VARIABLE_SENTENCE && element != NULL && element->type == VARIABLE_SENTENCE
+        && element->variable->expression->type == UNPACKED_ELEMENT
+        && element->variable->expression->unpackedVariable == sentence->variable;
+}
+
+/**
+ * The number of elements of a tuple or list constant, or -1 if the
+ * expression is not one.
+ */
+static int _constantElementCount(const Expression * expression) {
+    if (expression->type != CONSTANT_EXPRESSION || (expression->constant->type != CT_LIST && expression->constant->type != CT_TUPLE)
+            || expression->constant->list->type != LT_PARAMETRIZED_LIST) {
+        return -1;
+    }
+    int count = 0;
+    for (const Parameters * element = _elementsOf(expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Whether every return of the function gives back a constant with the given
+ * number of scalar elements, so that a variant can leave them in fields.
+ */
+static boolean _isFlattenable(const Block * function, const int count) {
+    if (_isMemoized(function->functionDefinition) || _completesNormally(function->nextSentence)) {
+        return false;
+    }
+    for (int index = 0; index < count; index++) {
+        if (returnedElementType(function, index, count) == SA_UNKNOWN) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static tUnpackingMode _unpackingMode(const Sentence * sentence, const Block ** function) {
+    const Expression * unpacked = sentence->variable->expression;
+    const int count = sentence->nextSentence->variable->expression->elementCount;
+    if (_constantElementCount(unpacked) == count) {
+        return UM_TEMPORARIES;
+    }
+    if (unpacked->type == FUNCTION_CALL_EXPRESSION && unpacked->functionCall->type == FC_DEF) {
+        const Block * callee = _findFunction(unpacked->functionCall->functionName);
+        if (callee != NULL && _isFlattenable(callee, count)) {
+            *function = callee;
+            return UM_FIELDS;
+        }
+    }
+    return UM_ARRAY;
+}
+
+static boolean _isUnpackedInPlace(const Sentence * sentence) {
+    const Block * function = NULL;
+    return _isUnpacking(sentence) && _unpackingMode(sentence, &function) != UM_ARRAY;
+}
+
+/**
+ * Requests the flattened variant of a function, unless it was already.
+ */
+static boolean _flatten(const Block * function, const int count) {
+    for (int k = 0; k < _flattenedCount; k++) {
+        if (_flattened[k].function == function) {
+            return true;
+        }
+    }
+    if (_flattenedCount == MAXIMUM_FLATTENED_FUNCTIONS) {
+        return false;
+    }
+    _flattened[_flattenedCount++] = (tFlattened) { .function = function, .count = count, .isOnlyUnpacked = false };
+    return true;
+}
+
+static tFlattened * _flattenedOf(const Block * function) {
+    for (int k = 0; k < _flattenedCount; k++) {
+        if (_flattened[k].function == function) {
+            return &_flattened[k];
+        }
+    }
+    return NULL;
+}
+
+static boolean _callsFunction(const Expression * expression, const char * name);
+
+static boolean _argumentsCallFunction(const Parameters * arguments, const char * name) {
+    for (; arguments != NULL && arguments->leftExpression != NULL; arguments = arguments->rightParameters) {
+        if (_callsFunction(arguments->leftExpression, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Whether the expression may call the function, or use it as a value, or
+ * call any function if the name is NULL. Expressions the generator does not
+ * look into are assumed to call it.
+ */
+static boolean _callsFunction(const Expression * expression, const char * name) {
+    if (expression == NULL) {
+        return false;
+    }
+    switch (expression->type) {
+        case VARIABLE_CALL_EXPRESSION:
+            return name != NULL && strcmp(expression->variableCall->variableName, name) == 0;
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return expression->constant->list->type == LT_PARAMETRIZED_LIST && _argumentsCallFunction(expression->constant->list->elements, name);
+            }
+            return false;
+        case FUNCTION_CALL_EXPRESSION:
+            return (expression->functionCall->type == FC_DEF && (name == NULL || strcmp(expression->functionCall->functionName, name) == 0))
+                || _argumentsCallFunction(expression->functionCall->functionArguments, name);
+        case UNPACKED_ELEMENT:
+            return false;
+        case LOGIC_NOT:
+            return _callsFunction(expression->notExpression, name);
+        case COMPARISON_EXPRESSION:
+            return _callsFunction(expression->leftCompExpression, name) || _callsFunction(expression->rightCompExpression, name);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _callsFunction(expression->leftExpression, name) || _callsFunction(expression->rightExpression, name);
+        default:
+            return true;
+    }
+}
+
+static boolean _sentencesCall(const Sentence * sentence, const char * name, const Block * flattened);
+
+static boolean _blockCalls(const Block * block, const char * name, const Block * flattened) {
+    switch (block->type) {
+        case BT_FUNCTION_DEFINITION:
+            return name != NULL && _sentencesCall(block->nextSentence, name, flattened);
+        case BT_WHILE:
+            return _callsFunction(block->whileBlock->expression, name) || _sentencesCall(block->nextSentence, name, flattened);
+        case BT_FOR:
+            return _callsFunction(block->forBlock->right, name) || _sentencesCall(block->nextSentence, name, flattened);
+        case BT_CONDITIONAL:
+            for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                if (_callsFunction(block->conditional->expression, name) || _sentencesCall(block->nextSentence, name, flattened)) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Whether running the sentence may call the function of the given name, or
+ * any function if it is NULL, where defining a function runs none of its
+ * body. Calls that unpack the result of the flattened function in place, if
+ * one is given, do not count, as they call its variant instead.
+ */
+static boolean _sentenceCalls(const Sentence * sentence, const char * name, const Block * flattened) {
+    const Block * callee = NULL;
+    switch (sentence->type) {
+        case EXPRESSION_SENTENCE:
+        case RETURN_SENTENCE:
+            return _callsFunction(sentence->expression, name);
+        case VARIABLE_SENTENCE:
+            if (flattened != NULL && _isUnpacking(sentence) && _unpackingMode(sentence, &callee) == UM_FIELDS && callee == flattened) {
+                return _argumentsCallFunction(sentence->variable->expression->functionCall->functionArguments, name);
+            }
+            return _callsFunction(sentence->variable->expression, name);
+        case BLOCK_SENTENCE:
+            return _blockCalls(sentence->block, name, flattened);
+        default:
+            return true;
+    }
+}
+
+static boolean _sentencesCall(const Sentence * sentence, const char * name, const Block * flattened) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (_sentenceCalls(sentence, name, flattened)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * The number of elements of the constant the first return of the sentences
+ * gives back, or -1 if there is none.
+ */
+static int _returnedElementCount(const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        int count = -1;
+        if (sentence->type == RETURN_SENTENCE) {
+            return _constantElementCount(sentence->expression);
+        }
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        for (const Block * block = sentence->block; block != NULL && count < 0; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+            if (block->type == BT_FUNCTION_DEFINITION || (block->type == BT_CONDITIONAL && block->conditional == NULL)) {
+                break;
+            }
+            count = _returnedElementCount(block->nextSentence);
+        }
+        if (count >= 0) {
+            return count;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Requests ahead the flattened variant of every top-level function whose
+ * calls all unpack its result in place, as the function itself is then
+ * never called and need not be generated.
+ */
+static void _flattenOnlyUnpacked(const Sentence * program) {
+    for (const Sentence * sentence = program; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE || sentence->block->type != BT_FUNCTION_DEFINITION) {
+            continue;
+        }
+        const Block * function = sentence->block;
+        const int count = _returnedElementCount(function->nextSentence);
+        // Bodies count too, as calls within functions are generated the same way.
+        if (count > 0 && _isFlattenable(function, count) && !_sentencesCall(program, function->functionDefinition->functionName, function) && _flatten(function, count)) {
+            _flattenedOf(function)->isOnlyUnpacked = true;
+        }
+    }
+}
+
+static boolean _sentencesUnpackIntoFields(const Sentence * sentence);
+
+static boolean _blockUnpacksIntoFields(const Block * block) {
+    switch (block->type) {
+        case BT_FUNCTION_DEFINITION:
+        case BT_WHILE:
+        case BT_FOR:
+            return _sentencesUnpackIntoFields(block->nextSentence);
+        case BT_CONDITIONAL:
+            for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                if (_sentencesUnpackIntoFields(block->nextSentence)) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Whether some unpacking of the sentences, or of the bodies they define,
+ * reads the fields a flattened variant leaves.
+ */
+static boolean _sentencesUnpackIntoFields(const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        const Block * function = NULL;
+        if (_isUnpacking(sentence) && _unpackingMode(sentence, &function) == UM_FIELDS) {
+            return true;
+        }
+        if (sentence->type == BLOCK_SENTENCE && _blockUnpacksIntoFields(sentence->block)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Outputs the value unpacked, unless its elements are assigned straight from
+ * the expressions of a constant or from the fields a flattened call leaves.
+ */
+static void _generateUnpacking(const Sentence * sentence) {
+    Variable * variable = sentence->variable;
+    const int count = sentence->nextSentence->variable->expression->elementCount;
+    const Block * function = NULL;
+    _unpacking = (tUnpacking) {
+        .variable = variable,
+        .mode = _unpackingMode(sentence, &function),
+        .function = function,
+        .temporaries = _unpackedCount
+    };
+    if (_unpacking.mode == UM_FIELDS && !_flatten(function, count)) {
+        _unpacking.mode = UM_ARRAY;
+    }
+    switch (_unpacking.mode) {
+        case UM_TEMPORARIES: {
+            // Every element is evaluated before any target is assigned, as a swap needs.
+            _unpackedCount++;
+            int index = 0;
+            for (Parameters * element = _elementsOf(variable->expression); element != NULL && element->leftExpression != NULL; element = element->rightParameters, index++) {
+                if (index > 0) {
+                    _outputIndent();
+                }
+                _output("%s $unpacked%d_%d = ", _javaDeclarationType(element->leftExpression->dataType, element->leftExpression->elementType), _unpacking.temporaries, index);
+                generateExpression(element->leftExpression);
+                _output(";\n");
+            }
+            return;
+        }
+        case UM_FIELDS:
+            _output("%s$unpacked", function->functionDefinition->functionName);
+            _generateArguments(variable->expression->functionCall->functionArguments, function->functionDefinition->parameters);
+            _output(";\n");
+            return;
+        default:
+            generateVariable(variable);
+            _output(";\n");
+            return;
+    }
+}
+
+/**
+ * Outputs an element read from the array holding the unpacked value, cast to
+ * the type inferred for it when the array holds a wider one.
+ */
+static void _generateArrayElement(const Expression * element) {
+    const Variable * variable = element->unpackedVariable;
+    const boolean isArray = variable->dataType == SA_LIST || variable->dataType == SA_TUPLE;
+    const SaDataType arrayType = isArray? variable->elementType : SA_OBJECT;
+    const SaDataType type = element->dataType;
+    const boolean isNumeric = type == SA_INTEGER || type == SA_LONG || type == SA_FLOAT;
+    const boolean isScalar = isNumeric || type == SA_BOOLEAN || type == SA_CHARACTER || type == SA_STRING;
+    const char * array = isArray? "%s[%d]" : "((Object[]) %s)[%d]";
+    if (type == arrayType || (!isScalar && type != SA_BIG_INTEGER)) {
+        _output(array, variable->identifier, element->elementIndex);
+    } else if (type == SA_BIG_INTEGER) {
+        _output("((java.math.BigInteger) ");
+        _output(array, variable->identifier, element->elementIndex);
+        _output(")");
+    } else if (arrayType != SA_OBJECT && arrayType != SA_STRING) {
+        _output("((%s) ", _javaType(type));
+        _output(array, variable->identifier, element->elementIndex);
+        _output(")");
+    } else if (isNumeric) {
+        _output("((Number) ");
+        _output(array, variable->identifier, element->elementIndex);
+        _output(").%sValue()", _javaType(type));
+    } else {
+        _output("((%s) ", (type == SA_BOOLEAN)? "Boolean" : (type == SA_CHARACTER)? "Character" : "String");
+        _output(array, variable->identifier, element->elementIndex);
+        _output(")");
+    }
+}
+
+static void _generateUnpackedElement(const Expression * element) {
+    if (element->unpackedVariable != _unpacking.variable) {
+        _generateArrayElement(element);
+        return;
+    }
+    switch (_unpacking.mode) {
+        case UM_TEMPORARIES:
+            _output("$unpacked%d_%d", _unpacking.temporaries, element->elementIndex);
+            return;
+        case UM_FIELDS:
+            // Read right after the call, before any other call may overwrite them.
+            _output("%s$value%d", _unpacking.function->functionDefinition->functionName, element->elementIndex);
+            return;
+        default:
+            _generateArrayElement(element);
+            return;
+    }
+}
+
+/**
+ * Outputs a return of the flattened variant, which stores the elements of
+ * the returned constant in the fields of the function. The elements are
+ * evaluated in order, into locals unless they are simple operands, and only
+ * the last one that is not is stored right away, so no call made while
+ * evaluating them can see the fields half written.
+ */
+static void _generateFlattenedReturn(Expression * returned) {
+    const Block * function = _flattenedFunction->function;
+    const int count = _flattenedFunction->count;
+    const char * name = function->functionDefinition->functionName;
+    const int result = _resultCount++;
+    int last = -1;
+    int index = 0;
+    for (Parameters * element = _elementsOf(returned); element != NULL && element->leftExpression != NULL; element = element->rightParameters, index++) {
+        if (!_isSimpleOperand(element->leftExpression)) {
+            last = index;
+        }
+    }
+    boolean isFirst = true;
+    index = 0;
+    for (Parameters * element = _elementsOf(returned); element != NULL && element->leftExpression != NULL; element = element->rightParameters, index++) {
+        if (index < last && !_isSimpleOperand(element->leftExpression)) {
+            if (!isFirst) {
+                _outputIndent();
+            }
+            const SaDataType type = returnedElementType(function, index, count);
+            _output("%s $result%d_%d = ", _javaType(type), result, index);
+            _generateStored(element->leftExpression, type);
+            _output(";\n");
+            isFirst = false;
+        }
+    }
+    if (last >= 0) {
+        if (!isFirst) {
+            _outputIndent();
+        }
+        _output("%s$value%d = ", name, last);
+        _generateStored(_parameterAt(_elementsOf(returned), last)->leftExpression, returnedElementType(function, last, count));
+        _output(";\n");
+        isFirst = false;
+    }
+    index = 0;
+    for (Parameters * element = _elementsOf(returned); element != NULL && element->leftExpression != NULL; element = element->rightParameters, index++) {
+        if (index == last) {
+            continue;
+        }
+        if (!isFirst) {
+            _outputIndent();
+        }
+        _output("%s$value%d = ", name, index);
+        if (index < last && !_isSimpleOperand(element->leftExpression)) {
+            _output("$result%d_%d", result, index);
+        } else {
+            _generateStored(element->leftExpression, returnedElementType(function, index, count));
+        }
+        _output(";\n");
+        isFirst = false;
+    }
+    _outputIndent();
+    _output("return;\n");
+}
+
+/**
+ * Outputs the fields and the variant of a function that returns its tuples
+ * through them, so that unpacking a call to it allocates nothing. Callers
+ * read the fields right after the call, so calls may nest or recurse, but
+ * not run on several threads.
+ */
+static void _generateFlattenedFunction(const tFlattened * flattened) {
+    const Block * function = flattened->function;
+    const char * name = function->functionDefinition->functionName;
+    indentLevel = 1;
+    for (int index = 0; index < flattened->count; index++) {
+        _outputIndent();
+        _output("private static %s %s$value%d;\n", _javaType(returnedElementType(function, index, flattened->count)), name, index);
+    }
+    _outputIndent();
+    _output("public static void %s$unpacked", name);
+    _generateParameters(function->functionDefinition->parameters);
+    _output("{\n");
+    indentLevel++;
+    _beginMethod(function->functionDefinition->parameters, function->nextSentence);
+    _flattenedFunction = flattened;
+    generateSentence(function->nextSentence);
+    _flattenedFunction = NULL;
+    indentLevel--;
+    _outputBraceWithIndent();
+}
+
+void generateFunctionDef(FunctionDefinition * fdef){
+    if (fdef == NULL) {
+        return;
+    }
+    switch (fdef->type) {
+        case FD_GENERIC:
+        case FD_OBJECT_TYPE:
+        case FD_VARIABLE_CALL_TYPE:
+        case FD_LIST_TYPE:
+        case FD_TUPLE_TYPE:
+        case FD_BUILTIN_TYPE:
+            _output("public static %s ", _javaDeclarationType(fdef->dataType, fdef->elementType));
+            _output(fdef->functionName);
+            if (_isMemoized(fdef)) {
+                // The memoizing method takes the name of the function, and calls this one on misses.
+                _output("$compute");
+            }
+            _generateParameters(fdef->parameters);
+            // while (fdef->parameters != NULL){
+            //     _outputIndent();
+            //     _output("Object ");
+            //     _output(fdef->parameters->leftExpression->variableCall->variableName);
+            //     if(fdef->parameters->rightParameters != NULL){
+            //         _output(", ");
+            //     }
+            //     fdef->parameters = fdef->parameters->rightParameters;
+            // }
+            _output("{\n");
+            indentLevel++;
+    }
+}
+
+void generateConditionalBlock(ConditionalBlock * conditionalBlock){
+    
+    if (conditionalBlock == NULL)
+        return;
+    switch (conditionalBlock->type)
+    {
+    case CB_IF:
+        _output("if (");
+        generateExpression(conditionalBlock->expression);
+        _output(") {\n");
+        indentLevel++;
+        break;
+    case CB_ELSE:
+        _outputIndent();
+        _output("else {\n");
+        indentLevel++;
+        break;
+    case CB_ELIF:
+        _outputIndent();
+        _output("else if (");
+        generateExpression(conditionalBlock->expression);
+        _output(") {\n");
+        indentLevel++;
+        break;
+    default:
+        break;
+    }
+}
+
+void generateWhileBlock(WhileBlock * whileBlock){
+    _output("while (");
+    generateExpression(whileBlock->expression);
+    _output(") {\n");
+    indentLevel++;
+}
+
+/**
+ * Outputs a bound of a range as a Java integral value.
+ */
+static void _generateRangeBound(Expression * bound) {
+    switch (bound->dataType) {
+        case SA_BOOLEAN:
+            _output("((");
+            generateExpression(bound);
+            _output(")? 1 : 0)");
+            return;
+        case SA_INTEGER:
+        case SA_LONG:
+            generateExpression(bound);
+            return;
+        default:
+            _output("((Number) (");
+            generateExpression(bound);
+            _output(")).longValue()");
+            return;
+    }
+}
+
+/**
+ * Outputs a bound of a range, which is either a literal or the local it
+ * was evaluated into before the loop.
+ */
+static void _outputRangeBound(Expression * bound, const char * name, const int loop) {
+    if (_isIntegerConstant(bound)) {
+        generateExpression(bound);
+    } else {
+        _output("$%s%d", name, loop);
+    }
+}
+
+/**
+ * Iterates over a range with a counted loop on a hidden index, so that the
+ * bounds are evaluated once, the body may assign the loop variable, and the
+ * variable keeps the last produced value afterwards. The index is a long
+ * whenever stepping past the end could overflow an int.
+ */
+static void _generateRangeForBlock(ForBlock * forBlock, const int loop) {
+    Expression * arguments[3] = { NULL, NULL, NULL };
+    int count = 0;
+    for (Parameters * argument = forBlock->right->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL && count < 3; argument = argument->rightParameters) {
+        arguments[count++] = argument->leftExpression;
+    }
+    Expression * bounds[3] = {
+        (count > 1)? arguments[0] : NULL,
+        (count > 1)? arguments[1] : arguments[0],
+        (count > 2)? arguments[2] : NULL
+    };
+    const char * names[3] = { "start", "stop", "step" };
+    Expression * step = bounds[2];
+    // The analyzer rejects a zero step, so zero stands for a step only known at runtime.
+    const long long stepValue = (step == NULL)? 1 : (_isIntegerConstant(step)? step->constant->integer : 0);
+    const boolean isUnitStep = stepValue == 1 || stepValue == -1;
+    const boolean isStopConstant = _isIntegerConstant(bounds[1]) && stepValue != 0;
+    const boolean isStepSafe = isUnitStep
+        || (isStopConstant && INT32_MIN <= bounds[1]->constant->integer + stepValue && bounds[1]->constant->integer + stepValue <= INT32_MAX);
+    const char * indexType = (forBlock->right->elementType == SA_INTEGER && isStepSafe)? "int" : "long";
+    boolean isFirstLine = true;
+    for (int i = 0; i < 3; ++i) {
+        if (bounds[i] != NULL && !_isIntegerConstant(bounds[i])) {
+            if (!isFirstLine) {
+                _outputIndent();
+            }
+            _output("%s $%s%d = ", indexType, names[i], loop);
+            _generateRangeBound(bounds[i]);
+            _output(";\n");
+            isFirstLine = false;
+        }
+    }
+    if (stepValue == 0) {
+        _outputIndent();
+        _output("if ($step%d == 0) {\n", loop);
+        indentLevel++;
+        _outputIndent();
+        _output("throw new IllegalArgumentException(\"range() arg 3 must not be zero\");\n");
+        indentLevel--;
+        _outputBraceWithIndent();
+    }
+    if (!isFirstLine) {
+        _outputIndent();
+    }
+    _output("for (%s $index%d = ", indexType, loop);
+    if (bounds[0] == NULL) {
+        _output("0");
+    } else {
+        _outputRangeBound(bounds[0], names[0], loop);
+    }
+    if (stepValue == 0) {
+        _output("; ($step%d > 0)? $index%d < ", loop, loop);
+        _outputRangeBound(bounds[1], names[1], loop);
+        _output(" : $index%d > ", loop);
+    } else {
+        _output((stepValue > 0)? "; $index%d < " : "; $index%d > ", loop);
+    }
+    _outputRangeBound(bounds[1], names[1], loop);
+    if (stepValue == 1) {
+        _output("; $index%d++) {\n", loop);
+    } else if (stepValue == -1) {
+        _output("; $index%d--) {\n", loop);
+    } else {
+        _output("; $index%d += ", loop);
+        _outputRangeBound(step, names[2], loop);
+        _output(") {\n");
+    }
+    indentLevel++;
+    _outputIndent();
+    const boolean isNarrowed = indexType[0] == 'l' && forBlock->left->dataType == SA_INTEGER;
+    _output("%s = %s$index%d;\n", forBlock->left->variableCall->variableName, isNarrowed? "(int) " : "", loop);
+}
+
+/**
+ * Iterates with an index instead of an iterator, so neither the string nor
+ * the array is copied and no element gets boxed. The iterable is evaluated
+ * once, as in Python.
+ */
+void generateForBlock(ForBlock * forBlock){
+    if (forBlock == NULL) {
+        return;
+    }
+    const char * variable = forBlock->left->variableCall->variableName;
+    Expression * iterable = forBlock->right;
+    const int loop = _loopCount++;
+    switch (iterable->dataType) {
+        case SA_RANGE:
+            _generateRangeForBlock(forBlock, loop);
+            return;
+        case SA_STRING:
+            _output("String $iterable%d = ", loop);
+            generateExpression(iterable);
+            _output(";\n");
+            _outputIndent();
+            _output("for (int $index%d = 0; $index%d < $iterable%d.length(); $index%d++) {\n", loop, loop, loop, loop);
+            indentLevel++;
+            _outputIndent();
+            _output("%s = $iterable%d.charAt($index%d);\n", variable, loop, loop);
+            return;
+        case SA_LIST:
+        case SA_TUPLE:
+            _output("%s $iterable%d = ", _javaDeclarationType(iterable->dataType, iterable->elementType), loop);
+            generateExpression(iterable);
+            _output(";\n");
+            _outputIndent();
+            _output("for (int $index%d = 0; $index%d < $iterable%d.length; $index%d++) {\n", loop, loop, loop, loop);
+            indentLevel++;
+            _outputIndent();
+            _output("%s = $iterable%d[$index%d];\n", variable, loop, loop);
+            return;
+        default:
+            // The iterable is only known at runtime, so it is read as a string.
+            _output("for (char $item%d : String.valueOf(", loop);
+            generateExpression(iterable);
+            _output(").toCharArray()) {\n");
+            indentLevel++;
+            _outputIndent();
+            _output("%s = $item%d;\n", variable, loop);
+            return;
+    }
+}
+
+/**
+ * Whether a for loop iterates over a tuple constant short enough to repeat
+ * its body once per element instead. Bodies that never complete are kept in
+ * a loop, as Java rejects the unreachable copies that would follow them.
+ */
+static boolean _isUnrollable(const Block * block) {
+    const Expression * iterable = block->forBlock->right;
+    if (iterable->type != CONSTANT_EXPRESSION || iterable->constant->type != CT_TUPLE) {
+        return false;
+    }
+    int count = 0;
+    for (Parameters * element = iterable->constant->tuple->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        count++;
+    }
+    return count <= MAXIMUM_UNROLLED_ELEMENTS && _completesNormally(block->nextSentence);
+}
+
+static void _generateUnrolledForBlock(Block * block) {
+    const char * variable = block->forBlock->left->variableCall->variableName;
+    boolean isFirst = true;
+    for (Parameters * element = block->forBlock->right->constant->tuple->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        if (!isFirst) {
+            _outputIndent();
+        }
+        _output("%s = ", variable);
+        generateExpression(element->leftExpression);
+        _output(";\n");
+        generateSentence(block->nextSentence);
+        isFirst = false;
+    }
+}
+
+/* PARALLEL REDUCTIONS */
+
+static boolean _isSideEffectFree(const Expression * expression);
+
+static boolean _areSideEffectFree(const Parameters * parameters) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        if (!_isSideEffectFree(parameters->leftExpression)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Whether evaluating the expression has no effect besides its value, so
+ * that it may run on any thread and in any order. Functions of the program
+ * qualify when they only read state, as nothing writes while the stream
+ * runs, but memoized ones share their table.
+ */
+static boolean _isSideEffectFree(const Expression * expression) {
+    switch (expression->type) {
+        case FUNCTION_CALL_EXPRESSION: {
+            if (!_areSideEffectFree(expression->functionCall->functionArguments)) {
+                return false;
+            }
+            if (expression->functionCall->type == FC_OBJECT) {
+                return true;
+            }
+            const Block * function = _findFunction(expression->functionCall->functionName);
+            return function != NULL && !function->functionDefinition->isCached
+                && getFunctionEffect(expression->functionCall->functionName) != SA_EFFECTFUL;
+        }
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return expression->constant->list->type != LT_PARAMETRIZED_LIST || _areSideEffectFree(expression->constant->list->elements);
+            }
+            return true;
+        case VARIABLE_CALL_EXPRESSION:
+            return true;
+        case LOGIC_NOT:
+            return _isSideEffectFree(expression->notExpression);
+        case COMPARISON_EXPRESSION:
+            return _isSideEffectFree(expression->leftCompExpression) && _isSideEffectFree(expression->rightCompExpression);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _isSideEffectFree(expression->leftExpression) && _isSideEffectFree(expression->rightExpression);
+        default:
+            return false;
+    }
+}
+
+static boolean _captureParameters(const Parameters * parameters, tReduction * reduction);
+
+/**
+ * Registers every variable read by the expression, other than the loop
+ * variable, as one its lambda must capture.
+ */
+static boolean _capture(const Expression * expression, tReduction * reduction) {
+    switch (expression->type) {
+        case VARIABLE_CALL_EXPRESSION: {
+            const char * name = expression->variableCall->variableName;
+            if (strcmp(name, reduction->variable) == 0) {
+                return true;
+            }
+            for (int k = 0; k < reduction->captureCount; k++) {
+                if (strcmp(reduction->captures[k]->variableCall->variableName, name) == 0) {
+                    return true;
+                }
+            }
+            if (reduction->captureCount == MAXIMUM_CAPTURED_VARIABLES) {
+                return false;
+            }
+            reduction->captures[reduction->captureCount++] = expression;
+            return true;
+        }
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return expression->constant->list->type != LT_PARAMETRIZED_LIST || _captureParameters(expression->constant->list->elements, reduction);
+            }
+            return true;
+        case FUNCTION_CALL_EXPRESSION:
+            return _captureParameters(expression->functionCall->functionArguments, reduction);
+        case LOGIC_NOT:
+            return _capture(expression->notExpression, reduction);
+        case COMPARISON_EXPRESSION:
+            return _capture(expression->leftCompExpression, reduction) && _capture(expression->rightCompExpression, reduction);
+        default:
+            return _capture(expression->leftExpression, reduction) && _capture(expression->rightExpression, reduction);
+    }
+}
+
+static boolean _captureParameters(const Parameters * parameters, tReduction * reduction) {
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        if (!_capture(parameters->leftExpression, reduction)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static boolean _isVariableNamed(const Expression * expression, const char * name) {
+    return expression->type == VARIABLE_CALL_EXPRESSION && strcmp(expression->variableCall->variableName, name) == 0;
+}
+
+/**
+ * Regroups acc + a + b, which Python parses as (acc + a) + b, into
+ * acc + (a + b), so that the reduction maps each element to a + b. Every
+ * operand must already have the type of the accumulator, or the sums of
+ * ints would wrap where the accumulated longs did not.
+ */
+static boolean _regroupSum(Expression * value, const Variable * accumulator, tReduction * reduction) {
+    Expression * operands[MAXIMUM_REGROUPED_OPERANDS + 1];
+    int count = 0;
+    Expression * sum = value;
+    for (; sum->type == ADDITION && !_isVariableNamed(sum->leftExpression, accumulator->identifier); sum = sum->leftExpression) {
+        if (count == MAXIMUM_REGROUPED_OPERANDS) {
+            return false;
+        }
+        operands[count++] = sum->rightExpression;
+    }
+    if (sum->type != ADDITION || count == 0) {
+        return false;
+    }
+    operands[count++] = sum->rightExpression;
+    for (int k = 0; k < count; k++) {
+        if (operands[k]->dataType != accumulator->dataType && operands[k]->dataType != SA_BOOLEAN) {
+            return false;
+        }
+    }
+    // The operands were collected from the last one.
+    Expression * mapped = operands[count - 1];
+    for (int k = count - 2; 0 <= k; k--) {
+        reduction->regrouped[k] = (Expression) {
+            .leftExpression = mapped,
+            .rightExpression = operands[k],
+            .type = ADDITION,
+            .dataType = accumulator->dataType,
+            .elementType = SA_UNKNOWN
+        };
+        mapped = &reduction->regrouped[k];
+    }
+    reduction->mapped = mapped;
+    return true;
+}
+
+/**
+ * Whether the loop iterates over a range with a unit step, or over an array,
+ * binding each element to a variable of the same type.
+ */
+static boolean _isParallelIterable(const ForBlock * forBlock) {
+    const Expression * iterable = forBlock->right;
+    const SaDataType type = forBlock->left->dataType;
+    if (iterable->dataType == SA_LIST || iterable->dataType == SA_TUPLE) {
+        return type == iterable->elementType && type != SA_OBJECT && type != SA_UNKNOWN && type != SA_UNDECLARED;
+    }
+    if (iterable->dataType != SA_RANGE || (type != SA_INTEGER && type != SA_LONG) || type != iterable->elementType) {
+        return false;
+    }
+    const Parameters * arguments = iterable->functionCall->functionArguments;
+    const int count = _countParameters(arguments);
+    const Parameters * step = (count > 2)? _parameterAt((Parameters *) arguments, 2) : NULL;
+    return count <= 2 || (count == 3 && _isIntegerConstant(step->leftExpression) && step->leftExpression->constant->integer == 1);
+}
+
+/**
+ * Whether the loop is a reduction, where the body only adds, subtracts or
+ * multiplies into an integral accumulator a side-effect free expression,
+ * maybe under a side-effect free condition, of the element and of variables
+ * the loop never assigns. Its iterations are then independent of each other
+ * and, integer arithmetic wrapping alike in any order, may run in parallel.
+ */
+static boolean _findReduction(const Block * block, tReduction * reduction) {
+    const ForBlock * forBlock = block->forBlock;
+    const long long iterations = _iterationCount(block);
+    if (_parallelThreshold <= 0 || (0 <= iterations && iterations < _parallelThreshold) || !_isParallelIterable(forBlock)) {
+        return false;
+    }
+    *reduction = (tReduction) {
+        .filter = NULL,
+        .variable = forBlock->left->variableCall->variableName,
+        .isArray = forBlock->right->dataType != SA_RANGE,
+        .captureCount = 0
+    };
+    const Sentence * body = block->nextSentence;
+    if (body != NULL && body->nextSentence == NULL && body->type == BLOCK_SENTENCE && body->block->type == BT_CONDITIONAL
+            && body->block->conditional != NULL && body->block->conditional->type == CB_IF
+            && body->block->nextCond != NULL && body->block->nextCond->conditional == NULL) {
+        reduction->filter = body->block->conditional->expression;
+        body = body->block->nextSentence;
+    }
+    if (body == NULL || body->nextSentence != NULL || body->type != VARIABLE_SENTENCE) {
+        return false;
+    }
+    const Variable * accumulator = body->variable;
+    Expression * value = accumulator->expression;
+    switch (value->type) {
+        case ADDITION:
+            reduction->operator = '+';
+            break;
+        case SUBTRACTION:
+            reduction->operator = '-';
+            break;
+        case MULTIPLICATION:
+            reduction->operator = '*';
+            break;
+        default:
+            return false;
+    }
+    if (_isVariableNamed(value->leftExpression, accumulator->identifier)) {
+        reduction->mapped = value->rightExpression;
+    } else if (reduction->operator != '-' && _isVariableNamed(value->rightExpression, accumulator->identifier)) {
+        reduction->mapped = value->leftExpression;
+    } else if (reduction->operator != '+' || !_regroupSum(value, accumulator, reduction)) {
+        return false;
+    }
+    reduction->accumulator = accumulator;
+    const SaDataType type = accumulator->dataType;
+    const SaDataType mappedType = reduction->mapped->dataType;
+    if ((type != SA_INTEGER && type != SA_LONG) || value->dataType != type
+            || (mappedType != SA_INTEGER && mappedType != SA_LONG && mappedType != SA_BOOLEAN) || (type == SA_INTEGER && mappedType == SA_LONG)) {
+        return false;
+    }
+    if (strcmp(accumulator->identifier, reduction->variable) == 0 || _mentions(reduction->mapped, accumulator->identifier)
+            || !_isSideEffectFree(reduction->mapped) || !_capture(reduction->mapped, reduction)) {
+        return false;
+    }
+    if (reduction->filter != NULL && (reduction->filter->dataType != SA_BOOLEAN || _mentions(reduction->filter, accumulator->identifier)
+            || !_isSideEffectFree(reduction->filter) || !_capture(reduction->filter, reduction))) {
+        return false;
+    }
+    // A called function may unpack through fields that the threads would share.
+    return !_usesResultFields || !(_callsFunction(reduction->mapped, NULL) || _callsFunction(reduction->filter, NULL));
+}
+
+static boolean _isMentionedOutside(const Sentence * sentence, const Block * loop, const char * name) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case VARIABLE_SENTENCE:
+                if (_mentions(sentence->variable->expression, name)) {
+                    return true;
+                }
                 break;
-            case SA_INTEGER:
-                _output("int ");
+            case EXPRESSION_SENTENCE:
+            case RETURN_SENTENCE:
+                if (_mentions(sentence->expression, name)) {
+                    return true;
+                }
                 break;
-            case SA_STRING:
-                _output("String ");
+            case BLOCK_SENTENCE: {
+                const Block * block = sentence->block;
+                if (block == loop || block->type == BT_FUNCTION_DEFINITION) {
+                    break;
+                }
+                if (block->type == BT_CONDITIONAL) {
+                    for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                        if (_mentions(block->conditional->expression, name) || _isMentionedOutside(block->nextSentence, loop, name)) {
+                            return true;
+                        }
+                    }
+                } else if (block->type == BT_WHILE) {
+                    if (_mentions(block->whileBlock->expression, name) || _isMentionedOutside(block->nextSentence, loop, name)) {
+                        return true;
+                    }
+                } else if (block->type == BT_FOR) {
+                    // A loop over the same variable binds it before its body reads it.
+                    const boolean isRebound = _isVariableNamed(block->forBlock->left, name);
+                    if (_mentions(block->forBlock->right, name) || (!isRebound && _isMentionedOutside(block->nextSentence, loop, name))) {
+                        return true;
+                    }
+                } else {
+                    return true;
+                }
                 break;
+            }
             default:
-                _output("Object ");
+                break;
         }
-        markDeclared(variable->identifier);
     }
-
-    _output(variable->identifier);
-    _output(" = ");
-    generateExpression(variable->expression);
+    return false;
 }
 
-void generateFunctionDef(FunctionDefinition * fdef){
-    if (fdef == NULL) {
-        return;
+/**
+ * Outputs a lambda of the reduction, which takes the index of an element.
+ */
+static void _generateReductionLambda(const tReduction * reduction, Expression * expression, const SaDataType type) {
+    _output("$index%d -> ", reduction->loop);
+    _reduction = reduction;
+    if (expression->dataType == SA_BOOLEAN && type != SA_BOOLEAN) {
+        _generateNumericOperand(expression, type);
+    } else {
+        generateExpression(expression);
     }
-    switch (fdef->type) {
-        case FD_GENERIC:
-        case FD_OBJECT_TYPE:
-        case FD_VARIABLE_CALL_TYPE:
-        case FD_LIST_TYPE:
-        case FD_TUPLE_TYPE:
-        case FD_BUILTIN_TYPE:
-            _output("public static ");
-            tValue retValue;
-            tKey key = { .varname = fdef->functionName };
-            boolean found = symbolTableFind(&key, &retValue);
-            if ( found ) {
-                switch (retValue.type) {
-                    case SA_BOOLEAN:
-                        _output("boolean ");
-                        break;
-                    case SA_FLOAT:
-                        _output("double ");
-                        break;
-                    case SA_INTEGER:
-                        _output("int ");
-                        break;
-                    case SA_STRING:
-                        _output("String ");
-                        break;
-                    default:
-                        _output("Object ");
-                }
-            } else {
-                _output("Object ");
-            }
-            _output(fdef->functionName);
-            _output("(");
-            Parameters * currentParam = fdef->parameters;
-            while (currentParam != NULL && currentParam->leftExpression != NULL) {
-                if (isAlreadyArithmetic(currentParam->leftExpression->variableCall->variableName))
-                    _output("double ");
-                else if (isAlreadyBoolean(currentParam->leftExpression->variableCall->variableName))
-                    _output("boolean ");
-                else
-                    _output("Object ");
-                _output(currentParam->leftExpression->variableCall->variableName);
-                currentParam = currentParam->rightParameters;
-                if (currentParam != NULL) {
-                    _output(", ");
+    _reduction = NULL;
+}
+
+/**
+ * Lowers a reduction loop to a stream over the indexes of its elements,
+ * which the helper makes parallel, running on the common fork-join pool,
+ * when there are enough of them. The lambdas read every other variable
+ * through a final copy, and the loop variable is still left holding the
+ * last element when something else in the method reads it.
+ */
+static void _generateParallelForBlock(Block * block, tReduction * reduction) {
+    ForBlock * forBlock = block->forBlock;
+    const SaDataType type = reduction->accumulator->dataType;
+    const boolean isLongStream = !reduction->isArray && forBlock->right->elementType == SA_LONG;
+    const char * indexType = isLongStream? "long" : "int";
+    const char * names[2] = { "start", "stop" };
+    Expression * bounds[2] = { NULL, NULL };
+    const int loop = _loopCount++;
+    reduction->loop = loop;
+    logDebugging(_logger, "Lowering the loop over %s to a parallel stream (loop: %d)", reduction->variable, loop);
+    boolean isFirstLine = true;
+    if (reduction->isArray) {
+        _output("%s $iterable%d = ", _javaDeclarationType(forBlock->right->dataType, forBlock->right->elementType), loop);
+        generateExpression(forBlock->right);
+        _output(";\n");
+        isFirstLine = false;
+    } else {
+        Parameters * arguments = forBlock->right->functionCall->functionArguments;
+        const boolean hasStart = _countParameters(arguments) > 1;
+        bounds[0] = hasStart? arguments->leftExpression : NULL;
+        bounds[1] = hasStart? arguments->rightParameters->leftExpression : arguments->leftExpression;
+        for (int i = 0; i < 2; ++i) {
+            if (bounds[i] != NULL && !_isIntegerConstant(bounds[i])) {
+                if (!isFirstLine) {
+                    _outputIndent();
                 }
+                _output("%s $%s%d = ", indexType, names[i], loop);
+                _generateRangeBound(bounds[i]);
+                _output(";\n");
+                isFirstLine = false;
             }
-            // while (fdef->parameters != NULL){
-            //     _outputIndent();
-            //     _output("Object ");
-            //     _output(fdef->parameters->leftExpression->variableCall->variableName);
-            //     if(fdef->parameters->rightParameters != NULL){
-            //         _output(", ");
-            //     }
-            //     fdef->parameters = fdef->parameters->rightParameters;
-            // }
-            _output("){\n");
-            indentLevel++;
+        }
     }
-}
-
-void generateConditionalBlock(ConditionalBlock * conditionalBlock){
-    
-    if (conditionalBlock == NULL)
-        return;
-    switch (conditionalBlock->type)
-    {
-    case CB_IF:
-        _output("if (");
-        generateExpression(conditionalBlock->expression);
-        _output(") {\n");
-        indentLevel++;
-        break;
-    case CB_ELSE:
-        _outputIndent();
-        _output("else {\n");
-        indentLevel++;
-        break;
-    case CB_ELIF:
+    for (int k = 0; k < reduction->captureCount; k++) {
+        if (!isFirstLine) {
+            _outputIndent();
+        }
+        const Expression * captured = reduction->captures[k];
+        const char * name = captured->variableCall->variableName;
+        _output("final %s %s$captured%d = %s;\n", _javaDeclarationType(captured->dataType, captured->elementType), name, loop, name);
+        isFirstLine = false;
+    }
+    if (!isFirstLine) {
         _outputIndent();
-        _output("else if (");
-        generateExpression(conditionalBlock->expression);
-        _output(") {\n");
-        indentLevel++;
-        break;
-    default:
-        break;
     }
-}
-
-void generateWhileBlock(WhileBlock * whileBlock){
-    _output("while (");
-    generateExpression(whileBlock->expression);
-    _output(") {\n");
-    indentLevel++;
-}
-
-void generateForBlock(ForBlock * forBlock){
-    if (forBlock == NULL) {
-        return;
+    const char * accumulator = reduction->accumulator->identifier;
+    // An accumulator that may overflow a long combines every partial result with checked arithmetic too.
+    const boolean isExact = reduction->accumulator->expression->mayOverflow;
+    if (isExact) {
+        const char * method = (reduction->operator == '*')? "multiplyExact" : (reduction->operator == '-')? "subtractExact" : "addExact";
+        _output("%s = Math.%s(%s, ", accumulator, method, accumulator);
+    } else {
+        _output("%s = %s %c ", accumulator, accumulator, reduction->operator);
+    }
+    if (reduction->isArray) {
+        _usesIntRange = true;
+        _output("$intRange(0, $iterable%d.length)", loop);
+    } else {
+        _usesIntRange = _usesIntRange || !isLongStream;
+        _usesLongRange = _usesLongRange || isLongStream;
+        _output(isLongStream? "$longRange(" : "$intRange(");
+        if (bounds[0] == NULL) {
+            _output("0");
+        } else {
+            _outputRangeBound(bounds[0], names[0], loop);
+        }
+        _output(", ");
+        _outputRangeBound(bounds[1], names[1], loop);
+        _output(")");
+    }
+    if (reduction->filter != NULL) {
+        _output(".filter(");
+        _generateReductionLambda(reduction, reduction->filter, SA_BOOLEAN);
+        _output(")");
+    }
+    if ((type == SA_LONG) == isLongStream) {
+        _output(".map(");
+    } else {
+        _output((type == SA_LONG)? ".mapToLong(" : ".mapToInt(");
+    }
+    _generateReductionLambda(reduction, reduction->mapped, type);
+    if (isExact) {
+        _output((reduction->operator == '*')? ").reduce(1L, Math::multiplyExact));\n" : ").reduce(0L, Math::addExact));\n");
+    } else if (reduction->operator == '*') {
+        _output(").reduce(%s, ($left, $right) -> $left * $right);\n", (type == SA_LONG)? "1L" : "1");
+    } else {
+        _output(").sum();\n");
+    }
+    if (_isMentionedOutside(_methodBody, block, reduction->variable)) {
+        _outputIndent();
+        if (reduction->isArray) {
+            _output("if ($iterable%d.length > 0) {\n", loop);
+            indentLevel++;
+            _outputIndent();
+            _output("%s = $iterable%d[$iterable%d.length - 1];\n", reduction->variable, loop, loop);
+        } else {
+            _output("if (");
+            if (bounds[0] == NULL) {
+                _output("0");
+            } else {
+                _outputRangeBound(bounds[0], names[0], loop);
+            }
+            _output(" < ");
+            _outputRangeBound(bounds[1], names[1], loop);
+            _output(") {\n");
+            indentLevel++;
+            _outputIndent();
+            _output("%s = ", reduction->variable);
+            _outputRangeBound(bounds[1], names[1], loop);
+            _output(" - 1;\n");
+        }
+        indentLevel--;
+        _outputBraceWithIndent();
     }
-    // struct key key = {.varname = forBlock->left->variableCall->variableName};
-    // struct value value;
-
-    // symbolTableFind(&key, &value);
-    // switch (value.type) {
-    //     case SA_BOOLEAN:
-    //         _output("boolean ");
-    //         break;
-    //     case SA_FLOAT:
-    //         _output("double ");
-    //         break;
-    //     case SA_INTEGER:
-    //         _output("int ");
-    //         break;
-    //     case SA_STRING:
-    //         _output("String ");
-    //         break;
-    //     default:
-    //         _output("Object ");
-    // }
-
-
-    _output("for ( Character ");
-    generateExpression(forBlock->left);
-    _output(" : ");
-    generateExpression(forBlock->right);
-    _output(".toCharArray() ) {\n");
-    indentLevel++;
 }
 
-
 void generateBlock(Block * block){
     if (block == NULL) 
         return;
+    tAccumulator accumulators[MAXIMUM_ACCUMULATORS];
+    int accumulatorCount = 0;
+    tReduction reduction;
     switch (block->type)
     {
     case BT_FUNCTION_DEFINITION:
@@ -421,42 +3743,71 @@ void generateBlock(Block * block){
         break;
     case BT_CLASS_DEFINITION:
     case BT_CONDITIONAL:
+        if (block->conditional == NULL) {
+            // The empty block that ends every conditional chain.
+            break;
+        }
         generateConditionalBlock(block->conditional);
         generateSentence(block->nextSentence);
         indentLevel--;
         _outputBraceWithIndent();
-        if (block->nextCond != NULL);{
-                generateBlock(block->nextCond);
-        }
+        generateBlock(block->nextCond);
         break;
     case BT_FOR:
+        if (_isUnrollable(block)) {
+            _generateUnrolledForBlock(block);
+            break;
+        }
+        if (_findReduction(block, &reduction)) {
+            _generateParallelForBlock(block, &reduction);
+            break;
+        }
+        accumulatorCount = _beginAccumulators(block, accumulators);
         generateForBlock(block->forBlock);
         generateSentence(block->nextSentence);
         indentLevel--;
         _outputBraceWithIndent();
+        _endAccumulators(accumulators, accumulatorCount);
         break;
     case BT_WHILE:
+        accumulatorCount = _beginAccumulators(block, accumulators);
         generateWhileBlock(block->whileBlock);
         generateSentence(block->nextSentence);
         indentLevel--;
         _outputBraceWithIndent();
+        _endAccumulators(accumulators, accumulatorCount);
     default:
         break;
     }
 }
 
+static boolean _isConstant(const Sentence * sentence);
+
 void generateSentence(Sentence * sentence) {
-    if (sentence == NULL) {
+    if (sentence == NULL || sentence == _chunkEnd) {
         return;
     }
-    _outputIndent();
+    if (_isConstant(sentence)) {
+        // Its value was already given to a field of the class.
+        generateSentence(sentence->nextSentence);
+        return;
+    }
+    if (sentence->type != BLOCK_SENTENCE || sentence->block->type != BT_FUNCTION_DEFINITION) {
+        // Definitions are generated later as methods, so they take no line here.
+        _outputIndent();
+    }
     switch (sentence->type) {
         case EXPRESSION_SENTENCE:
             generateExpression(sentence->expression);
-            _output(";");
+            _output(";\n");
             generateSentence(sentence->nextSentence);
             return;
         case VARIABLE_SENTENCE:
+            if (_isUnpacking(sentence)) {
+                _generateUnpacking(sentence);
+                generateSentence(sentence->nextSentence);
+                return;
+            }
             generateVariable(sentence->variable);
             _output(";");
             _output("\n");
@@ -467,10 +3818,19 @@ void generateSentence(Sentence * sentence) {
             generateSentence(sentence->nextSentence);
             return;
         case RETURN_SENTENCE:
+            if (_flattenedFunction != NULL) {
+                _generateFlattenedReturn(sentence->expression);
+                return;
+            }
+            if (_isTailCall(sentence->expression, _tailFunction)) {
+                _generateTailCall(sentence->expression->functionCall);
+                return;
+            }
             _output("return ");
-            generateExpression(sentence->expression);
+            if (sentence->expression != NULL) {
+                _generateStored(sentence->expression, _returnType);
+            }
             _output(";\n");
-            indentLevel--;
             return;
         default:
             return;
@@ -479,15 +3839,352 @@ void generateSentence(Sentence * sentence) {
 
 
 
-void generateProgram(Program * program) {
-     file = fopen("output.java", "wr");
-     write = file;
-    declaredVariablesCount = 0; // Reset declared variables
-    _output("public class Main {\n\t");
-    _output("public static void main(String[] args){\n");
+/* MODULE CONSTANTS */
+
+typedef struct {
+    const char * name;
+    int count;
+} tAssignmentCount;
+
+static void _countAssignment(hashMapADT counts, const char * name, const int times) {
+    tAssignmentCount count = { .name = name, .count = 0 };
+    hashMapFind(counts, &count, &count);
+    count.count += times;
+    hashMapInsertOrUpdate(counts, &count, &count);
+}
+
+/**
+ * Counts the assignments of each name in the top-level code. Loop variables
+ * are assigned on every iteration, so they count as assigned many times.
+ */
+static void _countAssignments(hashMapADT counts, const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE) {
+            _countAssignment(counts, sentence->variable->identifier, 1);
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            if (sentence->block->type == BT_FOR) {
+                _countAssignment(counts, sentence->block->forBlock->left->variableCall->variableName, 2);
+            }
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _countAssignments(counts, block->nextSentence);
+            }
+        }
+    }
+}
+
+/**
+ * Whether the expression always evaluates to the same value without any
+ * effect, as it only combines literals and the constants before it.
+ */
+static boolean _isConstantExpression(const Expression * expression) {
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if ((expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE)
+                    && expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+                for (const Parameters * element = expression->constant->list->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+                    if (!_isConstantExpression(element->leftExpression)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        case VARIABLE_CALL_EXPRESSION: {
+            tDeclarationKey key = { .name = expression->variableCall->variableName };
+            return hashMapFind(_constants, &key, NULL);
+        }
+        case LOGIC_NOT:
+            return _isConstantExpression(expression->notExpression);
+        case COMPARISON_EXPRESSION:
+            if ((expression->compType == BCT_MEMBER || expression->compType == BCT_NMEMBER) && _isSetMembership(expression)) {
+                // The helper set is a field declared after the constants, so it is still null while they are initialized.
+                return false;
+            }
+            return _isConstantExpression(expression->leftCompExpression) && _isConstantExpression(expression->rightCompExpression);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _isConstantExpression(expression->leftExpression) && _isConstantExpression(expression->rightExpression);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Whether the sentence is the only assignment of a top-level variable that
+ * was emitted as a constant of the class.
+ */
+static boolean _isConstant(const Sentence * sentence) {
+    if (_constants == NULL || sentence->type != VARIABLE_SENTENCE) {
+        return false;
+    }
+    tDeclarationKey key = { .name = sentence->variable->identifier };
+    return hashMapFind(_constants, &key, NULL);
+}
+
+/**
+ * Emits as a static final field every top-level variable assigned only
+ * once, by a constant expression, so that functions may read it and the JIT
+ * folds it. Only the assignments before the first sentence that may call a
+ * function are emitted, so that no function can read a constant before
+ * Python would have assigned it. The fields are assigned in a static block,
+ * as javac would otherwise fold them into constant loop conditions and then
+ * reject the statements those make unreachable.
+ */
+static void _generateConstants(Sentence * sentence) {
+    hashMapADT counts = hashMapInit(sizeof(tDeclarationKey), sizeof(tAssignmentCount), hashMapStringHash, hashMapStringKeyEquals);
+    _countAssignments(counts, sentence);
+    indentLevel = 1;
+    Sentence * first = sentence;
+    for (; sentence != NULL && !_sentenceCalls(sentence, NULL, NULL); sentence = sentence->nextSentence) {
+        if (sentence->type != VARIABLE_SENTENCE || _isUnpacking(sentence)) {
+            continue;
+        }
+        const Variable * variable = sentence->variable;
+        tAssignmentCount count = { .name = variable->identifier };
+        hashMapFind(counts, &count, &count);
+        if (count.count != 1 || !_isConstantExpression(variable->expression)) {
+            continue;
+        }
+        _outputIndent();
+        _output("private static final %s %s;\n", _javaDeclarationType(variable->dataType, variable->elementType), variable->identifier);
+        tDeclarationKey key = { .name = variable->identifier };
+        hashMapInsertOrUpdate(_constants, &key, &key);
+        logDebugging(_logger, "Variable %s is emitted as a constant", variable->identifier);
+    }
+    hashMapDestroy(counts);
+    if (hashMapSize(_constants) == 0) {
+        return;
+    }
+    _outputIndent();
+    _output("static {\n");
+    indentLevel++;
+    for (; first != sentence; first = first->nextSentence) {
+        if (_isConstant(first) && !_isUnpacking(first)) {
+            _outputIndent();
+            _output("%s = ", first->variable->identifier);
+            generateExpression(first->variable->expression);
+            _output(";\n");
+        }
+    }
+    indentLevel--;
+    _outputBraceWithIndent();
+}
+
+/* METHOD SPLITTING */
+
+static int _estimateExpressionSize(const Expression * expression);
+
+static int _estimateArgumentsSize(const Parameters * parameters) {
+    int size = 0;
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        size += _estimateExpressionSize(parameters->leftExpression);
+    }
+    return size;
+}
+
+/**
+ * A rough count of the bytes of bytecode an expression compiles to, which
+ * errs on the large side: loads and operators take a byte or two, calls and
+ * branches a few more.
+ */
+static int _estimateExpressionSize(const Expression * expression) {
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if ((expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE)
+                    && expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+                // Every element is stored with its index on a duplicate of the array.
+                return 4 + _estimateArgumentsSize(expression->constant->list->elements) + 4 * _countParameters(expression->constant->list->elements);
+            }
+            return 3;
+        case VARIABLE_CALL_EXPRESSION:
+        case UNPACKED_ELEMENT:
+            return 4;
+        case FUNCTION_CALL_EXPRESSION:
+            return 3 + _estimateArgumentsSize(expression->functionCall->functionArguments);
+        case METHOD_CALL_EXPRESSION:
+            return 8 + _estimateArgumentsSize(expression->methodCall->functionCall->functionArguments);
+        case FIELD_GETTER_EXPRESSION:
+            return 8;
+        case LOGIC_NOT:
+            return 8 + _estimateExpressionSize(expression->notExpression);
+        case COMPARISON_EXPRESSION:
+            return 8 + _estimateExpressionSize(expression->leftCompExpression) + _estimateExpressionSize(expression->rightCompExpression);
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return 8 + _estimateExpressionSize(expression->leftExpression) + _estimateExpressionSize(expression->rightExpression);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+            return 4 + _estimateExpressionSize(expression->leftExpression) + _estimateExpressionSize(expression->rightExpression);
+        default:
+            return 16;
+    }
+}
+
+static int _estimateSentencesSize(const Sentence * sentence);
+
+/**
+ * The estimated size of a single sentence, without the ones that follow it.
+ * Definitions are generated as methods of their own, and constants as
+ * fields, so they take no room.
+ */
+static int _estimateSentenceSize(const Sentence * sentence) {
+    if (_isConstant(sentence)) {
+        return 0;
+    }
+    switch (sentence->type) {
+        case VARIABLE_SENTENCE:
+            return 4 + _estimateExpressionSize(sentence->variable->expression);
+        case EXPRESSION_SENTENCE:
+        case RETURN_SENTENCE:
+            return 2 + ((sentence->expression != NULL)? _estimateExpressionSize(sentence->expression) : 0);
+        case BLOCK_SENTENCE:
+            break;
+        default:
+            return 0;
+    }
+    const Block * block = sentence->block;
+    int size = 0;
+    switch (block->type) {
+        case BT_CONDITIONAL:
+            for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                size += 6 + _estimateSentencesSize(block->nextSentence);
+                if (block->conditional->expression != NULL) {
+                    size += _estimateExpressionSize(block->conditional->expression);
+                }
+            }
+            return size;
+        case BT_WHILE:
+            return 6 + _estimateExpressionSize(block->whileBlock->expression) + _estimateSentencesSize(block->nextSentence);
+        case BT_FOR:
+            return 24 + _estimateExpressionSize(block->forBlock->right) + _estimateSentencesSize(block->nextSentence);
+        default:
+            return 0;
+    }
+}
+
+static int _estimateSentencesSize(const Sentence * sentence) {
+    int size = 0;
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        size += _estimateSentenceSize(sentence);
+    }
+    return size;
+}
+
+/**
+ * The first top-level sentence after the chunk that begins at the given one.
+ * Chunks take sentences while they fit under the maximum method size, but
+ * always at least one, and never leave the elements of an unpacking apart
+ * from the temporaries they read.
+ */
+static Sentence * _nextChunk(Sentence * sentence) {
+    int size = _estimateSentenceSize(sentence);
+    Sentence * end = sentence->nextSentence;
+    for (; end != NULL; end = end->nextSentence) {
+        const int sentenceSize = _estimateSentenceSize(end);
+        const boolean isUnpackedElement = end->type == VARIABLE_SENTENCE && end->variable->expression->type == UNPACKED_ELEMENT;
+        if (_maximumMethodSize < size + sentenceSize && !isUnpackedElement) {
+            break;
+        }
+        size += sentenceSize;
+    }
+    return end;
+}
+
+/**
+ * Generates the top-level sentences as a sequence of methods called by main,
+ * each one small enough for the JIT compiler to accept it. The variables of
+ * the program become static fields, so that every chunk sees the values left
+ * by the previous ones.
+ */
+static void _generateSplitMain(Program * program) {
+    indentLevel = 1;
+    _hoistsFields = true;
+    _beginMethod(NULL, program->sentence);
+    _hoistsFields = false;
+    _output("\tpublic static void main(String[] args){\n");
+    int chunk = 0;
+    for (Sentence * sentence = program->sentence; sentence != NULL; sentence = _nextChunk(sentence)) {
+        _output("\t\t$main%d();\n", chunk++);
+    }
     indentLevel = 2;
-    generateSentence(program->sentence);
-    _output("\n\t}\n");
+    if (_logCacheStatistics) {
+        _generateMemoStatistics(program->sentence);
+    }
+    _output("\t}\n");
+    logDebugging(_logger, "Splitting the main method into %d chunks", chunk);
+    chunk = 0;
+    for (Sentence * sentence = program->sentence; sentence != NULL; sentence = (Sentence *) _chunkEnd) {
+        _chunkEnd = _nextChunk(sentence);
+        _output("\tprivate static void $main%d(){\n", chunk++);
+        generateSentence(sentence);
+        _output("\t}\n");
+    }
+    _chunkEnd = NULL;
+}
+
+void generateProgram(Program * program) {
+    beginSpan("io", "open", "output.java");
+    file = fopen("output.java", "wr");
+    endSpan();
+    write = file;
+    _loopCount = 0;
+    _tailCallCount = 0;
+    _builderCount = 0;
+    _accumulators = hashMapInit(sizeof(tDeclarationKey), sizeof(tAccumulator), hashMapStringHash, hashMapStringKeyEquals);
+    _usesIntegerPower = false;
+    _usesLongPower = false;
+    _usesExactPower = false;
+    _usesFloorModulo = false;
+    _usesExactFloorDivision = false;
+    _usesBigDivision = false;
+    _usesIntegerContains = false;
+    _usesLongContains = false;
+    _usesDecimalContains = false;
+    _usesObjectContains = false;
+    _usesMemo = false;
+    _usesWideMemo = false;
+    _usesObjectMemo = false;
+    _usesIntRange = false;
+    _usesLongRange = false;
+    _inlining = NULL;
+    _unpacking = (tUnpacking) { .variable = NULL };
+    _unpackedCount = 0;
+    _flattenedCount = 0;
+    _resultCount = 0;
+    _collectFunctions(program->sentence);
+    _flattenOnlyUnpacked(program->sentence);
+    _usesResultFields = _sentencesUnpackIntoFields(program->sentence);
+    _output("public class Main {\n");
+    _constants = hashMapInit(sizeof(tDeclarationKey), sizeof(tDeclarationKey), hashMapStringHash, hashMapStringKeyEquals);
+    _generateConstants(program->sentence);
+    beginSpan("generation", "function", "main");
+    if (0 < _maximumMethodSize && _maximumMethodSize < _estimateSentencesSize(program->sentence)) {
+        _generateSplitMain(program);
+    } else {
+        _output("\tpublic static void main(String[] args){\n");
+        indentLevel = 2;
+        _beginMethod(NULL, program->sentence);
+        generateSentence(program->sentence);
+        if (_logCacheStatistics) {
+            _generateMemoStatistics(program->sentence);
+        }
+        _output("\n\t}\n");
+    }
+    endSpan();
+    // Functions declare their own locals, even the ones named after a constant.
+    hashMapDestroy(_constants);
+    _constants = NULL;
     indentLevel = 1;
     int funcListLength = getFuncLength();
 
@@ -495,15 +4192,63 @@ void generateProgram(Program * program) {
     funcIterBegin();
     for (int i = 0; i < funcListLength; i++ ){
         block = getNextFunc();
+        const tFlattened * flattened = _flattenedOf(block);
+        if (flattened != NULL && flattened->isOnlyUnpacked) {
+            // Only its flattened variant is ever called.
+            continue;
+        }
+        beginSpan("generation", "function", block->functionDefinition->functionName);
+        if (_isMemoized(block->functionDefinition)) {
+            _outputIndent();
+            _generateMemoizedFunction(block->functionDefinition);
+        }
+        _outputIndent();
         generateFunctionDef(block->functionDefinition);
-        indentLevel++;
+        _beginMethod(block->functionDefinition->parameters, block->nextSentence);
+        _returnType = block->functionDefinition->dataType;
+        // Memoized functions keep their self-calls, so that every intermediate result is cached.
+        _tailFunction = (!_isMemoized(block->functionDefinition) && _hasTailCall(block->nextSentence, block->functionDefinition))? block->functionDefinition : NULL;
+        if (_tailFunction != NULL) {
+            // Calls in tail position jump back here instead of growing the stack.
+            _outputIndent();
+            _output("$recurse: while (true) {\n");
+            indentLevel++;
+        }
         generateSentence(block->nextSentence);
+        if (block->functionDefinition->dataType == SA_OBJECT && _completesNormally(block->nextSentence)) {
+            // Falling off a Python function returns None.
+            _outputIndent();
+            _output("return null;\n");
+        } else if (_tailFunction != NULL && block->functionDefinition->dataType == SA_VOID && _completesNormally(block->nextSentence)) {
+            _outputIndent();
+            _output("return;\n");
+        }
+        if (_tailFunction != NULL) {
+            indentLevel--;
+            _outputBraceWithIndent();
+            _tailFunction = NULL;
+        }
+        _returnType = SA_VOID;
         indentLevel--;
         _outputBraceWithIndent();
-        
+        endSpan();
+    }
+    // Flattened variants may unpack calls to other functions, which adds their variants too.
+    for (int k = 0; k < _flattenedCount; k++) {
+        _generateFlattenedFunction(&_flattened[k]);
     }
+    _generateHelpers();
     _output("}\n\n");
+    countEmittedBytes(ftell(file));
+    beginSpan("io", "close", "output.java");
     fclose(file);
+    endSpan();
+    hashMapDestroy(_declared);
+    _declared = NULL;
+    hashMapDestroy(_accumulators);
+    _accumulators = NULL;
+    hashMapDestroy(_functions);
+    _functions = NULL;
 }
 
 
@@ -3,7 +3,9 @@
 
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "../../shared/CompilerState.h"
+#include "../../shared/Environment.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
 #include "../../shared/String.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -0,0 +1,491 @@
+#include "LoopInvariantHoister.h"
+#include "../semantic-analysis/HashMap.h"
+
+/* MODULE INTERNAL STATE */
+
+typedef struct {
+	const char * name;
+} AssignedKey;
+
+/** Longest description of a hoisted expression in the report. */
+#define MAXIMUM_DESCRIPTION_LENGTH 160
+
+static Logger * _logger = NULL;
+static boolean _logHoistedCode = false;
+static hashMapADT _assigned = NULL;
+static char ** _temporaries = NULL;
+static int _temporaryCount = 0;
+static int _temporaryCapacity = 0;
+
+void initializeLoopInvariantHoisterModule() {
+	_logger = createLogger("LoopInvariantHoister");
+	_logHoistedCode = getBooleanOrDefault("LOG_HOISTED_CODE", _logHoistedCode);
+}
+
+void shutdownLoopInvariantHoisterModule() {
+	for (int i = 0; i < _temporaryCount; ++i) {
+		free(_temporaries[i]);
+	}
+	free(_temporaries);
+	_temporaries = NULL;
+	_temporaryCount = 0;
+	_temporaryCapacity = 0;
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static void _describe(const Expression * expression, char * buffer, const size_t size);
+
+static void _append(char * buffer, const size_t size, const char * text) {
+	const size_t length = strlen(buffer);
+	if (length + 1 < size) {
+		snprintf(buffer + length, size - length, "%s", text);
+	}
+}
+
+static void _describeParameters(const Parameters * parameters, char * buffer, const size_t size) {
+	for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+		_describe(parameters->leftExpression, buffer, size);
+		if (parameters->rightParameters != NULL && parameters->rightParameters->leftExpression != NULL) {
+			_append(buffer, size, ", ");
+		}
+	}
+}
+
+static const char * _operatorOf(const Expression * expression) {
+	static const char * comparators[] = { " == ", " != ", " > ", " >= ", " < ", " <= ", " in ", " not in ", " is ", " is not " };
+	switch (expression->type) {
+		case ADDITION: return " + ";
+		case SUBTRACTION: return " - ";
+		case MULTIPLICATION: return " * ";
+		case DIVISION: return " / ";
+		case TRUNCATED_DIVISION: return " // ";
+		case MODULO: return " % ";
+		case EXPONENTIATION: return " ** ";
+		case LOGIC_AND: return " and ";
+		case LOGIC_OR: return " or ";
+		case COMPARISON_EXPRESSION: return comparators[expression->compType];
+		default: return " ? ";
+	}
+}
+
+/**
+ * Writes the expression back in Python, for the report.
+ */
+static void _describe(const Expression * expression, char * buffer, const size_t size) {
+	char literal[32];
+	switch (expression->type) {
+		case VARIABLE_CALL_EXPRESSION:
+			_append(buffer, size, expression->variableCall->variableName);
+			return;
+		case CONSTANT_EXPRESSION:
+			switch (expression->constant->type) {
+				case CT_INTEGER:
+					snprintf(literal, sizeof(literal), "%lld", expression->constant->integer);
+					_append(buffer, size, literal);
+					return;
+				case CT_FLOAT:
+					snprintf(literal, sizeof(literal), "%g", expression->constant->decimal);
+					_append(buffer, size, literal);
+					return;
+				case CT_BOOLEAN:
+					_append(buffer, size, expression->constant->boolean ? "True" : "False");
+					return;
+				case CT_STRING:
+					_append(buffer, size, expression->constant->string);
+					return;
+				default:
+					_append(buffer, size, expression->constant->type == CT_LIST ? "[" : "(");
+					if (expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+						_describeParameters(expression->constant->list->elements, buffer, size);
+					}
+					_append(buffer, size, expression->constant->type == CT_LIST ? "]" : ")");
+					return;
+			}
+		case FUNCTION_CALL_EXPRESSION:
+			if (expression->functionCall->type == FC_DEF) {
+				_append(buffer, size, expression->functionCall->functionName);
+			} else {
+				_append(buffer, size, expression->functionCall->object->builtinDefinition == BTF_LEN ? "len" : "abs");
+			}
+			_append(buffer, size, "(");
+			_describeParameters(expression->functionCall->functionArguments, buffer, size);
+			_append(buffer, size, ")");
+			return;
+		case LOGIC_NOT:
+			_append(buffer, size, "not ");
+			_describe(expression->notExpression, buffer, size);
+			return;
+		default:
+			_append(buffer, size, "(");
+			_describe(expression->leftExpression, buffer, size);
+			_append(buffer, size, _operatorOf(expression));
+			_describe(expression->rightExpression, buffer, size);
+			_append(buffer, size, ")");
+			return;
+	}
+}
+
+static void _markAssigned(const char * name) {
+	AssignedKey key = { .name = name };
+	hashMapInsertOrUpdate(_assigned, &key, &key);
+}
+
+/**
+ * Collects every local the sentences assign, including the variables of
+ * nested for loops. Nested function definitions have their own locals.
+ */
+static void _collectAssigned(const Sentence * sentence) {
+	for (; sentence != NULL; sentence = sentence->nextSentence) {
+		if (sentence->type == VARIABLE_SENTENCE) {
+			_markAssigned(sentence->variable->identifier);
+		} else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+			const Block * block = sentence->block;
+			if (block->type == BT_FOR) {
+				_markAssigned(block->forBlock->left->variableCall->variableName);
+			}
+			for (; block != NULL; block = (block->type == BT_CONDITIONAL) ? block->nextCond : NULL) {
+				_collectAssigned(block->nextSentence);
+			}
+		}
+	}
+}
+
+static boolean _areInvariant(const Parameters * parameters);
+
+/**
+ * Whether the expression yields the same value on every iteration, has no
+ * side effects and cannot fail. Calls to user functions may have side
+ * effects, so only calls to builtins qualify. Integer divisions and modulos
+ * fail on a zero divisor unless it is a literal.
+ */
+static boolean _isInvariant(const Expression * expression) {
+	AssignedKey key;
+	switch (expression->type) {
+		case CONSTANT_EXPRESSION:
+			if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+				return expression->constant->list->type != LT_TYPED_LIST && _areInvariant(expression->constant->list->elements);
+			}
+			return true;
+		case VARIABLE_CALL_EXPRESSION:
+			key.name = expression->variableCall->variableName;
+			return !hashMapFind(_assigned, &key, NULL);
+		case FUNCTION_CALL_EXPRESSION:
+			return expression->functionCall->type == FC_OBJECT
+				&& (expression->functionCall->object->builtinDefinition == BTF_LEN || expression->functionCall->object->builtinDefinition == BTF_ABS)
+				&& _areInvariant(expression->functionCall->functionArguments);
+		case LOGIC_NOT:
+			return _isInvariant(expression->notExpression);
+		case COMPARISON_EXPRESSION:
+			if (expression->compType == BCT_IDENTITY || expression->compType == BCT_NIDENTITY) {
+				return false;
+			}
+			return _isInvariant(expression->leftCompExpression) && _isInvariant(expression->rightCompExpression);
+		case TRUNCATED_DIVISION:
+		case MODULO: {
+			const Expression * divisor = expression->rightExpression;
+			const boolean isSafeDivisor = expression->dataType == SA_FLOAT
+				|| (divisor->type == CONSTANT_EXPRESSION && divisor->constant->type == CT_INTEGER && divisor->constant->integer != 0);
+			return isSafeDivisor && _isInvariant(expression->leftExpression) && _isInvariant(divisor);
+		}
+		case ADDITION:
+		case SUBTRACTION:
+		case MULTIPLICATION:
+		case DIVISION:
+		case EXPONENTIATION:
+		case LOGIC_AND:
+		case LOGIC_OR:
+			return _isInvariant(expression->leftExpression) && _isInvariant(expression->rightExpression);
+		default:
+			return false;
+	}
+}
+
+static boolean _areInvariant(const Parameters * parameters) {
+	for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+		if (!_isInvariant(parameters->leftExpression)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static boolean _readsVariables(const Expression * expression) {
+	switch (expression->type) {
+		case CONSTANT_EXPRESSION:
+			return false;
+		case VARIABLE_CALL_EXPRESSION:
+		case FUNCTION_CALL_EXPRESSION:
+			return true;
+		case LOGIC_NOT:
+			return _readsVariables(expression->notExpression);
+		default:
+			return _readsVariables(expression->leftExpression) || _readsVariables(expression->rightExpression);
+	}
+}
+
+/**
+ * Whether moving an invariant expression saves work: it must compute
+ * something out of variables, as Java already folds literal operations,
+ * and have a primitive, string or big integer type the temporary can be
+ * declared with.
+ */
+static boolean _isWorthHoisting(const Expression * expression) {
+	switch (expression->dataType) {
+		case SA_INTEGER:
+		case SA_LONG:
+		case SA_BIG_INTEGER:
+		case SA_FLOAT:
+		case SA_BOOLEAN:
+		case SA_CHARACTER:
+		case SA_STRING:
+			break;
+		default:
+			return false;
+	}
+	switch (expression->type) {
+		case CONSTANT_EXPRESSION:
+		case VARIABLE_CALL_EXPRESSION:
+			return false;
+		default:
+			return _readsVariables(expression);
+	}
+}
+
+/**
+ * Assigns the expression to a new temporary, appended to the sentences that
+ * will precede the loop, and returns a reference to that temporary.
+ */
+static Expression * _hoist(Expression * expression, Sentence *** hoisted, const char * loop) {
+	if (_temporaryCount == _temporaryCapacity) {
+		_temporaryCapacity = _temporaryCapacity == 0 ? 16 : 2 * _temporaryCapacity;
+		_temporaries = realloc(_temporaries, _temporaryCapacity * sizeof(char *));
+	}
+	char * name = calloc(24, sizeof(char));
+	snprintf(name, 24, "$invariant%d", _temporaryCount);
+	_temporaries[_temporaryCount++] = name;
+
+	char description[MAXIMUM_DESCRIPTION_LENGTH] = "";
+	_describe(expression, description, sizeof(description));
+	if (_logHoistedCode) {
+		logInformation(_logger, "Hoisted %s out of a %s loop into %s.", description, loop, name);
+	} else {
+		logDebugging(_logger, "Hoisted %s out of a %s loop into %s.", description, loop, name);
+	}
+
+	Variable * variable = calloc(1, sizeof(Variable));
+	variable->identifier = name;
+	variable->expression = expression;
+	variable->dataType = expression->dataType;
+	variable->elementType = expression->elementType;
+	Sentence * sentence = calloc(1, sizeof(Sentence));
+	sentence->variable = variable;
+	sentence->type = VARIABLE_SENTENCE;
+	**hoisted = sentence;
+	*hoisted = &sentence->nextSentence;
+
+	VariableCall * variableCall = calloc(1, sizeof(VariableCall));
+	variableCall->variableName = name;
+	variableCall->type = CALL_TYPE;
+	Expression * reference = calloc(1, sizeof(Expression));
+	reference->variableCall = variableCall;
+	reference->type = VARIABLE_CALL_EXPRESSION;
+	reference->dataType = expression->dataType;
+	reference->elementType = expression->elementType;
+	return reference;
+}
+
+static void _hoistInExpression(Expression ** slot, Sentence *** hoisted, const char * loop);
+
+static void _hoistInParameters(Parameters * parameters, Sentence *** hoisted, const char * loop) {
+	for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+		_hoistInExpression(&parameters->leftExpression, hoisted, loop);
+	}
+}
+
+/**
+ * Hoists the largest invariant subexpressions of the expression.
+ */
+static void _hoistInExpression(Expression ** slot, Sentence *** hoisted, const char * loop) {
+	Expression * expression = *slot;
+	if (expression == NULL) {
+		return;
+	}
+	if (_isInvariant(expression) && _isWorthHoisting(expression)) {
+		*slot = _hoist(expression, hoisted, loop);
+		return;
+	}
+	switch (expression->type) {
+		case CONSTANT_EXPRESSION:
+			if ((expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE)
+					&& expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+				_hoistInParameters(expression->constant->list->elements, hoisted, loop);
+			}
+			return;
+		case FUNCTION_CALL_EXPRESSION:
+			_hoistInParameters(expression->functionCall->functionArguments, hoisted, loop);
+			return;
+		case LOGIC_NOT:
+			_hoistInExpression(&expression->notExpression, hoisted, loop);
+			return;
+		case COMPARISON_EXPRESSION:
+		case ADDITION:
+		case SUBTRACTION:
+		case MULTIPLICATION:
+		case DIVISION:
+		case TRUNCATED_DIVISION:
+		case MODULO:
+		case EXPONENTIATION:
+		case LOGIC_AND:
+		case LOGIC_OR:
+			_hoistInExpression(&expression->leftExpression, hoisted, loop);
+			_hoistInExpression(&expression->rightExpression, hoisted, loop);
+			return;
+		default:
+			return;
+	}
+}
+
+static boolean _isTemporary(const Variable * variable) {
+	return strncmp(variable->identifier, "$invariant", strlen("$invariant")) == 0;
+}
+
+/**
+ * Hoists the invariants of the sentences. The temporaries of an inner loop
+ * whose expression is also invariant to this one are moved out whole.
+ */
+static void _hoistInSentences(Sentence ** link, Sentence *** hoisted, const char * loop) {
+	for (Sentence * sentence = *link; sentence != NULL; link = &sentence->nextSentence, sentence = *link) {
+		while (sentence->type == VARIABLE_SENTENCE && _isTemporary(sentence->variable) && _isInvariant(sentence->variable->expression)) {
+			logDebugging(_logger, "Moved %s out of a %s loop.", sentence->variable->identifier, loop);
+			*link = sentence->nextSentence;
+			sentence->nextSentence = NULL;
+			**hoisted = sentence;
+			*hoisted = &sentence->nextSentence;
+			sentence = *link;
+			if (sentence == NULL) {
+				return;
+			}
+		}
+		switch (sentence->type) {
+			case VARIABLE_SENTENCE:
+				_hoistInExpression(&sentence->variable->expression, hoisted, loop);
+				break;
+			case RETURN_SENTENCE:
+				_hoistInExpression(&sentence->expression, hoisted, loop);
+				break;
+			case EXPRESSION_SENTENCE:
+				// The sentence itself must remain an expression Java accepts as a statement.
+				if (sentence->expression->type == FUNCTION_CALL_EXPRESSION) {
+					_hoistInParameters(sentence->expression->functionCall->functionArguments, hoisted, loop);
+				}
+				break;
+			case BLOCK_SENTENCE: {
+				Block * block = sentence->block;
+				switch (block->type) {
+					case BT_CONDITIONAL:
+						for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+							_hoistInExpression(&block->conditional->expression, hoisted, loop);
+							_hoistInSentences(&block->nextSentence, hoisted, loop);
+						}
+						break;
+					case BT_WHILE:
+						_hoistInExpression(&block->whileBlock->expression, hoisted, loop);
+						_hoistInSentences(&block->nextSentence, hoisted, loop);
+						break;
+					case BT_FOR:
+						_hoistInExpression(&block->forBlock->right, hoisted, loop);
+						_hoistInSentences(&block->nextSentence, hoisted, loop);
+						break;
+					default:
+						break;
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * Hoists the invariants of the loop in the sentence, and inserts their
+ * temporaries before it. Returns the link that follows the loop.
+ */
+static Sentence ** _hoistLoop(Sentence ** link) {
+	Sentence * loop = *link;
+	Block * block = loop->block;
+	const char * kind = (block->type == BT_WHILE) ? "while" : "for";
+	_assigned = hashMapInit(sizeof(AssignedKey), sizeof(AssignedKey), hashMapStringHash, hashMapStringKeyEquals);
+	if (block->type == BT_FOR) {
+		_markAssigned(block->forBlock->left->variableCall->variableName);
+	}
+	_collectAssigned(block->nextSentence);
+
+	Sentence * hoisted = NULL;
+	Sentence ** tail = &hoisted;
+	if (block->type == BT_WHILE) {
+		_hoistInExpression(&block->whileBlock->expression, &tail, kind);
+	}
+	_hoistInSentences(&block->nextSentence, &tail, kind);
+	hashMapDestroy(_assigned);
+	_assigned = NULL;
+
+	if (hoisted != NULL) {
+		*tail = loop;
+		*link = hoisted;
+	}
+	return &loop->nextSentence;
+}
+
+/**
+ * Visits the loops of the sentences from the innermost, so that an
+ * expression invariant to several nested loops ends before the outermost.
+ */
+static void _hoistInLoops(Sentence ** link) {
+	while (*link != NULL) {
+		Sentence * sentence = *link;
+		if (sentence->type != BLOCK_SENTENCE) {
+			link = &sentence->nextSentence;
+			continue;
+		}
+		Block * block = sentence->block;
+		switch (block->type) {
+			case BT_CONDITIONAL:
+				for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+					_hoistInLoops(&block->nextSentence);
+				}
+				link = &sentence->nextSentence;
+				break;
+			case BT_WHILE:
+			case BT_FOR:
+				_hoistInLoops(&block->nextSentence);
+				link = _hoistLoop(link);
+				break;
+			default:
+				_hoistInLoops(&block->nextSentence);
+				link = &sentence->nextSentence;
+				break;
+		}
+	}
+}
+
+/** PUBLIC FUNCTIONS */
+
+void hoistLoopInvariants(Program * program) {
+	if (program == NULL) {
+		return;
+	}
+	logDebugging(_logger, "Hoisting loop invariants...");
+	const int previousCount = _temporaryCount;
+	for (Program * current = program; current != NULL; current = current->nextProgram) {
+		_hoistInLoops(&current->sentence);
+	}
+	if (_logHoistedCode && _temporaryCount > previousCount) {
+		logInformation(_logger, "Hoisted %d loop invariant expression(s).", _temporaryCount - previousCount);
+	}
+	logDebugging(_logger, "Loop invariant hoisting is done.");
+}
@@ -0,0 +1,24 @@
+#ifndef LOOP_INVARIANT_HOISTER_HEADER
+#define LOOP_INVARIANT_HOISTER_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+
+/** Initialize module's internal state. */
+void initializeLoopInvariantHoisterModule();
+
+/** Shutdown module's internal state. */
+void shutdownLoopInvariantHoisterModule();
+
+/**
+ * Moves every expression of a while or for loop that computes the same value
+ * on each iteration into a temporary assigned right before the loop. Only
+ * expressions free of side effects and that cannot fail are moved, so the
+ * program behaves the same even if the loop never iterates. Must run after
+ * the types were inferred, as temporaries take the type of their expression.
+ */
+void hoistLoopInvariants(Program * program);
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef BYTECODE_HEADER
+#define BYTECODE_HEADER
+
+#include "../../shared/Type.h"
+#include <stdint.h>
+
+/**
+ * The instruction set of the virtual machine. Every instruction works on the
+ * registers of the running function, named by "a" and "b", while "c" is a
+ * third register, a constant, an immediate value or the instruction to jump
+ * to, depending on the opcode:
+ *
+ *   MOVE a b                  a = b
+ *   LOAD_CONSTANT a c         a = constants[c]
+ *   LOAD_INTEGER a c          a = c
+ *   LOAD_NONE a               a = None
+ *   GET_GLOBAL a c            a = globals[c]
+ *   SET_GLOBAL a c            globals[c] = a
+ *   ADD ... POWER a b c       a = b <operator> c
+ *   EQUAL ... IS_NOT a b c    a = b <comparator> c
+ *   CONTAINS a b c            a = b in c
+ *   NOT a b                   a = not b
+ *   JUMP c                    continues on the instruction c
+ *   JUMP_IF_FALSE a c         jumps to c unless a is truthy
+ *   JUMP_UNLESS_EQUAL a b c   jumps to c unless a == b, and so on
+ *   NEW_LIST a b c            a = [b, b + 1, ..., b + c - 1]
+ *   CHECK_LENGTH a c          fails unless a holds exactly c elements
+ *   GET_ELEMENT a b c         a = b[c]
+ *   RANGE_PREPARE a           checks the start, stop and step on a, a + 1 and a + 2
+ *   RANGE_LOOP a c            a + 3 = a and a += a + 2 while in range, else jumps to c
+ *   ITERATE_PREPARE a         checks that a is iterable, and a + 1 = 0
+ *   ITERATE_LOOP a c          a + 2 = a[a + 1++] while in bounds, else jumps to c
+ *   CALL a b                  a = functions[b](a, a + 1, ...)
+ *   TAIL_CALL a               restarts the function with arguments a, a + 1, ...
+ *   CALL_BUILTIN a b c        a = builtin b of the c values a, a + 1, ...
+ *   RETURN a                  returns a
+ *   RETURN_NONE               returns None
+ */
+#define BYTECODE_OPCODES(X) \
+    X(MOVE) \
+    X(LOAD_CONSTANT) \
+    X(LOAD_INTEGER) \
+    X(LOAD_NONE) \
+    X(GET_GLOBAL) \
+    X(SET_GLOBAL) \
+    X(ADD) \
+    X(SUBTRACT) \
+    X(MULTIPLY) \
+    X(DIVIDE) \
+    X(FLOOR_DIVIDE) \
+    X(MODULO) \
+    X(POWER) \
+    X(EQUAL) \
+    X(NOT_EQUAL) \
+    X(LESS) \
+    X(LESS_EQUAL) \
+    X(GREATER) \
+    X(GREATER_EQUAL) \
+    X(CONTAINS) \
+    X(NOT_CONTAINS) \
+    X(IS) \
+    X(IS_NOT) \
+    X(NOT) \
+    X(JUMP) \
+    X(JUMP_IF_FALSE) \
+    X(JUMP_IF_TRUE) \
+    X(JUMP_UNLESS_EQUAL) \
+    X(JUMP_UNLESS_NOT_EQUAL) \
+    X(JUMP_UNLESS_LESS) \
+    X(JUMP_UNLESS_LESS_EQUAL) \
+    X(JUMP_UNLESS_GREATER) \
+    X(JUMP_UNLESS_GREATER_EQUAL) \
+    X(NEW_LIST) \
+    X(NEW_TUPLE) \
+    X(CHECK_LENGTH) \
+    X(GET_ELEMENT) \
+    X(RANGE_PREPARE) \
+    X(RANGE_LOOP) \
+    X(ITERATE_PREPARE) \
+    X(ITERATE_LOOP) \
+    X(CALL) \
+    X(TAIL_CALL) \
+    X(CALL_BUILTIN) \
+    X(RETURN) \
+    X(RETURN_NONE)
+
+#define BYTECODE_OPCODE_ENUMERATOR(name) BC_##name,
+
+typedef enum {
+    BYTECODE_OPCODES(BYTECODE_OPCODE_ENUMERATOR)
+    BC_OPCODE_COUNT
+} Opcode;
+
+typedef struct {
+    uint8_t opcode;
+    uint16_t a;
+    uint16_t b;
+    int32_t c;
+} Instruction;
+
+/** The types of the values, tagged on every register. */
+typedef enum {
+    CRVT_NONE,
+    CRVT_BOOLEAN,
+    CRVT_INTEGER,
+    CRVT_FLOAT,
+    CRVT_STRING,
+    CRVT_LIST,
+    CRVT_TUPLE,
+    /** The value of a global not assigned yet. */
+    CRVT_UNDEFINED
+} ComputationType;
+
+/** The builtins the virtual machine implements, called with CALL_BUILTIN. */
+typedef enum {
+    BB_ABS,
+    BB_BOOL,
+    BB_FLOAT,
+    BB_INT,
+    BB_LEN,
+    BB_MIN,
+    BB_STR,
+    BB_SUM
+} BytecodeBuiltin;
+
+/** A constant of the program, whose strings get interned when it starts running. */
+typedef struct {
+    ComputationType type;
+    union {
+        boolean boolean;
+        long long integer;
+        double decimal;
+        char * string;
+    };
+} BytecodeConstant;
+
+typedef struct {
+    char * name;
+    Instruction * code;
+    int length;
+    int capacity;
+    int parameterCount;
+    /** The registers of a call, where the parameters come first. */
+    int registerCount;
+    /** Whether results are memoized by argument, as "@cache" asks. */
+    boolean isCached;
+} BytecodeFunction;
+
+/**
+ * A compiled program. The first function holds the top-level sentences,
+ * whose variables are globals.
+ */
+typedef struct {
+    BytecodeFunction * functions;
+    int functionCount;
+    BytecodeConstant * constants;
+    int constantCount;
+    char ** globals;
+    int globalCount;
+} BytecodeProgram;
+
+#endif
@@ -0,0 +1,899 @@
+#include "BytecodeCompiler.h"
+#include "../semantic-analysis/HashMap.h"
+#include "../semantic-analysis/SemanticAnalyzer.h"
+
+/** The most registers a single call may use, as instructions name them with 16 bits. */
+#define MAXIMUM_REGISTERS 65535
+
+/** The end of a list of pending jumps, which are chained through their targets until patched. */
+#define NO_JUMP -1
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+/** Whether to log the compiled bytecode at INFORMATION level. */
+static boolean _logBytecode = false;
+
+/** Whether some construct of the program cannot run on the virtual machine. */
+static boolean _isUnsupported = false;
+
+static BytecodeProgram * _bytecode = NULL;
+static BytecodeFunction * _function = NULL;
+
+typedef struct {
+    const char * name;
+    int index;
+} tNamed;
+
+/** The indexes of the top-level functions and of the globals, by name. */
+static hashMapADT _functions = NULL;
+static hashMapADT _globals = NULL;
+
+/** The registers of the locals of the function being compiled, by name. */
+static hashMapADT _locals = NULL;
+
+/** The first register free for temporaries, which are released in the opposite order they were reserved. */
+static int _nextRegister = 0;
+
+static const char * const _opcodeNames[] = {
+#define BYTECODE_OPCODE_NAME(name) #name,
+    BYTECODE_OPCODES(BYTECODE_OPCODE_NAME)
+#undef BYTECODE_OPCODE_NAME
+};
+
+void initializeBytecodeCompilerModule() {
+    _logger = createLogger("BytecodeCompiler");
+    _logBytecode = getBooleanOrDefault("LOG_BYTECODE", _logBytecode);
+}
+
+void shutdownBytecodeCompilerModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/** PRIVATE FUNCTIONS */
+
+static void _unsupported(const char * construct) {
+    logError(_logger, "The virtual machine does not support %s.", construct);
+    _isUnsupported = true;
+}
+
+/* INSTRUCTIONS */
+
+static int _emit(const Opcode opcode, const int a, const int b, const int c) {
+    if (_function->length == _function->capacity) {
+        _function->capacity = (_function->capacity == 0)? 64 : 2 * _function->capacity;
+        _function->code = realloc(_function->code, _function->capacity * sizeof(Instruction));
+    }
+    _function->code[_function->length] = (Instruction) { .opcode = opcode, .a = (uint16_t) a, .b = (uint16_t) b, .c = c };
+    return _function->length++;
+}
+
+static int _here() {
+    return _function->length;
+}
+
+static int _emitJump(const Opcode opcode, const int a, const int b) {
+    return _emit(opcode, a, b, NO_JUMP);
+}
+
+/** Appends a list of pending jumps to another one. */
+static int _concatenateJumps(const int jumps, const int others) {
+    if (jumps == NO_JUMP) {
+        return others;
+    }
+    int last = jumps;
+    while (_function->code[last].c != NO_JUMP) {
+        last = _function->code[last].c;
+    }
+    _function->code[last].c = others;
+    return jumps;
+}
+
+static void _patchJumps(int jumps, const int target) {
+    while (jumps != NO_JUMP) {
+        const int next = _function->code[jumps].c;
+        _function->code[jumps].c = target;
+        jumps = next;
+    }
+}
+
+/* REGISTERS AND NAMES */
+
+static int _reserveRegisters(const int count) {
+    const int first = _nextRegister;
+    _nextRegister += count;
+    if (MAXIMUM_REGISTERS < _nextRegister) {
+        _unsupported("functions with that many locals and temporaries");
+        _nextRegister = first;
+        return 0;
+    }
+    if (_function->registerCount < _nextRegister) {
+        _function->registerCount = _nextRegister;
+    }
+    return first;
+}
+
+static int _findNamed(hashMapADT map, const char * name) {
+    tNamed named = { .name = name, .index = -1 };
+    hashMapFind(map, &named, &named);
+    return named.index;
+}
+
+static void _addNamed(hashMapADT map, const char * name, const int index) {
+    tNamed named = { .name = name, .index = index };
+    hashMapInsertOrUpdate(map, &named, &named);
+}
+
+/** The register of a local, or -1 if the name is global. */
+static int _findLocal(const char * name) {
+    return (_locals == NULL)? -1 : _findNamed(_locals, name);
+}
+
+static int _globalIndex(const char * name) {
+    int index = _findNamed(_globals, name);
+    if (index < 0) {
+        index = _bytecode->globalCount++;
+        _bytecode->globals = realloc(_bytecode->globals, _bytecode->globalCount * sizeof(char *));
+        _bytecode->globals[index] = strdup(name);
+        _addNamed(_globals, _bytecode->globals[index], index);
+    }
+    return index;
+}
+
+static void _declareLocal(const char * name) {
+    if (_findLocal(name) < 0) {
+        _addNamed(_locals, name, _reserveRegisters(1));
+    }
+}
+
+/**
+ * Visits every variable the sentences assign, including the loop
+ * variables, but not the ones of function definitions, which Python makes
+ * locals of the function.
+ */
+static void _declareAssigned(const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE) {
+            _declareLocal(sentence->variable->identifier);
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            if (sentence->block->type == BT_FOR && sentence->block->forBlock->left->type == VARIABLE_CALL_EXPRESSION) {
+                _declareLocal(sentence->block->forBlock->left->variableCall->variableName);
+            }
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _declareAssigned(block->nextSentence);
+            }
+        }
+    }
+}
+
+/* CONSTANTS */
+
+static int _addConstant(const BytecodeConstant constant) {
+    _bytecode->constants = realloc(_bytecode->constants, (_bytecode->constantCount + 1) * sizeof(BytecodeConstant));
+    _bytecode->constants[_bytecode->constantCount] = constant;
+    return _bytecode->constantCount++;
+}
+
+/**
+ * Decodes a string literal into its UTF-8 bytes. Returns NULL for unknown
+ * escapes and for the null character, since strings are interned by their
+ * null-terminated bytes.
+ */
+static char * _decodeLiteral(const char * literal) {
+    const int length = strlen(literal);
+    char * text = calloc(length + 1, sizeof(char));
+    int size = 0;
+    for (int k = 1; k < length - 1; k++) {
+        char value = literal[k];
+        if (value == '\\') {
+            switch (literal[++k]) {
+                case 'n': value = '\n'; break;
+                case 't': value = '\t'; break;
+                case 'r': value = '\r'; break;
+                case 'b': value = '\b'; break;
+                case 'f': value = '\f'; break;
+                case '\\': value = '\\'; break;
+                case '"': value = '"'; break;
+                case '\'': value = '\''; break;
+                default:
+                    free(text);
+                    return NULL;
+            }
+        }
+        text[size++] = value;
+    }
+    return text;
+}
+
+/* EXPRESSIONS */
+
+static void _compileInto(Expression * expression, const int target);
+
+/**
+ * The register holding the value of the expression: the one of a local
+ * when it is read as is, or a new temporary otherwise.
+ */
+static int _compileOperand(Expression * expression) {
+    if (expression->type == VARIABLE_CALL_EXPRESSION) {
+        const int local = _findLocal(expression->variableCall->variableName);
+        if (local >= 0) {
+            return local;
+        }
+    }
+    const int temporary = _reserveRegisters(1);
+    _compileInto(expression, temporary);
+    return temporary;
+}
+
+static void _compileBinary(const Opcode opcode, Expression * left, Expression * right, const int target) {
+    const int mark = _nextRegister;
+    const int leftRegister = _compileOperand(left);
+    const int rightRegister = _compileOperand(right);
+    _emit(opcode, target, leftRegister, rightRegister);
+    _nextRegister = mark;
+}
+
+static void _compileConstant(Constant * constant, const int target) {
+    switch (constant->type) {
+        case CT_INTEGER:
+            if (INT32_MIN <= constant->integer && constant->integer <= INT32_MAX) {
+                _emit(BC_LOAD_INTEGER, target, 0, (int32_t) constant->integer);
+            } else {
+                _emit(BC_LOAD_CONSTANT, target, 0, _addConstant((BytecodeConstant) { .type = CRVT_INTEGER, .integer = constant->integer }));
+            }
+            return;
+        case CT_BOOLEAN:
+            _emit(BC_LOAD_CONSTANT, target, 0, _addConstant((BytecodeConstant) { .type = CRVT_BOOLEAN, .boolean = constant->boolean }));
+            return;
+        case CT_FLOAT:
+            _emit(BC_LOAD_CONSTANT, target, 0, _addConstant((BytecodeConstant) { .type = CRVT_FLOAT, .decimal = constant->decimal }));
+            return;
+        case CT_STRING: {
+            char * text = _decodeLiteral(constant->string);
+            if (text == NULL) {
+                _unsupported("this string literal");
+                return;
+            }
+            _emit(BC_LOAD_CONSTANT, target, 0, _addConstant((BytecodeConstant) { .type = CRVT_STRING, .string = text }));
+            return;
+        }
+        case CT_LIST:
+        case CT_TUPLE: {
+            const List * list = (constant->type == CT_LIST)? constant->list : constant->tuple;
+            int count = 0;
+            for (const Parameters * element = (list->type == LT_PARAMETRIZED_LIST)? list->elements : NULL; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+                count++;
+            }
+            const int mark = _nextRegister;
+            const int first = _reserveRegisters(count);
+            int index = 0;
+            for (const Parameters * element = (list->type == LT_PARAMETRIZED_LIST)? list->elements : NULL; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+                _compileInto(element->leftExpression, first + index++);
+            }
+            _emit((constant->type == CT_LIST)? BC_NEW_LIST : BC_NEW_TUPLE, target, first, count);
+            _nextRegister = mark;
+            return;
+        }
+        default:
+            _unsupported("this constant");
+            return;
+    }
+}
+
+static void _compileVariable(const char * name, const int target) {
+    const int local = _findLocal(name);
+    if (local < 0) {
+        _emit(BC_GET_GLOBAL, target, 0, _globalIndex(name));
+    } else if (local != target) {
+        _emit(BC_MOVE, target, local, 0);
+    }
+}
+
+static void _assignVariable(const char * name, const int source) {
+    const int local = _findLocal(name);
+    if (local < 0) {
+        _emit(BC_SET_GLOBAL, source, 0, _globalIndex(name));
+    } else if (local != source) {
+        _emit(BC_MOVE, local, source, 0);
+    }
+}
+
+static int _countArguments(const Parameters * arguments) {
+    int count = 0;
+    for (; arguments != NULL && arguments->leftExpression != NULL; arguments = arguments->rightParameters) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Evaluates the arguments on consecutive registers above every live one, so
+ * that they become the first registers of the call.
+ */
+static int _compileArguments(Parameters * arguments) {
+    const int count = _countArguments(arguments);
+    const int first = _reserveRegisters((count == 0)? 1 : count);
+    int index = 0;
+    for (; arguments != NULL && arguments->leftExpression != NULL; arguments = arguments->rightParameters) {
+        _compileInto(arguments->leftExpression, first + index++);
+    }
+    return first;
+}
+
+static const struct {
+    const char * name;
+    BuiltinDefinition definition;
+} _builtinNames[] = {
+    { "abs", BTF_ABS },
+    { "bool", BTF_BOOL },
+    { "float", BTF_FLOAT },
+    { "int", BTF_INT },
+    { "len", BTF_LEN },
+    { "min", BTF_MIN },
+    { "str", BTF_STR },
+    { "sum", BTF_SUM }
+};
+
+/**
+ * Whether the call is to a builtin the virtual machine implements, with as
+ * many arguments as it takes. Builtins not resolved by the semantic
+ * analysis come by name, unless a function of the program shadows them.
+ */
+static boolean _builtinOf(const FunctionCall * functionCall, const int count, BytecodeBuiltin * builtin) {
+    BuiltinDefinition definition = BTF_PRINT;
+    if (functionCall->type == FC_OBJECT) {
+        definition = functionCall->object->builtinDefinition;
+    } else if (_findNamed(_functions, functionCall->functionName) < 0) {
+        for (int k = 0; k < sizeof(_builtinNames) / sizeof(_builtinNames[0]); k++) {
+            if (strcmp(functionCall->functionName, _builtinNames[k].name) == 0) {
+                definition = _builtinNames[k].definition;
+            }
+        }
+    }
+    switch (definition) {
+        case BTF_ABS:
+            *builtin = BB_ABS;
+            return count == 1;
+        case BTF_BOOL:
+            *builtin = BB_BOOL;
+            return count <= 1;
+        case BTF_FLOAT:
+            *builtin = BB_FLOAT;
+            return count <= 1;
+        case BTF_INT:
+            *builtin = BB_INT;
+            return count <= 1;
+        case BTF_LEN:
+            *builtin = BB_LEN;
+            return count == 1;
+        case BTF_MIN:
+            *builtin = BB_MIN;
+            return count >= 1;
+        case BTF_STR:
+            *builtin = BB_STR;
+            return count <= 1;
+        case BTF_SUM:
+            *builtin = BB_SUM;
+            return count == 1 || count == 2;
+        default:
+            return false;
+    }
+}
+
+static void _compileFunctionCall(FunctionCall * functionCall, const int target) {
+    const int mark = _nextRegister;
+    const int count = _countArguments(functionCall->functionArguments);
+    BytecodeBuiltin builtin;
+    if (_builtinOf(functionCall, count, &builtin)) {
+        const int first = _compileArguments(functionCall->functionArguments);
+        _emit(BC_CALL_BUILTIN, first, builtin, count);
+        if (first != target) {
+            _emit(BC_MOVE, target, first, 0);
+        }
+        _nextRegister = mark;
+        return;
+    }
+    if (functionCall->type == FC_OBJECT) {
+        _unsupported("this builtin call");
+        return;
+    }
+    const int index = _findNamed(_functions, functionCall->functionName);
+    if (index < 0 || _bytecode->functions[index].parameterCount != count) {
+        _unsupported("calls to undefined functions, or with another number of arguments");
+        return;
+    }
+    const int first = _compileArguments(functionCall->functionArguments);
+    _emit(BC_CALL, first, index, count);
+    if (first != target) {
+        _emit(BC_MOVE, target, first, 0);
+    }
+    _nextRegister = mark;
+}
+
+static Opcode _comparisonOpcode(const BinaryComparatorType comparator) {
+    switch (comparator) {
+        case BCT_EQU:
+            return BC_EQUAL;
+        case BCT_NEQ:
+            return BC_NOT_EQUAL;
+        case BCT_GT:
+            return BC_GREATER;
+        case BCT_GTE:
+            return BC_GREATER_EQUAL;
+        case BCT_LT:
+            return BC_LESS;
+        case BCT_LTE:
+            return BC_LESS_EQUAL;
+        case BCT_MEMBER:
+            return BC_CONTAINS;
+        case BCT_NMEMBER:
+            return BC_NOT_CONTAINS;
+        case BCT_IDENTITY:
+            return BC_IS;
+        default:
+            return BC_IS_NOT;
+    }
+}
+
+/**
+ * Outputs a short-circuit operator, which gives back the operand that
+ * decides it, as Python does.
+ */
+static void _compileLogic(Expression * expression, const int target) {
+    const int mark = _nextRegister;
+    const int result = _reserveRegisters(1);
+    _compileInto(expression->leftExpression, result);
+    const int jump = _emitJump((expression->type == LOGIC_AND)? BC_JUMP_IF_FALSE : BC_JUMP_IF_TRUE, result, 0);
+    _compileInto(expression->rightExpression, result);
+    _patchJumps(jump, _here());
+    _emit(BC_MOVE, target, result, 0);
+    _nextRegister = mark;
+}
+
+static void _compileUnpackedElement(Expression * expression, const int target) {
+    const int mark = _nextRegister;
+    int unpacked = _findLocal(expression->unpackedVariable->identifier);
+    if (unpacked < 0) {
+        unpacked = _reserveRegisters(1);
+        _compileVariable(expression->unpackedVariable->identifier, unpacked);
+    }
+    _emit(BC_GET_ELEMENT, target, unpacked, expression->elementIndex);
+    _nextRegister = mark;
+}
+
+static void _compileInto(Expression * expression, const int target) {
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            _compileConstant(expression->constant, target);
+            return;
+        case ADDITION:
+            _compileBinary(BC_ADD, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case SUBTRACTION:
+            _compileBinary(BC_SUBTRACT, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case MULTIPLICATION:
+            _compileBinary(BC_MULTIPLY, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case DIVISION:
+            _compileBinary(BC_DIVIDE, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case TRUNCATED_DIVISION:
+            _compileBinary(BC_FLOOR_DIVIDE, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case MODULO:
+            _compileBinary(BC_MODULO, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case EXPONENTIATION:
+            _compileBinary(BC_POWER, expression->leftExpression, expression->rightExpression, target);
+            return;
+        case COMPARISON_EXPRESSION:
+            _compileBinary(_comparisonOpcode(expression->compType), expression->leftCompExpression, expression->rightCompExpression, target);
+            return;
+        case LOGIC_AND:
+        case LOGIC_OR:
+            _compileLogic(expression, target);
+            return;
+        case LOGIC_NOT: {
+            const int mark = _nextRegister;
+            _emit(BC_NOT, target, _compileOperand(expression->notExpression), 0);
+            _nextRegister = mark;
+            return;
+        }
+        case VARIABLE_CALL_EXPRESSION:
+            _compileVariable(expression->variableCall->variableName, target);
+            return;
+        case FUNCTION_CALL_EXPRESSION:
+            _compileFunctionCall(expression->functionCall, target);
+            return;
+        case UNPACKED_ELEMENT:
+            _compileUnpackedElement(expression, target);
+            return;
+        default:
+            _unsupported("methods, fields and bitwise operators");
+            return;
+    }
+}
+
+/* CONDITIONS */
+
+/** The fused branch taken unless the comparison holds, if there is one. */
+static boolean _jumpUnlessOpcode(const BinaryComparatorType comparator, Opcode * opcode) {
+    switch (comparator) {
+        case BCT_EQU:
+            *opcode = BC_JUMP_UNLESS_EQUAL;
+            return true;
+        case BCT_NEQ:
+            *opcode = BC_JUMP_UNLESS_NOT_EQUAL;
+            return true;
+        case BCT_GT:
+            *opcode = BC_JUMP_UNLESS_GREATER;
+            return true;
+        case BCT_GTE:
+            *opcode = BC_JUMP_UNLESS_GREATER_EQUAL;
+            return true;
+        case BCT_LT:
+            *opcode = BC_JUMP_UNLESS_LESS;
+            return true;
+        case BCT_LTE:
+            *opcode = BC_JUMP_UNLESS_LESS_EQUAL;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Outputs the jumps taken when the condition has the given truth value,
+ * and returns them pending to be patched, so that conditions never
+ * materialize a boolean. Comparisons branch with a single instruction.
+ */
+static int _compileBranch(Expression * expression, const boolean jumpsIfTrue) {
+    const int mark = _nextRegister;
+    Opcode opcode;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_BOOLEAN) {
+                return (expression->constant->boolean == jumpsIfTrue)? _emitJump(BC_JUMP, 0, 0) : NO_JUMP;
+            }
+            break;
+        case LOGIC_NOT:
+            return _compileBranch(expression->notExpression, !jumpsIfTrue);
+        case LOGIC_AND:
+        case LOGIC_OR:
+            if ((expression->type == LOGIC_AND) != jumpsIfTrue) {
+                // Either operand decides on its own.
+                const int jumps = _compileBranch(expression->leftExpression, jumpsIfTrue);
+                return _concatenateJumps(jumps, _compileBranch(expression->rightExpression, jumpsIfTrue));
+            } else {
+                const int skip = _compileBranch(expression->leftExpression, !jumpsIfTrue);
+                const int jumps = _compileBranch(expression->rightExpression, jumpsIfTrue);
+                _patchJumps(skip, _here());
+                return jumps;
+            }
+        case COMPARISON_EXPRESSION:
+            // Negating an ordering is not the opposite ordering once NaN is compared.
+            if (!jumpsIfTrue && _jumpUnlessOpcode(expression->compType, &opcode)) {
+                const int left = _compileOperand(expression->leftCompExpression);
+                const int right = _compileOperand(expression->rightCompExpression);
+                _nextRegister = mark;
+                return _emitJump(opcode, left, right);
+            }
+            break;
+        default:
+            break;
+    }
+    const int value = _compileOperand(expression);
+    _nextRegister = mark;
+    return _emitJump(jumpsIfTrue? BC_JUMP_IF_TRUE : BC_JUMP_IF_FALSE, value, 0);
+}
+
+/* SENTENCES */
+
+static void _compileSentences(Sentence * sentence);
+
+static boolean _isUnpacking(const Sentence * sentence) {
+    const Sentence * element = sentence->nextSentence;
+    return sentence->type == VARIABLE_SENTENCE && element != NULL && element->type == VARIABLE_SENTENCE
+        && element->variable->expression->type == UNPACKED_ELEMENT
+        && element->variable->expression->unpackedVariable == sentence->variable;
+}
+
+static void _compileAssignment(Sentence * sentence) {
+    const Variable * variable = sentence->variable;
+    const int mark = _nextRegister;
+    int value = _findLocal(variable->identifier);
+    if (value < 0) {
+        value = _reserveRegisters(1);
+    }
+    _compileInto(variable->expression, value);
+    if (_isUnpacking(sentence)) {
+        _emit(BC_CHECK_LENGTH, value, 0, sentence->nextSentence->variable->expression->elementCount);
+    }
+    _assignVariable(variable->identifier, value);
+    _nextRegister = mark;
+}
+
+static void _compileConditional(Block * block) {
+    int ends = NO_JUMP;
+    for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+        int next = NO_JUMP;
+        if (block->conditional->type != CB_ELSE) {
+            next = _compileBranch(block->conditional->expression, false);
+        }
+        _compileSentences(block->nextSentence);
+        if (block->nextCond != NULL && block->nextCond->conditional != NULL) {
+            ends = _concatenateJumps(ends, _emitJump(BC_JUMP, 0, 0));
+        }
+        _patchJumps(next, _here());
+    }
+    _patchJumps(ends, _here());
+}
+
+static void _compileWhile(Block * block) {
+    const int condition = _here();
+    const int exits = _compileBranch(block->whileBlock->expression, false);
+    _compileSentences(block->nextSentence);
+    _emit(BC_JUMP, 0, 0, condition);
+    _patchJumps(exits, _here());
+}
+
+/**
+ * Outputs a for loop, whose state lives on registers reserved until the
+ * loop ends: the start, stop, step and current value of ranges, or the
+ * iterable, the position and the current element of the rest.
+ */
+static void _compileFor(Block * block) {
+    const ForBlock * forBlock = block->forBlock;
+    const int mark = _nextRegister;
+    const Expression * iterable = forBlock->right;
+    if (forBlock->left->type != VARIABLE_CALL_EXPRESSION) {
+        _unsupported("loops that unpack their elements");
+        return;
+    }
+    int state;
+    int element;
+    Opcode loop;
+    if (iterable->type == FUNCTION_CALL_EXPRESSION && isRangeCall(iterable->functionCall)) {
+        Expression * arguments[3] = { NULL, NULL, NULL };
+        const int count = _countArguments(iterable->functionCall->functionArguments);
+        if (count < 1 || 3 < count) {
+            _unsupported("ranges with that many arguments");
+            return;
+        }
+        int index = 0;
+        for (Parameters * argument = iterable->functionCall->functionArguments; index < count; argument = argument->rightParameters) {
+            arguments[index++] = argument->leftExpression;
+        }
+        state = _reserveRegisters(4);
+        if (count == 1) {
+            _emit(BC_LOAD_INTEGER, state, 0, 0);
+            _compileInto(arguments[0], state + 1);
+        } else {
+            _compileInto(arguments[0], state);
+            _compileInto(arguments[1], state + 1);
+        }
+        if (count == 3) {
+            _compileInto(arguments[2], state + 2);
+        } else {
+            _emit(BC_LOAD_INTEGER, state + 2, 0, 1);
+        }
+        _emit(BC_RANGE_PREPARE, state, 0, 0);
+        element = state + 3;
+        loop = BC_RANGE_LOOP;
+    } else {
+        state = _reserveRegisters(3);
+        _compileInto(forBlock->right, state);
+        _emit(BC_ITERATE_PREPARE, state, 0, 0);
+        element = state + 2;
+        loop = BC_ITERATE_LOOP;
+    }
+    const int next = _here();
+    const int exit = _emitJump(loop, state, 0);
+    _assignVariable(forBlock->left->variableCall->variableName, element);
+    _compileSentences(block->nextSentence);
+    _emit(BC_JUMP, 0, 0, next);
+    _patchJumps(exit, _here());
+    _nextRegister = mark;
+}
+
+/**
+ * Whether the expression calls the function being compiled from a return,
+ * so that the call reuses its registers. Memoized functions keep their
+ * calls, so that every intermediate result is cached.
+ */
+static boolean _isTailCall(const Expression * expression) {
+    return expression->type == FUNCTION_CALL_EXPRESSION && expression->functionCall->type == FC_DEF
+        && !_function->isCached && _function != &_bytecode->functions[0]
+        && strcmp(expression->functionCall->functionName, _function->name) == 0
+        && _countArguments(expression->functionCall->functionArguments) == _function->parameterCount;
+}
+
+static void _compileReturn(Sentence * sentence) {
+    const int mark = _nextRegister;
+    if (sentence->expression == NULL) {
+        _emit(BC_RETURN_NONE, 0, 0, 0);
+    } else if (_isTailCall(sentence->expression)) {
+        _emit(BC_TAIL_CALL, _compileArguments(sentence->expression->functionCall->functionArguments), 0, 0);
+    } else {
+        _emit(BC_RETURN, _compileOperand(sentence->expression), 0, 0);
+    }
+    _nextRegister = mark;
+}
+
+static void _compileBlock(Block * block) {
+    switch (block->type) {
+        case BT_CONDITIONAL:
+            _compileConditional(block);
+            return;
+        case BT_WHILE:
+            _compileWhile(block);
+            return;
+        case BT_FOR:
+            _compileFor(block);
+            return;
+        case BT_FUNCTION_DEFINITION:
+            // Top-level functions are compiled on their own, ahead.
+            if (_function != &_bytecode->functions[0]) {
+                _unsupported("nested function definitions");
+            }
+            return;
+        default:
+            _unsupported("class definitions");
+            return;
+    }
+}
+
+static void _compileSentences(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case EXPRESSION_SENTENCE: {
+                const int mark = _nextRegister;
+                _compileInto(sentence->expression, _reserveRegisters(1));
+                _nextRegister = mark;
+                break;
+            }
+            case VARIABLE_SENTENCE:
+                _compileAssignment(sentence);
+                break;
+            case BLOCK_SENTENCE:
+                _compileBlock(sentence->block);
+                break;
+            case RETURN_SENTENCE:
+                _compileReturn(sentence);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/* FUNCTIONS */
+
+/**
+ * Gives an index to every function defined out of other functions, before
+ * compiling any, so that calls may come before definitions.
+ */
+static void _collectFunctions(Sentence * sentence, Block *** blocks) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        Block * block = sentence->block;
+        if (block->type == BT_FUNCTION_DEFINITION) {
+            const FunctionDefinition * definition = block->functionDefinition;
+            if (_findNamed(_functions, definition->functionName) >= 0) {
+                _unsupported("functions defined twice");
+                continue;
+            }
+            const int index = _bytecode->functionCount++;
+            _bytecode->functions = realloc(_bytecode->functions, _bytecode->functionCount * sizeof(BytecodeFunction));
+            *blocks = realloc(*blocks, _bytecode->functionCount * sizeof(Block *));
+            (*blocks)[index] = block;
+            _bytecode->functions[index] = (BytecodeFunction) {
+                .name = strdup(definition->functionName),
+                .parameterCount = _countArguments(definition->parameters),
+                .isCached = definition->isCached
+            };
+            _addNamed(_functions, _bytecode->functions[index].name, index);
+        } else if (block->type != BT_CLASS_DEFINITION) {
+            for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _collectFunctions(block->nextSentence, blocks);
+            }
+        }
+    }
+}
+
+static void _compileFunction(const int index, Block * block) {
+    _function = &_bytecode->functions[index];
+    _nextRegister = 0;
+    _locals = hashMapInit(sizeof(tNamed), sizeof(tNamed), hashMapStringHash, hashMapStringKeyEquals);
+    for (const Parameters * parameter = block->functionDefinition->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+        if (parameter->leftExpression->type != VARIABLE_CALL_EXPRESSION) {
+            _unsupported("parameters with default values");
+            break;
+        }
+        _addNamed(_locals, parameter->leftExpression->variableCall->variableName, _reserveRegisters(1));
+    }
+    _declareAssigned(block->nextSentence);
+    _compileSentences(block->nextSentence);
+    // Falling off a Python function returns None.
+    _emit(BC_RETURN_NONE, 0, 0, 0);
+    hashMapDestroy(_locals);
+    _locals = NULL;
+}
+
+static void _logFunction(const BytecodeFunction * function) {
+    logInformation(_logger, "Function %s (%d parameter(s), %d register(s)%s):", function->name,
+        function->parameterCount, function->registerCount, function->isCached? ", cached" : "");
+    for (int k = 0; k < function->length; k++) {
+        const Instruction * instruction = &function->code[k];
+        logInformation(_logger, "  %04d %-26s %5d %5d %7d", k, _opcodeNames[instruction->opcode], instruction->a, instruction->b, instruction->c);
+    }
+}
+
+/** PUBLIC FUNCTIONS */
+
+BytecodeProgram * compileBytecode(Program * program) {
+    logDebugging(_logger, "Compiling bytecode...");
+    _isUnsupported = false;
+    _bytecode = calloc(1, sizeof(BytecodeProgram));
+    _functions = hashMapInit(sizeof(tNamed), sizeof(tNamed), hashMapStringHash, hashMapStringKeyEquals);
+    _globals = hashMapInit(sizeof(tNamed), sizeof(tNamed), hashMapStringHash, hashMapStringKeyEquals);
+    Block ** blocks = NULL;
+    _bytecode->functionCount = 1;
+    _bytecode->functions = calloc(1, sizeof(BytecodeFunction));
+    _bytecode->functions[0].name = strdup("<module>");
+    blocks = calloc(1, sizeof(Block *));
+    _collectFunctions(program->sentence, &blocks);
+    for (int k = 1; k < _bytecode->functionCount; k++) {
+        _compileFunction(k, blocks[k]);
+    }
+    // The top-level sentences have no locals, only temporaries.
+    _function = &_bytecode->functions[0];
+    _nextRegister = 0;
+    _compileSentences(program->sentence);
+    _emit(BC_RETURN_NONE, 0, 0, 0);
+    free(blocks);
+    hashMapDestroy(_functions);
+    hashMapDestroy(_globals);
+    _functions = NULL;
+    _globals = NULL;
+    if (_isUnsupported) {
+        releaseBytecode(_bytecode);
+        _bytecode = NULL;
+        return NULL;
+    }
+    if (_logBytecode) {
+        for (int k = 0; k < _bytecode->functionCount; k++) {
+            _logFunction(&_bytecode->functions[k]);
+        }
+    }
+    logDebugging(_logger, "Bytecode compilation is done.");
+    return _bytecode;
+}
+
+void releaseBytecode(BytecodeProgram * bytecode) {
+    if (bytecode == NULL) {
+        return;
+    }
+    for (int k = 0; k < bytecode->functionCount; k++) {
+        free(bytecode->functions[k].name);
+        free(bytecode->functions[k].code);
+    }
+    for (int k = 0; k < bytecode->constantCount; k++) {
+        if (bytecode->constants[k].type == CRVT_STRING) {
+            free(bytecode->constants[k].string);
+        }
+    }
+    for (int k = 0; k < bytecode->globalCount; k++) {
+        free(bytecode->globals[k]);
+    }
+    free(bytecode->functions);
+    free(bytecode->constants);
+    free(bytecode->globals);
+    free(bytecode);
+}
@@ -0,0 +1,29 @@
+#ifndef BYTECODE_COMPILER_HEADER
+#define BYTECODE_COMPILER_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Bytecode.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeBytecodeCompilerModule();
+
+/** Shutdown module's internal state. */
+void shutdownBytecodeCompilerModule();
+
+/**
+ * Compiles the analyzed program to the register bytecode of the virtual
+ * machine. Locals and temporaries of each function live in registers, and
+ * top-level variables in globals. Returns NULL if the program uses a
+ * construct the virtual machine cannot run, such as classes, methods or
+ * nested functions.
+ */
+BytecodeProgram * compileBytecode(Program * program);
+
+/** Releases a compiled program. */
+void releaseBytecode(BytecodeProgram * bytecode);
+
+#endif
@@ -0,0 +1,1650 @@
+#include "VirtualMachine.h"
+#include "../semantic-analysis/HashMap.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+
+/** The size of the blocks the arena takes from the heap, unless an object needs more. */
+#define ARENA_BLOCK_SIZE 65536
+
+/** The deepest chain of calls, past which the program fails instead of exhausting the memory. */
+#define MAXIMUM_CALL_DEPTH 100000
+
+#define MAXIMUM_ERROR_LENGTH 512
+
+typedef struct VmString VmString;
+typedef struct VmList VmList;
+
+/** A value, tagged with its type. Integers, floats and booleans are never boxed. */
+typedef struct {
+    ComputationType type;
+    union {
+        boolean booleanValue;
+        long long integerValue;
+        double floatValue;
+        VmString * stringValue;
+        VmList * listValue;
+    };
+} ComputationResult;
+
+/** An interned string, so that equal strings are the same. */
+struct VmString {
+    /** The bytes of the UTF-8 encoding. */
+    int size;
+    /** The code points. */
+    int length;
+    char chars[];
+};
+
+/** A list or a tuple, which cannot change once built. */
+struct VmList {
+    int size;
+    ComputationResult elements[];
+};
+
+typedef struct ArenaBlock {
+    struct ArenaBlock * next;
+    size_t used;
+    size_t capacity;
+    long long memory[];
+} ArenaBlock;
+
+typedef struct {
+    const char * chars;
+} tInterned;
+
+typedef struct {
+    uint64_t hash;
+    /** The arguments of the call, or NULL if the entry is free. */
+    VmList * arguments;
+    ComputationResult result;
+} MemoEntry;
+
+/** The results of a "@cache" function, by arguments, in an open addressing table. */
+typedef struct {
+    MemoEntry * entries;
+    int capacity;
+    int size;
+    long hits;
+    long misses;
+} MemoTable;
+
+typedef struct {
+    const BytecodeFunction * function;
+    /** The first register of the call in the register stack. */
+    int base;
+    /** Where the function continues when its callee returns. */
+    const Instruction * returnAddress;
+    /** The arguments of a memoized call, kept to fill the memo table when it returns. */
+    VmList * memoArguments;
+    uint64_t memoHash;
+} Frame;
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+static boolean _isVirtualMachine = false;
+
+/** Whether to report the hits and misses of the memo tables when the program ends. */
+static boolean _logCacheStatistics = false;
+
+static const BytecodeProgram * _program = NULL;
+
+static ArenaBlock * _arena = NULL;
+static hashMapADT _interned = NULL;
+static VmString * _characters[128];
+
+static ComputationResult * _constants = NULL;
+static ComputationResult * _globals = NULL;
+static MemoTable * _memos = NULL;
+
+static ComputationResult * _stack = NULL;
+static int _stackCapacity = 0;
+static Frame * _frames = NULL;
+static int _frameCount = 0;
+static int _frameCapacity = 0;
+
+/** A growable buffer where strings are built before being interned. */
+static char * _buffer = NULL;
+static int _bufferSize = 0;
+static int _bufferCapacity = 0;
+
+static char _error[MAXIMUM_ERROR_LENGTH];
+
+void initializeVirtualMachineModule() {
+    _logger = createLogger("VirtualMachine");
+    _isVirtualMachine = strcmp(getStringOrDefault("TARGET_LANGUAGE", "JAVA"), "VM") == 0;
+    _logCacheStatistics = getBooleanOrDefault("LOG_CACHE_STATISTICS", _logCacheStatistics);
+}
+
+void shutdownVirtualMachineModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/** PRIVATE FUNCTIONS */
+
+static boolean _raise(const char * format, ...) {
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(_error, MAXIMUM_ERROR_LENGTH, format, arguments);
+    va_end(arguments);
+    return false;
+}
+
+/* MEMORY */
+
+static void * _allocate(size_t size) {
+    size = (size + sizeof(long long) - 1) & ~(sizeof(long long) - 1);
+    if (_arena == NULL || _arena->capacity - _arena->used < size) {
+        const size_t capacity = (size < ARENA_BLOCK_SIZE)? ARENA_BLOCK_SIZE : size;
+        ArenaBlock * block = malloc(sizeof(ArenaBlock) + capacity);
+        block->next = _arena;
+        block->used = 0;
+        block->capacity = capacity;
+        _arena = block;
+    }
+    void * memory = (char *) _arena->memory + _arena->used;
+    _arena->used += size;
+    return memory;
+}
+
+static void _releaseArena() {
+    while (_arena != NULL) {
+        ArenaBlock * next = _arena->next;
+        free(_arena);
+        _arena = next;
+    }
+}
+
+static void _append(const char * chars, const int size) {
+    if (_bufferCapacity <= _bufferSize + size) {
+        while (_bufferCapacity <= _bufferSize + size) {
+            _bufferCapacity = (_bufferCapacity == 0)? 256 : 2 * _bufferCapacity;
+        }
+        _buffer = realloc(_buffer, _bufferCapacity);
+    }
+    memcpy(_buffer + _bufferSize, chars, size);
+    _bufferSize += size;
+    _buffer[_bufferSize] = '\0';
+}
+
+static void _appendText(const char * text) {
+    _append(text, strlen(text));
+}
+
+/* VALUES */
+
+static inline ComputationResult _none() {
+    return (ComputationResult) { .type = CRVT_NONE, .integerValue = 0 };
+}
+
+static inline ComputationResult _boolean(const boolean value) {
+    return (ComputationResult) { .type = CRVT_BOOLEAN, .booleanValue = value };
+}
+
+static inline ComputationResult _integer(const long long value) {
+    return (ComputationResult) { .type = CRVT_INTEGER, .integerValue = value };
+}
+
+static inline ComputationResult _float(const double value) {
+    return (ComputationResult) { .type = CRVT_FLOAT, .floatValue = value };
+}
+
+static inline ComputationResult _string(VmString * value) {
+    return (ComputationResult) { .type = CRVT_STRING, .stringValue = value };
+}
+
+static VmList * _newList(const int size) {
+    VmList * list = _allocate(sizeof(VmList) + size * sizeof(ComputationResult));
+    list->size = size;
+    return list;
+}
+
+static inline ComputationResult _list(const ComputationType type, VmList * value) {
+    return (ComputationResult) { .type = type, .listValue = value };
+}
+
+static const char * _typeName(const ComputationType type) {
+    switch (type) {
+        case CRVT_NONE:
+            return "NoneType";
+        case CRVT_BOOLEAN:
+            return "bool";
+        case CRVT_INTEGER:
+            return "int";
+        case CRVT_FLOAT:
+            return "float";
+        case CRVT_STRING:
+            return "str";
+        case CRVT_LIST:
+            return "list";
+        default:
+            return "tuple";
+    }
+}
+
+static inline boolean _isIntegral(const ComputationResult * value) {
+    return value->type == CRVT_INTEGER || value->type == CRVT_BOOLEAN;
+}
+
+static inline boolean _isNumber(const ComputationResult * value) {
+    return _isIntegral(value) || value->type == CRVT_FLOAT;
+}
+
+static inline boolean _isSequence(const ComputationResult * value) {
+    return value->type == CRVT_LIST || value->type == CRVT_TUPLE;
+}
+
+/** The value of an integer or a boolean. */
+static inline long long _integerOf(const ComputationResult * value) {
+    return (value->type == CRVT_BOOLEAN)? (long long) value->booleanValue : value->integerValue;
+}
+
+static inline double _floatOf(const ComputationResult * value) {
+    return (value->type == CRVT_FLOAT)? value->floatValue : (double) _integerOf(value);
+}
+
+static inline boolean _isTruthy(const ComputationResult * value) {
+    switch (value->type) {
+        case CRVT_BOOLEAN:
+            return value->booleanValue;
+        case CRVT_INTEGER:
+            return value->integerValue != 0;
+        case CRVT_FLOAT:
+            return value->floatValue != 0.0;
+        case CRVT_STRING:
+            return value->stringValue->size != 0;
+        case CRVT_LIST:
+        case CRVT_TUPLE:
+            return value->listValue->size != 0;
+        default:
+            return false;
+    }
+}
+
+/* STRINGS */
+
+static int _countCodePoints(const char * chars, const int size) {
+    int length = 0;
+    for (int k = 0; k < size; k++) {
+        length += (chars[k] & 0xC0) != 0x80;
+    }
+    return length;
+}
+
+/** The string with the given null-terminated bytes, created the first time they are seen. */
+static VmString * _intern(const char * chars, const int size) {
+    tInterned key = { .chars = chars };
+    VmString * string = NULL;
+    if (hashMapFind(_interned, &key, &string)) {
+        return string;
+    }
+    string = _allocate(sizeof(VmString) + size + 1);
+    string->size = size;
+    string->length = _countCodePoints(chars, size);
+    memcpy(string->chars, chars, size + 1);
+    key.chars = string->chars;
+    hashMapInsertOrUpdate(_interned, &key, &string);
+    return string;
+}
+
+/** Interns the string built on the buffer. */
+static VmString * _internBuffer() {
+    _append("", 0);
+    return _intern(_buffer, _bufferSize);
+}
+
+/** The string of the code point starting at the given bytes. */
+static VmString * _character(const char * chars, const int size) {
+    char character[8] = { 0 };
+    memcpy(character, chars, (size < 8)? size : 7);
+    if (size == 1 && (unsigned char) chars[0] < 128) {
+        if (_characters[(int) chars[0]] == NULL) {
+            _characters[(int) chars[0]] = _intern(character, 1);
+        }
+        return _characters[(int) chars[0]];
+    }
+    return _intern(character, size);
+}
+
+static int _codePointSize(const char * chars) {
+    int size = 1;
+    while ((chars[size] & 0xC0) == 0x80) {
+        size++;
+    }
+    return size;
+}
+
+/* REPRESENTATIONS */
+
+static void _appendRepresentation(const ComputationResult * value);
+
+/** Appends the shortest decimal that reads back as the float, as Python does. */
+static void _appendFloat(const double value) {
+    if (isnan(value)) {
+        _appendText("nan");
+        return;
+    }
+    if (isinf(value)) {
+        _appendText((value < 0)? "-inf" : "inf");
+        return;
+    }
+    char scientific[32];
+    for (int precision = 1; precision <= 17; precision++) {
+        snprintf(scientific, sizeof(scientific), "%.*e", precision - 1, value);
+        if (strtod(scientific, NULL) == value) {
+            break;
+        }
+    }
+    // Splits "-d.ddde+XX" in its sign, digits and exponent.
+    char digits[32];
+    int count = 0;
+    const char * next = scientific;
+    if (*next == '-') {
+        _appendText("-");
+        next++;
+    }
+    for (; *next != 'e'; next++) {
+        if (*next != '.') {
+            digits[count++] = *next;
+        }
+    }
+    const int exponent = atoi(next + 1);
+    if (-4 <= exponent && exponent < 16) {
+        if (exponent < 0) {
+            _appendText("0.");
+            for (int k = exponent + 1; k < 0; k++) {
+                _appendText("0");
+            }
+            _append(digits, count);
+        } else {
+            for (int k = 0; k <= exponent; k++) {
+                _append((k < count)? &digits[k] : "0", 1);
+            }
+            _appendText(".");
+            if (exponent + 1 < count) {
+                _append(&digits[exponent + 1], count - exponent - 1);
+            } else {
+                _appendText("0");
+            }
+        }
+    } else {
+        char suffix[16];
+        _append(digits, 1);
+        if (1 < count) {
+            _appendText(".");
+            _append(&digits[1], count - 1);
+        }
+        snprintf(suffix, sizeof(suffix), "e%c%02d", (exponent < 0)? '-' : '+', abs(exponent));
+        _appendText(suffix);
+    }
+}
+
+static void _appendQuoted(const VmString * string) {
+    const char quote = (strchr(string->chars, '\'') != NULL && strchr(string->chars, '"') == NULL)? '"' : '\'';
+    _append(&quote, 1);
+    for (int k = 0; k < string->size; k++) {
+        const unsigned char character = string->chars[k];
+        char escaped[8];
+        if (character == '\\' || character == quote) {
+            escaped[0] = '\\';
+            escaped[1] = character;
+            _append(escaped, 2);
+        } else if (character == '\n') {
+            _appendText("\\n");
+        } else if (character == '\r') {
+            _appendText("\\r");
+        } else if (character == '\t') {
+            _appendText("\\t");
+        } else if (character < 0x20 || character == 0x7F) {
+            snprintf(escaped, sizeof(escaped), "\\x%02x", character);
+            _appendText(escaped);
+        } else {
+            _append((const char *) &string->chars[k], 1);
+        }
+    }
+    _append(&quote, 1);
+}
+
+static void _appendRepresentation(const ComputationResult * value) {
+    char integer[32];
+    switch (value->type) {
+        case CRVT_NONE:
+            _appendText("None");
+            return;
+        case CRVT_BOOLEAN:
+            _appendText(value->booleanValue? "True" : "False");
+            return;
+        case CRVT_INTEGER:
+            snprintf(integer, sizeof(integer), "%lld", value->integerValue);
+            _appendText(integer);
+            return;
+        case CRVT_FLOAT:
+            _appendFloat(value->floatValue);
+            return;
+        case CRVT_STRING:
+            _appendQuoted(value->stringValue);
+            return;
+        default: {
+            const VmList * list = value->listValue;
+            _appendText((value->type == CRVT_LIST)? "[" : "(");
+            for (int k = 0; k < list->size; k++) {
+                if (0 < k) {
+                    _appendText(", ");
+                }
+                _appendRepresentation(&list->elements[k]);
+            }
+            if (value->type == CRVT_TUPLE && list->size == 1) {
+                _appendText(",");
+            }
+            _appendText((value->type == CRVT_LIST)? "]" : ")");
+            return;
+        }
+    }
+}
+
+static VmString * _toString(const ComputationResult * value) {
+    if (value->type == CRVT_STRING) {
+        return value->stringValue;
+    }
+    _bufferSize = 0;
+    _appendRepresentation(value);
+    return _internBuffer();
+}
+
+/* ARITHMETIC */
+
+static inline boolean _addsExactly(const long long x, const long long y, long long * result) {
+#if defined(__GNUC__)
+    return !__builtin_add_overflow(x, y, result);
+#else
+    if ((y > 0 && x > LLONG_MAX - y) || (y < 0 && x < LLONG_MIN - y)) {
+        return false;
+    }
+    *result = x + y;
+    return true;
+#endif
+}
+
+static inline boolean _subtractsExactly(const long long x, const long long y, long long * result) {
+#if defined(__GNUC__)
+    return !__builtin_sub_overflow(x, y, result);
+#else
+    if ((y < 0 && x > LLONG_MAX + y) || (y > 0 && x < LLONG_MIN + y)) {
+        return false;
+    }
+    *result = x - y;
+    return true;
+#endif
+}
+
+static inline boolean _multipliesExactly(const long long x, const long long y, long long * result) {
+#if defined(__GNUC__)
+    return !__builtin_mul_overflow(x, y, result);
+#else
+    if (x != 0 && ((x == -1 && y == LLONG_MIN) || (y == -1 && x == LLONG_MIN) || (x != -1 && (x * y) / x != y))) {
+        return false;
+    }
+    *result = x * y;
+    return true;
+#endif
+}
+
+static const char * _operatorSymbol(const Opcode opcode) {
+    switch (opcode) {
+        case BC_ADD:
+            return "+";
+        case BC_SUBTRACT:
+            return "-";
+        case BC_MULTIPLY:
+            return "*";
+        case BC_DIVIDE:
+            return "/";
+        case BC_FLOOR_DIVIDE:
+            return "//";
+        case BC_MODULO:
+            return "%";
+        case BC_POWER:
+            return "** or pow()";
+        case BC_LESS:
+            return "<";
+        case BC_LESS_EQUAL:
+            return "<=";
+        case BC_GREATER:
+            return ">";
+        default:
+            return ">=";
+    }
+}
+
+static boolean _integerArithmetic(const Opcode opcode, ComputationResult * result, const long long x, const long long y) {
+    long long value;
+    switch (opcode) {
+        case BC_ADD:
+            if (!_addsExactly(x, y, &value)) {
+                return _raise("OverflowError: integer overflow");
+            }
+            break;
+        case BC_SUBTRACT:
+            if (!_subtractsExactly(x, y, &value)) {
+                return _raise("OverflowError: integer overflow");
+            }
+            break;
+        case BC_MULTIPLY:
+            if (!_multipliesExactly(x, y, &value)) {
+                return _raise("OverflowError: integer overflow");
+            }
+            break;
+        case BC_DIVIDE:
+            if (y == 0) {
+                return _raise("ZeroDivisionError: division by zero");
+            }
+            *result = _float((double) x / (double) y);
+            return true;
+        case BC_FLOOR_DIVIDE:
+            if (y == 0) {
+                return _raise("ZeroDivisionError: integer division or modulo by zero");
+            }
+            if (x == LLONG_MIN && y == -1) {
+                return _raise("OverflowError: integer overflow");
+            }
+            value = x / y;
+            if (x % y != 0 && (x < 0) != (y < 0)) {
+                value--;
+            }
+            break;
+        case BC_MODULO:
+            if (y == 0) {
+                return _raise("ZeroDivisionError: integer division or modulo by zero");
+            }
+            value = (y == -1)? 0 : x % y;
+            if (value != 0 && (value < 0) != (y < 0)) {
+                value += y;
+            }
+            break;
+        default:
+            if (y < 0) {
+                if (x == 0) {
+                    return _raise("ZeroDivisionError: 0.0 cannot be raised to a negative power");
+                }
+                *result = _float(pow((double) x, (double) y));
+                return true;
+            }
+            long long base = x;
+            long long exponent = y;
+            value = 1;
+            while (0 < exponent) {
+                if ((exponent & 1) && !_multipliesExactly(value, base, &value)) {
+                    return _raise("OverflowError: integer overflow");
+                }
+                exponent >>= 1;
+                if (0 < exponent && !_multipliesExactly(base, base, &base)) {
+                    return _raise("OverflowError: integer overflow");
+                }
+            }
+            break;
+    }
+    *result = _integer(value);
+    return true;
+}
+
+static boolean _floatArithmetic(const Opcode opcode, ComputationResult * result, const double x, const double y) {
+    switch (opcode) {
+        case BC_ADD:
+            *result = _float(x + y);
+            return true;
+        case BC_SUBTRACT:
+            *result = _float(x - y);
+            return true;
+        case BC_MULTIPLY:
+            *result = _float(x * y);
+            return true;
+        case BC_DIVIDE:
+            if (y == 0.0) {
+                return _raise("ZeroDivisionError: float division by zero");
+            }
+            *result = _float(x / y);
+            return true;
+        case BC_FLOOR_DIVIDE:
+        case BC_MODULO: {
+            if (y == 0.0) {
+                return _raise("ZeroDivisionError: float %s by zero", (opcode == BC_MODULO)? "modulo" : "floor division");
+            }
+            // The algorithm of CPython, which keeps the sign of the divisor.
+            double modulo = fmod(x, y);
+            double quotient = (x - modulo) / y;
+            if (modulo != 0.0) {
+                if ((y < 0) != (modulo < 0)) {
+                    modulo += y;
+                    quotient -= 1.0;
+                }
+            } else {
+                modulo = copysign(0.0, y);
+            }
+            if (quotient != 0.0) {
+                const double floored = floor(quotient);
+                quotient = (0.5 < quotient - floored)? floored + 1.0 : floored;
+            } else {
+                quotient = copysign(0.0, x / y);
+            }
+            *result = _float((opcode == BC_MODULO)? modulo : quotient);
+            return true;
+        }
+        default: {
+            if (x == 0.0 && y < 0.0) {
+                return _raise("ZeroDivisionError: 0.0 cannot be raised to a negative power");
+            }
+            if (x < 0.0 && isfinite(y) && y != floor(y)) {
+                return _raise("ValueError: negative number cannot be raised to a fractional power");
+            }
+            const double value = pow(x, y);
+            if (isinf(value) && isfinite(x) && isfinite(y)) {
+                return _raise("OverflowError: numerical result out of range");
+            }
+            *result = _float(value);
+            return true;
+        }
+    }
+}
+
+static boolean _concatenate(ComputationResult * result, const ComputationResult * left, const ComputationResult * right) {
+    if (left->type == CRVT_STRING) {
+        if (INT_MAX - left->stringValue->size <= right->stringValue->size) {
+            return _raise("OverflowError: the string is too long");
+        }
+        _bufferSize = 0;
+        _append(left->stringValue->chars, left->stringValue->size);
+        _append(right->stringValue->chars, right->stringValue->size);
+        *result = _string(_internBuffer());
+        return true;
+    }
+    const VmList * first = left->listValue;
+    const VmList * second = right->listValue;
+    VmList * list = _newList(first->size + second->size);
+    memcpy(list->elements, first->elements, first->size * sizeof(ComputationResult));
+    memcpy(list->elements + first->size, second->elements, second->size * sizeof(ComputationResult));
+    *result = _list(left->type, list);
+    return true;
+}
+
+static boolean _repeat(ComputationResult * result, const ComputationResult * sequence, const long long times) {
+    const long long count = (times < 0)? 0 : times;
+    const int size = (sequence->type == CRVT_STRING)? sequence->stringValue->size : sequence->listValue->size;
+    if (size != 0 && INT_MAX / size <= count) {
+        return _raise("OverflowError: the repeated %s is too long", _typeName(sequence->type));
+    }
+    if (sequence->type == CRVT_STRING) {
+        _bufferSize = 0;
+        for (long long k = 0; k < count; k++) {
+            _append(sequence->stringValue->chars, size);
+        }
+        *result = _string(_internBuffer());
+        return true;
+    }
+    VmList * list = _newList(size * count);
+    for (long long k = 0; k < count; k++) {
+        memcpy(list->elements + k * size, sequence->listValue->elements, size * sizeof(ComputationResult));
+    }
+    *result = _list(sequence->type, list);
+    return true;
+}
+
+/**
+ * Applies an arithmetic operator to any pair of values. The result may be
+ * one of the operands.
+ */
+static boolean _arithmetic(const Opcode opcode, ComputationResult * result, const ComputationResult * left, const ComputationResult * right) {
+    if (_isIntegral(left) && _isIntegral(right)) {
+        return _integerArithmetic(opcode, result, _integerOf(left), _integerOf(right));
+    }
+    if (_isNumber(left) && _isNumber(right)) {
+        return _floatArithmetic(opcode, result, _floatOf(left), _floatOf(right));
+    }
+    if (opcode == BC_ADD && left->type == right->type && (left->type == CRVT_STRING || _isSequence(left))) {
+        return _concatenate(result, left, right);
+    }
+    if (opcode == BC_MULTIPLY && _isIntegral(right) && (left->type == CRVT_STRING || _isSequence(left))) {
+        return _repeat(result, left, _integerOf(right));
+    }
+    if (opcode == BC_MULTIPLY && _isIntegral(left) && (right->type == CRVT_STRING || _isSequence(right))) {
+        return _repeat(result, right, _integerOf(left));
+    }
+    return _raise("TypeError: unsupported operand type(s) for %s: '%s' and '%s'",
+        _operatorSymbol(opcode), _typeName(left->type), _typeName(right->type));
+}
+
+/* COMPARISONS */
+
+static boolean _equals(const ComputationResult * left, const ComputationResult * right) {
+    if (_isIntegral(left) && _isIntegral(right)) {
+        return _integerOf(left) == _integerOf(right);
+    }
+    if (_isNumber(left) && _isNumber(right)) {
+        // Every long fits in a long double, so mixed comparisons are exact.
+        const long double x = (left->type == CRVT_FLOAT)? left->floatValue : _integerOf(left);
+        const long double y = (right->type == CRVT_FLOAT)? right->floatValue : _integerOf(right);
+        return x == y;
+    }
+    if (left->type != right->type) {
+        return false;
+    }
+    switch (left->type) {
+        case CRVT_NONE:
+            return true;
+        case CRVT_STRING:
+            return left->stringValue == right->stringValue;
+        default: {
+            const VmList * first = left->listValue;
+            const VmList * second = right->listValue;
+            if (first->size != second->size) {
+                return false;
+            }
+            for (int k = 0; k < first->size; k++) {
+                if (!_equals(&first->elements[k], &second->elements[k])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+}
+
+#define ORDER(opcode, x, y) \
+    (((opcode) == BC_LESS)? (x) < (y) : ((opcode) == BC_LESS_EQUAL)? (x) <= (y) : ((opcode) == BC_GREATER)? (x) > (y) : (x) >= (y))
+
+/** Evaluates an ordering comparator, with the opcode of its comparison. */
+static boolean _compare(const Opcode opcode, boolean * holds, const ComputationResult * left, const ComputationResult * right) {
+    if (_isIntegral(left) && _isIntegral(right)) {
+        *holds = ORDER(opcode, _integerOf(left), _integerOf(right));
+        return true;
+    }
+    if (_isNumber(left) && _isNumber(right)) {
+        const long double x = (left->type == CRVT_FLOAT)? left->floatValue : _integerOf(left);
+        const long double y = (right->type == CRVT_FLOAT)? right->floatValue : _integerOf(right);
+        *holds = ORDER(opcode, x, y);
+        return true;
+    }
+    if (left->type == CRVT_STRING && right->type == CRVT_STRING) {
+        // Bytes of UTF-8 sort as their code points.
+        *holds = ORDER(opcode, strcmp(left->stringValue->chars, right->stringValue->chars), 0);
+        return true;
+    }
+    if (_isSequence(left) && left->type == right->type) {
+        const VmList * first = left->listValue;
+        const VmList * second = right->listValue;
+        for (int k = 0; k < first->size && k < second->size; k++) {
+            if (!_equals(&first->elements[k], &second->elements[k])) {
+                return _compare(opcode, holds, &first->elements[k], &second->elements[k]);
+            }
+        }
+        *holds = ORDER(opcode, first->size, second->size);
+        return true;
+    }
+    return _raise("TypeError: '%s' not supported between instances of '%s' and '%s'",
+        _operatorSymbol(opcode), _typeName(left->type), _typeName(right->type));
+}
+
+static boolean _contains(boolean * holds, const ComputationResult * element, const ComputationResult * container) {
+    if (container->type == CRVT_STRING) {
+        if (element->type != CRVT_STRING) {
+            return _raise("TypeError: 'in <string>' requires string as left operand, not %s", _typeName(element->type));
+        }
+        *holds = strstr(container->stringValue->chars, element->stringValue->chars) != NULL;
+        return true;
+    }
+    if (!_isSequence(container)) {
+        return _raise("TypeError: argument of type '%s' is not iterable", _typeName(container->type));
+    }
+    *holds = false;
+    for (int k = 0; k < container->listValue->size && !*holds; k++) {
+        *holds = _equals(element, &container->listValue->elements[k]);
+    }
+    return true;
+}
+
+static boolean _isIdentical(const ComputationResult * left, const ComputationResult * right) {
+    if (left->type != right->type) {
+        return false;
+    }
+    switch (left->type) {
+        case CRVT_NONE:
+            return true;
+        case CRVT_BOOLEAN:
+            return left->booleanValue == right->booleanValue;
+        case CRVT_INTEGER:
+            return left->integerValue == right->integerValue;
+        case CRVT_FLOAT:
+            return memcmp(&left->floatValue, &right->floatValue, sizeof(double)) == 0;
+        case CRVT_STRING:
+            return left->stringValue == right->stringValue;
+        default:
+            return left->listValue == right->listValue;
+    }
+}
+
+/* SEQUENCES */
+
+static boolean _lengthOf(int * length, const ComputationResult * value) {
+    if (value->type == CRVT_STRING) {
+        *length = value->stringValue->length;
+    } else if (_isSequence(value)) {
+        *length = value->listValue->size;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Moves to the next element of a sequence, where the position counts
+ * elements, or bytes on strings. Returns false once past the end.
+ */
+static inline boolean _nextElement(const ComputationResult * sequence, long long * position, ComputationResult * element) {
+    if (sequence->type == CRVT_STRING) {
+        const VmString * string = sequence->stringValue;
+        if (string->size <= *position) {
+            return false;
+        }
+        const int size = _codePointSize(&string->chars[*position]);
+        *element = _string(_character(&string->chars[*position], size));
+        *position += size;
+        return true;
+    }
+    if (sequence->listValue->size <= *position) {
+        return false;
+    }
+    *element = sequence->listValue->elements[(*position)++];
+    return true;
+}
+
+static void _elementAt(ComputationResult * element, const ComputationResult * sequence, const int index) {
+    if (sequence->type == CRVT_STRING) {
+        const char * chars = sequence->stringValue->chars;
+        for (int k = 0; k < index; k++) {
+            chars += _codePointSize(chars);
+        }
+        *element = _string(_character(chars, _codePointSize(chars)));
+    } else {
+        *element = sequence->listValue->elements[index];
+    }
+}
+
+/* MEMO TABLES */
+
+static inline uint64_t _mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/** Hashes a value so that equal values, such as 1, 1.0 and True, hash the same. */
+static boolean _hash(uint64_t * hash, const ComputationResult * value) {
+    switch (value->type) {
+        case CRVT_NONE:
+            *hash = 0x9E3779B97F4A7C15ULL;
+            return true;
+        case CRVT_BOOLEAN:
+        case CRVT_INTEGER:
+            *hash = _mix((uint64_t) _integerOf(value));
+            return true;
+        case CRVT_FLOAT: {
+            const double decimal = value->floatValue;
+            if (decimal == floor(decimal) && -9.2e18 < decimal && decimal < 9.2e18) {
+                *hash = _mix((uint64_t) (long long) decimal);
+            } else {
+                uint64_t bits;
+                memcpy(&bits, &decimal, sizeof(bits));
+                *hash = _mix(bits);
+            }
+            return true;
+        }
+        case CRVT_STRING:
+            *hash = _mix((uint64_t) (uintptr_t) value->stringValue);
+            return true;
+        case CRVT_TUPLE: {
+            uint64_t combined = 0xCBF29CE484222325ULL;
+            for (int k = 0; k < value->listValue->size; k++) {
+                uint64_t element;
+                if (!_hash(&element, &value->listValue->elements[k])) {
+                    return false;
+                }
+                combined = _mix(combined ^ element) + k;
+            }
+            *hash = combined;
+            return true;
+        }
+        default:
+            return _raise("TypeError: unhashable type: '%s'", _typeName(value->type));
+    }
+}
+
+static boolean _hashArguments(uint64_t * hash, const ComputationResult * arguments, const int count) {
+    uint64_t combined = 0x84222325CBF29CE4ULL;
+    for (int k = 0; k < count; k++) {
+        uint64_t element;
+        if (!_hash(&element, &arguments[k])) {
+            return false;
+        }
+        combined = _mix(combined ^ element) + k;
+    }
+    *hash = combined;
+    return true;
+}
+
+static MemoEntry * _findMemoEntry(const MemoTable * memo, const uint64_t hash, const ComputationResult * arguments, const int count) {
+    if (memo->capacity == 0) {
+        return NULL;
+    }
+    for (int slot = hash & (memo->capacity - 1); ; slot = (slot + 1) & (memo->capacity - 1)) {
+        MemoEntry * entry = &memo->entries[slot];
+        if (entry->arguments == NULL) {
+            return entry;
+        }
+        if (entry->hash == hash) {
+            int k = 0;
+            while (k < count && _equals(&entry->arguments->elements[k], &arguments[k])) {
+                k++;
+            }
+            if (k == count) {
+                return entry;
+            }
+        }
+    }
+}
+
+static void _insertMemo(MemoTable * memo, const uint64_t hash, VmList * arguments, const ComputationResult * result) {
+    if (3 * memo->capacity <= 4 * (memo->size + 1)) {
+        MemoTable grown = { .capacity = (memo->capacity == 0)? 64 : 2 * memo->capacity, .hits = memo->hits, .misses = memo->misses };
+        grown.entries = calloc(grown.capacity, sizeof(MemoEntry));
+        for (int k = 0; k < memo->capacity; k++) {
+            const MemoEntry * entry = &memo->entries[k];
+            if (entry->arguments != NULL) {
+                *_findMemoEntry(&grown, entry->hash, entry->arguments->elements, entry->arguments->size) = *entry;
+                grown.size++;
+            }
+        }
+        free(memo->entries);
+        *memo = grown;
+    }
+    MemoEntry * entry = _findMemoEntry(memo, hash, arguments->elements, arguments->size);
+    if (entry->arguments == NULL) {
+        memo->size++;
+    }
+    *entry = (MemoEntry) { .hash = hash, .arguments = arguments, .result = *result };
+}
+
+/* BUILTINS */
+
+static boolean _parseInteger(long long * value, const VmString * string) {
+    const char * chars = string->chars;
+    while (isspace((unsigned char) *chars)) {
+        chars++;
+    }
+    const boolean isNegative = *chars == '-';
+    if (*chars == '-' || *chars == '+') {
+        chars++;
+    }
+    long long parsed = 0;
+    int digits = 0;
+    for (; isdigit((unsigned char) *chars) || (*chars == '_' && 0 < digits && isdigit((unsigned char) chars[1])); chars++) {
+        if (*chars == '_') {
+            continue;
+        }
+        // Accumulates negatively, so that the smallest long parses too.
+        if (!_multipliesExactly(parsed, 10, &parsed) || !_subtractsExactly(parsed, *chars - '0', &parsed)) {
+            return _raise("OverflowError: integer overflow");
+        }
+        digits++;
+    }
+    while (isspace((unsigned char) *chars)) {
+        chars++;
+    }
+    if (digits == 0 || *chars != '\0' || (!isNegative && parsed == LLONG_MIN)) {
+        if (digits != 0 && *chars == '\0') {
+            return _raise("OverflowError: integer overflow");
+        }
+        _bufferSize = 0;
+        _appendQuoted(string);
+        return _raise("ValueError: invalid literal for int() with base 10: %s", _buffer);
+    }
+    *value = isNegative? parsed : -parsed;
+    return true;
+}
+
+static boolean _parseFloat(double * value, const VmString * string) {
+    char * end = NULL;
+    *value = strtod(string->chars, &end);
+    while (isspace((unsigned char) *end)) {
+        end++;
+    }
+    // Python reads no hexadecimal floats.
+    if (end == string->chars || *end != '\0' || strpbrk(string->chars, "xX") != NULL) {
+        _bufferSize = 0;
+        _appendQuoted(string);
+        return _raise("ValueError: could not convert string to float: %s", _buffer);
+    }
+    return true;
+}
+
+static boolean _toInteger(ComputationResult * result, const ComputationResult * value) {
+    long long integer;
+    if (_isIntegral(value)) {
+        integer = _integerOf(value);
+    } else if (value->type == CRVT_FLOAT) {
+        const double decimal = value->floatValue;
+        if (isnan(decimal)) {
+            return _raise("ValueError: cannot convert float NaN to integer");
+        }
+        if (isinf(decimal)) {
+            return _raise("OverflowError: cannot convert float infinity to integer");
+        }
+        if (decimal <= -9223372036854775809.0 || 9223372036854775807.0 <= decimal) {
+            return _raise("OverflowError: integer overflow");
+        }
+        integer = (long long) decimal;
+    } else if (value->type == CRVT_STRING) {
+        if (!_parseInteger(&integer, value->stringValue)) {
+            return false;
+        }
+    } else {
+        return _raise("TypeError: int() argument must be a string or a real number, not '%s'", _typeName(value->type));
+    }
+    *result = _integer(integer);
+    return true;
+}
+
+static boolean _toFloat(ComputationResult * result, const ComputationResult * value) {
+    double decimal;
+    if (_isNumber(value)) {
+        decimal = _floatOf(value);
+    } else if (value->type == CRVT_STRING) {
+        if (!_parseFloat(&decimal, value->stringValue)) {
+            return false;
+        }
+    } else {
+        return _raise("TypeError: float() argument must be a string or a real number, not '%s'", _typeName(value->type));
+    }
+    *result = _float(decimal);
+    return true;
+}
+
+static boolean _minimum(ComputationResult * result, const ComputationResult * arguments, const int count) {
+    ComputationResult best;
+    ComputationResult candidate;
+    long long position = 0;
+    boolean isSmaller;
+    if (1 < count) {
+        best = arguments[0];
+        for (int k = 1; k < count; k++) {
+            if (!_compare(BC_LESS, &isSmaller, &arguments[k], &best)) {
+                return false;
+            }
+            if (isSmaller) {
+                best = arguments[k];
+            }
+        }
+    } else if (arguments[0].type != CRVT_STRING && !_isSequence(&arguments[0])) {
+        return _raise("TypeError: '%s' object is not iterable", _typeName(arguments[0].type));
+    } else if (!_nextElement(&arguments[0], &position, &best)) {
+        return _raise("ValueError: min() arg is an empty sequence");
+    } else {
+        while (_nextElement(&arguments[0], &position, &candidate)) {
+            if (!_compare(BC_LESS, &isSmaller, &candidate, &best)) {
+                return false;
+            }
+            if (isSmaller) {
+                best = candidate;
+            }
+        }
+    }
+    *result = best;
+    return true;
+}
+
+static boolean _sum(ComputationResult * result, const ComputationResult * arguments, const int count) {
+    ComputationResult total = (count == 2)? arguments[1] : _integer(0);
+    ComputationResult element;
+    long long position = 0;
+    if (total.type == CRVT_STRING) {
+        return _raise("TypeError: sum() can't sum strings [use ''.join(seq) instead]");
+    }
+    if (arguments[0].type != CRVT_STRING && !_isSequence(&arguments[0])) {
+        return _raise("TypeError: '%s' object is not iterable", _typeName(arguments[0].type));
+    }
+    while (_nextElement(&arguments[0], &position, &element)) {
+        if (!_arithmetic(BC_ADD, &total, &total, &element)) {
+            return false;
+        }
+    }
+    *result = total;
+    return true;
+}
+
+/** Calls a builtin with the values on its first registers, and leaves the result on the first one. */
+static boolean _callBuiltin(const BytecodeBuiltin builtin, ComputationResult * registers, const int count) {
+    int length;
+    switch (builtin) {
+        case BB_ABS:
+            if (_isIntegral(&registers[0])) {
+                const long long value = _integerOf(&registers[0]);
+                if (value == LLONG_MIN) {
+                    return _raise("OverflowError: integer overflow");
+                }
+                registers[0] = _integer((value < 0)? -value : value);
+            } else if (registers[0].type == CRVT_FLOAT) {
+                registers[0] = _float(fabs(registers[0].floatValue));
+            } else {
+                return _raise("TypeError: bad operand type for abs(): '%s'", _typeName(registers[0].type));
+            }
+            return true;
+        case BB_BOOL:
+            registers[0] = _boolean(0 < count && _isTruthy(&registers[0]));
+            return true;
+        case BB_FLOAT:
+            if (count == 0) {
+                registers[0] = _float(0.0);
+                return true;
+            }
+            return _toFloat(&registers[0], &registers[0]);
+        case BB_INT:
+            if (count == 0) {
+                registers[0] = _integer(0);
+                return true;
+            }
+            return _toInteger(&registers[0], &registers[0]);
+        case BB_LEN:
+            if (!_lengthOf(&length, &registers[0])) {
+                return _raise("TypeError: object of type '%s' has no len()", _typeName(registers[0].type));
+            }
+            registers[0] = _integer(length);
+            return true;
+        case BB_MIN:
+            return _minimum(&registers[0], registers, count);
+        case BB_STR:
+            registers[0] = _string((count == 0)? _intern("", 0) : _toString(&registers[0]));
+            return true;
+        default:
+            return _sum(&registers[0], registers, count);
+    }
+}
+
+/* INTERPRETER */
+
+static boolean _ensureRegisters(const int top) {
+    if (_stackCapacity < top) {
+        int capacity = (_stackCapacity == 0)? 1024 : _stackCapacity;
+        while (capacity < top) {
+            capacity *= 2;
+        }
+        ComputationResult * stack = realloc(_stack, capacity * sizeof(ComputationResult));
+        if (stack == NULL) {
+            return _raise("MemoryError: the register stack is exhausted");
+        }
+        _stack = stack;
+        _stackCapacity = capacity;
+    }
+    return true;
+}
+
+static boolean _pushFrame(const Frame frame) {
+    if (_frameCount == MAXIMUM_CALL_DEPTH) {
+        return _raise("RecursionError: maximum recursion depth exceeded");
+    }
+    if (_frameCount == _frameCapacity) {
+        _frameCapacity = (_frameCapacity == 0)? 64 : 2 * _frameCapacity;
+        _frames = realloc(_frames, _frameCapacity * sizeof(Frame));
+    }
+    _frames[_frameCount++] = frame;
+    return _ensureRegisters(frame.base + frame.function->registerCount);
+}
+
+/** Clears the locals of a call, past its parameters. */
+static inline void _clearLocals(ComputationResult * registers, const BytecodeFunction * function) {
+    for (int k = function->parameterCount; k < function->registerCount; k++) {
+        registers[k].type = CRVT_NONE;
+    }
+}
+
+/*
+ * Jumps straight to the code of each opcode with computed gotos where the
+ * compiler supports them, which predicts branches per instruction, and falls
+ * back to a switch elsewhere.
+ */
+#if defined(__GNUC__)
+#define VM_LABEL(name) &&VM_##name,
+#define VM_CASE(name) VM_##name:
+#define VM_DISPATCH() do { instruction = pc++; goto *labels[instruction->opcode]; } while (0)
+#define VM_BEGIN VM_DISPATCH();
+#define VM_END
+#else
+#define VM_CASE(name) case BC_##name:
+#define VM_DISPATCH() goto dispatch
+#define VM_BEGIN dispatch: instruction = pc++; switch (instruction->opcode) {
+#define VM_END default: _raise("SystemError: unknown opcode %d", instruction->opcode); goto failure; }
+#endif
+
+#define A (registers[instruction->a])
+#define B (registers[instruction->b])
+#define C (registers[instruction->c])
+
+/** An arithmetic operator, with fast paths for integers and floats. */
+#define VM_ARITHMETIC(name, exactly, operator) \
+    VM_CASE(name) { \
+        long long value; \
+        if (B.type == CRVT_INTEGER && C.type == CRVT_INTEGER && exactly(B.integerValue, C.integerValue, &value)) { \
+            A = _integer(value); \
+        } else if (B.type == CRVT_FLOAT && C.type == CRVT_FLOAT) { \
+            A = _float(B.floatValue operator C.floatValue); \
+        } else if (!_arithmetic(BC_##name, &A, &B, &C)) { \
+            goto failure; \
+        } \
+        VM_DISPATCH(); \
+    }
+
+#define VM_OPERATION(name) \
+    VM_CASE(name) { \
+        if (!_arithmetic(BC_##name, &A, &B, &C)) { \
+            goto failure; \
+        } \
+        VM_DISPATCH(); \
+    }
+
+/** An ordering comparator, with a fast path for integers. */
+#define VM_ORDER(name, operator) \
+    VM_CASE(name) { \
+        boolean holds; \
+        if (B.type == CRVT_INTEGER && C.type == CRVT_INTEGER) { \
+            holds = B.integerValue operator C.integerValue; \
+        } else if (!_compare(BC_##name, &holds, &B, &C)) { \
+            goto failure; \
+        } \
+        A = _boolean(holds); \
+        VM_DISPATCH(); \
+    }
+
+/** Jumps unless an ordering comparator holds, which fuses a comparison and a branch. */
+#define VM_JUMP_UNLESS(name, operator) \
+    VM_CASE(JUMP_UNLESS_##name) { \
+        boolean holds; \
+        if (A.type == CRVT_INTEGER && B.type == CRVT_INTEGER) { \
+            holds = A.integerValue operator B.integerValue; \
+        } else if (!_compare(BC_##name, &holds, &A, &B)) { \
+            goto failure; \
+        } \
+        if (!holds) { \
+            pc = code + instruction->c; \
+        } \
+        VM_DISPATCH(); \
+    }
+
+static boolean _execute() {
+#if defined(__GNUC__)
+    static const void * const labels[] = {
+        BYTECODE_OPCODES(VM_LABEL)
+    };
+#endif
+    const BytecodeFunction * main = &_program->functions[0];
+    _frameCount = 0;
+    if (!_pushFrame((Frame) { .function = main, .base = 0 })) {
+        return false;
+    }
+    ComputationResult * registers = _stack;
+    _clearLocals(registers, main);
+    const Instruction * code = main->code;
+    const Instruction * pc = code;
+    const Instruction * instruction;
+    ComputationResult result;
+
+    VM_BEGIN
+
+    VM_CASE(MOVE) {
+        A = B;
+        VM_DISPATCH();
+    }
+    VM_CASE(LOAD_CONSTANT) {
+        A = _constants[instruction->c];
+        VM_DISPATCH();
+    }
+    VM_CASE(LOAD_INTEGER) {
+        A = _integer(instruction->c);
+        VM_DISPATCH();
+    }
+    VM_CASE(LOAD_NONE) {
+        A = _none();
+        VM_DISPATCH();
+    }
+    VM_CASE(GET_GLOBAL) {
+        if (_globals[instruction->c].type == CRVT_UNDEFINED) {
+            _raise("NameError: name '%s' is not defined", _program->globals[instruction->c]);
+            goto failure;
+        }
+        A = _globals[instruction->c];
+        VM_DISPATCH();
+    }
+    VM_CASE(SET_GLOBAL) {
+        _globals[instruction->c] = A;
+        VM_DISPATCH();
+    }
+    VM_ARITHMETIC(ADD, _addsExactly, +)
+    VM_ARITHMETIC(SUBTRACT, _subtractsExactly, -)
+    VM_ARITHMETIC(MULTIPLY, _multipliesExactly, *)
+    VM_OPERATION(DIVIDE)
+    VM_OPERATION(FLOOR_DIVIDE)
+    VM_OPERATION(MODULO)
+    VM_OPERATION(POWER)
+    VM_CASE(EQUAL) {
+        A = _boolean(_equals(&B, &C));
+        VM_DISPATCH();
+    }
+    VM_CASE(NOT_EQUAL) {
+        A = _boolean(!_equals(&B, &C));
+        VM_DISPATCH();
+    }
+    VM_ORDER(LESS, <)
+    VM_ORDER(LESS_EQUAL, <=)
+    VM_ORDER(GREATER, >)
+    VM_ORDER(GREATER_EQUAL, >=)
+    VM_CASE(CONTAINS) {
+        boolean holds;
+        if (!_contains(&holds, &B, &C)) {
+            goto failure;
+        }
+        A = _boolean(holds);
+        VM_DISPATCH();
+    }
+    VM_CASE(NOT_CONTAINS) {
+        boolean holds;
+        if (!_contains(&holds, &B, &C)) {
+            goto failure;
+        }
+        A = _boolean(!holds);
+        VM_DISPATCH();
+    }
+    VM_CASE(IS) {
+        A = _boolean(_isIdentical(&B, &C));
+        VM_DISPATCH();
+    }
+    VM_CASE(IS_NOT) {
+        A = _boolean(!_isIdentical(&B, &C));
+        VM_DISPATCH();
+    }
+    VM_CASE(NOT) {
+        A = _boolean(!_isTruthy(&B));
+        VM_DISPATCH();
+    }
+    VM_CASE(JUMP) {
+        pc = code + instruction->c;
+        VM_DISPATCH();
+    }
+    VM_CASE(JUMP_IF_FALSE) {
+        if (!_isTruthy(&A)) {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(JUMP_IF_TRUE) {
+        if (_isTruthy(&A)) {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(JUMP_UNLESS_EQUAL) {
+        if (!_equals(&A, &B)) {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(JUMP_UNLESS_NOT_EQUAL) {
+        if (_equals(&A, &B)) {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_JUMP_UNLESS(LESS, <)
+    VM_JUMP_UNLESS(LESS_EQUAL, <=)
+    VM_JUMP_UNLESS(GREATER, >)
+    VM_JUMP_UNLESS(GREATER_EQUAL, >=)
+    VM_CASE(NEW_LIST) {
+        VmList * list = _newList(instruction->c);
+        memcpy(list->elements, &B, instruction->c * sizeof(ComputationResult));
+        A = _list(CRVT_LIST, list);
+        VM_DISPATCH();
+    }
+    VM_CASE(NEW_TUPLE) {
+        VmList * list = _newList(instruction->c);
+        memcpy(list->elements, &B, instruction->c * sizeof(ComputationResult));
+        A = _list(CRVT_TUPLE, list);
+        VM_DISPATCH();
+    }
+    VM_CASE(CHECK_LENGTH) {
+        int length;
+        if (!_lengthOf(&length, &A)) {
+            _raise("TypeError: cannot unpack non-iterable %s object", _typeName(A.type));
+            goto failure;
+        }
+        if (length < instruction->c) {
+            _raise("ValueError: not enough values to unpack (expected %d, got %d)", instruction->c, length);
+            goto failure;
+        }
+        if (instruction->c < length) {
+            _raise("ValueError: too many values to unpack (expected %d)", instruction->c);
+            goto failure;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(GET_ELEMENT) {
+        _elementAt(&A, &B, instruction->c);
+        VM_DISPATCH();
+    }
+    VM_CASE(RANGE_PREPARE) {
+        ComputationResult * state = &A;
+        for (int k = 0; k < 3; k++) {
+            if (!_isIntegral(&state[k])) {
+                _raise("TypeError: '%s' object cannot be interpreted as an integer", _typeName(state[k].type));
+                goto failure;
+            }
+            state[k] = _integer(_integerOf(&state[k]));
+        }
+        if (state[2].integerValue == 0) {
+            _raise("ValueError: range() arg 3 must not be zero");
+            goto failure;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(RANGE_LOOP) {
+        ComputationResult * state = &A;
+        const long long current = state[0].integerValue;
+        const long long stop = state[1].integerValue;
+        const long long step = state[2].integerValue;
+        if ((0 < step)? current < stop : stop < current) {
+            state[3] = _integer(current);
+            if (!_addsExactly(current, step, &state[0].integerValue)) {
+                // The next value is out of every range of longs.
+                state[0].integerValue = stop;
+            }
+        } else {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(ITERATE_PREPARE) {
+        if (A.type != CRVT_STRING && !_isSequence(&A)) {
+            _raise("TypeError: '%s' object is not iterable", _typeName(A.type));
+            goto failure;
+        }
+        (&A)[1] = _integer(0);
+        VM_DISPATCH();
+    }
+    VM_CASE(ITERATE_LOOP) {
+        ComputationResult * state = &A;
+        if (!_nextElement(&state[0], &state[1].integerValue, &state[2])) {
+            pc = code + instruction->c;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(CALL) {
+        const BytecodeFunction * callee = &_program->functions[instruction->b];
+        Frame frame = { .function = callee, .base = (registers - _stack) + instruction->a };
+        if (callee->isCached) {
+            MemoTable * memo = &_memos[instruction->b];
+            if (!_hashArguments(&frame.memoHash, &A, instruction->c)) {
+                goto failure;
+            }
+            const MemoEntry * entry = _findMemoEntry(memo, frame.memoHash, &A, instruction->c);
+            if (entry != NULL && entry->arguments != NULL) {
+                memo->hits++;
+                A = entry->result;
+                VM_DISPATCH();
+            }
+            memo->misses++;
+            frame.memoArguments = _newList(instruction->c);
+            memcpy(frame.memoArguments->elements, &A, instruction->c * sizeof(ComputationResult));
+        }
+        _frames[_frameCount - 1].returnAddress = pc;
+        if (!_pushFrame(frame)) {
+            goto failure;
+        }
+        registers = _stack + frame.base;
+        _clearLocals(registers, callee);
+        code = pc = callee->code;
+        VM_DISPATCH();
+    }
+    VM_CASE(TAIL_CALL) {
+        const BytecodeFunction * function = _frames[_frameCount - 1].function;
+        memmove(registers, &A, function->parameterCount * sizeof(ComputationResult));
+        _clearLocals(registers, function);
+        pc = code;
+        VM_DISPATCH();
+    }
+    VM_CASE(CALL_BUILTIN) {
+        if (!_callBuiltin(instruction->b, &A, instruction->c)) {
+            goto failure;
+        }
+        VM_DISPATCH();
+    }
+    VM_CASE(RETURN) {
+        result = A;
+        goto leave;
+    }
+    VM_CASE(RETURN_NONE) {
+        result = _none();
+        goto leave;
+    }
+
+    VM_END
+
+leave: {
+        const Frame * frame = &_frames[--_frameCount];
+        if (_frameCount == 0) {
+            return true;
+        }
+        if (frame->memoArguments != NULL) {
+            _insertMemo(&_memos[frame->function - _program->functions], frame->memoHash, frame->memoArguments, &result);
+        }
+        // The result goes where the caller put the first argument.
+        _stack[frame->base] = result;
+        const Frame * caller = &_frames[_frameCount - 1];
+        registers = _stack + caller->base;
+        code = caller->function->code;
+        pc = caller->returnAddress;
+        VM_DISPATCH();
+    }
+
+failure:
+    logError(_logger, "Runtime error in %s: %s", _frames[_frameCount - 1].function->name, _error);
+    return false;
+}
+
+#undef A
+#undef B
+#undef C
+
+static void _printGlobals() {
+    for (int k = 0; k < _program->globalCount; k++) {
+        if (_program->globals[k][0] != '$' && _globals[k].type != CRVT_UNDEFINED) {
+            _bufferSize = 0;
+            _appendRepresentation(&_globals[k]);
+            printf("%s = %s\n", _program->globals[k], _buffer);
+        }
+    }
+}
+
+static void _logMemoStatistics() {
+    for (int k = 0; k < _program->functionCount; k++) {
+        if (_program->functions[k].isCached) {
+            fprintf(stderr, "%s: %ld hits, %ld misses\n", _program->functions[k].name, _memos[k].hits, _memos[k].misses);
+        }
+    }
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean isVirtualMachineSelected() {
+    return _isVirtualMachine;
+}
+
+boolean runBytecode(const BytecodeProgram * program) {
+    logDebugging(_logger, "Running bytecode...");
+    _program = program;
+    _interned = hashMapInit(sizeof(tInterned), sizeof(VmString *), hashMapStringHash, hashMapStringKeyEquals);
+    memset(_characters, 0, sizeof(_characters));
+    _constants = calloc(program->constantCount + 1, sizeof(ComputationResult));
+    for (int k = 0; k < program->constantCount; k++) {
+        const BytecodeConstant * constant = &program->constants[k];
+        switch (constant->type) {
+            case CRVT_BOOLEAN:
+                _constants[k] = _boolean(constant->boolean);
+                break;
+            case CRVT_INTEGER:
+                _constants[k] = _integer(constant->integer);
+                break;
+            case CRVT_FLOAT:
+                _constants[k] = _float(constant->decimal);
+                break;
+            default:
+                _constants[k] = _string(_intern(constant->string, strlen(constant->string)));
+                break;
+        }
+    }
+    _globals = calloc(program->globalCount + 1, sizeof(ComputationResult));
+    for (int k = 0; k < program->globalCount; k++) {
+        _globals[k].type = CRVT_UNDEFINED;
+    }
+    _memos = calloc(program->functionCount, sizeof(MemoTable));
+    const boolean succeed = _execute();
+    if (succeed) {
+        _printGlobals();
+    }
+    if (_logCacheStatistics) {
+        _logMemoStatistics();
+    }
+    for (int k = 0; k < program->functionCount; k++) {
+        free(_memos[k].entries);
+    }
+    free(_memos);
+    free(_globals);
+    free(_constants);
+    free(_stack);
+    free(_frames);
+    free(_buffer);
+    hashMapDestroy(_interned);
+    _releaseArena();
+    _memos = NULL;
+    _globals = NULL;
+    _constants = NULL;
+    _stack = NULL;
+    _stackCapacity = 0;
+    _frames = NULL;
+    _frameCount = 0;
+    _frameCapacity = 0;
+    _buffer = NULL;
+    _bufferSize = 0;
+    _bufferCapacity = 0;
+    _interned = NULL;
+    logDebugging(_logger, "The program ran to its end.");
+    return succeed;
+}
@@ -0,0 +1,32 @@
+#ifndef VIRTUAL_MACHINE_HEADER
+#define VIRTUAL_MACHINE_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Bytecode.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeVirtualMachineModule();
+
+/** Shutdown module's internal state. */
+void shutdownVirtualMachineModule();
+
+/**
+ * Whether the programs must run on the built-in virtual machine instead of
+ * being translated, as selected by the "TARGET_LANGUAGE" environment
+ * variable.
+ */
+boolean isVirtualMachineSelected();
+
+/**
+ * Runs a compiled program, and prints the final value of every top-level
+ * variable as Python would represent it. Strings are interned and, like
+ * lists, live in an arena released when the program ends. Returns false if
+ * the program raises an error, which is logged.
+ */
+boolean runBytecode(const BytecodeProgram * program);
+
+#endif
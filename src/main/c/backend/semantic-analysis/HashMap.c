@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "../../shared/Logger.h"
+#include "../../shared/Trace.h"
 
 typedef struct entry{
     tAny key;
@@ -23,17 +24,22 @@ typedef struct hashMapCDT {
 } hashMapCDT;
 
 static Logger * _logger = NULL;
+static uint64_t _instances = 0;
 
 #define INITIAL_SIZE 20
+#define STRING_SEED 0x2468ace1
 typedef enum {FREE = 0, USED, BRIDGE} status;
 
 hashMapADT hashMapInit(uint64_t keySize, uint64_t valueSize, hashFp prehash, keyEqualsFp keyEquals) {
     hashMapADT new = malloc(sizeof(hashMapCDT));
-    _logger = createLogger("HashMap");
     if(new == NULL || (new->lookup = calloc(INITIAL_SIZE, sizeof(entry))) == NULL) {
         free(new);
         return NULL;
     }
+    // The logger is shared by every live hash map.
+    if(_instances++ == 0) {
+        _logger = createLogger("HashMap");
+    }
     new->totalSize = 0;
     new->usedSize = 0;
     new->threshold = 0.75;
@@ -45,6 +51,22 @@ hashMapADT hashMapInit(uint64_t keySize, uint64_t valueSize, hashFp prehash, key
     return new;
 }
 
+// One-byte-at-a-time hash based on Murmur's mix, as the symbol table does.
+uint64_t hashMapStringHash(tAny key) {
+    uint64_t h = STRING_SEED;
+    const char * str = *(const char **) key;
+    for (; *str; ++str) {
+        h ^= *str;
+        h *= 0x5bd1e995;
+        h ^= h >> 15;
+    }
+    return h;
+}
+
+boolean hashMapStringKeyEquals(tAny key1, tAny key2) {
+    return strcmp(*(const char **) key1, *(const char **) key2) == 0;
+}
+
 static uint64_t hash(hashMapADT hm, tAny key) {
     return hm->prehash(key) % hm->lookupSize;
 }
@@ -57,6 +79,11 @@ static void resize(hashMapADT hm) {
         return;
     }
     uint64_t oldSize = hm->lookupSize;
+    char detail[64] = "";
+    if (isTraceEnabled()) {
+        snprintf(detail, sizeof(detail), "%llu to %llu slots", (unsigned long long) oldSize, (unsigned long long) oldSize*2);
+    }
+    beginSpan("hash-map", "resize", detail);
     hm->lookupSize *= 2;
     hm->totalSize = 0;
     hm->usedSize = 0;
@@ -68,6 +95,7 @@ static void resize(hashMapADT hm) {
         }
     }
     free(oldTable);
+    endSpan();
 }
 
 void hashMapInsertOrUpdate(hashMapADT hm, tAny key, tAny value) {
@@ -170,7 +198,10 @@ uint64_t hashMapSize(hashMapADT hm) {
 }
 
 void hashMapDestroy(hashMapADT hm) {
-    if (_logger != NULL) { destroyLogger(_logger); }
+    if(--_instances == 0 && _logger != NULL) {
+        destroyLogger(_logger);
+        _logger = NULL;
+    }
     for(uint64_t i = 0; i < hm->lookupSize; i++) {
         entry * aux = &hm->lookup[i];
         if(aux->status == USED) {
@@ -13,6 +13,21 @@ typedef uint64_t (*hashFp)(tAny);
 typedef boolean (*keyEqualsFp)(tAny, tAny);
 typedef struct hashMapCDT * hashMapADT;
 
+/**
+ * @brief Hash function for keys whose first member is a null-terminated string.
+ * @param key The key to be hashed.
+ * @return The hash of the string.
+ */
+uint64_t hashMapStringHash(tAny key);
+
+/**
+ * @brief Key comparison for keys whose first member is a null-terminated string.
+ * @param key1 The first key.
+ * @param key2 The second key.
+ * @return True if both strings are equal, false otherwise.
+ */
+boolean hashMapStringKeyEquals(tAny key1, tAny key2);
+
 /**
  * @brief Initializes a new hash map.
  * @param keySize The size of the key in bytes.
@@ -17,6 +17,15 @@ typedef enum {
     SA_UNKNOWN = 13,
     SA_FUNCTION_DEF = 14,
     SA_UNDECLARED = 15,
+    SA_LONG = 16,
+    SA_LIST = 17,
+    SA_TUPLE = 18,
+    SA_CHARACTER = 19,
+    SA_RANGE = 20,
+    /**
+     * @brief An integer that may not fit in a long.
+     */
+    SA_BIG_INTEGER = 21,
     /**
      * @brief Upper-most value for numeric type coercion
      */
@@ -40,6 +49,20 @@ typedef enum {
     SA_STR_STR_OP = SA_STRING*2 + SA_STRING*3,
 } SaValidBinaryArithmeticTypes;
 
+/**
+ * @brief What running a function may do besides returning its value, ordered from the least to the most.
+ */
+typedef enum {
+    /** The symbol is not a function whose effects were analyzed. */
+    SA_UNSUMMARIZED = 0,
+    /** Depends only on its arguments, and changes nothing. */
+    SA_PURE = 1,
+    /** Also reads variables or fields it does not own, but changes nothing. */
+    SA_READ_ONLY = 2,
+    /** May call methods, builtins with effects or unknown functions. */
+    SA_EFFECTFUL = 3,
+} SaEffect;
+
 /**
  * @brief The result of a semantic check, including data type for successful checks.
  */
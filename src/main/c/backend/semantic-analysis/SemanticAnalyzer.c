@@ -12,6 +12,17 @@ static Logger * _logger = NULL;
  * @return The resulting data type of the operation, or SA_ERROR if the operation is not defined for the given data types.
  */
 static SaDataType getOperationDataType(const SaDataType left, const SaDataType right) {
+    if (left == SA_LIST || left == SA_TUPLE || right == SA_LIST || right == SA_TUPLE) {
+        return SA_ERROR;
+    }
+    if (left == SA_OBJECT || right == SA_OBJECT) {
+        // Only known at runtime, such as the variable of a for loop.
+        return SA_OBJECT;
+    }
+    if (left == SA_LONG || right == SA_LONG) {
+        const SaDataType other = (left == SA_LONG)? right : left;
+        return (other == SA_FLOAT)? SA_FLOAT : SA_LONG;
+    }
     SaValidBinaryArithmeticTypes jumpIdx = left * 2 + right * 3;
     switch (jumpIdx) {
         case SA_INT_INT_OP:
@@ -60,8 +71,9 @@ static BinaryArithmeticOperation _expressionTypeToBinaryOperator(const Expressio
 		case ADDITION:
         case MULTIPLICATION:
             return binaryArithmeticOperatorW;
-        case SUBTRACTION:
         case DIVISION:
+            return binaryDivisionOperator;
+        case SUBTRACTION:
         case TRUNCATED_DIVISION:
         case MODULO:
         case EXPONENTIATION:
@@ -77,6 +89,17 @@ static BinaryArithmeticOperation _expressionTypeToBinaryOperator(const Expressio
 	}
 }
 
+/**
+ * @brief Check if an expression is a negative integer literal.
+ * @param expression The expression to be checked.
+ * @return True if the expression is a negative integer constant, false otherwise.
+ */
+static boolean _isNegativeIntegerConstant(const Expression * expression) {
+    return expression->type == CONSTANT_EXPRESSION
+        && expression->constant->type == CT_INTEGER
+        && expression->constant->integer < 0;
+}
+
 /**
  * @brief Check if a function or class definition is present in the given sentence.
  * @param sentence The sentence to be checked.
@@ -101,9 +124,13 @@ static boolean _addToSymbolTable(const char * identifier, SaComputationResult co
     tValue existingValue;
 
     boolean isAlreadyDeclared = symbolTableFind(&key, &existingValue);
-    boolean isMismatchType = existingValue.type != SA_UNDECLARED && existingValue.type != comp.dataType;
+    boolean isMismatchType = isAlreadyDeclared && existingValue.type != SA_UNDECLARED && existingValue.type != dataType;
 
-    if (isAlreadyDeclared && isMismatchType) {
+    if (isMismatchType && (existingValue.type == SA_OBJECT || dataType == SA_OBJECT)) {
+        // An object symbol can hold a value of any type, and an object value may be of any type.
+        return true;
+    }
+    if (isMismatchType) {
         logWarning(_logger, "Symbol %s is already declared with a mismatching type", identifier);
         return false;
     }
@@ -124,10 +151,11 @@ static boolean _addToSymbolTable(const char * identifier, SaComputationResult co
  */
 static tValue _getFromSymbolTable(const char * identifier) {
     tKey key = { .varname = identifier };
-    tValue value;
-
-    boolean found = symbolTableFind(&key, &value);
+    tValue value = { .type = SA_UNDECLARED };
 
+    if (symbolTableFind(&key, &value)) {
+        return value;
+    }
     value.type = SA_UNDECLARED;
     logInformation(_logger, "Undeclared symbol %s with type %d added to the symbol table", key.varname, value.type);
     symbolTableInsert(&key, &value);
@@ -135,6 +163,270 @@ static tValue _getFromSymbolTable(const char * identifier) {
     return value;
 }
 
+/**
+ * @brief Get the type a symbol was finally resolved to.
+ * @param identifier The identifier/name of the symbol.
+ * @return The data type of the symbol.
+ */
+static SaDataType _getSymbolType(const char * identifier) {
+    tKey key = { .varname = (char *) identifier };
+    tValue value;
+    return symbolTableFind(&key, &value)? value.type : SA_UNDECLARED;
+}
+
+static SaComputationResult _computeSingleSentence(Sentence * sentence);
+static SaComputationResult _computeExpression(Expression * expression);
+
+/**
+ * @brief Check if an element of an unpacking assignment comes from a tuple or list, which must have as many elements
+ * as there are variables when it is a constant.
+ * @param element The unpacked element to be computed.
+ * @return A computation result with the data type of the element, if it is known, when successful.
+ */
+static SaComputationResult _computeUnpackedElement(const Expression * element) {
+    const Expression * unpacked = element->unpackedVariable->expression;
+    const SaDataType type = unpacked->dataType;
+    if (type != SA_TUPLE && type != SA_LIST && type != SA_OBJECT && type != SA_UNDECLARED) {
+        logError(_logger, "Only tuples and lists can be unpacked");
+        return generateInvalidComputationResult();
+    }
+    SaDataType elementType = SA_UNDECLARED;
+    if (unpacked->type == CONSTANT_EXPRESSION && (unpacked->constant->type == CT_LIST || unpacked->constant->type == CT_TUPLE)) {
+        int count = 0;
+        const List * collection = unpacked->constant->list;
+        for (const Parameters * value = (collection->type == LT_PARAMETRIZED_LIST)? collection->elements : NULL;
+                value != NULL && value->leftExpression != NULL; value = value->rightParameters, ++count) {
+            if (count == element->elementIndex) {
+                elementType = value->leftExpression->dataType;
+            }
+        }
+        if (count != element->elementCount) {
+            logError(_logger, "Cannot unpack %d values into %d variables", count, element->elementCount);
+            return generateInvalidComputationResult();
+        }
+    }
+    return (SaComputationResult) {
+        .dataType = elementType,
+        .success = true
+    };
+}
+
+/**
+ * @brief Check if the body of a control-flow block is semantically correct.
+ * @param block The block whose body will be computed.
+ * @return A computation result with the subjacent data type if successful.
+ */
+static SaComputationResult _computeBlockBody(Block * block) {
+    if (!computeSentence(block->nextSentence).success) {
+        logError(_logger, "The code block body is invalid");
+        return generateInvalidComputationResult();
+    }
+    return (SaComputationResult) {
+        .dataType = SA_VOID,
+        .success = true
+    };
+}
+
+/**
+ * @brief A function of the program, with the names its body binds, which Python makes local to it.
+ */
+typedef struct {
+    FunctionDefinition * definition;
+    Sentence * body;
+    hashMapADT locals;
+} tEffectSummary;
+
+typedef struct {
+    const char * name;
+} tLocalKey;
+
+static tEffectSummary * _summaries = NULL;
+static int _summaryCount = 0;
+
+static SaEffect _joinEffects(const SaEffect left, const SaEffect right) {
+    return (left < right)? right : left;
+}
+
+/**
+ * @brief Register the names a sentence chain binds, either by assignment or as a loop variable.
+ */
+static void _collectLocals(hashMapADT locals, const Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE) {
+            tLocalKey key = { .name = sentence->variable->identifier };
+            hashMapInsertOrUpdate(locals, &key, &key);
+        } else if (sentence->type == BLOCK_SENTENCE) {
+            if (sentence->block->type == BT_FOR && sentence->block->forBlock->left->type == VARIABLE_CALL_EXPRESSION) {
+                tLocalKey key = { .name = sentence->block->forBlock->left->variableCall->variableName };
+                hashMapInsertOrUpdate(locals, &key, &key);
+            }
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _collectLocals(locals, block->nextSentence);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Register every function definition found in a sentence chain, and in the blocks it contains.
+ */
+static void _collectSummaries(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        Block * block = sentence->block;
+        if (block->type == BT_FUNCTION_DEFINITION) {
+            tEffectSummary summary = {
+                .definition = block->functionDefinition,
+                .body = block->nextSentence,
+                .locals = hashMapInit(sizeof(tLocalKey), sizeof(tLocalKey), hashMapStringHash, hashMapStringKeyEquals)
+            };
+            for (Parameters * parameter = summary.definition->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+                if (parameter->leftExpression->type != VARIABLE_CALL_EXPRESSION) {
+                    continue;
+                }
+                tLocalKey key = { .name = parameter->leftExpression->variableCall->variableName };
+                hashMapInsertOrUpdate(summary.locals, &key, &key);
+            }
+            _collectLocals(summary.locals, summary.body);
+            _summaries = realloc(_summaries, (_summaryCount + 1) * sizeof(tEffectSummary));
+            _summaries[_summaryCount++] = summary;
+            continue;
+        }
+        for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+            _collectSummaries(block->nextSentence);
+        }
+    }
+}
+
+static SaEffect _expressionEffect(const Expression * expression, hashMapADT locals);
+
+static SaEffect _parametersEffect(const Parameters * parameters, hashMapADT locals) {
+    SaEffect effect = SA_PURE;
+    for (; parameters != NULL && parameters->leftExpression != NULL; parameters = parameters->rightParameters) {
+        effect = _joinEffects(effect, _expressionEffect(parameters->leftExpression, locals));
+    }
+    return effect;
+}
+
+/**
+ * @brief Get the effect of calling a function, which is the one of its summary so far for functions of the program.
+ * Calls to "@cache" functions are effectful whatever their body does, as they write the shared memo table.
+ */
+static SaEffect _callEffect(const FunctionCall * functionCall) {
+    if (functionCall->type == FC_OBJECT) {
+        const BuiltinDefinition builtin = functionCall->object->builtinDefinition;
+        return (builtin == BTF_LEN || builtin == BTF_ABS || builtin == BTF_RANGE)? SA_PURE : SA_EFFECTFUL;
+    }
+    for (int i = 0; i < _summaryCount; ++i) {
+        if (strcmp(_summaries[i].definition->functionName, functionCall->functionName) == 0) {
+            if (_summaries[i].definition->isCached) {
+                return SA_EFFECTFUL;
+            }
+            return getFunctionEffect(functionCall->functionName);
+        }
+    }
+    return isRangeCall(functionCall)? SA_PURE : SA_EFFECTFUL;
+}
+
+/**
+ * @brief Get what evaluating an expression may do, where reading a name the function does not bind reads a global.
+ */
+static SaEffect _expressionEffect(const Expression * expression, hashMapADT locals) {
+    tLocalKey key;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if ((expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE)
+                    && expression->constant->list->type == LT_PARAMETRIZED_LIST) {
+                return _parametersEffect(expression->constant->list->elements, locals);
+            }
+            return SA_PURE;
+        case VARIABLE_CALL_EXPRESSION:
+            key.name = expression->variableCall->variableName;
+            return hashMapFind(locals, &key, NULL)? SA_PURE : SA_READ_ONLY;
+        case FUNCTION_CALL_EXPRESSION:
+            return _joinEffects(_callEffect(expression->functionCall), _parametersEffect(expression->functionCall->functionArguments, locals));
+        case FIELD_GETTER_EXPRESSION:
+            return SA_READ_ONLY;
+        case UNPACKED_ELEMENT:
+            return SA_PURE;
+        case LOGIC_NOT:
+            return _expressionEffect(expression->notExpression, locals);
+        case COMPARISON_EXPRESSION:
+            return _joinEffects(_expressionEffect(expression->leftCompExpression, locals), _expressionEffect(expression->rightCompExpression, locals));
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            return _joinEffects(_expressionEffect(expression->leftExpression, locals), _expressionEffect(expression->rightExpression, locals));
+        case METHOD_CALL_EXPRESSION:
+        default:
+            return SA_EFFECTFUL;
+    }
+}
+
+/**
+ * @brief Get what running a sentence chain may do. Assignments only bind locals, so they add no effect of their own.
+ */
+static SaEffect _sentencesEffect(const Sentence * sentence, hashMapADT locals) {
+    SaEffect effect = SA_PURE;
+    for (; sentence != NULL && effect != SA_EFFECTFUL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case VARIABLE_SENTENCE:
+                effect = _joinEffects(effect, _expressionEffect(sentence->variable->expression, locals));
+                break;
+            case EXPRESSION_SENTENCE:
+            case RETURN_SENTENCE:
+                if (sentence->expression != NULL) {
+                    effect = _joinEffects(effect, _expressionEffect(sentence->expression, locals));
+                }
+                break;
+            case BLOCK_SENTENCE: {
+                const Block * block = sentence->block;
+                switch (block->type) {
+                    case BT_CONDITIONAL:
+                        for (; block != NULL && block->conditional != NULL; block = block->nextCond) {
+                            if (block->conditional->expression != NULL) {
+                                effect = _joinEffects(effect, _expressionEffect(block->conditional->expression, locals));
+                            }
+                            effect = _joinEffects(effect, _sentencesEffect(block->nextSentence, locals));
+                        }
+                        break;
+                    case BT_WHILE:
+                        effect = _joinEffects(effect, _expressionEffect(block->whileBlock->expression, locals));
+                        effect = _joinEffects(effect, _sentencesEffect(block->nextSentence, locals));
+                        break;
+                    case BT_FOR:
+                        effect = _joinEffects(effect, _expressionEffect(block->forBlock->right, locals));
+                        effect = _joinEffects(effect, _sentencesEffect(block->nextSentence, locals));
+                        break;
+                    default:
+                        effect = SA_EFFECTFUL;
+                        break;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return effect;
+}
+
+static void _storeFunctionEffect(const char * functionName, const SaEffect effect) {
+    tKey key = { .varname = (char *) functionName };
+    tValue value = { .type = SA_UNDECLARED, .effect = effect };
+    symbolTableFind(&key, &value);
+    value.effect = effect;
+    symbolTableInsert(&key, &value);
+}
+
 /** PUBLIC FUNCTIONS SECTION **/
 
 void initializeSemanticAnalyzerModule() {
@@ -148,6 +440,7 @@ void shutdownSemanticAnalyzerModule() {
     if (_logger != NULL) {
         destroyLogger(_logger);
     }
+    countSymbols((long) symbolTableSize());
     symbolTableDestroy();
 }
 
@@ -197,11 +490,25 @@ SaComputationResult binaryArithmeticOperatorWO(SaComputationResult left, SaCompu
         return generateInvalidComputationResult();
     }
     return (SaComputationResult) {
-        .dataType = SA_FLOAT,
+        .dataType = (operationDataType == SA_BOOLEAN)? SA_INTEGER : operationDataType,
         .success = true
     };
 }
 
+/**
+ * @brief Check if a true division is defined for the given operands.
+ * @param left The left operand.
+ * @param right The right operand.
+ * @return A computation result with the subjacent data type if successful, which is always a float.
+ */
+SaComputationResult binaryDivisionOperator(SaComputationResult left, SaComputationResult right) {
+    SaComputationResult result = binaryArithmeticOperatorWO(left, right);
+    if (result.success) {
+        result.dataType = SA_FLOAT;
+    }
+    return result;
+}
+
 SaComputationResult binaryBooleanOperator(SaComputationResult left, SaComputationResult right) {
     logDebugging(_logger, "Performing boolean operation ...");
     if (!left.success || !right.success) {
@@ -213,6 +520,28 @@ SaComputationResult binaryBooleanOperator(SaComputationResult left, SaComputatio
     };
 }
 
+/**
+ * Computes the top-level sentences as "computeSentence" would, but one at a
+ * time, so that each one gets its own span on the trace.
+ */
+static SaComputationResult _computeTopLevelSentences(Sentence * sentence) {
+    SaComputationResult result = { .dataType = SA_VOID, .success = true };
+    for (int k = 0; sentence != NULL; sentence = sentence->nextSentence, ++k) {
+        char detail[96] = "";
+        if (isTraceEnabled()) {
+            const boolean isFunction = sentence->type == BLOCK_SENTENCE && sentence->block->type == BT_FUNCTION_DEFINITION;
+            snprintf(detail, sizeof(detail), "#%d%s%.64s", k, isFunction? " def " : "", isFunction? sentence->block->functionDefinition->functionName : "");
+        }
+        beginSpan("semantic-analysis", "sentence", detail);
+        result = _computeSingleSentence(sentence);
+        endSpan();
+        if (!result.success) {
+            return generateInvalidComputationResult();
+        }
+    }
+    return result;
+}
+
 SaComputationResult computeProgram(Program * program) {
     logDebugging(_logger, "Computing program (ADDR: %p)...", program);
     if (program == NULL) {
@@ -232,7 +561,7 @@ SaComputationResult computeProgram(Program * program) {
         return nextResult;
     } else {
         logDebugging(_logger, "...non-empty line");
-        SaComputationResult tempSacr = computeSentence(program->sentence);
+        SaComputationResult tempSacr = _computeTopLevelSentences(program->sentence);
         if (symbolTableHasUnititializedTypes()) {
             logError(_logger, "There are symbols with uninitialized types");
             return generateInvalidComputationResult();
@@ -243,7 +572,19 @@ SaComputationResult computeProgram(Program * program) {
 
 SaComputationResult computeSentence(Sentence * sentence) {
     if (sentence == NULL) { return (SaComputationResult) { .dataType = SA_VOID, .success = true }; };
-    if (!computeSentence(sentence->nextSentence).success) { return generateInvalidComputationResult(); }
+    // Sentences are computed in source order, so every use sees the types of the previous assignments.
+    SaComputationResult result = _computeSingleSentence(sentence);
+    if (!result.success) { return generateInvalidComputationResult(); }
+    if (sentence->nextSentence == NULL) { return result; }
+    return computeSentence(sentence->nextSentence);
+}
+
+/**
+ * @brief Check if a sentence, without the ones that follow it, is semantically correct.
+ * @param sentence The sentence to be computed.
+ * @return A computation result with the subjacent data type if successful.
+ */
+static SaComputationResult _computeSingleSentence(Sentence * sentence) {
     logDebugging(_logger, "Computing sentence (ADDR: %p)...", sentence);
     switch (sentence->type){
         case EXPRESSION_SENTENCE:
@@ -270,6 +611,17 @@ SaComputationResult computeSentence(Sentence * sentence) {
 }
 
 SaComputationResult computeExpression(Expression * expression) {
+    SaComputationResult result = _computeExpression(expression);
+    expression->dataType = result.dataType;
+    return result;
+}
+
+/**
+ * @brief Check if an expression is semantically correct, without caching its type.
+ * @param expression The expression to be computed.
+ * @return A computation result with the subjacent data type if successful.
+ */
+static SaComputationResult _computeExpression(Expression * expression) {
     logDebugging(_logger, "Computing expression (ADDR: %p)...", expression);
     switch (expression->type) {
         case CONSTANT_EXPRESSION:
@@ -293,8 +645,13 @@ SaComputationResult computeExpression(Expression * expression) {
                 logDebugging(_logger, expression->rightExpression->variableCall->variableName);
             }
             logDebugging(_logger, "...of an arithmetic operator (type: %d)", expression->type);
-            return (_expressionTypeToBinaryOperator(expression->type))
+            SaComputationResult arithmeticResult = (_expressionTypeToBinaryOperator(expression->type))
                 (computeExpression(expression->leftExpression), computeExpression(expression->rightExpression));
+            if (expression->type == EXPONENTIATION && _isNegativeIntegerConstant(expression->rightExpression)) {
+                // An integer raised to a negative power is a float.
+                arithmeticResult.dataType = SA_FLOAT;
+            }
+            return arithmeticResult;
         case LOGIC_AND:
         case LOGIC_OR:
             if (expression->leftExpression->type == VARIABLE_CALL_EXPRESSION){
@@ -312,6 +669,9 @@ SaComputationResult computeExpression(Expression * expression) {
         case FUNCTION_CALL_EXPRESSION:
             logDebugging(_logger, "...of a function call (id: %s)", expression->functionCall->functionName);
             return computeFunctionCall(expression->functionCall);
+        case UNPACKED_ELEMENT:
+            logDebugging(_logger, "...of an unpacked element (index: %d)", expression->elementIndex);
+            return _computeUnpackedElement(expression);
         default:
             logError(_logger, "The specified expression type is not supported: %d", expression->type);
             return generateInvalidComputationResult();
@@ -335,12 +695,97 @@ SaComputationResult computeVariableCall(VariableCall * vCall) {
     };
 }
 
+/**
+ * @brief Resolve a call to len or abs that no symbol shadows into a call to the builtin, so later phases tell them
+ * apart from user functions by their FC_OBJECT type.
+ * @param functionCall The function call to be resolved.
+ */
+static void _resolveBuiltinCall(FunctionCall * functionCall) {
+    if (functionCall->type != FC_DEF || _getSymbolType(functionCall->functionName) != SA_UNDECLARED) {
+        return;
+    }
+    BuiltinDefinition builtin;
+    if (strcmp(functionCall->functionName, "len") == 0) {
+        builtin = BTF_LEN;
+    } else if (strcmp(functionCall->functionName, "abs") == 0) {
+        builtin = BTF_ABS;
+    } else {
+        return;
+    }
+    Object * object = calloc(1, sizeof(Object));
+    object->builtinDefinition = builtin;
+    object->type = OT_BUILTIN;
+    functionCall->object = object;
+    functionCall->type = FC_OBJECT;
+}
+
+/**
+ * @brief Check if a call to the builtin len or abs has a single argument of a supported type.
+ * @param functionCall The call to the builtin.
+ * @return A computation result with the type of the returned value if successful.
+ */
+static SaComputationResult _computeBuiltinCall(FunctionCall * functionCall) {
+    Parameters * arguments = functionCall->functionArguments;
+    if (arguments == NULL || arguments->leftExpression == NULL || (arguments->rightParameters != NULL && arguments->rightParameters->leftExpression != NULL)) {
+        logError(_logger, "Builtin functions take exactly one argument");
+        return generateInvalidComputationResult();
+    }
+    SaComputationResult argument = computeExpression(arguments->leftExpression);
+    if (!argument.success) {
+        return argument;
+    }
+    SaDataType dataType = SA_ERROR;
+    switch (functionCall->object->builtinDefinition) {
+        case BTF_LEN:
+            if (argument.dataType == SA_STRING || argument.dataType == SA_LIST || argument.dataType == SA_TUPLE
+                    || argument.dataType == SA_OBJECT || argument.dataType == SA_UNDECLARED) {
+                dataType = SA_INTEGER;
+            }
+            break;
+        case BTF_ABS:
+            if (argument.dataType == SA_BOOLEAN) {
+                dataType = SA_INTEGER;
+            } else if (argument.dataType == SA_INTEGER || argument.dataType == SA_LONG || argument.dataType == SA_FLOAT
+                    || argument.dataType == SA_OBJECT) {
+                dataType = argument.dataType;
+            } else if (argument.dataType == SA_UNDECLARED) {
+                dataType = SA_OBJECT;
+            }
+            break;
+        default:
+            break;
+    }
+    if (dataType == SA_ERROR) {
+        logError(_logger, "Unsupported argument of type %d for a builtin function", argument.dataType);
+        return generateInvalidComputationResult();
+    }
+    return (SaComputationResult) {
+        .dataType = dataType,
+        .success = true
+    };
+}
+
 SaComputationResult computeFunctionCall(FunctionCall * fCall) {
     if (fCall == NULL) {
         logError(_logger, "Invalid function call");
         return generateInvalidComputationResult();
     }
     logDebugging(_logger, "Computing function call (ADDR: %p)...", fCall);
+    _resolveBuiltinCall(fCall);
+    if (fCall->type == FC_OBJECT && fCall->object != NULL
+            && (fCall->object->builtinDefinition == BTF_LEN || fCall->object->builtinDefinition == BTF_ABS)) {
+        return _computeBuiltinCall(fCall);
+    }
+    if (fCall->type != FC_DEF) {
+        logError(_logger, "Calls to builtin functions are not supported");
+        return generateInvalidComputationResult();
+    }
+    for (Parameters * argument = fCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        if (!computeExpression(argument->leftExpression).success) {
+            logError(_logger, "Invalid argument for function %s", fCall->functionName);
+            return generateInvalidComputationResult();
+        }
+    }
     tValue retVal = _getFromSymbolTable(fCall->functionName);
     return (SaComputationResult) {
         .dataType = retVal.type,
@@ -350,34 +795,98 @@ SaComputationResult computeFunctionCall(FunctionCall * fCall) {
 
 SaComputationResult computeBlock(Block * block) {
     logDebugging(_logger, "Computing code block (ADDR: %p)...", block);
-    if (!computeSentence(block->nextSentence).success) {
-        logError(_logger, "The code block body is invalid");
-        return generateInvalidComputationResult();
-    }
+    SaComputationResult headerResult;
     switch (block->type) {
         case BT_FUNCTION_DEFINITION:
             logDebugging(_logger, "...of function definition type");
             return computeFunctionDefinition(block->functionDefinition, block->nextSentence);
         case BT_CONDITIONAL:
             logDebugging(_logger, "...of conditional type");
-            return computeConditionalBlock(block->conditional);
+            for (Block * branch = block; branch != NULL && branch->conditional != NULL; branch = branch->nextCond) {
+                if (!computeConditionalBlock(branch->conditional).success || !_computeBlockBody(branch).success) {
+                    return generateInvalidComputationResult();
+                }
+            }
+            return (SaComputationResult) {
+                .dataType = SA_VOID,
+                .success = true
+            };
         case BT_FOR:
             logDebugging(_logger, "...of for loop type");
-            return computeForLoopBlock(block->forBlock);
+            headerResult = computeForLoopBlock(block->forBlock);
+            break;
         case BT_WHILE:
             logDebugging(_logger, "...of while loop type");
-            return computeWhileLoopBlock(block->whileBlock);
+            headerResult = computeWhileLoopBlock(block->whileBlock);
+            break;
         case BT_CLASS_DEFINITION:
         default:
             logError(_logger, "The specified block type is not supported: %d", block->type);
             return generateInvalidComputationResult();
     }
+    if (!headerResult.success) {
+        return headerResult;
+    }
+    return _computeBlockBody(block);
+}
+
+boolean isRangeCall(const FunctionCall * functionCall) {
+    if (functionCall->type == FC_OBJECT) {
+        return functionCall->object != NULL && functionCall->object->builtinDefinition == BTF_RANGE;
+    }
+    return functionCall->functionName != NULL && strcmp(functionCall->functionName, "range") == 0;
+}
+
+/**
+ * @brief Check if the iterable of a for loop is a call to the builtin range, which is not shadowed by a symbol.
+ * @param iterable The iterable of the for loop.
+ * @return True if the loop iterates over a range, false otherwise.
+ */
+static boolean _isRangeIterable(const Expression * iterable) {
+    if (iterable == NULL || iterable->type != FUNCTION_CALL_EXPRESSION || !isRangeCall(iterable->functionCall)) {
+        return false;
+    }
+    return iterable->functionCall->type == FC_OBJECT || _getSymbolType(iterable->functionCall->functionName) == SA_UNDECLARED;
+}
+
+/**
+ * @brief Check if a range has one to three integer arguments, and a step other than zero.
+ * @param iterable The call to range.
+ * @return A computation result of range type if successful.
+ */
+static SaComputationResult _computeRange(Expression * iterable) {
+    logDebugging(_logger, "Computing range (ADDR: %p)...", iterable);
+    int count = 0;
+    Expression * step = NULL;
+    for (Parameters * argument = iterable->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        SaComputationResult argumentCompute = computeExpression(argument->leftExpression);
+        SaDataType type = argumentCompute.dataType;
+        if (!argumentCompute.success || (type != SA_INTEGER && type != SA_LONG && type != SA_BOOLEAN && type != SA_OBJECT && type != SA_UNDECLARED)) {
+            logError(_logger, "The arguments of range must be integers");
+            return generateInvalidComputationResult();
+        }
+        step = argument->leftExpression;
+        ++count;
+    }
+    if (count < 1 || 3 < count) {
+        logError(_logger, "Range expects from one to three arguments, but %d were given", count);
+        return generateInvalidComputationResult();
+    }
+    if (count == 3 && step->type == CONSTANT_EXPRESSION && step->constant->type == CT_INTEGER && step->constant->integer == 0) {
+        logError(_logger, "The step of a range must not be zero");
+        return generateInvalidComputationResult();
+    }
+    iterable->dataType = SA_RANGE;
+    return (SaComputationResult) {
+        .dataType = SA_RANGE,
+        .success = true
+    };
 }
 
 SaComputationResult computeForLoopBlock(ForBlock * forLoop) {
     logDebugging(_logger, "Computing for loop block (ADDR: %p)...", forLoop);
     SaComputationResult leftCompute = computeExpression(forLoop->left);
-    SaComputationResult rightCompute = computeExpression(forLoop->right);
+    SaComputationResult rightCompute = _isRangeIterable(forLoop->right)? _computeRange(forLoop->right) : computeExpression(forLoop->right);
     if (forLoop->left == NULL || forLoop->left->type != VARIABLE_CALL_EXPRESSION) {
         logError(_logger, "Invalid for loop initialization");
         return generateInvalidComputationResult();
@@ -388,6 +897,7 @@ SaComputationResult computeForLoopBlock(ForBlock * forLoop) {
     }
     _addToSymbolTable(forLoop->left->variableCall->variableName,
         (SaComputationResult) { .dataType = SA_OBJECT, .success = true });
+    forLoop->left->dataType = _getSymbolType(forLoop->left->variableCall->variableName);
     return (SaComputationResult) {
         .dataType = SA_VOID,
         .success = true
@@ -433,8 +943,7 @@ boolean _findReturn(Sentence * first, SaDataType * returnType) {
         logDebugging(_logger, "This function returns void");
         return false;
     } else if (first->type == RETURN_SENTENCE) {
-        // Inefficient, but works for now
-        *returnType = computeExpression(first->expression).dataType;
+        *returnType = first->expression->dataType;
         logDebugging(_logger, "This function returns type %d", *returnType);
         return true;
     } else {
@@ -443,7 +952,6 @@ boolean _findReturn(Sentence * first, SaDataType * returnType) {
 }
 
 SaComputationResult computeFunctionDefinition(FunctionDefinition * fdef, Sentence * body) {
-    if (!computeSentence(body).success) { return generateInvalidComputationResult(); }
     logDebugging(_logger, "Computing function definition (ADDR: %p)...", fdef);
     if (_hasDefinition(body)) {
         logError(_logger, "Definition of classes or functions inside a function is not allowed");
@@ -452,18 +960,20 @@ SaComputationResult computeFunctionDefinition(FunctionDefinition * fdef, Sentenc
     switch (fdef->type) {
         case FD_GENERIC:
             logDebugging(_logger, "...without explicitely typed return (name: %s)", fdef->functionName);
-            SaDataType returnType;
-            boolean hasReturn = _findReturn(body, &returnType);
             SaComputationResult paramComputation = computeParameters(fdef->parameters);
             if (!paramComputation.success) {
                 logError(_logger, "Invalid parameters for function %s", fdef->functionName);
                 return generateInvalidComputationResult();
             }
+            if (!computeSentence(body).success) { return generateInvalidComputationResult(); }
+            SaDataType returnType = SA_VOID;
+            boolean hasReturn = _findReturn(body, &returnType);
             SaComputationResult sacr = {
                 .dataType = hasReturn? returnType : SA_VOID,
                 .success = true
             };
             _addToSymbolTable(fdef->functionName, sacr);
+            fdef->dataType = _getSymbolType(fdef->functionName);
             // hacky, change whenever possible
             sacr.dataType = SA_VOID;
             return sacr;
@@ -500,6 +1010,7 @@ SaComputationResult computeParameters(Parameters * params) {
         .success = true
     };
     _addToSymbolTable(params->leftExpression->variableCall->variableName, thisComputation);
+    params->leftExpression->dataType = _getSymbolType(params->leftExpression->variableCall->variableName);
     return thisComputation;
 }
 
@@ -516,6 +1027,7 @@ SaComputationResult computeVariableDeclaration(Variable * var) {
         logError(_logger, "The variable declared type mismatches its uses");
         return generateInvalidComputationResult();
     }
+    var->dataType = _getSymbolType(var->identifier);
     // This may change should we support assignments other than '='
     return (SaComputationResult) {
         .dataType = SA_VOID,
@@ -523,6 +1035,47 @@ SaComputationResult computeVariableDeclaration(Variable * var) {
     };
 }
 
+/**
+ * @brief Check if the elements of a list or tuple are semantically correct and share a data type. Numbers of
+ * different types can be mixed, as they are promoted.
+ * @param collection The list or tuple to be computed.
+ * @param collectionType The data type of the collection.
+ * @return A computation result with the data type of the collection if successful.
+ */
+static SaComputationResult _computeCollection(const List * collection, const SaDataType collectionType) {
+    if (collection == NULL || collection->type == LT_TYPED_LIST) {
+        logError(_logger, "A typed collection is not a valid constant");
+        return generateInvalidComputationResult();
+    }
+    SaDataType elementType = SA_UNDECLARED;
+    for (Parameters * element = collection->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+        SaComputationResult elementResult = computeExpression(element->leftExpression);
+        if (!elementResult.success) {
+            return generateInvalidComputationResult();
+        }
+        SaDataType type = elementResult.dataType;
+        boolean isWildcard = type == SA_OBJECT || type == SA_UNDECLARED || elementType == SA_OBJECT || elementType == SA_UNDECLARED;
+        boolean isNumeric = (type == SA_INTEGER || type == SA_LONG || type == SA_FLOAT)
+            && (elementType == SA_INTEGER || elementType == SA_LONG || elementType == SA_FLOAT);
+        if (!isWildcard && !isNumeric && type != elementType && collectionType == SA_TUPLE) {
+            // Tuples may mix element types, which makes them tuples of objects.
+            elementType = SA_OBJECT;
+            continue;
+        }
+        if (!isWildcard && !isNumeric && type != elementType) {
+            logError(_logger, "The elements of a collection must share a data type");
+            return generateInvalidComputationResult();
+        }
+        if (elementType == SA_UNDECLARED || elementType == SA_OBJECT) {
+            elementType = type;
+        }
+    }
+    return (SaComputationResult) {
+        .dataType = collectionType,
+        .success = true
+    };
+}
+
 SaComputationResult computeConstant(Constant * constant) {
     logDebugging(_logger, "Computing constant (ADDR: %p)...", constant);
     switch (constant->type) {
@@ -533,9 +1086,9 @@ SaComputationResult computeConstant(Constant * constant) {
                 .success = true
             };
         case CT_INTEGER:
-            logDebugging(_logger, "...of integer type (value: %ld)", constant->integer);
+            logDebugging(_logger, "...of integer type (value: %lld)", constant->integer);
             return (SaComputationResult) {
-                .dataType = SA_INTEGER,
+                .dataType = (INT_MIN <= constant->integer && constant->integer <= INT_MAX)? SA_INTEGER : SA_LONG,
                 .success = true
             };
         case CT_FLOAT:
@@ -550,8 +1103,54 @@ SaComputationResult computeConstant(Constant * constant) {
                 .dataType = SA_STRING,
                 .success = true
             };
+        case CT_LIST:
+            logDebugging(_logger, "...of list type (ADDR: %p)", constant->list);
+            return _computeCollection(constant->list, SA_LIST);
+        case CT_TUPLE:
+            logDebugging(_logger, "...of tuple type (ADDR: %p)", constant->tuple);
+            return _computeCollection(constant->tuple, SA_TUPLE);
         default:
             logError(_logger, "The specified constant type is not supported: %d", constant->type);
             return generateInvalidComputationResult();
     }
 }
+
+void computeFunctionEffects(Program * program) {
+    logDebugging(_logger, "Computing function effects (ADDR: %p)...", program);
+    for (; program != NULL; program = program->nextProgram) {
+        _collectSummaries(program->sentence);
+    }
+    for (int i = 0; i < _summaryCount; ++i) {
+        _storeFunctionEffect(_summaries[i].definition->functionName, SA_PURE);
+    }
+    boolean isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (int i = 0; i < _summaryCount; ++i) {
+            const char * name = _summaries[i].definition->functionName;
+            const SaEffect effect = _sentencesEffect(_summaries[i].body, _summaries[i].locals);
+            if (effect != getFunctionEffect(name)) {
+                _storeFunctionEffect(name, effect);
+                isChanged = true;
+            }
+        }
+    }
+    for (int i = 0; i < _summaryCount; ++i) {
+        const char * name = _summaries[i].definition->functionName;
+        const SaEffect effect = getFunctionEffect(name);
+        logDebugging(_logger, "Function %s is %s", name, (effect == SA_PURE)? "pure" : (effect == SA_READ_ONLY)? "read-only" : "effectful");
+        hashMapDestroy(_summaries[i].locals);
+    }
+    free(_summaries);
+    _summaries = NULL;
+    _summaryCount = 0;
+}
+
+SaEffect getFunctionEffect(const char * functionName) {
+    tKey key = { .varname = (char *) functionName };
+    tValue value;
+    if (functionName == NULL || !symbolTableFind(&key, &value) || value.effect == SA_UNSUMMARIZED) {
+        return SA_EFFECTFUL;
+    }
+    return value.effect;
+}
@@ -3,6 +3,7 @@
 
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
 #include "SaDataTypes.h"
 #include "SymbolTable.h"
 #include "funcList.h"
@@ -37,7 +38,15 @@ SaComputationResult binaryArithmeticOperatorW(SaComputationResult left, SaComput
 SaComputationResult binaryArithmeticOperatorWO(SaComputationResult left, SaComputationResult right);
 
 /**
- * @brief Check if a function with an operator WITHOUT string support is defined for the given operands.
+ * @brief Check if a true division is defined for the given operands.
+ * @param left The left operand.
+ * @param right The right operand.
+ * @return A computation result with the subjacent data type if successful, which is always a float.
+ */
+SaComputationResult binaryDivisionOperator(SaComputationResult left, SaComputationResult right);
+
+/**
+ * @brief Check if a boolean operator is defined for the given operands.
  * @param left The left operand.
  * @param right The right operand.
  * @return A computation result with the subjacent data type if successful.
@@ -51,6 +60,21 @@ SaComputationResult binaryBooleanOperator(SaComputationResult left, SaComputatio
  */
 SaComputationResult computeProgram(Program * program);
 
+/**
+ * @brief Label every function of a program accepted by the semantic analysis with what running it may do, and store
+ * the label in the symbol table. Functions start as pure and only get worse, so the calls within recursive cycles
+ * settle on a fixed point.
+ * @param program The program whose functions will be labeled.
+ */
+void computeFunctionEffects(Program * program);
+
+/**
+ * @brief Get what running a function of the analyzed program may do besides returning its value.
+ * @param functionName The name of the function.
+ * @return The effect stored in the symbol table, or SA_EFFECTFUL if the name is not an analyzed function.
+ */
+SaEffect getFunctionEffect(const char * functionName);
+
 /**
  * @brief Check if a sentence is semantically correct.
  * @param sentence The sentence to be computed.
@@ -108,6 +132,14 @@ SaComputationResult computeFunctionDefinition(FunctionDefinition * fdef, Sentenc
  */
 SaComputationResult computeParameters(Parameters * params);
 
+/**
+ * @brief Check if a call is to the builtin range, either through its builtin identifier or by name. A user function
+ * named range shadows the builtin, which the caller must rule out.
+ * @param functionCall The call to be checked.
+ * @return True if the call may be to the builtin range, false otherwise.
+ */
+boolean isRangeCall(const FunctionCall * functionCall);
+
 /**
  * @brief Check if a for loop is semantically correct.
  * @param for The for loop to be computed.
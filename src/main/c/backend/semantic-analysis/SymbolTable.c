@@ -48,6 +48,10 @@ void symbolTableInsert(struct key * key, struct value * value) {
     hashMapInsertOrUpdate(table, key, value);
 }
 
+uint64_t symbolTableSize() {
+    return hashMapSize(table);
+}
+
 void symbolTableDestroy() {
     hashMapDestroy(table);
     if (_logger != NULL) { 
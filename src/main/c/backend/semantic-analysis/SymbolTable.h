@@ -11,6 +11,8 @@ typedef struct key {
 
 typedef struct value {
     SaDataType type;
+    /** The effects of a function symbol, once computed for the whole program. */
+    SaEffect effect;
 } tValue;
 
 void symbolTableInit();
@@ -25,5 +27,8 @@ void symbolTableInsert(struct key * key, struct value * value);
  */
 boolean symbolTableHasUnititializedTypes();
 
+/** The number of symbols in the symbol table. */
+uint64_t symbolTableSize();
+
 void symbolTableDestroy();
 #endif
\ No newline at end of file
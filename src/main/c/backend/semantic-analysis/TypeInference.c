@@ -0,0 +1,1047 @@
+#include "TypeInference.h"
+#include "SemanticAnalyzer.h"
+
+/** The lattice is shallow, so the fixed point is always reached much sooner. */
+#define MAXIMUM_ITERATIONS 64
+
+/** The times the range of a symbol may grow before it is widened, so that loops and recursion converge. */
+#define MAXIMUM_RANGE_CHANGES 4
+
+/** The largest exponent whose power is bounded by multiplying the range of its base. */
+#define MAXIMUM_BOUNDED_EXPONENT 64
+
+typedef struct {
+    const char * name;
+} tSymbolKey;
+
+/**
+ * The integers a value may take. A bound at the limit of a long stands for any larger value, and an empty range
+ * for a value not known yet.
+ */
+typedef struct {
+    long long low;
+    long long high;
+} tRange;
+
+typedef struct {
+    SaDataType type;
+    /** The type of the elements, if the symbol holds a collection. */
+    SaDataType elementType;
+    /** The integers the symbol may hold. */
+    tRange range;
+    int rangeChanges;
+} tSymbolValue;
+
+typedef struct {
+    Block * block;
+    hashMapADT locals;
+    SaDataType returnType;
+    SaDataType returnElementType;
+    tRange returnRange;
+    int returnRangeChanges;
+    boolean hasReturn;
+    boolean isUsedAsValue;
+} tFunctionValue;
+
+static Logger * _logger = NULL;
+static hashMapADT _globals = NULL;
+static hashMapADT _functions = NULL;
+/** The function whose body is being inferred, or NULL for the top-level sentences. */
+static const char * _currentFunction = NULL;
+static hashMapADT _currentLocals = NULL;
+static boolean _changed = false;
+/** During the last pass the symbols are not updated, and the unknown types are resolved. */
+static boolean _resolving = false;
+/** The symbol whose new value is being inferred, if any. */
+static const char * _assigned = NULL;
+
+/** PRIVATE FUNCTIONS SECTION **/
+
+static SaDataType _inferExpression(Expression * expression);
+static void _inferSentence(Sentence * sentence);
+static SaDataType _inferUnpackedElement(Expression * expression);
+static tRange _rangeOf(const Expression * expression);
+
+static const tRange _emptyRange = { .low = LLONG_MAX, .high = LLONG_MIN };
+static const tRange _unboundedRange = { .low = LLONG_MIN, .high = LLONG_MAX };
+
+static boolean _isNumeric(const SaDataType type) {
+    return type == SA_INTEGER || type == SA_LONG || type == SA_BIG_INTEGER || type == SA_FLOAT;
+}
+
+static boolean _isUnknown(const SaDataType type) {
+    return type == SA_UNKNOWN || type == SA_UNDECLARED;
+}
+
+static boolean _isCollection(const SaDataType type) {
+    return type == SA_LIST || type == SA_TUPLE;
+}
+
+static boolean _isIntegral(const SaDataType type) {
+    return type == SA_INTEGER || type == SA_LONG || type == SA_BIG_INTEGER || type == SA_BOOLEAN;
+}
+
+static boolean _isEmptyRange(const tRange range) {
+    return range.high < range.low;
+}
+
+static boolean _isUnboundedRange(const tRange range) {
+    return !_isEmptyRange(range) && (range.low == LLONG_MIN || range.high == LLONG_MAX);
+}
+
+static boolean _fitsInteger(const tRange range) {
+    return INT32_MIN <= range.low && range.high <= INT32_MAX;
+}
+
+static tRange _joinRanges(const tRange left, const tRange right) {
+    if (_isEmptyRange(left)) {
+        return right;
+    }
+    if (_isEmptyRange(right)) {
+        return left;
+    }
+    return (tRange) {
+        .low = (left.low < right.low)? left.low : right.low,
+        .high = (left.high < right.high)? right.high : left.high
+    };
+}
+
+/**
+ * @brief Join a range into the previous one of a symbol. A range that keeps growing has its growing bounds widened
+ * to the ones of an int, and then to any integer.
+ * @param changes The times the range grew before, which is updated.
+ */
+static tRange _growRange(const tRange previous, const tRange range, int * changes) {
+    tRange joined = _joinRanges(previous, range);
+    if (_isEmptyRange(previous) || (joined.low == previous.low && joined.high == previous.high)) {
+        return joined;
+    }
+    if (MAXIMUM_RANGE_CHANGES <= ++*changes) {
+        if (joined.low < previous.low) {
+            joined.low = (INT32_MIN <= joined.low)? INT32_MIN : LLONG_MIN;
+        }
+        if (previous.high < joined.high) {
+            joined.high = (joined.high <= INT32_MAX)? INT32_MAX : LLONG_MAX;
+        }
+    }
+    return joined;
+}
+
+/**
+ * @brief The range of the values a type can hold, where a long may already be the result of an overflow.
+ */
+static tRange _typeRange(const SaDataType type) {
+    switch (type) {
+        case SA_BOOLEAN:
+            return (tRange) { .low = 0, .high = 1 };
+        case SA_INTEGER:
+            return (tRange) { .low = INT32_MIN, .high = INT32_MAX };
+        case SA_LONG:
+        case SA_BIG_INTEGER:
+            return _unboundedRange;
+        default:
+            return _emptyRange;
+    }
+}
+
+static long long _clamp(const __int128 value) {
+    return (value < LLONG_MIN)? LLONG_MIN : (LLONG_MAX < value)? LLONG_MAX : (long long) value;
+}
+
+static tRange _addRanges(const tRange left, const tRange right) {
+    return (tRange) {
+        .low = (left.low == LLONG_MIN || right.low == LLONG_MIN)? LLONG_MIN : _clamp((__int128) left.low + right.low),
+        .high = (left.high == LLONG_MAX || right.high == LLONG_MAX)? LLONG_MAX : _clamp((__int128) left.high + right.high)
+    };
+}
+
+static tRange _negateRange(const tRange range) {
+    return (tRange) {
+        .low = (range.high == LLONG_MAX)? LLONG_MIN : -range.high,
+        .high = (range.low == LLONG_MIN)? LLONG_MAX : -range.low
+    };
+}
+
+static tRange _multiplyRanges(const tRange left, const tRange right) {
+    const __int128 products[4] = {
+        (__int128) left.low * right.low, (__int128) left.low * right.high,
+        (__int128) left.high * right.low, (__int128) left.high * right.high
+    };
+    __int128 low = products[0];
+    __int128 high = products[0];
+    for (int i = 1; i < 4; ++i) {
+        low = (products[i] < low)? products[i] : low;
+        high = (high < products[i])? products[i] : high;
+    }
+    return (tRange) { .low = _clamp(low), .high = _clamp(high) };
+}
+
+static long long _floorDivide(const long long dividend, const long long divisor) {
+    const long long quotient = dividend / divisor;
+    return (dividend % divisor != 0 && (dividend < 0) != (divisor < 0))? quotient - 1 : quotient;
+}
+
+/**
+ * @brief The range of a floor division, which for positive divisors is bounded by the quotients of the corners, and
+ * otherwise by the magnitude of the dividend.
+ */
+static tRange _divideRanges(const tRange dividend, const tRange divisor) {
+    if (0 < divisor.low) {
+        const long long quotients[4] = {
+            _floorDivide(dividend.low, divisor.low), _floorDivide(dividend.low, divisor.high),
+            _floorDivide(dividend.high, divisor.low), _floorDivide(dividend.high, divisor.high)
+        };
+        tRange range = { .low = quotients[0], .high = quotients[0] };
+        for (int i = 1; i < 4; ++i) {
+            range = _joinRanges(range, (tRange) { .low = quotients[i], .high = quotients[i] });
+        }
+        return range;
+    }
+    const tRange magnitude = _joinRanges(dividend, _negateRange(dividend));
+    return _joinRanges(magnitude, (tRange) { .low = -1, .high = 1 });
+}
+
+/**
+ * @brief The range of a Python modulo, which takes the sign of the divisor and is smaller than it in magnitude.
+ */
+static tRange _moduloRanges(const tRange divisor) {
+    if (0 < divisor.low) {
+        return (tRange) { .low = 0, .high = divisor.high - 1 };
+    }
+    if (divisor.high < 0) {
+        return (tRange) { .low = divisor.low + 1, .high = 0 };
+    }
+    const tRange magnitude = _joinRanges(divisor, _negateRange(divisor));
+    return (tRange) { .low = _clamp((__int128) magnitude.low + 1), .high = _clamp((__int128) magnitude.high - 1) };
+}
+
+/**
+ * @brief The range of an integer arithmetic operation, or an empty one if an operand is not known yet. Powers are
+ * integral only for literal exponents, which bound the result by repeated multiplications of the base.
+ */
+static tRange _arithmeticRange(const Expression * expression) {
+    const tRange left = _rangeOf(expression->leftExpression);
+    const tRange right = _rangeOf(expression->rightExpression);
+    if (_isEmptyRange(left) || _isEmptyRange(right)) {
+        return _emptyRange;
+    }
+    switch (expression->type) {
+        case ADDITION:
+            return _addRanges(left, right);
+        case SUBTRACTION:
+            return _addRanges(left, _negateRange(right));
+        case MULTIPLICATION:
+            return _multiplyRanges(left, right);
+        case TRUNCATED_DIVISION:
+            return _divideRanges(left, right);
+        case MODULO:
+            return _moduloRanges(right);
+        case EXPONENTIATION: {
+            if (right.low != right.high || right.low < 0) {
+                return _emptyRange;
+            }
+            if (MAXIMUM_BOUNDED_EXPONENT < right.low) {
+                return _unboundedRange;
+            }
+            tRange power = { .low = 1, .high = 1 };
+            for (long long i = 0; i < right.low; ++i) {
+                power = _multiplyRanges(power, left);
+            }
+            return power;
+        }
+        default:
+            return _emptyRange;
+    }
+}
+
+/**
+ * @brief Whether the arithmetic expression reads the symbol, directly or through the arguments of calls, where a
+ * call to a function reads its result.
+ */
+static boolean _reads(const Expression * expression, const char * name) {
+    switch (expression->type) {
+        case VARIABLE_CALL_EXPRESSION:
+            return strcmp(expression->variableCall->variableName, name) == 0;
+        case FUNCTION_CALL_EXPRESSION:
+            if (expression->functionCall->type == FC_DEF && strcmp(expression->functionCall->functionName, name) == 0) {
+                return true;
+            }
+            for (const Parameters * argument = expression->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+                if (_reads(argument->leftExpression, name)) {
+                    return true;
+                }
+            }
+            return false;
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+            return _reads(expression->leftExpression, name) || _reads(expression->rightExpression, name);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Whether an unbounded result multiplies the symbol it is assigned to, or adds it to itself, which then grows
+ * geometrically and leaves the longs in a few dozen steps. Counters and sums of other terms take many more, and stay
+ * checked longs.
+ */
+static boolean _growsGeometrically(const Expression * expression) {
+    if (_assigned == NULL) {
+        return false;
+    }
+    const boolean isLeftRead = _reads(expression->leftExpression, _assigned);
+    const boolean isRightRead = _reads(expression->rightExpression, _assigned);
+    switch (expression->type) {
+        case MULTIPLICATION:
+        case EXPONENTIATION:
+            return isLeftRead || isRightRead;
+        case ADDITION:
+        case SUBTRACTION:
+            return isLeftRead && isRightRead;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Resolve a data type for code generation, where unknown types can only be objects.
+ */
+static SaDataType _resolve(const SaDataType type) {
+    return _isUnknown(type)? SA_OBJECT : type;
+}
+
+static SaDataType _store(Expression * expression, const SaDataType type) {
+    expression->dataType = _resolving? _resolve(type) : type;
+    return type;
+}
+
+static void _storeElement(Expression * expression, const SaDataType elementType) {
+    expression->elementType = _resolving? _resolve(elementType) : elementType;
+}
+
+/**
+ * @brief Join two values, where a collection keeps its element type only while every value agrees on it, since
+ * Java arrays of different element types are not assignable to each other.
+ */
+static tSymbolValue _joinValues(const tSymbolValue previous, const tSymbolValue value) {
+    tSymbolValue joined = {
+        .type = joinDataTypes(previous.type, value.type),
+        .elementType = SA_UNKNOWN,
+        .range = previous.range,
+        .rangeChanges = previous.rangeChanges
+    };
+    if (_isCollection(joined.type)) {
+        SaDataType previousElement = _isCollection(previous.type)? previous.elementType : SA_UNKNOWN;
+        SaDataType valueElement = _isCollection(value.type)? value.elementType : SA_UNKNOWN;
+        if (_isUnknown(previousElement) || _isUnknown(valueElement) || previousElement == valueElement) {
+            joined.elementType = _isUnknown(previousElement)? valueElement : previousElement;
+        } else {
+            joined.type = SA_OBJECT;
+        }
+    }
+    return joined;
+}
+
+/**
+ * @brief Get the value of the symbol in the table, which is of type SA_UNKNOWN if it is absent.
+ */
+static tSymbolValue _lookup(hashMapADT table, const char * name, boolean * found) {
+    tSymbolKey key = { .name = name };
+    tSymbolValue value = { .type = SA_UNKNOWN, .elementType = SA_UNKNOWN, .range = _emptyRange, .rangeChanges = 0 };
+    *found = hashMapFind(table, &key, &value);
+    return value;
+}
+
+/**
+ * @brief Join a new value into a symbol of the table, flagging any change.
+ */
+static tSymbolValue _assign(hashMapADT table, const char * name, const SaDataType type, const SaDataType elementType, const tRange range) {
+    boolean found;
+    tSymbolValue previous = _lookup(table, name, &found);
+    tSymbolValue joined = _joinValues(previous, (tSymbolValue) { .type = type, .elementType = elementType });
+    joined.range = _growRange(previous.range, range, &joined.rangeChanges);
+    boolean isChanged = joined.type != previous.type || joined.elementType != previous.elementType
+        || joined.range.low != previous.range.low || joined.range.high != previous.range.high;
+    if (!_resolving && (!found || isChanged)) {
+        tSymbolKey key = { .name = name };
+        hashMapInsertOrUpdate(table, &key, &joined);
+        _changed = _changed || isChanged;
+    }
+    return joined;
+}
+
+static boolean _findFunction(const char * name, tFunctionValue * function) {
+    tSymbolKey key = { .name = name };
+    return name != NULL && hashMapFind(_functions, &key, function);
+}
+
+static tSymbolValue _variableValue(const char * name) {
+    boolean found = false;
+    tSymbolValue value;
+    if (_currentLocals != NULL) {
+        value = _lookup(_currentLocals, name, &found);
+    }
+    if (!found) {
+        value = _lookup(_globals, name, &found);
+    }
+    tFunctionValue function;
+    if (!found && _findFunction(name, &function)) {
+        value.type = SA_OBJECT;
+    }
+    return value;
+}
+
+static tSymbolValue _assignVariable(const char * name, const SaDataType type, const SaDataType elementType, const tRange range) {
+    return _assign(_currentLocals != NULL? _currentLocals : _globals, name, type, elementType, range);
+}
+
+/**
+ * @brief The type of the values produced by iterating over a value of the given type: characters of a string, and
+ * elements of a collection.
+ */
+static SaDataType _iteratedType(const SaDataType type, const SaDataType elementType) {
+    switch (type) {
+        case SA_STRING:
+            return SA_CHARACTER;
+        case SA_LIST:
+        case SA_TUPLE:
+        case SA_RANGE:
+            return elementType;
+        case SA_UNKNOWN:
+        case SA_UNDECLARED:
+            return SA_UNKNOWN;
+        default:
+            return SA_OBJECT;
+    }
+}
+
+/**
+ * @brief The result of an arithmetic operation, following the numeric promotion of the operands.
+ * Booleans behave as integers, true divisions are always floats, and integer powers are integers only if the
+ * exponent is a non-negative literal.
+ */
+static SaDataType _arithmeticType(const Expression * expression, SaDataType left, SaDataType right) {
+    if (_isUnknown(left) || _isUnknown(right)) {
+        return SA_UNKNOWN;
+    }
+    boolean isLeftText = left == SA_STRING || left == SA_CHARACTER;
+    boolean isRightText = right == SA_STRING || right == SA_CHARACTER;
+    if (expression->type == ADDITION && isLeftText && isRightText) {
+        return SA_STRING;
+    }
+    left = (left == SA_BOOLEAN)? SA_INTEGER : left;
+    right = (right == SA_BOOLEAN)? SA_INTEGER : right;
+    if (!_isNumeric(left) || !_isNumeric(right)) {
+        return SA_OBJECT;
+    }
+    if (expression->type == DIVISION) {
+        return SA_FLOAT;
+    }
+    if (expression->type == EXPONENTIATION) {
+        const Expression * exponent = expression->rightExpression;
+        boolean isNaturalExponent = exponent->type == CONSTANT_EXPRESSION
+            && exponent->constant->type == CT_INTEGER
+            && exponent->constant->integer >= 0;
+        if (!isNaturalExponent) {
+            return SA_FLOAT;
+        }
+    }
+    return joinDataTypes(left, right);
+}
+
+static SaDataType _inferConstant(const Constant * constant) {
+    switch (constant->type) {
+        case CT_INTEGER:
+            return (INT32_MIN <= constant->integer && constant->integer <= INT32_MAX)? SA_INTEGER : SA_LONG;
+        case CT_BOOLEAN:
+            return SA_BOOLEAN;
+        case CT_FLOAT:
+            return SA_FLOAT;
+        case CT_STRING:
+            return SA_STRING;
+        default:
+            return SA_OBJECT;
+    }
+}
+
+/**
+ * @brief Infer the elements of a list or tuple constant, which are all of the same type in accepted programs, except
+ * for numbers that get promoted. Nested collections are held as objects.
+ */
+static SaDataType _inferCollection(Expression * expression) {
+    SaDataType elementType = SA_UNKNOWN;
+    const List * collection = (expression->constant->type == CT_LIST)? expression->constant->list : expression->constant->tuple;
+    if (collection->type != LT_TYPED_LIST) {
+        for (Parameters * element = collection->elements; element != NULL && element->leftExpression != NULL; element = element->rightParameters) {
+            SaDataType type = _inferExpression(element->leftExpression);
+            elementType = joinDataTypes(elementType, _isCollection(type)? SA_OBJECT : type);
+        }
+    }
+    _storeElement(expression, elementType);
+    return _store(expression, (expression->constant->type == CT_LIST)? SA_LIST : SA_TUPLE);
+}
+
+/**
+ * @brief Infer the arguments of a call, joining their types into the parameters of the callee.
+ * @param isValue Whether the result of the call is used, or the call is a sentence on its own.
+ */
+/**
+ * The type returned by a call to a builtin, which the semantic analysis
+ * resolved.
+ */
+static SaDataType _inferBuiltinCall(FunctionCall * functionCall) {
+    SaDataType argument = _inferExpression(functionCall->functionArguments->leftExpression);
+    switch (functionCall->object->builtinDefinition) {
+        case BTF_LEN:
+            return SA_INTEGER;
+        case BTF_ABS:
+            return (argument == SA_BOOLEAN)? SA_INTEGER : argument;
+        default:
+            return SA_OBJECT;
+    }
+}
+
+static SaDataType _inferFunctionCall(FunctionCall * functionCall, const boolean isValue) {
+    if (functionCall->type == FC_OBJECT && functionCall->functionArguments != NULL && functionCall->functionArguments->leftExpression != NULL) {
+        return _inferBuiltinCall(functionCall);
+    }
+    tFunctionValue function;
+    boolean isUserFunction = functionCall->type == FC_DEF && _findFunction(functionCall->functionName, &function);
+    if (isUserFunction && isValue && !function.isUsedAsValue) {
+        function.isUsedAsValue = true;
+        tSymbolKey key = { .name = functionCall->functionName };
+        hashMapInsertOrUpdate(_functions, &key, &function);
+    }
+    Parameters * parameter = isUserFunction? function.block->functionDefinition->parameters : NULL;
+    // A recursive call assigns its arguments to the parameters of the running function.
+    const boolean isRecursive = isUserFunction && _currentFunction != NULL && strcmp(functionCall->functionName, _currentFunction) == 0;
+    const char * assigned = _assigned;
+    for (Parameters * argument = functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        if (isRecursive) {
+            _assigned = (parameter != NULL && parameter->leftExpression != NULL)? parameter->leftExpression->variableCall->variableName : NULL;
+        }
+        SaDataType argumentType = _inferExpression(argument->leftExpression);
+        if (parameter != NULL && parameter->leftExpression != NULL) {
+            _assign(function.locals, parameter->leftExpression->variableCall->variableName, argumentType, argument->leftExpression->elementType, _rangeOf(argument->leftExpression));
+            parameter = parameter->rightParameters;
+        }
+    }
+    _assigned = assigned;
+    return isUserFunction? function.returnType : SA_OBJECT;
+}
+
+static SaDataType _inferFunctionCallExpression(Expression * expression, const boolean isValue) {
+    tFunctionValue function;
+    SaDataType type = _inferFunctionCall(expression->functionCall, isValue);
+    boolean isUserFunction = expression->functionCall->type == FC_DEF && _findFunction(expression->functionCall->functionName, &function);
+    _storeElement(expression, isUserFunction? function.returnElementType : SA_UNKNOWN);
+    return _store(expression, type);
+}
+
+static SaDataType _inferExpression(Expression * expression) {
+    if (expression == NULL) {
+        return SA_VOID;
+    }
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_LIST || expression->constant->type == CT_TUPLE) {
+                return _inferCollection(expression);
+            }
+            return _store(expression, _inferConstant(expression->constant));
+        case VARIABLE_CALL_EXPRESSION: {
+            tSymbolValue value = _variableValue(expression->variableCall->variableName);
+            _storeElement(expression, value.elementType);
+            return _store(expression, value.type);
+        }
+        case FUNCTION_CALL_EXPRESSION:
+            return _inferFunctionCallExpression(expression, true);
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case DIVISION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION: {
+            SaDataType left = _inferExpression(expression->leftExpression);
+            SaDataType right = _inferExpression(expression->rightExpression);
+            SaDataType type = _arithmeticType(expression, left, right);
+            boolean isWidening = expression->type == ADDITION || expression->type == SUBTRACTION
+                || expression->type == MULTIPLICATION || expression->type == EXPONENTIATION || expression->type == TRUNCATED_DIVISION;
+            if (isWidening && (type == SA_INTEGER || type == SA_LONG)) {
+                // Results that may not fit in an int are computed on longs, and checked if not even those suffice,
+                // unless they grow fast enough to leave them, which are computed on big integers instead.
+                tRange range = _arithmeticRange(expression);
+                if (!_isEmptyRange(range) && !_fitsInteger(range)) {
+                    type = SA_LONG;
+                }
+                if (type == SA_LONG && _isUnboundedRange(range) && _growsGeometrically(expression)) {
+                    type = SA_BIG_INTEGER;
+                }
+                expression->mayOverflow = _resolving && type == SA_LONG && _isUnboundedRange(range);
+                if (expression->type == TRUNCATED_DIVISION) {
+                    // Only the smallest long divided by -1 leaves the longs.
+                    const tRange dividend = _rangeOf(expression->leftExpression);
+                    const tRange divisor = _rangeOf(expression->rightExpression);
+                    expression->mayOverflow = expression->mayOverflow && dividend.low == LLONG_MIN && divisor.low <= -1 && -1 <= divisor.high;
+                }
+            }
+            return _store(expression, type);
+        }
+        case COMPARISON_EXPRESSION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+            _inferExpression(expression->leftExpression);
+            _inferExpression(expression->rightExpression);
+            return _store(expression, SA_BOOLEAN);
+        case LOGIC_NOT:
+            _inferExpression(expression->notExpression);
+            return _store(expression, SA_BOOLEAN);
+        case UNPACKED_ELEMENT:
+            return _inferUnpackedElement(expression);
+        default:
+            return _store(expression, SA_OBJECT);
+    }
+}
+
+/**
+ * @brief Join into the type the element at a position of every constant returned by the sentences.
+ * @return False if some return is not a constant with that many scalar elements.
+ */
+static boolean _joinReturnedElements(const Sentence * sentence, const int index, const int count, SaDataType * type) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == RETURN_SENTENCE) {
+            const Expression * returned = sentence->expression;
+            if (returned == NULL || returned->type != CONSTANT_EXPRESSION
+                    || (returned->constant->type != CT_LIST && returned->constant->type != CT_TUPLE)
+                    || returned->constant->list->type != LT_PARAMETRIZED_LIST) {
+                return false;
+            }
+            int position = 0;
+            for (const Parameters * value = returned->constant->list->elements; value != NULL && value->leftExpression != NULL; value = value->rightParameters, ++position) {
+                if (_isCollection(value->leftExpression->dataType)) {
+                    return false;
+                }
+                if (position == index) {
+                    *type = joinDataTypes(*type, value->leftExpression->dataType);
+                }
+            }
+            if (position != count) {
+                return false;
+            }
+        } else if (sentence->type == BLOCK_SENTENCE && sentence->block->type != BT_FUNCTION_DEFINITION) {
+            for (const Block * block = sentence->block; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                if (!_joinReturnedElements(block->nextSentence, index, count, type)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Infer an element of an unpacking assignment, which takes the type of its position when the unpacked value
+ * is a constant or the result of a function returning only constants, and the element type of the value otherwise.
+ */
+static SaDataType _inferUnpackedElement(Expression * expression) {
+    const Expression * unpacked = expression->unpackedVariable->expression;
+    SaDataType type = _iteratedType(unpacked->dataType, unpacked->elementType);
+    SaDataType elementType = SA_UNKNOWN;
+    tFunctionValue function;
+    if (unpacked->type == CONSTANT_EXPRESSION && (unpacked->constant->type == CT_LIST || unpacked->constant->type == CT_TUPLE)
+            && unpacked->constant->list->type == LT_PARAMETRIZED_LIST) {
+        int position = 0;
+        for (const Parameters * value = unpacked->constant->list->elements; value != NULL && value->leftExpression != NULL; value = value->rightParameters, ++position) {
+            if (position == expression->elementIndex) {
+                type = value->leftExpression->dataType;
+                elementType = value->leftExpression->elementType;
+            }
+        }
+    } else if (unpacked->type == FUNCTION_CALL_EXPRESSION && unpacked->functionCall->type == FC_DEF
+            && _findFunction(unpacked->functionCall->functionName, &function)) {
+        // The returned elements keep the types of the semantic analysis until the function body is first inferred.
+        SaDataType returned = SA_UNKNOWN;
+        if (!function.hasReturn) {
+            type = SA_UNKNOWN;
+        } else if (_joinReturnedElements(function.block->nextSentence, expression->elementIndex, expression->elementCount, &returned)) {
+            type = returned;
+        }
+    }
+    _storeElement(expression, elementType);
+    return _store(expression, type);
+}
+
+static void _inferReturn(Expression * expression) {
+    // The result of a function is assigned the returned value.
+    _assigned = _currentFunction;
+    SaDataType type = _inferExpression(expression);
+    _assigned = NULL;
+    tFunctionValue function;
+    if (_resolving || !_findFunction(_currentFunction, &function)) {
+        return;
+    }
+    tSymbolValue previous = { .type = function.returnType, .elementType = function.returnElementType };
+    tSymbolValue joined = _joinValues(previous, (tSymbolValue) { .type = type, .elementType = expression->elementType });
+    tRange range = _growRange(function.returnRange, _rangeOf(expression), &function.returnRangeChanges);
+    boolean isChanged = joined.type != previous.type || joined.elementType != previous.elementType
+        || range.low != function.returnRange.low || range.high != function.returnRange.high;
+    if (!function.hasReturn || isChanged) {
+        _changed = _changed || isChanged;
+        function.returnType = joined.type;
+        function.returnElementType = joined.elementType;
+        function.returnRange = range;
+        function.hasReturn = true;
+        tSymbolKey key = { .name = _currentFunction };
+        hashMapInsertOrUpdate(_functions, &key, &function);
+    }
+}
+
+/**
+ * @brief Infer the bounds of a range, which produces integers, or longs if any bound may not fit in an integer.
+ * @return SA_RANGE, or SA_UNKNOWN if the iterable is not a range.
+ */
+static SaDataType _inferRange(Expression * iterable) {
+    tFunctionValue function;
+    if (iterable->type != FUNCTION_CALL_EXPRESSION || !isRangeCall(iterable->functionCall)
+            || (iterable->functionCall->type == FC_DEF && _findFunction(iterable->functionCall->functionName, &function))) {
+        return SA_UNKNOWN;
+    }
+    SaDataType elementType = SA_INTEGER;
+    for (Parameters * argument = iterable->functionCall->functionArguments; argument != NULL && argument->leftExpression != NULL; argument = argument->rightParameters) {
+        SaDataType type = _inferExpression(argument->leftExpression);
+        if (_isUnknown(type)) {
+            elementType = SA_UNKNOWN;
+        } else if (type != SA_INTEGER && type != SA_BOOLEAN && elementType != SA_UNKNOWN) {
+            elementType = SA_LONG;
+        }
+    }
+    _storeElement(iterable, elementType);
+    return _store(iterable, SA_RANGE);
+}
+
+/**
+ * @brief The range of the integers a range call produces, which lie between its start and its stop whatever the sign
+ * of its step.
+ */
+static tRange _rangeElements(const Expression * iterable) {
+    const Parameters * arguments = iterable->functionCall->functionArguments;
+    if (arguments == NULL || arguments->leftExpression == NULL) {
+        return _emptyRange;
+    }
+    const boolean hasStart = arguments->rightParameters != NULL && arguments->rightParameters->leftExpression != NULL;
+    const tRange start = hasStart? _rangeOf(arguments->leftExpression) : (tRange) { .low = 0, .high = 0 };
+    const tRange stop = _rangeOf(hasStart? arguments->rightParameters->leftExpression : arguments->leftExpression);
+    if (_isEmptyRange(start) || _isEmptyRange(stop)) {
+        return _emptyRange;
+    }
+    // A positive step stops right below the stop, and a negative one right above it.
+    const long long belowStop = _clamp((__int128) stop.high - 1);
+    const long long aboveStop = _clamp((__int128) stop.low + 1);
+    return (tRange) {
+        .low = (start.low < aboveStop)? start.low : aboveStop,
+        .high = (belowStop < start.high)? start.high : belowStop
+    };
+}
+
+/**
+ * @brief The range of an integral expression, from the ranges of the symbols and functions it reads. Values whose
+ * range is not tracked may take any value of their type.
+ */
+static tRange _rangeOf(const Expression * expression) {
+    tRange range = _emptyRange;
+    tFunctionValue function;
+    switch (expression->type) {
+        case CONSTANT_EXPRESSION:
+            if (expression->constant->type == CT_INTEGER) {
+                range = (tRange) { .low = expression->constant->integer, .high = expression->constant->integer };
+            } else if (expression->constant->type == CT_BOOLEAN) {
+                range = (tRange) { .low = expression->constant->boolean? 1 : 0, .high = expression->constant->boolean? 1 : 0 };
+            }
+            break;
+        case VARIABLE_CALL_EXPRESSION:
+            range = _variableValue(expression->variableCall->variableName).range;
+            break;
+        case FUNCTION_CALL_EXPRESSION:
+            if (expression->functionCall->type == FC_DEF && _findFunction(expression->functionCall->functionName, &function)) {
+                range = function.returnRange;
+            } else if (expression->functionCall->type == FC_OBJECT && expression->functionCall->object->builtinDefinition == BTF_LEN) {
+                range = (tRange) { .low = 0, .high = INT32_MAX };
+            } else if (expression->functionCall->type == FC_OBJECT && expression->functionCall->object->builtinDefinition == BTF_ABS
+                    && expression->functionCall->functionArguments != NULL) {
+                const tRange argument = _rangeOf(expression->functionCall->functionArguments->leftExpression);
+                if (!_isEmptyRange(argument)) {
+                    range = (tRange) { .low = 0, .high = _joinRanges(argument, _negateRange(argument)).high };
+                }
+            }
+            break;
+        case ADDITION:
+        case SUBTRACTION:
+        case MULTIPLICATION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
+            range = _arithmeticRange(expression);
+            break;
+        case COMPARISON_EXPRESSION:
+        case LOGIC_AND:
+        case LOGIC_OR:
+        case LOGIC_NOT:
+            return (tRange) { .low = 0, .high = 1 };
+        default:
+            break;
+    }
+    if (!_isIntegral(expression->dataType)) {
+        return _emptyRange;
+    }
+    return _isEmptyRange(range)? _typeRange(expression->dataType) : range;
+}
+
+static void _inferBlock(Block * block) {
+    switch (block->type) {
+        case BT_FUNCTION_DEFINITION:
+            // Function bodies are inferred on their own scope.
+            return;
+        case BT_CONDITIONAL:
+            for (Block * branch = block; branch != NULL && branch->conditional != NULL; branch = branch->nextCond) {
+                _inferExpression(branch->conditional->expression);
+                _inferSentence(branch->nextSentence);
+            }
+            return;
+        case BT_WHILE:
+            _inferExpression(block->whileBlock->expression);
+            _inferSentence(block->nextSentence);
+            return;
+        case BT_FOR: {
+            SaDataType iterableType = _inferRange(block->forBlock->right);
+            if (iterableType != SA_RANGE) {
+                iterableType = _inferExpression(block->forBlock->right);
+            }
+            SaDataType iteratedType = _iteratedType(iterableType, block->forBlock->right->elementType);
+            tRange range = (iterableType == SA_RANGE)? _rangeElements(block->forBlock->right) : _typeRange(iteratedType);
+            tSymbolValue value = _assignVariable(block->forBlock->left->variableCall->variableName, iteratedType, SA_UNKNOWN, range);
+            _storeElement(block->forBlock->left, value.elementType);
+            _store(block->forBlock->left, value.type);
+            _inferSentence(block->nextSentence);
+            return;
+        }
+        default:
+            _inferSentence(block->nextSentence);
+            return;
+    }
+}
+
+static void _inferSentence(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        switch (sentence->type) {
+            case EXPRESSION_SENTENCE:
+                if (sentence->expression->type == FUNCTION_CALL_EXPRESSION) {
+                    _inferFunctionCallExpression(sentence->expression, false);
+                } else {
+                    _inferExpression(sentence->expression);
+                }
+                break;
+            case VARIABLE_SENTENCE: {
+                Expression * expression = sentence->variable->expression;
+                _assigned = sentence->variable->identifier;
+                SaDataType type = _inferExpression(expression);
+                _assigned = NULL;
+                tSymbolValue value = _assignVariable(sentence->variable->identifier, type, expression->elementType, _rangeOf(expression));
+                if (_resolving) {
+                    sentence->variable->dataType = _resolve(value.type);
+                    sentence->variable->elementType = _resolve(value.elementType);
+                    if (_isCollection(type) && type == value.type && expression->type == CONSTANT_EXPRESSION) {
+                        // An empty collection takes the element type of the symbol it is assigned to.
+                        expression->elementType = sentence->variable->elementType;
+                    }
+                }
+                break;
+            }
+            case RETURN_SENTENCE:
+                _inferReturn(sentence->expression);
+                break;
+            case BLOCK_SENTENCE:
+                _inferBlock(sentence->block);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Declare, with an unknown type, every symbol assigned in a function body, since in that case the symbol is
+ * local to the function even where it is read before being assigned.
+ */
+static void _declareLocals(hashMapADT locals, Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type == VARIABLE_SENTENCE) {
+            _assign(locals, sentence->variable->identifier, SA_UNKNOWN, SA_UNKNOWN, _emptyRange);
+        } else if (sentence->type == BLOCK_SENTENCE) {
+            Block * block = sentence->block;
+            if (block->type == BT_FOR) {
+                _assign(locals, block->forBlock->left->variableCall->variableName, SA_UNKNOWN, SA_UNKNOWN, _emptyRange);
+            }
+            for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _declareLocals(locals, block->nextSentence);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Register every function definition, with its parameters and locals, and without any known type.
+ */
+static void _registerFunctions(Sentence * sentence) {
+    for (; sentence != NULL; sentence = sentence->nextSentence) {
+        if (sentence->type != BLOCK_SENTENCE) {
+            continue;
+        }
+        Block * block = sentence->block;
+        if (block->type == BT_FUNCTION_DEFINITION) {
+            tFunctionValue function = {
+                .block = block,
+                .locals = hashMapInit(sizeof(tSymbolKey), sizeof(tSymbolValue), hashMapStringHash, hashMapStringKeyEquals),
+                .returnType = SA_UNKNOWN,
+                .returnElementType = SA_UNKNOWN,
+                .returnRange = _emptyRange,
+                .returnRangeChanges = 0,
+                .hasReturn = false,
+                .isUsedAsValue = false
+            };
+            for (Parameters * parameter = block->functionDefinition->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+                _assign(function.locals, parameter->leftExpression->variableCall->variableName, SA_UNKNOWN, SA_UNKNOWN, _emptyRange);
+            }
+            _declareLocals(function.locals, block->nextSentence);
+            tSymbolKey key = { .name = block->functionDefinition->functionName };
+            tFunctionValue previous;
+            if (hashMapFind(_functions, &key, &previous)) {
+                hashMapDestroy(previous.locals);
+            }
+            hashMapInsertOrUpdate(_functions, &key, &function);
+        } else {
+            for (; block != NULL; block = (block->type == BT_CONDITIONAL)? block->nextCond : NULL) {
+                _registerFunctions(block->nextSentence);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Infer every function body on its own scope, and write back the resolved types of its signature.
+ */
+static void _inferFunctions() {
+    int count;
+    tFunctionValue ** functions = (tFunctionValue **) hashMapValues(_functions, &count);
+    // The values may move while the map is updated, so the blocks are gathered first.
+    Block ** blocks = malloc((count + 1) * sizeof(Block *));
+    for (int i = 0; i < count; ++i) {
+        blocks[i] = functions[i]->block;
+    }
+    free(functions);
+    for (int i = 0; i < count; ++i) {
+        FunctionDefinition * definition = blocks[i]->functionDefinition;
+        tFunctionValue function;
+        _findFunction(definition->functionName, &function);
+        _currentFunction = definition->functionName;
+        _currentLocals = function.locals;
+        _inferSentence(blocks[i]->nextSentence);
+        if (_resolving) {
+            _findFunction(definition->functionName, &function);
+            for (Parameters * parameter = definition->parameters; parameter != NULL && parameter->leftExpression != NULL; parameter = parameter->rightParameters) {
+                boolean found;
+                tSymbolValue value = _lookup(function.locals, parameter->leftExpression->variableCall->variableName, &found);
+                parameter->leftExpression->dataType = _resolve(value.type);
+                parameter->leftExpression->elementType = _resolve(value.elementType);
+            }
+            // Python returns None from functions without a return, which Java can only do on an object.
+            definition->dataType = (function.hasReturn || function.isUsedAsValue)? _resolve(function.returnType) : SA_VOID;
+            definition->elementType = _resolve(function.returnElementType);
+        }
+    }
+    _currentFunction = NULL;
+    _currentLocals = NULL;
+    free(blocks);
+}
+
+static void _inferProgram(Program * program) {
+    for (; program != NULL; program = program->nextProgram) {
+        _inferSentence(program->sentence);
+    }
+    _inferFunctions();
+}
+
+static void _destroyFunctions() {
+    int count;
+    tFunctionValue ** functions = (tFunctionValue **) hashMapValues(_functions, &count);
+    for (int i = 0; i < count; ++i) {
+        hashMapDestroy(functions[i]->locals);
+    }
+    free(functions);
+    hashMapDestroy(_functions);
+    _functions = NULL;
+}
+
+/** PUBLIC FUNCTIONS SECTION **/
+
+void initializeTypeInferenceModule() {
+    _logger = createLogger("TypeInference");
+}
+
+void shutdownTypeInferenceModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+SaDataType returnedElementType(const Block * function, const int index, const int count) {
+    SaDataType type = SA_UNKNOWN;
+    if (!_joinReturnedElements(function->nextSentence, index, count, &type)) {
+        return SA_UNKNOWN;
+    }
+    return type;
+}
+
+SaDataType joinDataTypes(const SaDataType left, const SaDataType right) {
+    if (left == right || _isUnknown(right)) {
+        return left;
+    }
+    if (_isUnknown(left)) {
+        return right;
+    }
+    if (_isNumeric(left) && _isNumeric(right)) {
+        if (left == SA_FLOAT || right == SA_FLOAT) {
+            return SA_FLOAT;
+        }
+        return (left == SA_BIG_INTEGER || right == SA_BIG_INTEGER)? SA_BIG_INTEGER : SA_LONG;
+    }
+    return SA_OBJECT;
+}
+
+void inferTypes(Program * program) {
+    logDebugging(_logger, "Inferring types (ADDR: %p)...", program);
+    _globals = hashMapInit(sizeof(tSymbolKey), sizeof(tSymbolValue), hashMapStringHash, hashMapStringKeyEquals);
+    _functions = hashMapInit(sizeof(tSymbolKey), sizeof(tFunctionValue), hashMapStringHash, hashMapStringKeyEquals);
+    for (Program * current = program; current != NULL; current = current->nextProgram) {
+        _registerFunctions(current->sentence);
+    }
+    _resolving = false;
+    int iterations = 0;
+    do {
+        _changed = false;
+        _inferProgram(program);
+        ++iterations;
+    } while (_changed && iterations < MAXIMUM_ITERATIONS);
+    if (_changed) {
+        logWarning(_logger, "Type inference did not converge after %d iterations", iterations);
+    }
+    logDebugging(_logger, "...converged after %d iteration(s)", iterations);
+    _resolving = true;
+    _inferProgram(program);
+    _resolving = false;
+    _destroyFunctions();
+    hashMapDestroy(_globals);
+    _globals = NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef _TYPE_INFERENCE_H_
+#define _TYPE_INFERENCE_H_
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Logger.h"
+#include "HashMap.h"
+#include "SaDataTypes.h"
+
+/**
+ * @brief Initialize the module's internal state.
+ */
+void initializeTypeInferenceModule();
+
+/**
+ * @brief Shutdown the module's internal state.
+ */
+void shutdownTypeInferenceModule();
+
+/**
+ * @brief Get the narrowest data type able to hold values of both data types.
+ * @param left A data type.
+ * @param right Another data type.
+ * @return The join of both data types, which is SA_OBJECT if they are not compatible.
+ */
+SaDataType joinDataTypes(const SaDataType left, const SaDataType right);
+
+/**
+ * @brief Get the type of an element of the tuples a function returns, when every return of the function gives back a
+ * tuple or list constant with the same number of scalar elements.
+ * @param function The definition block of the function.
+ * @param index The position of the element.
+ * @param count The number of elements every returned constant must have.
+ * @return The join of the types at that position, or SA_UNKNOWN if some return is not such a constant.
+ */
+SaDataType returnedElementType(const Block * function, const int index, const int count);
+
+/**
+ * @brief Refine the data types cached on the AST of a program accepted by the semantic analysis.
+ * Types are propagated through assignments, arithmetic, call arguments and returns until a fixed point is reached,
+ * so integers, longs and booleans stay primitive wherever every value a symbol can hold has the same type.
+ * @param program The program whose types will be inferred.
+ */
+void inferTypes(Program * program);
+
+#endif
@@ -184,7 +184,7 @@ Token BuiltinIdentifierLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerCont
 
 Token IntegerLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-	lexicalAnalyzerContext->semanticValue->integer = atoi(lexicalAnalyzerContext->lexeme);
+	lexicalAnalyzerContext->semanticValue->integer = strtoll(lexicalAnalyzerContext->lexeme, NULL, 10);
 	return INTEGER;
 }
 
@@ -535,6 +535,12 @@ Token DefineLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	return DEF;
 }
 
+Token CacheDecoratorLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+	lexicalAnalyzerContext->semanticValue->token = CACHE;
+	return CACHE;
+}
+
 Token IndentLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
 	lexicalAnalyzerContext->semanticValue->token = INDENT;
@@ -146,6 +146,7 @@ Token TypeKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 Token AssertKeywordLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
 Token DefineLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token CacheDecoratorLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
 Token UnknownLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
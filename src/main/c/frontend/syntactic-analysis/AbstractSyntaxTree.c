@@ -89,6 +89,9 @@ void releaseExpression(Expression * expression) {
         case DIVISION:
         case MULTIPLICATION:
         case SUBTRACTION:
+        case TRUNCATED_DIVISION:
+        case MODULO:
+        case EXPONENTIATION:
         case LOGIC_OR:
         case LOGIC_AND:
             releaseExpression(expression->leftExpression);
@@ -221,6 +224,7 @@ void releaseBlock(Block * block){
     if(block->nextSentence!= NULL) {
         releaseSentence(block->nextSentence);
     }
+    free(block);
 }
 
 void releaseConditionalBlock(ConditionalBlock * cblock) {
@@ -260,11 +264,15 @@ void releaseSentence(Sentence * sentence){
             if(sentence->variable != NULL){
                 releaseVariable(sentence->variable);
             }
+        break;
         case BLOCK_SENTENCE:
             if(sentence->block != NULL){
                 releaseBlock(sentence->block);
             }
         break;
+        case RETURN_SENTENCE:
+            releaseExpression(sentence->expression);
+        break;
     }
     releaseSentence(sentence->nextSentence);
     free(sentence);
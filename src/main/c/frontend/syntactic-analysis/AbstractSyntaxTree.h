@@ -1,6 +1,7 @@
 #ifndef ABSTRACT_SYNTAX_TREE_HEADER
 #define ABSTRACT_SYNTAX_TREE_HEADER
 
+#include "../../backend/semantic-analysis/SaDataTypes.h"
 #include "../../shared/Logger.h"
 #include <stdlib.h>
 
@@ -123,6 +124,7 @@ enum ExpressionType {
 	LOGIC_OR,
 	LOGIC_NOT,
     COMPARISON_EXPRESSION,
+	UNPACKED_ELEMENT,
 };
 
 enum SentenceType {
@@ -280,7 +282,7 @@ enum ConditionalType {
 
 struct Constant {
 	union{
-        int integer;
+        long long integer;
         boolean boolean;
         double decimal;
         char * string;
@@ -294,6 +296,10 @@ struct Constant {
 struct Variable {
 	Expression * expression;
 	char * identifier;
+	/** The type of the assigned symbol, resolved by the semantic analysis. */
+	SaDataType dataType;
+	/** The type of the elements, if the symbol holds a collection. */
+	SaDataType elementType;
 };
 
 struct Object {
@@ -328,8 +334,20 @@ struct Expression {
             BinaryComparatorType compType;
 		};
         Expression * notExpression;
+		/** An element of the value assigned to a hidden variable by an unpacking assignment. */
+		struct {
+			Variable * unpackedVariable;
+			int elementIndex;
+			int elementCount;
+		};
 	};
 	ExpressionType type;
+	/** The type of the expression, resolved by the semantic analysis. */
+	SaDataType dataType;
+	/** The type of the elements, if the expression is a collection. */
+	SaDataType elementType;
+	/** Whether the integer result may not fit in a long, so the operation must fail instead of wrapping around. */
+	boolean mayOverflow;
 };
 
 struct Sentence {
@@ -382,6 +400,12 @@ struct FunctionDefinition {
     Parameters * parameters;
     char * functionName;
     FunctionDefinitionType type;
+    /** The return type of the function, resolved by the semantic analysis. */
+    SaDataType dataType;
+    /** The type of the returned elements, if the function returns a collection. */
+    SaDataType elementType;
+    /** Whether the function was decorated with "@cache", so results are memoized by argument. */
+    boolean isCached;
 };
 
 struct ClassDefinition {
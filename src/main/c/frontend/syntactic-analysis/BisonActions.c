@@ -7,6 +7,8 @@
 /* GLOBAL VARIABLES*/
 static int expectedDepth = 0;
 static int currentDepth = 0;
+/** Numbers the hidden variables holding the values of unpacking assignments. */
+static int unpackingCount = 0;
 
 /* MODULE INTERNAL STATE */
 
@@ -29,6 +31,16 @@ extern unsigned int flexCurrentContext(void);
 /* PRIVATE FUNCTIONS */
 
 static void _logSyntacticAnalyzerAction(const char * functionName);
+
+/**
+ * Allocates a node of the abstract syntax tree, counting it by type for the
+ * statistics of the compilation.
+ */
+static void * _newNode(const char * type, const size_t size) {
+	countNode(type);
+	return calloc(1, size);
+}
+
 static int getExpressionType(Expression *expression) {
     struct key key;
     struct value value;
@@ -114,9 +126,9 @@ static void _logSyntacticAnalyzerAction(const char * functionName) {
 /* PUBLIC FUNCTIONS */
 
 /** CONSTANT SECTION **/
-Constant * IntegerConstantSemanticAction(const int value) {
+Constant * IntegerConstantSemanticAction(const long long value) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->integer = value;
     constant->type = CT_INTEGER;
 	return constant;
@@ -124,7 +136,7 @@ Constant * IntegerConstantSemanticAction(const int value) {
 
 Constant * BooleanConstantSemanticAction(const boolean value) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->boolean = value;
     constant->type = CT_BOOLEAN;
 	return constant;
@@ -132,7 +144,7 @@ Constant * BooleanConstantSemanticAction(const boolean value) {
 
 Constant * FloatConstantSemanticAction(const double decimal) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->decimal = decimal;
     constant->type = CT_FLOAT;
 	return constant;
@@ -140,7 +152,7 @@ Constant * FloatConstantSemanticAction(const double decimal) {
 
 Constant * StringConstantSemanticAction(char * restrict string) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->string = string;
     constant->type = CT_STRING;
 	return constant;
@@ -148,7 +160,7 @@ Constant * StringConstantSemanticAction(char * restrict string) {
 
 Constant * ListConstantSemanticAction(List * lst) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->list = lst;
     constant->type = CT_LIST;
 	return constant;
@@ -156,7 +168,7 @@ Constant * ListConstantSemanticAction(List * lst) {
 
 Constant * TupleConstantSemanticAction(Tuple * tpl) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Constant * constant = calloc(1, sizeof(Constant));
+	Constant * constant = _newNode("Constant", sizeof(Constant));
 	constant->tuple = tpl;
     constant->type = CT_TUPLE;
 	return constant;
@@ -165,7 +177,7 @@ Constant * TupleConstantSemanticAction(Tuple * tpl) {
 /** EXPRESSION SECTION **/
 Expression * ArithmeticExpressionSemanticAction(Expression * leftExpression, Expression * rightExpression, ExpressionType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->leftExpression = leftExpression;
 	expression->rightExpression = rightExpression;
 	expression->type = type;
@@ -174,7 +186,7 @@ Expression * ArithmeticExpressionSemanticAction(Expression * leftExpression, Exp
 
 Expression * BitArithmeticExpressionSemanticAction(Expression * leftExpression, Expression * rightExpression, ExpressionType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->leftExpression = leftExpression;
 	expression->rightExpression = rightExpression;
 	expression->type = type;
@@ -183,7 +195,15 @@ Expression * BitArithmeticExpressionSemanticAction(Expression * leftExpression,
 
 Expression * ConstantExpressionSemanticAction(Constant * constant) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	if (constant->type == CT_TUPLE && constant->tuple->type == LT_PARAMETRIZED_LIST && constant->tuple->elements->type == FINAL) {
+		// A parenthesized expression without a trailing comma only groups it.
+		Expression * grouped = constant->tuple->elements->leftExpression;
+		free(constant->tuple->elements);
+		free(constant->tuple);
+		free(constant);
+		return grouped;
+	}
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->constant = constant;
 	expression->type = CONSTANT_EXPRESSION;
 	return expression;
@@ -191,7 +211,7 @@ Expression * ConstantExpressionSemanticAction(Constant * constant) {
 
 Expression * VariableCallExpressionSemanticAction(VariableCall * var) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->variableCall = var;
 	expression->type = VARIABLE_CALL_EXPRESSION;
 	return expression;
@@ -199,7 +219,7 @@ Expression * VariableCallExpressionSemanticAction(VariableCall * var) {
 
 Expression * FunctionCallExpressionSemanticAction(FunctionCall * fcall) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->functionCall = fcall;
 	expression->type = FUNCTION_CALL_EXPRESSION;
 	return expression;
@@ -207,7 +227,7 @@ Expression * FunctionCallExpressionSemanticAction(FunctionCall * fcall) {
 
 Expression * MethodCallExpressionSemanticAction(MethodCall * methodCall) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->methodCall = methodCall;
 	expression->type = METHOD_CALL_EXPRESSION;
 	return expression;
@@ -215,7 +235,7 @@ Expression * MethodCallExpressionSemanticAction(MethodCall * methodCall) {
 
 Expression * FieldGetterExpressionSemanticAction(FieldGetter * fieldGetter) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->fieldGetter = fieldGetter;
 	expression->type = FIELD_GETTER_EXPRESSION;
 	return expression;
@@ -223,7 +243,7 @@ Expression * FieldGetterExpressionSemanticAction(FieldGetter * fieldGetter) {
 
 Expression * LogicalOrExpressionSemanticAction(Expression * left, Expression * right) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->leftExpression = left;
     expression->rightExpression = right;
 	expression->type = LOGIC_OR;
@@ -233,7 +253,7 @@ Expression * LogicalOrExpressionSemanticAction(Expression * left, Expression * r
 
 Expression * LogicalAndExpressionSemanticAction(Expression * left, Expression * right) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->leftExpression = left;
     expression->rightExpression = right;
 	expression->type = LOGIC_AND;
@@ -242,7 +262,7 @@ Expression * LogicalAndExpressionSemanticAction(Expression * left, Expression *
 
 Expression * LogicalNotExpressionSemanticAction(Expression * notExp) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
 	expression->notExpression = notExp;
 	expression->type = LOGIC_NOT;
 	return expression;
@@ -250,7 +270,7 @@ Expression * LogicalNotExpressionSemanticAction(Expression * notExp) {
 
 Expression * ExpressionComparisonSemanticAction(BinaryComparatorType compType, Expression * left, Expression * right) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Expression * expression = calloc(1, sizeof(Expression));
+	Expression * expression = _newNode("Expression", sizeof(Expression));
     expression->leftCompExpression = left;
     expression->rightCompExpression = right;
     expression->compType = compType;
@@ -260,7 +280,7 @@ Expression * ExpressionComparisonSemanticAction(BinaryComparatorType compType, E
 
 Program * GeneralProgramSemanticAction(CompilerState * compilerState, Depth * dp, Sentence * sentence, Program * nprog) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Program * program = calloc(1, sizeof(Program));
+	Program * program = _newNode("Program", sizeof(Program));
 	program->depth = dp;
 	program->sentence = sentence;
 	program->nextProgram = nprog;
@@ -283,7 +303,7 @@ Program * FinishedProgramSemanticAction(CompilerState * compilerState) {
 
 FunctionCall * FunctionCallSemanticAction(const char * function, Parameters * parameters) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	FunctionCall * functionCall = calloc(1, sizeof(FunctionCall));
+	FunctionCall * functionCall = _newNode("FunctionCall", sizeof(FunctionCall));
 	functionCall->functionName = function; // function is obtained from strdup, should be freed
 	functionCall->functionArguments = parameters;
     functionCall->type = FC_DEF;
@@ -292,7 +312,7 @@ FunctionCall * FunctionCallSemanticAction(const char * function, Parameters * pa
 
 FunctionCall * ObjectFunctionCallSemanticAction(Object * obj, Parameters * parameters){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	FunctionCall * functionCall = calloc(1, sizeof(FunctionCall));
+	FunctionCall * functionCall = _newNode("FunctionCall", sizeof(FunctionCall));
 	functionCall->object = obj;
 	functionCall->functionArguments = parameters;
     functionCall->type = FC_OBJECT;
@@ -301,7 +321,7 @@ FunctionCall * ObjectFunctionCallSemanticAction(Object * obj, Parameters * param
 
 VariableCall * VariableCallSemanticAction(const char * variable) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	VariableCall * variableCall = calloc(1, sizeof(VariableCall));
+	VariableCall * variableCall = _newNode("VariableCall", sizeof(VariableCall));
 	variableCall->variableName = variable;
 	return variableCall;
 }
@@ -309,7 +329,7 @@ VariableCall * VariableCallSemanticAction(const char * variable) {
 Parameters * ParametersSemanticAction(Expression * leftExpression, Parameters * followingParameters,
 									ParamType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Parameters * parameters = calloc(1, sizeof(Parameters));
+	Parameters * parameters = _newNode("Parameters", sizeof(Parameters));
 	parameters->leftExpression = leftExpression;
 	parameters->rightParameters = followingParameters;
 	parameters->type = type;
@@ -319,7 +339,7 @@ Parameters * ParametersSemanticAction(Expression * leftExpression, Parameters *
 Depth * DepthSemanticAction(DepthType type) {
 	if (type != END_DEPTH) { currentDepth++; }
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Depth * depth = calloc(1, sizeof(Depth));
+	Depth * depth = _newNode("Depth", sizeof(Depth));
 	depth->type = type;
 	return depth;
 }
@@ -327,7 +347,7 @@ Depth * DepthSemanticAction(DepthType type) {
 /** SENTENCE SECTION **/
 Sentence * ExpressionSentenceSemanticAction(Expression * exp, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Sentence * sentence = calloc(1, sizeof(Sentence));
+	Sentence * sentence = _newNode("Sentence", sizeof(Sentence));
 	sentence->expression = exp;
 	sentence->type = EXPRESSION_SENTENCE;
 	sentence->nextSentence = next;
@@ -336,7 +356,7 @@ Sentence * ExpressionSentenceSemanticAction(Expression * exp, Sentence * next) {
 
 Sentence * VariableSentenceSemanticAction(Variable * var, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Sentence * sentence = calloc(1, sizeof(Sentence));
+	Sentence * sentence = _newNode("Sentence", sizeof(Sentence));
 	sentence->variable = var;
 	sentence->type = VARIABLE_SENTENCE;
 	sentence->nextSentence = next;
@@ -345,7 +365,7 @@ Sentence * VariableSentenceSemanticAction(Variable * var, Sentence * next) {
 
 Sentence * BlockSentenceSemanticAction(Block * block, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Sentence * sentence = calloc(1, sizeof(Sentence));
+	Sentence * sentence = _newNode("Sentence", sizeof(Sentence));
 	sentence->block = block;
 	sentence->type = BLOCK_SENTENCE;
 	sentence->nextSentence = next;
@@ -354,13 +374,46 @@ Sentence * BlockSentenceSemanticAction(Block * block, Sentence * next) {
 
 Sentence * ReturnSentenceSemanticAction(Expression * exp, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Sentence * sentence = calloc(1, sizeof(Sentence));
+	Sentence * sentence = _newNode("Sentence", sizeof(Sentence));
 	sentence->expression = exp;
 	sentence->type = RETURN_SENTENCE;
 	sentence->nextSentence = next;
 	return sentence;
 }
 
+Sentence * UnpackingSentenceSemanticAction(Parameters * targets, Expression * expression, Sentence * next) {
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	// "a, b = x" becomes "$unpackN = x", followed by one assignment of each element.
+	char * name = calloc(24, sizeof(char));
+	sprintf(name, "$unpack%d", unpackingCount++);
+	Variable * unpacked = ExpressionVariableSemanticAction(name, expression);
+	int count = 0;
+	for (Parameters * target = targets; target != NULL; target = target->rightParameters) {
+		++count;
+	}
+	Sentence * sentences[count + 1];
+	int index = 0;
+	while (targets != NULL) {
+		Expression * element = _newNode("Expression", sizeof(Expression));
+		element->unpackedVariable = unpacked;
+		element->elementIndex = index;
+		element->elementCount = count;
+		element->type = UNPACKED_ELEMENT;
+		char * target = strdup(targets->leftExpression->variableCall->variableName);
+		sentences[index++] = VariableSentenceSemanticAction(ExpressionVariableSemanticAction(target, element), NULL);
+		Parameters * parsed = targets;
+		targets = targets->rightParameters;
+		free(parsed->leftExpression->variableCall);
+		free(parsed->leftExpression);
+		free(parsed);
+	}
+	sentences[count] = next;
+	for (index = count - 1; 0 <= index; --index) {
+		sentences[index]->nextSentence = sentences[index + 1];
+	}
+	return VariableSentenceSemanticAction(unpacked, sentences[0]);
+}
+
 Sentence * EndOfSentencesSemanticAction() {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
 	return NULL;
@@ -369,7 +422,7 @@ Sentence * EndOfSentencesSemanticAction() {
 /** BLOCK SECTION **/
 Block * FunctionDefinitionBlockSemanticAction(FunctionDefinition * fdef, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Block * block = calloc(1, sizeof(Block));
+	Block * block = _newNode("Block", sizeof(Block));
     block->type = BT_FUNCTION_DEFINITION;
     block->functionDefinition = fdef;
     block->nextSentence = next;
@@ -378,7 +431,7 @@ Block * FunctionDefinitionBlockSemanticAction(FunctionDefinition * fdef, Sentenc
 
 Block * ClassDefinitionBlockSemanticAction(ClassDefinition * cdef, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    Block * block = calloc(1, sizeof(Block));
+    Block * block = _newNode("Block", sizeof(Block));
     block->type = BT_CLASS_DEFINITION;
     block->classDefinition = cdef;
     block->nextSentence = next;
@@ -387,7 +440,7 @@ Block * ClassDefinitionBlockSemanticAction(ClassDefinition * cdef, Sentence * ne
 
 Block * ConditionalBlockSemanticAction(ConditionalBlock * cond, Sentence * nextSentence, Block * nextConditional) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Block * block = calloc(1, sizeof(Block));
+	Block * block = _newNode("Block", sizeof(Block));
 	block->type = BT_CONDITIONAL;
 	block->conditional = cond;
 	block->nextSentence = nextSentence;
@@ -397,7 +450,7 @@ Block * ConditionalBlockSemanticAction(ConditionalBlock * cond, Sentence * nextS
 
 Block * WhileLoopBlockSemanticAction(WhileBlock * wblock, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Block * block = calloc(1, sizeof(Block));
+	Block * block = _newNode("Block", sizeof(Block));
 	block->type = BT_WHILE;
 	block->whileBlock = wblock;
 	block->nextSentence = next;
@@ -406,7 +459,7 @@ Block * WhileLoopBlockSemanticAction(WhileBlock * wblock, Sentence * next) {
 
 Block * ForLoopBlockSemanticAction(ForBlock * fblock, Sentence * next) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Block * block = calloc(1, sizeof(Block));
+	Block * block = _newNode("Block", sizeof(Block));
 	block->type = BT_FOR;
 	block->forBlock = fblock;
 	block->nextSentence = next;
@@ -420,7 +473,7 @@ ConditionalBlock * ConditionalSemanticAction(ConditionalType type, Expression *
 	// 	logCritical(_logger, "ERROR: Not boolean expression");
 	// 	exit(1);
 	// }
-	ConditionalBlock * conditionalBlock = calloc(1, sizeof(ConditionalBlock));
+	ConditionalBlock * conditionalBlock = _newNode("ConditionalBlock", sizeof(ConditionalBlock));
     conditionalBlock->expression = exp;
     conditionalBlock->type = type;
 	return conditionalBlock;
@@ -429,7 +482,7 @@ ConditionalBlock * ConditionalSemanticAction(ConditionalType type, Expression *
 /** WHILE BLOCK SECTION **/
 WhileBlock * WhileBlockSemanticAction(Expression * exp) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	WhileBlock * whileBlock = calloc(1, sizeof(WhileBlock));
+	WhileBlock * whileBlock = _newNode("WhileBlock", sizeof(WhileBlock));
 	whileBlock->expression = exp;
 	return whileBlock;
 }
@@ -437,7 +490,7 @@ WhileBlock * WhileBlockSemanticAction(Expression * exp) {
 /** FOR BLOCK SECTION **/
 ForBlock * ForBlockSemanticAction(Expression * left, Expression * right) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	ForBlock * forBlock = calloc(1, sizeof(ForBlock));
+	ForBlock * forBlock = _newNode("ForBlock", sizeof(ForBlock));
     forBlock->left = left;
     forBlock->right = right;
 	return forBlock;
@@ -446,7 +499,7 @@ ForBlock * ForBlockSemanticAction(Expression * left, Expression * right) {
 /** FUNCTION DEFINITION SECTION **/
 FunctionDefinition * GenericFunctionDefinitionSemanticAction(char * restrict id, Parameters * params) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionDefinition * functionDefinition = calloc(1, sizeof(FunctionDefinition));
+    FunctionDefinition * functionDefinition = _newNode("FunctionDefinition", sizeof(FunctionDefinition));
     functionDefinition->functionName = id;
     functionDefinition->parameters = params;
     functionDefinition->type = FD_GENERIC;
@@ -455,7 +508,7 @@ FunctionDefinition * GenericFunctionDefinitionSemanticAction(char * restrict id,
 
 FunctionDefinition * ObjectFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, Object * object) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionDefinition * functionDefinition = calloc(1, sizeof(FunctionDefinition));
+    FunctionDefinition * functionDefinition = _newNode("FunctionDefinition", sizeof(FunctionDefinition));
     functionDefinition->functionName = id;
     functionDefinition->parameters = params;
     functionDefinition->objectType = object;
@@ -465,7 +518,7 @@ FunctionDefinition * ObjectFunctionDefinitionSemanticAction(char * restrict id,
 
 FunctionDefinition * VariableCallFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, VariableCall * retVar) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionDefinition * functionDefinition = calloc(1, sizeof(FunctionDefinition));
+    FunctionDefinition * functionDefinition = _newNode("FunctionDefinition", sizeof(FunctionDefinition));
     functionDefinition->functionName = id;
     functionDefinition->parameters = params;
     functionDefinition->returnVariableType = retVar;
@@ -476,7 +529,7 @@ FunctionDefinition * VariableCallFunctionDefinitionSemanticAction(char * restric
 
 FunctionDefinition * TupleFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, Tuple * tupleVar) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionDefinition * functionDefinition = calloc(1, sizeof(FunctionDefinition));
+    FunctionDefinition * functionDefinition = _newNode("FunctionDefinition", sizeof(FunctionDefinition));
     functionDefinition->functionName = id;
     functionDefinition->parameters = params;
     functionDefinition->tupleReturnType = tupleVar;
@@ -486,7 +539,7 @@ FunctionDefinition * TupleFunctionDefinitionSemanticAction(char * restrict id, P
 
 FunctionDefinition * ListFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, List * listVar) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    FunctionDefinition * functionDefinition = calloc(1, sizeof(FunctionDefinition));
+    FunctionDefinition * functionDefinition = _newNode("FunctionDefinition", sizeof(FunctionDefinition));
     functionDefinition->functionName = id;
     functionDefinition->parameters = params;
     functionDefinition->listReturnType = listVar;
@@ -494,10 +547,16 @@ FunctionDefinition * ListFunctionDefinitionSemanticAction(char * restrict id, Pa
     return functionDefinition;
 }
 
+FunctionDefinition * CachedFunctionDefinitionSemanticAction(FunctionDefinition * functionDefinition) {
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+    functionDefinition->isCached = true;
+    return functionDefinition;
+}
+
 /** CLASS DEFINITION SECTION **/
 ClassDefinition * ClassDefinitionSemanticAction(char * restrict id) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    ClassDefinition * classDefinition = calloc(1, sizeof(ClassDefinition));
+    ClassDefinition * classDefinition = _newNode("ClassDefinition", sizeof(ClassDefinition));
     classDefinition->className = id;
     classDefinition->type = CDT_NOT_INHERITS;
     return classDefinition;
@@ -505,7 +564,7 @@ ClassDefinition * ClassDefinitionSemanticAction(char * restrict id) {
 
 ClassDefinition * TupleClassDefinitionSemanticAction(char * restrict id, Tuple * tpl) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    ClassDefinition * classDefinition = calloc(1, sizeof(ClassDefinition));
+    ClassDefinition * classDefinition = _newNode("ClassDefinition", sizeof(ClassDefinition));
     classDefinition->className = id;
     classDefinition->tuple = tpl;
     classDefinition->type = CDT_TUPLE_INHERITANCE;
@@ -515,7 +574,7 @@ ClassDefinition * TupleClassDefinitionSemanticAction(char * restrict id, Tuple *
 /** VARIABLE SECTION **/
 Variable * ExpressionVariableSemanticAction(char * restrict id, Expression * expr) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-    Variable * variable = calloc(1, sizeof(Variable));
+    Variable * variable = _newNode("Variable", sizeof(Variable));
 	variable->expression = expr;
 	variable->identifier = id;
 	return variable;
@@ -524,7 +583,7 @@ Variable * ExpressionVariableSemanticAction(char * restrict id, Expression * exp
 /** METHOD CALL SECTION **/
 MethodCall * VariableMethodCallSemanticAction(VariableCall * var, FunctionCall * method) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	MethodCall * methodCall = calloc(1, sizeof(MethodCall));
+	MethodCall * methodCall = _newNode("MethodCall", sizeof(MethodCall));
 	methodCall->variableCall = var;
 	methodCall->functionCall = method;
 	methodCall->type = MCT_VARIABLE_TRIGGER;
@@ -533,7 +592,7 @@ MethodCall * VariableMethodCallSemanticAction(VariableCall * var, FunctionCall *
 
 MethodCall * ConstantMethodCallSemanticAction(Constant * cons, FunctionCall * method) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	MethodCall * methodCall = calloc(1, sizeof(MethodCall));
+	MethodCall * methodCall = _newNode("MethodCall", sizeof(MethodCall));
 	methodCall->constant = cons;
 	methodCall->functionCall = method;
 	methodCall->type = MCT_CONSTANT_TRIGGER;
@@ -543,7 +602,7 @@ MethodCall * ConstantMethodCallSemanticAction(Constant * cons, FunctionCall * me
 /** FIELD GETTER SECTION **/
 FieldGetter * VariableFieldGetterSemanticAction(VariableCall * var, VariableCall * field) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	FieldGetter * fieldGetter = calloc(1, sizeof(FieldGetter));
+	FieldGetter * fieldGetter = _newNode("FieldGetter", sizeof(FieldGetter));
 	fieldGetter->variableCall = var;
 	fieldGetter->field = field;
 	fieldGetter->type = FG_VARIABLE_OWNER;
@@ -552,7 +611,7 @@ FieldGetter * VariableFieldGetterSemanticAction(VariableCall * var, VariableCall
 
 FieldGetter * ConstantFieldGetterSemanticAction(Constant * cons, VariableCall * field) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	FieldGetter * fieldGetter = calloc(1, sizeof(FieldGetter));
+	FieldGetter * fieldGetter = _newNode("FieldGetter", sizeof(FieldGetter));
 	fieldGetter->constant = cons;
 	fieldGetter->field = field;
 	fieldGetter->type = FG_CONSTANT_OWNER;
@@ -562,7 +621,7 @@ FieldGetter * ConstantFieldGetterSemanticAction(Constant * cons, VariableCall *
 /** OBJECT SECTION **/
 Object * ObjectSemanticAction(BuiltinDefinition def, ObjectType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Object * object = calloc(1, sizeof(Object));
+	Object * object = _newNode("Object", sizeof(Object));
 	object->builtinDefinition = def;
 	object->type = type;
 	return object;
@@ -571,7 +630,7 @@ Object * ObjectSemanticAction(BuiltinDefinition def, ObjectType type) {
 /** LIST SECTION **/
 List * TypedListSemanticAction(Object * obj) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	List * list = calloc(1, sizeof(List));
+	List * list = _newNode("List", sizeof(List));
 	list->objectType = obj;
 	list->type = LT_TYPED_LIST;
 	return list;
@@ -579,7 +638,7 @@ List * TypedListSemanticAction(Object * obj) {
 
 List * ParametrizedListSemanticAction(Parameters * params) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	List * list = calloc(1, sizeof(List));
+	List * list = _newNode("List", sizeof(List));
 	list->elements = params;
     if(params != NULL) {
 	    list->type = LT_PARAMETRIZED_LIST;
@@ -593,7 +652,7 @@ List * ParametrizedListSemanticAction(Parameters * params) {
 /** TUPLE SECTION **/
 Tuple * ParametrizedTupleSemanticAction(Parameters * params) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Tuple * tuple = calloc(1, sizeof(List));
+	Tuple * tuple = _newNode("List", sizeof(List));
 	tuple->elements = params;
     if(params != NULL) {
 	    tuple->type = LT_PARAMETRIZED_LIST;
@@ -606,7 +665,7 @@ Tuple * ParametrizedTupleSemanticAction(Parameters * params) {
 
 Tuple * TypedTupleSemanticAction(Object * obj) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Tuple * tuple = calloc(1, sizeof(List));
+	Tuple * tuple = _newNode("List", sizeof(List));
 	tuple->objectType = obj;
 	tuple->type = LT_TYPED_LIST;
 	return tuple;
@@ -3,6 +3,7 @@
 
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
 #include "../../shared/Type.h"
 #include "AbstractSyntaxTree.h"
 #include "SyntacticAnalyzer.h"
@@ -19,7 +20,7 @@ void shutdownBisonActionsModule();
  */
 
 /** CONSTANT SECTION**/
-Constant * IntegerConstantSemanticAction(const int value);
+Constant * IntegerConstantSemanticAction(const long long value);
 Constant * BooleanConstantSemanticAction(const boolean value);
 Constant * FloatConstantSemanticAction(const double decimal);
 Constant * StringConstantSemanticAction(char * restrict str);
@@ -54,6 +55,7 @@ Sentence * ExpressionSentenceSemanticAction(Expression * exp, Sentence * sentenc
 Sentence * VariableSentenceSemanticAction(Variable * var, Sentence * sentence);
 Sentence * BlockSentenceSemanticAction(Block * block, Sentence * sentence);
 Sentence * ReturnSentenceSemanticAction(Expression * exp, Sentence * sentence);
+Sentence * UnpackingSentenceSemanticAction(Parameters * targets, Expression * expression, Sentence * sentence);
 Sentence * EndOfSentencesSemanticAction();
 
 /** BLOCK SECTION **/
@@ -78,6 +80,7 @@ FunctionDefinition * ObjectFunctionDefinitionSemanticAction(char * restrict id,
 FunctionDefinition * VariableCallFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, VariableCall * retVar);
 FunctionDefinition * TupleFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, Tuple * tupleVar);
 FunctionDefinition * ListFunctionDefinitionSemanticAction(char * restrict id, Parameters * params, List * listVar);
+FunctionDefinition * CachedFunctionDefinitionSemanticAction(FunctionDefinition * functionDefinition);
 
 /** CLASS DEFINITION SECTION **/
 ClassDefinition * ClassDefinitionSemanticAction(char * restrict id);
@@ -2,6 +2,16 @@
 
 #include "BisonActions.h"
 
+/**
+ * The sentence rules are right-recursive, so every sentence of a block stays
+ * on the stack until the block ends. The default of 10000 states rejects
+ * programs of a few hundred thousand lines.
+ */
+#define YYMAXDEPTH 100000000
+
+/** Counts and traces every token the parser reads. */
+#define yylex() nextToken()
+
 %}
 
 %define api.value.union.name SemanticValue
@@ -9,7 +19,7 @@
 %union {
 	/** Terminals. */
 
-	int integer;
+	long long integer;
 	double fp_number;
 	boolean boolean;
     char * string;
@@ -133,6 +143,7 @@
 %token <token> CONTINUE
 
 %token <token> DEF
+%token <token> CACHE
 %token <token> RETURNS
 %token <token> CLASS
 
@@ -158,6 +169,8 @@
 %type <expression> expression
 %type <program> program
 %type <parameters> parameters
+%type <parameters> unpackingTargets
+%type <parameters> packedElements
 %type <functionCall> functionCall
 %type <methodCall> methodCall
 %type <fieldGetter> fieldGetter
@@ -215,6 +228,9 @@ sentence: expression[expr] sentence[sent]							{ $$ = ExpressionSentenceSemanti
 	| variable[var] sentence[sent]									{ $$ = VariableSentenceSemanticAction($var, $sent);    }
     | block[bloc] sentence[sent]                                    { $$ = BlockSentenceSemanticAction($bloc, $sent);      }
 	| RETURN_KEYWORD_TOKEN expression[expr] sentence[sent]			{ $$ = ReturnSentenceSemanticAction($expr, $sent);     }
+	| unpackingTargets[targets] ASSIGN expression[expr] sentence[sent]	{ $$ = UnpackingSentenceSemanticAction($targets, $expr, $sent); }
+	| unpackingTargets[targets] ASSIGN expression[first] COMMA packedElements[rest] sentence[sent]
+		{ $$ = UnpackingSentenceSemanticAction($targets, ConstantExpressionSemanticAction(TupleConstantSemanticAction(ParametrizedTupleSemanticAction(ParametersSemanticAction($first, $rest, NOT_FINAL)))), $sent); }
 	| %empty														{ $$ = EndOfSentencesSemanticAction(); }
 
 block: functionDefinition[fdef] COLON INDENT sentence[prog] DEDENT             				{ $$ = FunctionDefinitionBlockSemanticAction($fdef, $prog); }
@@ -244,6 +260,7 @@ functionDefinition: DEF IDENTIFIER[id] OPEN_PARENTHESIS parameters[params] CLOSE
                   | DEF IDENTIFIER[id] OPEN_PARENTHESIS parameters[params] CLOSE_PARENTHESIS RETURNS variableCall[retVar]   { $$ = VariableCallFunctionDefinitionSemanticAction($id, $params, $retVar); }
                   | DEF IDENTIFIER[id] OPEN_PARENTHESIS parameters[params] CLOSE_PARENTHESIS RETURNS tuple[tupleVar]        { $$ = TupleFunctionDefinitionSemanticAction($id, $params, $tupleVar); }
                   | DEF IDENTIFIER[id] OPEN_PARENTHESIS parameters[params] CLOSE_PARENTHESIS RETURNS list[listVar]          { $$ = ListFunctionDefinitionSemanticAction($id, $params, $listVar); }
+                  | CACHE functionDefinition[fdef]                                                                          { $$ = CachedFunctionDefinitionSemanticAction($fdef); }
 
 classDefinition: CLASS IDENTIFIER[id]                               { $$ = ClassDefinitionSemanticAction($id); }
                | CLASS IDENTIFIER[id] tuple[tpl]                    { $$ = TupleClassDefinitionSemanticAction($id, $tpl); }
@@ -284,6 +301,15 @@ expression: expression[left] ADD expression[right]					{ $$ = ArithmeticExpressi
 variable: IDENTIFIER[id] ASSIGN expression[expr]                    { $$ = ExpressionVariableSemanticAction($id, $expr);}
 		;
 
+unpackingTargets: IDENTIFIER[id] COMMA IDENTIFIER[last]			{ $$ = ParametersSemanticAction(VariableCallExpressionSemanticAction(VariableCallSemanticAction($id)),
+																		ParametersSemanticAction(VariableCallExpressionSemanticAction(VariableCallSemanticAction($last)), NULL, FINAL), NOT_FINAL); }
+	| IDENTIFIER[id] COMMA unpackingTargets[next]					{ $$ = ParametersSemanticAction(VariableCallExpressionSemanticAction(VariableCallSemanticAction($id)), $next, NOT_FINAL); }
+	;
+
+packedElements: expression[left]									{ $$ = ParametersSemanticAction($left, NULL, FINAL); }
+	| expression[left] COMMA packedElements[right]					{ $$ = ParametersSemanticAction($left, $right, NOT_FINAL); }
+	;
+
 constant: INTEGER													{ $$ = IntegerConstantSemanticAction($1); }
 	    | BOOLEAN													{ $$ = BooleanConstantSemanticAction($1); }
         | FLOAT                                                     { $$ = FloatConstantSemanticAction($1); }
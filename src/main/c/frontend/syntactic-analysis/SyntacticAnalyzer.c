@@ -46,6 +46,16 @@ CompilerState * currentCompilerState() {
 	return _currentCompilerState;
 }
 
+Token nextToken() {
+	if (!isTraceEnabled()) {
+		return countToken(yylex());
+	}
+	const double start = traceTimestamp();
+	const Token token = yylex();
+	completeSpan("lexing", "token", start);
+	return countToken(token);
+}
+
 SyntacticAnalysisStatus parse(CompilerState * compilerState) {
 	logDebugging(_logger, "Parsing...");
 	_currentCompilerState = compilerState;
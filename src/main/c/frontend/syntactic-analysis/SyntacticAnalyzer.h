@@ -3,6 +3,7 @@
 
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
 
 /** Bison imported functions. */
 
@@ -29,6 +30,12 @@ typedef enum {
  */
 CompilerState * currentCompilerState();
 
+/**
+ * Reads the next token for Bison, counting it for the statistics and
+ * tracing the time spent lexing it.
+ */
+Token nextToken();
+
 /**
  * Executes the parsing phase of the compiler.
  */
@@ -2,6 +2,7 @@
 #define ENVIRONMENT_HEADER
 
 #include "Type.h"
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -12,6 +13,13 @@
  */
 const boolean getBooleanOrDefault(const char * name, const boolean defaultValue);
 
+/**
+ * Analog to "getStringOrDefault", but parsing the value as a decimal integer.
+ * The default value is used when the variable is undefined or is not an
+ * integer.
+ */
+const int getIntegerOrDefault(const char * name, const int defaultValue);
+
 /**
  * Gets the value of an environment variable by name, or returns a default
  * value if the variable is undefined.
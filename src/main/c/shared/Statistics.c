@@ -0,0 +1,453 @@
+#include "Statistics.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#if defined (_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#if defined (__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/** The most phases a single compilation reports. */
+#define MAXIMUM_PHASES 32
+
+/** The most types of nodes of the abstract syntax tree counted apart. */
+#define MAXIMUM_NODE_TYPES 32
+
+/**
+ * The events of the processor and the kernel counted on every phase, where
+ * the kernel lets the process count them.
+ */
+typedef enum {
+	PC_CYCLES,
+	PC_INSTRUCTIONS,
+	PC_BRANCH_MISSES,
+	PC_L1_DATA_MISSES,
+	PC_LAST_LEVEL_CACHE_MISSES,
+	PC_PAGE_FAULTS,
+	PC_COUNT
+} PerformanceCounter;
+
+static const char * const _counterNames[PC_COUNT] = {
+	"cycles",
+	"instructions",
+	"branchMisses",
+	"l1DataMisses",
+	"lastLevelCacheMisses",
+	"pageFaults"
+};
+
+typedef struct {
+	const char * name;
+	double wallMilliseconds;
+	double cpuMilliseconds;
+	long long allocations;
+	long long releases;
+	/** The events counted during the phase, or -1 where unavailable. */
+	long long counters[PC_COUNT];
+	long peakResidentKilobytes;
+} Phase;
+
+typedef struct {
+	const char * type;
+	long long count;
+} NodeCount;
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+/** Where to write the report, or NULL if statistics are disabled. */
+static const char * _statisticsFile = NULL;
+
+static Phase _phases[MAXIMUM_PHASES];
+static int _phaseCount = 0;
+static double _phaseStart = 0;
+static double _phaseCpuStart = 0;
+static long long _phaseAllocations = 0;
+static long long _phaseReleases = 0;
+static long long _phaseCounters[PC_COUNT];
+static double _start = 0;
+static double _cpuStart = 0;
+static long long _startCounters[PC_COUNT];
+
+/** The file descriptors of the performance counters, or -1 where unavailable. */
+static int _counterFiles[PC_COUNT];
+
+static long long _tokens = 0;
+static NodeCount _nodes[MAXIMUM_NODE_TYPES];
+static int _nodeTypeCount = 0;
+static long _symbols = 0;
+static long long _emittedBytes = 0;
+
+/**
+ * Every call to the allocator made by the compiler. They are only counted
+ * when the build wraps the allocator (see "WRAP_ALLOCATOR"), and always
+ * counted then, since an increment costs less than testing whether
+ * statistics are enabled.
+ */
+static long long _allocations = 0;
+static long long _reallocations = 0;
+static long long _releases = 0;
+
+/* ALLOCATOR */
+
+#if defined (WRAP_ALLOCATOR)
+
+/**
+ * The linker sends every call to these functions made by the compiler to
+ * their "__wrap_" version, and their "__real_" version to the C library,
+ * as requested with "-Wl,--wrap=malloc" and so on.
+ */
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t count, size_t size);
+void * __real_realloc(void * pointer, size_t size);
+void __real_free(void * pointer);
+char * __real_strdup(const char * string);
+
+void * __wrap_malloc(size_t size) {
+	++_allocations;
+	return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t count, size_t size) {
+	++_allocations;
+	return __real_calloc(count, size);
+}
+
+void * __wrap_realloc(void * pointer, size_t size) {
+	if (pointer == NULL) {
+		++_allocations;
+	} else {
+		++_reallocations;
+	}
+	return __real_realloc(pointer, size);
+}
+
+void __wrap_free(void * pointer) {
+	if (pointer != NULL) {
+		++_releases;
+	}
+	__real_free(pointer);
+}
+
+char * __wrap_strdup(const char * string) {
+	++_allocations;
+	return __real_strdup(string);
+}
+
+#endif
+
+/* PRIVATE FUNCTIONS */
+
+/**
+ * The milliseconds elapsed since an arbitrary moment, from a clock that
+ * never goes back.
+ */
+static double _now() {
+#if defined (_WIN32)
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return 1000.0 * counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return 1000.0 * now.tv_sec + now.tv_nsec / 1000000.0;
+#endif
+}
+
+/**
+ * The milliseconds of processor time the process spent so far, both in user
+ * and in kernel mode.
+ */
+static double _cpuNow() {
+#if defined (_WIN32)
+	FILETIME creation;
+	FILETIME exit;
+	FILETIME kernel;
+	FILETIME user;
+	GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+	const unsigned long long ticks = (((unsigned long long) kernel.dwHighDateTime << 32) | kernel.dwLowDateTime)
+		+ (((unsigned long long) user.dwHighDateTime << 32) | user.dwLowDateTime);
+	return ticks / 10000.0;
+#else
+	return 1000.0 * clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * The largest resident set size the process reached so far, in kilobytes.
+ */
+static long _peakResidentKilobytes() {
+#if defined (_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return (long) (counters.PeakWorkingSetSize / 1024);
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#if defined (__APPLE__) && defined (__MACH__)
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+#if defined (__linux__)
+static int _openCounter(const uint32_t type, const uint64_t config) {
+	struct perf_event_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.size = sizeof(attributes);
+	attributes.type = type;
+	attributes.config = config;
+	// The kernel shares the hardware counters when too many are open, and reports how long each one ran.
+	attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	// Counting only the user mode is allowed with the default "perf_event_paranoid" of most distributions.
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	return (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+static uint64_t _cacheMisses(const uint64_t cache) {
+	return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+/**
+ * Opens the performance counters of the process, leaving at -1 the ones the
+ * kernel or the processor do not provide, as on virtual machines, inside
+ * most containers, or out of Linux.
+ */
+static void _openCounters() {
+#if defined (__linux__)
+	_counterFiles[PC_CYCLES] = _openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	_counterFiles[PC_INSTRUCTIONS] = _openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	_counterFiles[PC_BRANCH_MISSES] = _openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	_counterFiles[PC_L1_DATA_MISSES] = _openCounter(PERF_TYPE_HW_CACHE, _cacheMisses(PERF_COUNT_HW_CACHE_L1D));
+	_counterFiles[PC_LAST_LEVEL_CACHE_MISSES] = _openCounter(PERF_TYPE_HW_CACHE, _cacheMisses(PERF_COUNT_HW_CACHE_LL));
+	_counterFiles[PC_PAGE_FAULTS] = _openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+#endif
+	for (int k = 0; k < PC_COUNT; ++k) {
+		if (_counterFiles[k] < 0) {
+			logDebugging(_logger, "The performance counter of %s is unavailable.", _counterNames[k]);
+		}
+	}
+}
+
+static void _closeCounters() {
+#if defined (__linux__)
+	for (int k = 0; k < PC_COUNT; ++k) {
+		if (0 <= _counterFiles[k]) {
+			close(_counterFiles[k]);
+		}
+		_counterFiles[k] = -1;
+	}
+#endif
+}
+
+/**
+ * Reads the events counted since the counters were opened, or -1 for the
+ * unavailable ones. Counters that shared the hardware with others are
+ * scaled to the whole time they were enabled.
+ */
+static void _readCounters(long long values[PC_COUNT]) {
+	for (int k = 0; k < PC_COUNT; ++k) {
+		values[k] = -1;
+#if defined (__linux__)
+		// The count, and the nanoseconds the counter was enabled and running.
+		uint64_t readings[3];
+		if (_counterFiles[k] < 0 || read(_counterFiles[k], readings, sizeof(readings)) != sizeof(readings)) {
+			continue;
+		}
+		if (readings[2] == 0) {
+			values[k] = 0;
+		} else if (readings[2] < readings[1]) {
+			values[k] = (long long) ((double) readings[0] * readings[1] / readings[2]);
+		} else {
+			values[k] = (long long) readings[0];
+		}
+#endif
+	}
+}
+
+/**
+ * The events counted between two readings, or -1 where unavailable.
+ */
+static void _countersBetween(const long long starts[PC_COUNT], const long long ends[PC_COUNT], long long counters[PC_COUNT]) {
+	for (int k = 0; k < PC_COUNT; ++k) {
+		counters[k] = (starts[k] < 0 || ends[k] < 0) ? -1 : ends[k] - starts[k];
+	}
+}
+
+/** Writes the counted events, with null for the unavailable ones. */
+static void _writeCounters(FILE * file, const long long counters[PC_COUNT]) {
+	fprintf(file, "\"counters\": {");
+	for (int k = 0; k < PC_COUNT; ++k) {
+		fprintf(file, (k == 0) ? " \"%s\": " : ", \"%s\": ", _counterNames[k]);
+		if (counters[k] < 0) {
+			fprintf(file, "null");
+		} else {
+			fprintf(file, "%lld", counters[k]);
+		}
+	}
+	fprintf(file, " }");
+}
+
+/**
+ * Writes an allocator counter, or null if this build cannot count them.
+ */
+static void _writeAllocatorCounter(FILE * file, const char * name, const long long count) {
+#if defined (WRAP_ALLOCATOR)
+	fprintf(file, "\"%s\": %lld", name, count);
+#else
+	fprintf(file, "\"%s\": null", name);
+#endif
+}
+
+static void _writeReport() {
+	const boolean isStandardError = strcmp(_statisticsFile, "-") == 0;
+	FILE * file = isStandardError ? stderr : fopen(_statisticsFile, "w");
+	if (file == NULL) {
+		logError(_logger, "Cannot write the statistics on \"%s\".", _statisticsFile);
+		return;
+	}
+	fprintf(file, "{\n\t\"phases\": [");
+	for (int k = 0; k < _phaseCount; ++k) {
+		const Phase * phase = &_phases[k];
+		fprintf(file, "%s\n\t\t{ \"name\": \"%s\", \"wallMilliseconds\": %.3f, \"cpuMilliseconds\": %.3f, ",
+			(k == 0) ? "" : ",", phase->name, phase->wallMilliseconds, phase->cpuMilliseconds);
+		_writeAllocatorCounter(file, "allocations", phase->allocations);
+		fprintf(file, ", ");
+		_writeAllocatorCounter(file, "releases", phase->releases);
+		fprintf(file, ", ");
+		_writeCounters(file, phase->counters);
+		fprintf(file, ", \"peakResidentKilobytes\": %ld }", phase->peakResidentKilobytes);
+	}
+	fprintf(file, "\n\t],\n\t\"wallMilliseconds\": %.3f,\n\t\"cpuMilliseconds\": %.3f,\n\t\"tokens\": %lld,\n\t\"nodes\": {",
+		_now() - _start, _cpuNow() - _cpuStart, _tokens);
+	for (int k = 0; k < _nodeTypeCount; ++k) {
+		fprintf(file, "%s\n\t\t\"%s\": %lld", (k == 0) ? "" : ",", _nodes[k].type, _nodes[k].count);
+	}
+	fprintf(file, "\n\t},\n\t\"symbols\": %ld,\n\t\"emittedBytes\": %lld,\n\t", _symbols, _emittedBytes);
+	_writeAllocatorCounter(file, "allocations", _allocations);
+	fprintf(file, ",\n\t");
+	_writeAllocatorCounter(file, "reallocations", _reallocations);
+	fprintf(file, ",\n\t");
+	_writeAllocatorCounter(file, "releases", _releases);
+	long long ends[PC_COUNT];
+	long long counters[PC_COUNT];
+	_readCounters(ends);
+	_countersBetween(_startCounters, ends, counters);
+	fprintf(file, ",\n\t");
+	_writeCounters(file, counters);
+	fprintf(file, ",\n\t\"peakResidentKilobytes\": %ld\n}\n", _peakResidentKilobytes());
+	if (!isStandardError) {
+		fclose(file);
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+void initializeStatisticsModule() {
+	_logger = createLogger("Statistics");
+	_statisticsFile = getStringOrDefault("STATISTICS_FILE", NULL);
+	if (_statisticsFile != NULL && *_statisticsFile == '\0') {
+		_statisticsFile = NULL;
+	}
+	_phaseCount = 0;
+	_nodeTypeCount = 0;
+	for (int k = 0; k < PC_COUNT; ++k) {
+		_counterFiles[k] = -1;
+	}
+	if (_statisticsFile != NULL) {
+		_openCounters();
+	}
+	_readCounters(_startCounters);
+	_start = _now();
+	_cpuStart = _cpuNow();
+}
+
+void shutdownStatisticsModule() {
+	if (_statisticsFile != NULL) {
+		_writeReport();
+	}
+	_closeCounters();
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+boolean isStatisticsEnabled() {
+	return _statisticsFile != NULL;
+}
+
+void beginPhase(const char * name) {
+	beginSpan("phase", name, NULL);
+	if (_statisticsFile == NULL || _phaseCount == MAXIMUM_PHASES) {
+		return;
+	}
+	_phases[_phaseCount].name = name;
+	_phaseAllocations = _allocations;
+	_phaseReleases = _releases;
+	_readCounters(_phaseCounters);
+	_phaseCpuStart = _cpuNow();
+	_phaseStart = _now();
+}
+
+void endPhase() {
+	endSpan();
+	if (_statisticsFile == NULL || _phaseCount == MAXIMUM_PHASES) {
+		return;
+	}
+	Phase * phase = &_phases[_phaseCount];
+	phase->wallMilliseconds = _now() - _phaseStart;
+	phase->cpuMilliseconds = _cpuNow() - _phaseCpuStart;
+	phase->allocations = _allocations - _phaseAllocations;
+	phase->releases = _releases - _phaseReleases;
+	long long counters[PC_COUNT];
+	_readCounters(counters);
+	_countersBetween(_phaseCounters, counters, phase->counters);
+	phase->peakResidentKilobytes = _peakResidentKilobytes();
+	++_phaseCount;
+}
+
+Token countToken(Token token) {
+	++_tokens;
+	return token;
+}
+
+void countNode(const char * type) {
+	if (_statisticsFile == NULL) {
+		return;
+	}
+	for (int k = 0; k < _nodeTypeCount; ++k) {
+		if (_nodes[k].type == type || strcmp(_nodes[k].type, type) == 0) {
+			++_nodes[k].count;
+			return;
+		}
+	}
+	if (_nodeTypeCount < MAXIMUM_NODE_TYPES) {
+		_nodes[_nodeTypeCount].type = type;
+		_nodes[_nodeTypeCount].count = 1;
+		++_nodeTypeCount;
+	}
+}
+
+void countSymbols(long symbols) {
+	_symbols = symbols;
+}
+
+void countEmittedBytes(long bytes) {
+	if (0 < bytes) {
+		_emittedBytes += bytes;
+	}
+}
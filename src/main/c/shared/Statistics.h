@@ -0,0 +1,57 @@
+#ifndef STATISTICS_HEADER
+#define STATISTICS_HEADER
+
+#include "Environment.h"
+#include "Logger.h"
+#include "Trace.h"
+#include "Type.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeStatisticsModule();
+
+/**
+ * Shutdown module's internal state, writing the report of the measured
+ * phases if one was requested.
+ */
+void shutdownStatisticsModule();
+
+/**
+ * Whether the phases of the compilation are measured, as requested by the
+ * "STATISTICS_FILE" environment variable.
+ */
+boolean isStatisticsEnabled();
+
+/**
+ * Starts measuring a phase of the compilation, which lasts until the next
+ * call to "endPhase", and starts its span on the trace. Does nothing unless
+ * statistics or the trace are enabled.
+ */
+void beginPhase(const char * name);
+
+/**
+ * Ends the phase that began last, recording its wall and processor times,
+ * the allocations made during it and the peak resident set size of the
+ * process by its end.
+ */
+void endPhase();
+
+/**
+ * Counts a token read by the parser, and returns it unchanged so that it
+ * can wrap the scanner.
+ */
+Token countToken(Token token);
+
+/**
+ * Counts a node of the abstract syntax tree of the given type, which must
+ * be a string that outlives the module.
+ */
+void countNode(const char * type);
+
+/** Records how many symbols the semantic analysis declared. */
+void countSymbols(long symbols);
+
+/** Adds the size of a generated file to the bytes emitted. */
+void countEmittedBytes(long bytes);
+
+#endif
@@ -0,0 +1,161 @@
+#include "Trace.h"
+#include <time.h>
+#if defined (_WIN32)
+#include <windows.h>
+#elif defined (__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+
+/** Where the events go, or NULL if tracing is disabled. */
+static FILE * _file = NULL;
+
+/** The moment the trace started, in microseconds of a monotonic clock. */
+static double _start = 0;
+
+/* PRIVATE FUNCTIONS */
+
+static double _now() {
+#if defined (_WIN32)
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return 1000000.0 * counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return 1000000.0 * now.tv_sec + now.tv_nsec / 1000.0;
+#endif
+}
+
+/**
+ * The identifier of the calling thread, so that every thread gets its own
+ * lane on the timeline.
+ */
+static long _threadIdentifier() {
+#if defined (_WIN32)
+	return (long) GetCurrentThreadId();
+#elif defined (__linux__)
+	// Asking the kernel on every event would cost more than the event.
+	static __thread long identifier = 0;
+	if (identifier == 0) {
+		identifier = (long) syscall(SYS_gettid);
+	}
+	return identifier;
+#else
+	return 1;
+#endif
+}
+
+/**
+ * Keeps the events that take several writes whole when threads trace at
+ * the same time.
+ */
+static void _lock() {
+#if defined (_WIN32)
+	_lock_file(_file);
+#else
+	flockfile(_file);
+#endif
+}
+
+static void _unlock() {
+#if defined (_WIN32)
+	_unlock_file(_file);
+#else
+	funlockfile(_file);
+#endif
+}
+
+/**
+ * Writes a string as the contents of a JSON string, escaping the
+ * characters that would end it.
+ */
+static void _writeEscaped(const char * string) {
+	for (; *string != '\0'; ++string) {
+		const unsigned char character = (unsigned char) *string;
+		if (character == '"' || character == '\\') {
+			fputc('\\', _file);
+			fputc(character, _file);
+		} else if (character < 0x20) {
+			fprintf(_file, "\\u%04x", character);
+		} else {
+			fputc(character, _file);
+		}
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+void initializeTraceModule() {
+	_logger = createLogger("Trace");
+	const char * path = getStringOrDefault("TRACE_FILE", NULL);
+	_file = NULL;
+	if (path == NULL || *path == '\0') {
+		return;
+	}
+	_file = fopen(path, "w");
+	if (_file == NULL) {
+		logError(_logger, "Cannot write the trace on \"%s\".", path);
+		return;
+	}
+	_start = _now();
+	// Every later event follows a comma, since this one always comes first.
+	fprintf(_file, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"Compiler\"}}", _threadIdentifier());
+}
+
+void shutdownTraceModule() {
+	if (_file != NULL) {
+		fprintf(_file, "\n]\n");
+		fclose(_file);
+		_file = NULL;
+	}
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+boolean isTraceEnabled() {
+	return _file != NULL;
+}
+
+void beginSpan(const char * category, const char * name, const char * detail) {
+	if (_file == NULL) {
+		return;
+	}
+	_lock();
+	fprintf(_file, ",\n{\"cat\":\"%s\",\"name\":\"", category);
+	_writeEscaped(name);
+	fprintf(_file, "\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%ld", _now() - _start, _threadIdentifier());
+	if (detail != NULL) {
+		fprintf(_file, ",\"args\":{\"detail\":\"");
+		_writeEscaped(detail);
+		fprintf(_file, "\"}");
+	}
+	fputc('}', _file);
+	_unlock();
+}
+
+void endSpan() {
+	if (_file == NULL) {
+		return;
+	}
+	fprintf(_file, ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%ld}", _now() - _start, _threadIdentifier());
+}
+
+double traceTimestamp() {
+	return (_file == NULL) ? 0 : _now() - _start;
+}
+
+void completeSpan(const char * category, const char * name, const double start) {
+	if (_file == NULL) {
+		return;
+	}
+	fprintf(_file, ",\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%ld}",
+		category, name, start, _now() - _start - start, _threadIdentifier());
+}
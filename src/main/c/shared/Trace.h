@@ -0,0 +1,45 @@
+#ifndef TRACE_HEADER
+#define TRACE_HEADER
+
+#include "Environment.h"
+#include "Logger.h"
+#include "Type.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeTraceModule();
+
+/** Shutdown module's internal state, closing the trace if one was requested. */
+void shutdownTraceModule();
+
+/**
+ * Whether the compilation writes a timeline in the trace event format of
+ * Chrome and Perfetto, as requested by the "TRACE_FILE" environment variable.
+ */
+boolean isTraceEnabled();
+
+/**
+ * Starts a span of the timeline on the lane of the calling thread, which
+ * lasts until the next call to "endSpan" on the same thread. The detail is
+ * optional, and shows as an argument of the span. Does nothing unless
+ * tracing is enabled.
+ */
+void beginSpan(const char * category, const char * name, const char * detail);
+
+/** Ends the span of the calling thread that began last. */
+void endSpan();
+
+/**
+ * The microseconds elapsed since the trace started, to be given later to
+ * "completeSpan".
+ */
+double traceTimestamp();
+
+/**
+ * Writes a whole span that started at the given timestamp and ends now, in
+ * a single event. Preferred for short and frequent spans, such as the ones
+ * of every token.
+ */
+void completeSpan(const char * category, const char * name, const double start);
+
+#endif
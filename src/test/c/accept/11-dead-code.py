@@ -0,0 +1,31 @@
+# Unreachable sentences and never called functions are dropped before generation
+
+def used(a): @{
+    if a > 0: @{
+        return a
+    @}
+    else: @{
+        return 0
+    @}
+    a = 7
+@}
+
+def unused(b): @{
+    return used(b)
+@}
+
+def loop(): @{
+    while True: @{
+        y = 1
+    @}
+    y = 2
+@}
+
+x = used(1)
+z = loop()
+if False: @{
+    w = 3
+@}
+while False: @{
+    w = 4
+@}
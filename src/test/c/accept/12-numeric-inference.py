@@ -0,0 +1,16 @@
+# Values keep a primitive type when every assignment agrees on it
+
+def scale(value, factor): @{
+    return value * factor
+@}
+
+big = 3000000000
+small = 7
+ratio = small / 2
+square = small ** 2
+total = big + small
+scaled = scale(small, 2)
+half = scale(ratio, 0.5)
+if small > 3: @{
+    flag = True
+@}
@@ -0,0 +1,26 @@
+# Strings, lists and tuples are iterated without copying or boxing
+
+word = "banana"
+count = 0
+for letter in word: @{
+    if letter == "a": @{
+        count = count + 1
+    @}
+@}
+
+primes = [2, 3, 5, 7]
+total = 0
+for prime in primes: @{
+    total = total + prime
+@}
+
+weights = [0.5, 1, 2.5]
+weighted = 0.0
+for weight in weights: @{
+    weighted = weighted + weight
+@}
+
+offset = 0
+for step in (1, 10, 100): @{
+    offset = offset + step
+@}
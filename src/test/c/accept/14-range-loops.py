@@ -0,0 +1,33 @@
+# Ranges become counted loops over a primitive index
+
+def triangle(n): @{
+    total = 0
+    for i in range(n): @{
+        total = total + i
+    @}
+    return total
+@}
+
+evens = 0
+for j in range(0, 10, 2): @{
+    evens = evens + j
+@}
+
+countdown = 0
+for k in range(10, 0, -1): @{
+    countdown = countdown + k
+    k = 0
+@}
+
+stride = 3
+strided = 0
+for m in range(1, 20, stride): @{
+    strided = strided + m
+@}
+
+big = 0
+for n in range(3000000000, 3000000005): @{
+    big = big + n
+@}
+
+result = triangle(100)
@@ -0,0 +1,24 @@
+# Floor division, modulo and powers keep Python semantics
+
+def cube(value): @{
+    return value ** 3
+@}
+
+count = -7
+big = 5000000000
+height = 2.5
+halves = count // 2
+quarters = (count + 1) // 4
+rest = count % 8
+digit = count % 10
+split = count // 3
+bigRest = big % 4294967296
+side = height ** 0.5
+area = height ** 2
+unit = count ** 0
+power = count ** 9
+growth = height ** 3.5
+fraction = height // 0.5
+leftover = height % 0.75
+ones = (True + True) * 3
+volume = cube(count)
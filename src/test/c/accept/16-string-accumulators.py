@@ -0,0 +1,33 @@
+# Strings only appended to inside a loop are built with a StringBuilder
+
+def repeat(text, times): @{
+    result = ""
+    count = 0
+    while count < times: @{
+        result = result + text
+        count = count + 1
+    @}
+    return result
+@}
+
+line = ""
+for i in range(10): @{
+    line = line + "ab" + "c"
+@}
+vowels = ""
+others = ""
+for letter in "accumulator": @{
+    if letter == "a": @{
+        vowels = vowels + letter
+    @}
+    else: @{
+        others = others + letter
+    @}
+@}
+echo = ""
+for word in ["x", "y"]: @{
+    echo = echo + word
+    echo = echo + echo
+@}
+once = "left" + "right"
+twice = repeat(once, 2)
@@ -0,0 +1,35 @@
+# Membership tests against literals never build a collection
+
+def isVowel(letter): @{
+    return letter in "aeiou"
+@}
+
+primes = [2, 3, 5, 7, 11]
+count = 0
+for number in range(100): @{
+    if number in [2, 3, 5, 7, 11, 13]: @{
+        count = count + 1
+    @}
+    if number * 3 in (1000, 2000, 40): @{
+        count = count + 1
+    @}
+    if number not in primes: @{
+        count = count - 1
+    @}
+    if number in [0.5, 1, 2]: @{
+        count = count + 2
+    @}
+@}
+vowels = 0
+for letter in "membership": @{
+    if letter in ["a", "e", "e"]: @{
+        vowels = vowels + 1
+    @}
+    if isVowel(letter): @{
+        vowels = vowels + 1
+    @}
+@}
+color = "red"
+isWarm = color in ["red", "orange", "yellow"]
+isCold = color not in ["blue", "green"]
+isPart = "ed" in color
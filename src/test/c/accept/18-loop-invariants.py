@@ -0,0 +1,24 @@
+# Invariant expressions are computed once before their loop
+
+def weigh(data, scale): @{
+    total = 0
+    index = 0
+    while index < len(data) * scale: @{
+        total = total + abs(scale - 10) * index
+        index = index + 1
+    @}
+    return total
+@}
+
+width = 12
+height = 5
+area = 0
+for row in range(height): @{
+    for column in range(width): @{
+        area = area + width * height + row * (width // 4)
+        if column % 2 == 0 and width > height: @{
+            area = area - 1
+        @}
+    @}
+@}
+weight = weigh("payload", 3)
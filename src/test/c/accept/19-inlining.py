@@ -0,0 +1,40 @@
+# Small single-return functions are expanded at their call sites
+
+def square(x): @{
+    return x * x
+@}
+
+def hypotenuse(a, b): @{
+    return square(a) + square(b)
+@}
+
+def average(a, b): @{
+    return (a + b) / 2
+@}
+
+def between(value, low, high): @{
+    return low < value and value < high
+@}
+
+def countdown(n): @{
+    if n <= 0: @{
+        return 0
+    @}
+    return countdown(n - 1)
+@}
+
+def next(n): @{
+    return n + 1
+@}
+
+def twice(n): @{
+    return n + n
+@}
+
+side = 3
+diagonal = hypotenuse(side, side + 1)
+middle = average(side, 2.5)
+inside = between(side, 1, 10)
+stepped = next(next(side))
+doubled = twice(side * 2)
+unwound = countdown(side)
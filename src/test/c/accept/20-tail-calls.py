@@ -0,0 +1,29 @@
+# Functions returning a call to themselves run as loops
+
+def total(n, accumulated): @{
+    if n == 0: @{
+        return accumulated
+    @}
+    return total(n - 1, accumulated + n)
+@}
+
+def gcd(a, b): @{
+    if b == 0: @{
+        return a
+    @}
+    return gcd(b, a % b)
+@}
+
+def collatz(n, steps): @{
+    if n == 1: @{
+        return steps
+    @}
+    if n % 2 == 0: @{
+        return collatz(n // 2, steps + 1)
+    @}
+    return collatz(3 * n + 1, steps + 1)
+@}
+
+summed = total(100000, 0)
+divisor = gcd(1071, 462)
+steps = collatz(27, 0)
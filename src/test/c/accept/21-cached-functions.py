@@ -0,0 +1,32 @@
+# Functions decorated with @cache remember their results by argument
+
+@cache
+def fibonacci(n): @{
+    if n < 2: @{
+        return n
+    @}
+    return fibonacci(n - 1) + fibonacci(n - 2)
+@}
+
+@cache
+def paths(rows, columns): @{
+    if rows == 0 or columns == 0: @{
+        return 1
+    @}
+    return paths(rows - 1, columns) + paths(rows, columns - 1)
+@}
+
+@cache
+def shout(word): @{
+    return word + "!"
+@}
+
+@cache
+def half(x): @{
+    return x / 2
+@}
+
+big = fibonacci(40)
+grid = paths(16, 16)
+loud = shout("hey")
+third = half(3)
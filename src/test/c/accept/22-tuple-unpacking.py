@@ -0,0 +1,21 @@
+# Unpacking assignments read tuples without building them when they can
+
+def divide(dividend, divisor): @{
+    if divisor == 0: @{
+        return (0, "undefined")
+    @}
+    return (dividend // divisor, "exact")
+@}
+
+def bounds(center): @{
+    interval = (center - 1, center + 1)
+    return interval
+@}
+
+a = 1
+b = 2
+a, b = b, a
+quotient, label = divide(17, 5)
+low, high = (3, 4)
+x, y, z = (a + b, quotient * 2, label)
+left, right = bounds(5)
@@ -0,0 +1,53 @@
+# Loops that only fold a side-effect free expression into an integer run as streams
+
+def square(n): @{
+    return n * n
+@}
+
+def collatz(n): @{
+    steps = 0
+    while n != 1: @{
+        if n % 2 == 0: @{
+            n = n // 2
+        @} else: @{
+            n = 3 * n + 1
+        @}
+        steps = steps + 1
+    @}
+    return steps
+@}
+
+limit = 100000
+offset = 3
+total = 0
+for i in range(limit): @{
+    total = total + square(i) % 7 + offset
+@}
+
+longest = 0
+for i in range(1, limit): @{
+    if collatz(i) > 100: @{
+        longest = longest + 1
+    @}
+@}
+
+product = 1
+for k in range(1, 20000): @{
+    product = product * (k % 3 + 1)
+@}
+
+small = 0
+for j in range(10): @{
+    small = small + j
+@}
+last = j
+
+def energy(values): @{
+    result = 0
+    for v in values: @{
+        result = result + v * v
+    @}
+    return result
+@}
+
+e = energy([1, 2, 3])
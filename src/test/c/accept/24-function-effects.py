@@ -0,0 +1,30 @@
+# Function effects are summarized across mutual recursion and reads of globals
+
+def is_even(n): @{
+    if n == 0: @{
+        return True
+    @}
+    return is_odd(n - 1)
+@}
+
+def is_odd(n): @{
+    if n == 0: @{
+        return False
+    @}
+    return is_even(n - 1)
+@}
+
+scale = 3
+
+def scaled(n): @{
+    return n * scale
+@}
+
+
+limit = 20000
+evens = 0
+for i in range(limit): @{
+    if is_even(i % 10): @{
+        evens = evens + scaled(i)
+    @}
+@}
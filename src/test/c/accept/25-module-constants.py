@@ -0,0 +1,24 @@
+# Top-level variables assigned once with a constant value become constants that functions can read
+
+greeting = "Hola Mundo"
+base = 10
+limit = base * 2 + 1
+weights = [1, 2, base]
+isHalf = 0.5 in [0.5, 1, 2]
+counter = 0
+counter = counter + 1
+
+def greet(times): @{
+    return greeting
+@}
+
+def scaled(n): @{
+    base = n + 1
+    return base * limit
+@}
+
+total = 0
+for i in range(limit): @{
+    total = total + scaled(i)
+@}
+message = greet(total)
@@ -0,0 +1,23 @@
+# Integers are held in ints, longs, checked longs or big integers depending on the values they may take
+
+def area(width, height): @{
+    return width * height
+@}
+
+def factorial(n): @{
+    result = 1
+    for k in range(1, n + 1): @{
+        result = result * k
+    @}
+    return result
+@}
+
+side = 100000
+small = area(3, 4)
+large = area(side, side)
+digits = large % 10
+huge = factorial(25)
+cubes = 0
+for i in range(2000): @{
+    cubes = cubes + i ** 3
+@}
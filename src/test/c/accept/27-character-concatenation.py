@@ -0,0 +1,14 @@
+# Characters of a string are joined as strings, not added as numbers
+
+total = ""
+for c in "xy": @{
+    total = c + c + total
+@}
+pair = ""
+for c in "ab": @{
+    pair = c + c
+@}
+tail = "z"
+for c in "qr": @{
+    tail = tail + c
+@}
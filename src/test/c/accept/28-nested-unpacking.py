@@ -0,0 +1,17 @@
+# Unpacked calls nest, and loops calling them stay sequential
+
+def split(n, d): @{
+    return (n // d, n % d)
+@}
+
+def digits(n): @{
+    q, r = split(n, 10)
+    s, t = split(q, 10)
+    return r + t
+@}
+
+a, b = split(digits(123), 3)
+total = 0
+for i in range(100000): @{
+    total = total + digits(i)
+@}
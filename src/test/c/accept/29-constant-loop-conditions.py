@@ -0,0 +1,21 @@
+# Loops whose condition only reads module constants keep their bodies reachable
+
+running = True
+done = False
+start = 3
+steps = 0
+while done: @{
+    steps = steps + 1
+@}
+while start > 5: @{
+    steps = steps + start
+@}
+
+def first(n): @{
+    while running: @{
+        return n
+    @}
+    return 0
+@}
+
+value = first(start)
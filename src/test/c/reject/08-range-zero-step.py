@@ -0,0 +1,4 @@
+total = 0
+for i in range(0, 10, 0): @{
+    total = total + i
+@}
@@ -0,0 +1 @@
+first, second = (1, 2, 3)